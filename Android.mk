@@ -67,6 +67,7 @@ LOCAL_SRC_FILES += src/phFriNfc_LlcpTransport_Connectionless.c
 LOCAL_SRC_FILES += src/phFriNfc_LlcpTransport_Connection.c
 LOCAL_SRC_FILES += src/phFriNfc_LlcpMac.c
 LOCAL_SRC_FILES += src/phFriNfc_LlcpMacNfcip.c
+LOCAL_SRC_FILES += src/phFriNfc_LlcpMacLoopback.c
 
 #phFriNfc_NdefMap
 LOCAL_SRC_FILES += src/phFriNfc_FelicaMap.c
@@ -156,3 +157,25 @@ LOCAL_MODULE_TAGS := optional
 LOCAL_SHARED_LIBRARIES := libcutils liblog
 
 include $(BUILD_SHARED_LIBRARY)
+
+#
+# libnfc_ndef for the host, linked by the NDEF benchmark in tests/
+#
+
+include $(CLEAR_VARS)
+
+LOCAL_SRC_FILES += src/phFriNfc_NdefRecord.c
+
+LOCAL_CFLAGS += -I$(LOCAL_PATH)/inc
+LOCAL_CFLAGS += -I$(LOCAL_PATH)/src
+
+LOCAL_MODULE:= libnfc_ndef
+LOCAL_MODULE_TAGS := optional
+
+include $(BUILD_HOST_STATIC_LIBRARY)
+
+#
+# Host benchmarks and tests
+#
+
+include $(call all-makefiles-under,$(LOCAL_PATH))
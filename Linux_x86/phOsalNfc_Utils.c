@@ -27,6 +27,7 @@
  *
  */
 
+#include <time.h>
 #include <phNfcStatus.h>
 #include <phNfcCompId.h>
 #include <phNfcConfig.h>
@@ -52,6 +53,12 @@ int phOsalNfc_MemCompare ( void *src, void *dest, unsigned int n )
     return (int)diff;
 }
 
+/*The function returns the monotonic time in milliseconds, used to
+measure the duration of the operations*/
+uint32_t phOsalNfc_GetTime ( void )
+{
+    struct timespec now;
 
-
-
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)((now.tv_sec * 1000) + (now.tv_nsec / 1000000));
+}
@@ -200,6 +200,30 @@
 #define PRESENCE_CHECK_INTERVAL   500U
 #endif 
 
+/**< Idle period of the discovery wheel in microseconds,
+ * for the Fast Tap polling profile */
+#ifndef NXP_POLL_FAST_TAP_DURATION
+#define NXP_POLL_FAST_TAP_DURATION      50000U
+#endif
+
+/**< Idle period of the discovery wheel in microseconds,
+ * for the Full Sweep polling profile */
+#ifndef NXP_POLL_FULL_SWEEP_DURATION
+#define NXP_POLL_FULL_SWEEP_DURATION    300000U
+#endif
+
+/**< Idle period of the discovery wheel in microseconds,
+ * for the Low Power polling profile */
+#ifndef NXP_POLL_LOW_POWER_DURATION
+#define NXP_POLL_LOW_POWER_DURATION     1000000U
+#endif
+
+/**< Time in milliseconds after the last detection, during which the
+ * Adaptive polling profile keeps the Fast Tap idle period */
+#ifndef NXP_POLL_ADAPTIVE_IDLE_TIME
+#define NXP_POLL_ADAPTIVE_IDLE_TIME     30000U
+#endif
+
 /** Resolution value for the timer, here the 
     timer resolution is 500 milliseconds */
 #ifndef TIMER_RESOLUTION
@@ -264,6 +288,58 @@
 #define NXP_NFC_HCI_TIMEOUT     6000
 #endif
 
+/**< Number of Registry values cached per HCI Pipe, when the
+ * HCI Registry Cache is enabled */
+#ifndef NXP_HCI_REG_CACHE_ENTRIES
+#define NXP_HCI_REG_CACHE_ENTRIES       0x06U
+#endif
+
+/**< Delay in milliseconds before a Registry value served from the
+ * HCI Registry Cache is delivered to the Gate */
+#ifndef NXP_HCI_REG_CACHE_DELAY
+#define NXP_HCI_REG_CACHE_DELAY         0x01U
+#endif
+
+/**< Number of Targets whose Activation Parameters are cached for
+ * the Fast Reselection of the Targets in the field */
+#ifndef NXP_HCI_ACT_CACHE_ENTRIES
+#define NXP_HCI_ACT_CACHE_ENTRIES       0x04U
+#endif
+
+/**< Maximum number of LLCP PDUs aggregated in one AGF frame, bounding the
+ * send notifications deferred until the frame is sent */
+#ifndef NXP_LLCP_AGF_MAX_PDUS
+#define NXP_LLCP_AGF_MAX_PDUS           0x08U
+#endif
+
+/**< Number of Tags whose NDEF message is kept by the NDEF Read Cache */
+#ifndef NXP_NDEF_READ_CACHE_ENTRIES
+#define NXP_NDEF_READ_CACHE_ENTRIES     0x04U
+#endif
+
+/**< Largest NDEF message, in bytes, kept by the NDEF Read Cache */
+#ifndef NXP_NDEF_READ_CACHE_MAX_LEN
+#define NXP_NDEF_READ_CACHE_MAX_LEN     0x0400U
+#endif
+
+/**< Number of bytes of the last response of the Check NDEF compared by the
+ * NDEF Read Cache to detect a message changed by another device */
+#ifndef NXP_NDEF_READ_CACHE_PRINT_LEN
+#define NXP_NDEF_READ_CACHE_PRINT_LEN   0x10U
+#endif
+
+/**< Number of bytes read ahead of the requested range by the ranged
+ * NDEF reads, rounded up to the block size of the Tag */
+#ifndef NXP_NDEF_READ_PREFETCH_LEN
+#define NXP_NDEF_READ_PREFETCH_LEN      0x40U
+#endif
+
+/**< Maximum number of pages of a Type 2 Tag read by one FAST_READ, bounded
+ * by the frame the HAL receives: 0x3C pages are 240 bytes */
+#ifndef NXP_MFUL_FAST_READ_PAGES
+#define NXP_MFUL_FAST_READ_PAGES        0x3CU
+#endif
+
 
 /*
  *****************************************************************
@@ -372,6 +448,46 @@
 /**< Support reconnecting to a different handle on the same tag */
 #define RECONNECT_SUPPORT
 
+/**< Macro to Enable the Profiling of the HCI Sequence Steps, the duration
+ * of each step run by the HCI Sequence Engine is recorded */
+#define NXP_HCI_SEQ_PROFILE
+
+/**< Macro to Enable the HCI Registry Cache, the Registry values read
+ * through ANY_GET_PARAMETER are served from the HCI Context until the
+ * Target is lost or the Session is reset */
+#define NXP_HCI_REG_CACHE
+
+/**< Macro to Enable the Fast Reselection of the Targets, the Activation
+ * Parameters of a Target reselected through Activate Next are restored
+ * from the cache once its identifier is read */
+#define NXP_HCI_FAST_RESELECT
+
+/**< Macro to Enable the Accounting of the HCP Messages dispatched to the
+ * Gate handlers of each HCI Pipe */
+#define NXP_HCI_DISPATCH_STATS
+
+/**< Macro to Enable the Aggregation of the LLCP PDUs ready on a send turn
+ * into a single AGF frame, up to the MIU of the remote LLC; the sockets are
+ * notified of their sends once the AGF frame is sent */
+/* #define NXP_LLCP_AGF_SEND */
+
+/**< Macro to Enable the NDEF Read Cache, a complete NDEF message read from
+ * a Tag is served again from memory while the UID, the NDEF information and
+ * the first data read by the Check NDEF of the Tag are unchanged */
+/* #define NXP_NDEF_READ_CACHE */
+
+/**< Macro to Enable the FAST_READ of the NDEF data of the Mifare UL EV1 and
+ * NTAG Tags, identified with GET_VERSION at the end of the first Check NDEF
+ * of an NXP Tag whose message needs more than one READ; the other Type 2
+ * Tags are read with READ */
+/* #define NXP_MFUL_FAST_READ */
+
+/**< Number of consecutive send turns granted to the ready LLCP sockets of
+ * each priority before the lower priorities are served */
+#define NXP_LLCP_SCHED_WEIGHT_HIGH          0x04U
+#define NXP_LLCP_SCHED_WEIGHT_NORMAL        0x02U
+#define NXP_LLCP_SCHED_WEIGHT_LOW           0x01U
+
 /**< Macro to Enable the Card Emulation Feature */
 /* #define HOST_EMULATION */
 
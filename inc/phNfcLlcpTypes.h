@@ -48,6 +48,7 @@
 #define PHFRINFC_LLCP_PDU_HEADER_MAX      3    /**< Max size of PDU header (in bytes) */
 #define PHFRINFC_LLCP_SN_MAX_LENGTH       255  /**< Max length value for the Service Name */
 #define PHFRINFC_LLCP_RW_MAX              15   /**< Max RW value (in frames).*/
+#define PHFRINFC_LLCP_MIU_MAX             (PHFRINFC_LLCP_MIU_DEFAULT + PHFRINFC_LLCP_MIUX_MAX) /**< Max MIU value (in bytes).*/
 /*@}*/
 
 /**
@@ -57,7 +58,8 @@
  *
  */
  /*@{*/
-#define PHFRINFC_LLCP_NB_SOCKET_MAX          10                                /**< Max.number of simultaneous sockets */
+#define PHFRINFC_LLCP_NB_SOCKET_MAX          10                                /**< Default number of simultaneous sockets */
+#define PHFRINFC_LLCP_NB_SOCKET_LIMIT        0x80                              /**< Max.number of simultaneous sockets */
 #define PHFRINFC_LLCP_SNL_RESPONSE_MAX       256                               /**< Max.number of simultaneous discovery requests */
 /*@}*/
 
@@ -104,6 +106,15 @@ typedef enum phFriNfc_LlcpTransport_eSocketType
    phFriNfc_LlcpTransport_eConnectionLess
 }phFriNfc_LlcpTransport_eSocketType_t;
 
+/* Enum represents the scheduling priorities of the Sockets */
+typedef enum phFriNfc_LlcpTransport_eSocketPriority
+{
+   phFriNfc_LlcpTransport_ePriorityHigh,
+   phFriNfc_LlcpTransport_ePriorityNormal,
+   phFriNfc_LlcpTransport_ePriorityLow,
+   phFriNfc_LlcpTransport_ePriorityNb
+}phFriNfc_LlcpTransport_eSocketPriority_t;
+
 
 /*========== STRUCTURES ===========*/
 
@@ -117,6 +128,58 @@ typedef struct phFriNfc_LlcpTransport_sSocketOptions
 
 }phFriNfc_LlcpTransport_sSocketOptions_t;
 
+typedef struct phFriNfc_LlcpTransport_sSocketSchedStats
+{
+   /** The number of send turns granted to the socket*/
+   uint32_t   nScheduled;
+
+   /** The cumulated time spent in the ready queue (in ms)*/
+   uint32_t   nTotalDelay;
+
+   /** The longest time spent in the ready queue (in ms)*/
+   uint32_t   nMaxDelay;
+
+}phFriNfc_LlcpTransport_sSocketSchedStats_t;
+
+typedef struct phFriNfc_LlcpTransport_sSocketRecvStats
+{
+   /** The number of I frames stored straight into the receive or linear buffer*/
+   uint32_t   nDirectFrames;
+
+   /** The number of I frames staged in the receive window buffers*/
+   uint32_t   nStagedFrames;
+
+   /** The number of I frames dropped for lack of room*/
+   uint32_t   nDroppedFrames;
+
+}phFriNfc_LlcpTransport_sSocketRecvStats_t;
+
+typedef struct phFriNfc_LlcpTransport_sConfig
+{
+   /** The number of sockets (0 for PHFRINFC_LLCP_NB_SOCKET_MAX)*/
+   uint8_t    nSocketTableSize;
+
+   /** The number of SDP cached service names (0 for PHFRINFC_LLCP_SDP_ADVERTISED_NB)*/
+   uint8_t    nCachedServiceNamesSize;
+
+   /** The lifetime in ms of the remote SAPs learnt by the SDP client (0 for PHFRINFC_LLCP_REMOTE_SAP_TTL)*/
+   uint32_t   nRemoteSapTtl;
+
+}phFriNfc_LlcpTransport_sConfig_t;
+
+typedef struct phFriNfc_LlcpTransport_sSocketMemory
+{
+   /** The size of the socket descriptor (in bytes)*/
+   uint32_t   nSocketBytes;
+
+   /** The size of the receive window buffer table allocated for the socket (in bytes)*/
+   uint32_t   nRwTableBytes;
+
+   /** The size of the working buffer used by the socket (in bytes)*/
+   uint32_t   nBufferBytes;
+
+}phFriNfc_LlcpTransport_sSocketMemory_t;
+
 typedef struct phFriNfc_Llcp_sLinkParameters
 {
     /** The remote Maximum Information Unit (NOTE: this is MIU, not MIUX !)*/
@@ -131,6 +194,15 @@ typedef struct phFriNfc_Llcp_sLinkParameters
     /** The remote options*/
     uint8_t    option;
 
+    /** The shortest delay before answering a SYMM on an idle link, in
+        milliseconds (local parameter only, not exchanged with the peer)*/
+    uint16_t   symm_delay_min;
+
+    /** The longest delay before answering a SYMM on an idle link, in
+        milliseconds, bounded by half the local LTO (local parameter only,
+        0 answers SYMM immediately)*/
+    uint16_t   symm_delay_max;
+
 } phFriNfc_Llcp_sLinkParameters_t;
 
 #endif
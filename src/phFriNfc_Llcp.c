@@ -92,59 +92,35 @@ static NFCSTATUS phFriNfc_Llcp_InternalSend( phFriNfc_Llcp_t
                                              phFriNfc_Llcp_sPacketSequence_t    *psSequence,
                                              phNfc_sData_t                      *psInfo );
 static bool_t phFriNfc_Llcp_HandlePendingSend ( phFriNfc_Llcp_t *Llcp );
-
-static phNfc_sData_t * phFriNfc_Llcp_AllocateAndCopy(phNfc_sData_t * pOrig)
+static void phFriNfc_Llcp_EncodePacket( phFriNfc_Llcp_sPacketHeader_t      *psHeader,
+                                        phFriNfc_Llcp_sPacketSequence_t    *psSequence,
+                                        phNfc_sData_t                      *psInfo,
+                                        phNfc_sData_t                      *psRawPacket );
+static NFCSTATUS phFriNfc_Llcp_SendRawPacket( phFriNfc_Llcp_t *Llcp,
+                                              uint8_t         nPdus );
+#ifdef NXP_LLCP_AGF_SEND
+static NFCSTATUS phFriNfc_Llcp_SendAggregated( phFriNfc_Llcp_t                    *Llcp,
+                                               phFriNfc_Llcp_sPacketHeader_t      *psHeader,
+                                               phFriNfc_Llcp_sPacketSequence_t    *psSequence,
+                                               phNfc_sData_t                      *psInfo );
+#endif /* #ifdef NXP_LLCP_AGF_SEND */
+
+static phNfc_sData_t * phFriNfc_Llcp_BorrowSendInfo( phFriNfc_Llcp_t *Llcp,
+                                                     phNfc_sData_t   *psInfo )
 {
-   phNfc_sData_t * pDest = NULL;
-
-   if (pOrig == NULL)
-   {
-       return NULL;
-   }
-
-   pDest = phOsalNfc_GetMemory(sizeof(phNfc_sData_t));
-   if (pDest == NULL)
-   {
-      goto error;
-   }
-
-   pDest->buffer = phOsalNfc_GetMemory(pOrig->length);
-   if (pDest->buffer == NULL)
+   if (psInfo == NULL)
    {
-      goto error;
+      return NULL;
    }
 
-   memcpy(pDest->buffer, pOrig->buffer, pOrig->length);
-   pDest->length = pOrig->length;
-
-   return pDest;
+   /* Keep the descriptor only, the caller must not release the info */
+   /* buffer before its send callback is called                       */
+   /* NOTE: a single send can be pending, so a single descriptor is needed */
+   Llcp->sSendInfo.buffer = psInfo->buffer;
+   Llcp->sSendInfo.length = psInfo->length;
+   Llcp->sSendStats.nDeferredPdus++;
 
-error:
-   if (pDest != NULL)
-   {
-      if (pDest->buffer != NULL)
-      {
-         phOsalNfc_FreeMemory(pDest->buffer);
-      }
-      phOsalNfc_FreeMemory(pDest);
-   }
-   return NULL;
-}
-
-static void phFriNfc_Llcp_Deallocate(phNfc_sData_t * pData)
-{
-   if (pData != NULL)
-   {
-      if (pData->buffer != NULL)
-      {
-         phOsalNfc_FreeMemory(pData->buffer);
-      }
-      else
-      {
-         LLCP_PRINT("Warning, deallocating empty buffer");
-      }
-      phOsalNfc_FreeMemory(pData);
-   }
+   return &Llcp->sSendInfo;
 }
 
 static NFCSTATUS phFriNfc_Llcp_InternalDeactivate( phFriNfc_Llcp_t *Llcp )
@@ -165,11 +141,7 @@ static NFCSTATUS phFriNfc_Llcp_InternalDeactivate( phFriNfc_Llcp_t *Llcp )
       Llcp->psSendHeader = NULL;
       Llcp->psSendSequence = NULL;
       /* Return delayed send operation in error, in any */
-      if (Llcp->psSendInfo != NULL)
-      {
-         phFriNfc_Llcp_Deallocate(Llcp->psSendInfo);
-         Llcp->psSendInfo = NULL;
-      }
+      Llcp->psSendInfo = NULL;
       if (Llcp->pfSendCB != NULL)
       {
          /* Get Callback params */
@@ -181,6 +153,14 @@ static NFCSTATUS phFriNfc_Llcp_InternalDeactivate( phFriNfc_Llcp_t *Llcp )
          /* Call the callback */
          (pfSendCB)(pSendContext, NFCSTATUS_FAILED);
       }
+#ifdef NXP_LLCP_AGF_SEND
+      if (Llcp->bTurnDeferred == TRUE)
+      {
+         /* Fail the PDUs aggregated in the frame not sent */
+         Llcp->bTurnDeferred = FALSE;
+         (Llcp->pfSendTurnCB)(Llcp->pSendTurnContext, NFCSTATUS_FAILED);
+      }
+#endif /* #ifdef NXP_LLCP_AGF_SEND */
 
       /* Notify service layer */
       Llcp->pfLink_CB(Llcp->pLinkContext, phFriNfc_LlcpMac_eLinkDeactivated);
@@ -373,6 +353,7 @@ static NFCSTATUS phFriNfc_Llcp_ParseLinkParams( phNfc_sData_t
    }
 
    /* Prepare default param structure */
+   memset(&sParams, 0x00, sizeof(phFriNfc_Llcp_sLinkParameters_t));
    sParams.miu    = PHFRINFC_LLCP_MIU_DEFAULT;
    sParams.wks    = PHFRINFC_LLCP_WKS_DEFAULT;
    sParams.lto    = PHFRINFC_LLCP_LTO_DEFAULT;
@@ -410,7 +391,7 @@ static NFCSTATUS phFriNfc_Llcp_ParseLinkParams( phNfc_sData_t
                break;
             }
             /* Get MIU */
-            sParams.miu = (PHFRINFC_LLCP_MIU_DEFAULT + ((sValueBuffer.buffer[0] << 8) | sValueBuffer.buffer[1])) & PHFRINFC_LLCP_TLV_MIUX_MASK;
+            sParams.miu = PHFRINFC_LLCP_MIU_DEFAULT + (((sValueBuffer.buffer[0] << 8) | sValueBuffer.buffer[1]) & PHFRINFC_LLCP_TLV_MIUX_MASK);
             break;
          }
          case PHFRINFC_LLCP_TLV_TYPE_WKS:
@@ -555,6 +536,12 @@ static NFCSTATUS phFriNfc_Llcp_InternalActivate( phFriNfc_Llcp_t *Llcp,
             Llcp->sRemoteParams.miu = Llcp->nTxBufferLength - nMaxHeaderSize;
          }
 
+         /* Start the statistics of the send turns */
+         memset(&Llcp->sSendStats, 0x00, sizeof(phFriNfc_Llcp_sSendStats_t));
+         memset(&Llcp->sSymmStats, 0x00, sizeof(phFriNfc_Llcp_sSymmStats_t));
+         Llcp->nSymmIdleCount = 0;
+         Llcp->nActivationTime = phOsalNfc_GetTime();
+
          /* Initiate Symmetry procedure by resetting LTO timer */
          /* NOTE: this also updates current state */
          phFriNfc_Llcp_ResetLTO(Llcp);
@@ -607,6 +594,7 @@ static NFCSTATUS phFriNfc_Llcp_HandleMACLinkActivated( phFriNfc_Llcp_t  *Llcp,
    if (status == NFCSTATUS_SUCCESS)
    {
       /* Start listening for incoming packets */
+      Llcp->sRxBuffer.buffer = Llcp->pRxBuffer;
       Llcp->sRxBuffer.length = Llcp->nRxBufferLength;
       phFriNfc_LlcpMac_Receive(&Llcp->MAC, &Llcp->sRxBuffer, phFriNfc_Llcp_Receive_CB, Llcp);
    }
@@ -699,6 +687,36 @@ static void phFriNfc_Llcp_LinkStatus_CB( void                              *pCon
 }
 
 
+static uint32_t phFriNfc_Llcp_GetSymmDelay( phFriNfc_Llcp_t *Llcp )
+{
+   uint32_t nMaxDelay;
+   uint32_t nDelay;
+   uint8_t  i;
+
+   /* Answer at once while data is flowing, or if the policy is disabled */
+   if ((Llcp->sLocalParams.symm_delay_max == 0) || (Llcp->nSymmIdleCount <= 1))
+   {
+      return 0;
+   }
+
+   /* The answer must be sent before the local announced LTO */
+   nMaxDelay = (Llcp->sLocalParams.lto * 10) / 2;
+   if (Llcp->sLocalParams.symm_delay_max < nMaxDelay)
+   {
+      nMaxDelay = Llcp->sLocalParams.symm_delay_max;
+   }
+
+   /* Double the delay on each idle exchange */
+   nDelay = (Llcp->sLocalParams.symm_delay_min > 0)?Llcp->sLocalParams.symm_delay_min:1;
+   for (i=2 ; (i<Llcp->nSymmIdleCount) && (nDelay<nMaxDelay) ; i++)
+   {
+      nDelay <<= 1;
+   }
+
+   return (nDelay < nMaxDelay)?nDelay:nMaxDelay;
+}
+
+
 static void phFriNfc_Llcp_ResetLTO( phFriNfc_Llcp_t *Llcp )
 {
    uint32_t nDuration = 0;
@@ -866,8 +884,8 @@ static bool_t phFriNfc_Llcp_HandlePendingSend ( phFriNfc_Llcp_t *Llcp )
    phFriNfc_Llcp_sPacketSequence_t  *psSendSequence = NULL;
    phNfc_sData_t                    *psSendInfo = NULL;
    NFCSTATUS                        result;
-   uint8_t                          bDeallocate = FALSE;
    uint8_t                          return_value = FALSE;
+   uint32_t                         nSymmDelay;
    /* Handle pending disconnection request */
    if (Llcp->bDiscPendingFlag == TRUE)
    {
@@ -903,13 +921,22 @@ static bool_t phFriNfc_Llcp_HandlePendingSend ( phFriNfc_Llcp_t *Llcp )
       Llcp->psSendHeader = NULL;
       Llcp->psSendSequence = NULL;
       Llcp->psSendInfo = NULL;
-      bDeallocate = TRUE;
    }
 
    /* Perform send, if needed */
    if (psSendHeader != NULL)
    {
-      result = phFriNfc_Llcp_InternalSend(Llcp, psSendHeader, psSendSequence, psSendInfo);
+#ifdef NXP_LLCP_AGF_SEND
+      if (psSendHeader->ptype != PHFRINFC_LLCP_PTYPE_DISC)
+      {
+         /* Send the other PDUs ready along in the same turn */
+         result = phFriNfc_Llcp_SendAggregated(Llcp, psSendHeader, psSendSequence, psSendInfo);
+      }
+      else
+#endif /* #ifdef NXP_LLCP_AGF_SEND */
+      {
+         result = phFriNfc_Llcp_InternalSend(Llcp, psSendHeader, psSendSequence, psSendInfo);
+      }
       if ((result != NFCSTATUS_SUCCESS) && (result != NFCSTATUS_PENDING))
       {
          /* Error: send failed, impossible to recover */
@@ -919,16 +946,24 @@ static bool_t phFriNfc_Llcp_HandlePendingSend ( phFriNfc_Llcp_t *Llcp )
    } else if (Llcp->pfSendCB == NULL) {
       // Nothing to send, send SYMM instead to allow peer to send something
       // if it wants.
-      phFriNfc_Llcp_SendSymm(Llcp);
+      nSymmDelay = phFriNfc_Llcp_GetSymmDelay(Llcp);
+      if (nSymmDelay == 0)
+      {
+         phFriNfc_Llcp_SendSymm(Llcp);
+      }
+      else
+      {
+         /* Idle link, let the timer send SYMM unless data comes before */
+         phOsalNfc_Timer_Stop(Llcp->hSymmTimer);
+         phOsalNfc_Timer_Start(Llcp->hSymmTimer,
+                               nSymmDelay,
+                               phFriNfc_Llcp_Timer_CB,
+                               Llcp);
+         Llcp->sSymmStats.nDelayedSymm++;
+      }
       return_value = TRUE;
    }
 
-clean_and_return:
-   if (bDeallocate)
-   {
-       phFriNfc_Llcp_Deallocate(psSendInfo);
-   }
-
    return return_value;
 }
 
@@ -1023,6 +1058,21 @@ static void phFriNfc_Llcp_Receive_CB( void               *pContext,
       case PHFRINFC_LLCP_STATE_OPERATION_RECV:
       case PHFRINFC_LLCP_STATE_OPERATION_SEND:
       {
+         /* Track the idle exchanges */
+         if (sPacketHeader.ptype == PHFRINFC_LLCP_PTYPE_SYMM)
+         {
+            Llcp->sSymmStats.nSymmReceived++;
+            if (Llcp->nSymmIdleCount < 0xFF)
+            {
+               Llcp->nSymmIdleCount++;
+            }
+         }
+         else
+         {
+            Llcp->sSymmStats.nDataReceived++;
+            Llcp->nSymmIdleCount = 0;
+         }
+
          /* Handle Symmetry procedure by resetting LTO timer */
          phFriNfc_Llcp_ResetLTO(Llcp);
          /* Handle packet */
@@ -1043,7 +1093,8 @@ static void phFriNfc_Llcp_Receive_CB( void               *pContext,
       }
    }
 
-   /* Restart reception */
+   /* Restart reception, the transport has moved the buffer past the headers */
+   Llcp->sRxBuffer.buffer = Llcp->pRxBuffer;
    Llcp->sRxBuffer.length = Llcp->nRxBufferLength;
    phFriNfc_LlcpMac_Receive(&Llcp->MAC, &Llcp->sRxBuffer, phFriNfc_Llcp_Receive_CB, Llcp);
 }
@@ -1057,6 +1108,15 @@ static void phFriNfc_Llcp_Send_CB( void               *pContext,
    phFriNfc_Llcp_Send_CB_t          pfSendCB;
    void                             *pSendContext;
 
+#ifdef NXP_LLCP_AGF_SEND
+   if (Llcp->bTurnDeferred == TRUE)
+   {
+      /* Complete the PDUs aggregated in the frame */
+      Llcp->bTurnDeferred = FALSE;
+      (Llcp->pfSendTurnCB)(Llcp->pSendTurnContext, status);
+   }
+#endif /* #ifdef NXP_LLCP_AGF_SEND */
+
    /* Call the upper layer callback if last packet sent was  */
    /* NOTE: if Llcp->psSendHeader is not NULL, this means that the send operation is still not initiated */
    if (Llcp->psSendHeader == NULL)
@@ -1083,19 +1143,12 @@ static void phFriNfc_Llcp_Send_CB( void               *pContext,
 }
 
 
-static NFCSTATUS phFriNfc_Llcp_InternalSend( phFriNfc_Llcp_t                    *Llcp,
-                                             phFriNfc_Llcp_sPacketHeader_t      *psHeader,
-                                             phFriNfc_Llcp_sPacketSequence_t    *psSequence,
-                                             phNfc_sData_t                      *psInfo )
+static void phFriNfc_Llcp_EncodePacket( phFriNfc_Llcp_sPacketHeader_t      *psHeader,
+                                        phFriNfc_Llcp_sPacketSequence_t    *psSequence,
+                                        phNfc_sData_t                      *psInfo,
+                                        phNfc_sData_t                      *psRawPacket )
 {
-   NFCSTATUS status;
-   phNfc_sData_t  *psRawPacket = &Llcp->sTxBuffer; /* Use internal Tx buffer */
-
-   /* Handle Symmetry procedure */
-   phFriNfc_Llcp_ResetLTO(Llcp);
-
-   /* Generate raw packet to send (aggregate header + sequence + info fields) */
-   psRawPacket->length = 0;
+   /* Append header + sequence + info fields to the raw packet */
    psRawPacket->length += phFriNfc_Llcp_Header2Buffer(psHeader, psRawPacket->buffer, psRawPacket->length);
    if (psSequence != NULL)
    {
@@ -1106,26 +1159,207 @@ static NFCSTATUS phFriNfc_Llcp_InternalSend( phFriNfc_Llcp_t
       memcpy(psRawPacket->buffer + psRawPacket->length, psInfo->buffer, psInfo->length);
       psRawPacket->length += psInfo->length;
    }
+}
+
 
-   if (psHeader->ptype != PHFRINFC_LLCP_PTYPE_SYMM)
+static NFCSTATUS phFriNfc_Llcp_SendRawPacket( phFriNfc_Llcp_t *Llcp,
+                                              uint8_t         nPdus )
+{
+   phNfc_sData_t  *psRawPacket = &Llcp->sTxBuffer; /* Use internal Tx buffer */
+
+   if (nPdus > 0)
    {
       LLCP_PRINT_BUFFER("\nSending LLCP packet :", psRawPacket->buffer, psRawPacket->length);
+
+      /* Data is flowing */
+      Llcp->nSymmIdleCount = 0;
+      Llcp->sSymmStats.nDataSent++;
+
+      /* Update the statistics of the send turns */
+      Llcp->sSendStats.nSendTurns++;
+      Llcp->sSendStats.nSentPdus += nPdus;
+      Llcp->sSendStats.nSentBytes += psRawPacket->length;
+      if (nPdus > Llcp->sSendStats.nMaxPdusPerTurn)
+      {
+         Llcp->sSendStats.nMaxPdusPerTurn = nPdus;
+      }
    }
    else
    {
       LLCP_PRINT("!");
+      Llcp->sSymmStats.nSymmSent++;
    }
 
    /* Send raw packet */
-   status = phFriNfc_LlcpMac_Send (
+   return phFriNfc_LlcpMac_Send (
                &Llcp->MAC,
                psRawPacket,
                phFriNfc_Llcp_Send_CB,
                Llcp );
+}
 
-   return status;
+
+static NFCSTATUS phFriNfc_Llcp_InternalSend( phFriNfc_Llcp_t                    *Llcp,
+                                             phFriNfc_Llcp_sPacketHeader_t      *psHeader,
+                                             phFriNfc_Llcp_sPacketSequence_t    *psSequence,
+                                             phNfc_sData_t                      *psInfo )
+{
+   /* Handle Symmetry procedure */
+   phFriNfc_Llcp_ResetLTO(Llcp);
+
+   /* Generate raw packet to send in the internal Tx buffer */
+   Llcp->sTxBuffer.length = 0;
+   phFriNfc_Llcp_EncodePacket(psHeader, psSequence, psInfo, &Llcp->sTxBuffer);
+
+   return phFriNfc_Llcp_SendRawPacket(Llcp,
+             (psHeader->ptype != PHFRINFC_LLCP_PTYPE_SYMM)?1:0);
+}
+
+
+#ifdef NXP_LLCP_AGF_SEND
+
+static bool_t phFriNfc_Llcp_AggregatePacket( phFriNfc_Llcp_t                    *Llcp,
+                                             phFriNfc_Llcp_sPacketHeader_t      *psHeader,
+                                             phFriNfc_Llcp_sPacketSequence_t    *psSequence,
+                                             phNfc_sData_t                      *psInfo )
+{
+   phNfc_sData_t  *psRawPacket = &Llcp->sTxBuffer;
+   uint16_t       nLength;
+   uint16_t       nOffset;
+
+   /* Compute the PDU length */
+   nLength = PHFRINFC_LLCP_PACKET_HEADER_SIZE;
+   if (psSequence != NULL)
+   {
+      nLength += PHFRINFC_LLCP_PACKET_SEQUENCE_SIZE;
+   }
+   if (psInfo != NULL)
+   {
+      nLength += psInfo->length;
+   }
+
+   /* The AGF information field shall not exceed the remote MIU, the first */
+   /* PDU always fits as it is sent alone if nothing else is aggregated   */
+   if ((Llcp->nAggregatedPdus > 0) &&
+       ((((psRawPacket->length - PHFRINFC_LLCP_PACKET_HEADER_SIZE) +
+          PHFRINFC_LLCP_AGF_LENGTH_SIZE + nLength) > Llcp->sRemoteParams.miu) ||
+        (Llcp->nAggregatedPdus >= NXP_LLCP_AGF_MAX_PDUS)))
+   {
+      return FALSE;
+   }
+
+   /* Append the length field followed by the PDU */
+   nOffset = psRawPacket->length;
+   psRawPacket->buffer[nOffset]     = (uint8_t)(nLength >> 8);
+   psRawPacket->buffer[nOffset + 1] = (uint8_t)(nLength & 0xFF);
+   psRawPacket->length += PHFRINFC_LLCP_AGF_LENGTH_SIZE;
+   phFriNfc_Llcp_EncodePacket(psHeader, psSequence, psInfo, psRawPacket);
+   Llcp->nAggregatedPdus++;
+
+   return TRUE;
 }
 
+
+static NFCSTATUS phFriNfc_Llcp_SendAggregated( phFriNfc_Llcp_t                    *Llcp,
+                                               phFriNfc_Llcp_sPacketHeader_t      *psHeader,
+                                               phFriNfc_Llcp_sPacketSequence_t    *psSequence,
+                                               phNfc_sData_t                      *psInfo )
+{
+   phNfc_sData_t                 *psRawPacket = &Llcp->sTxBuffer;
+   phFriNfc_Llcp_sPacketHeader_t sHeader;
+   phFriNfc_Llcp_Send_CB_t       pfSendCB;
+   void                          *pSendContext;
+   uint16_t                      nOffset;
+   uint16_t                      nLength;
+
+   /* A PDU leaving no room for a second one in the remote MIU is sent   */
+   /* alone, the Tx buffer cannot hold a PDU of the remote MIU after the */
+   /* AGF header and length field                                         */
+   nLength = PHFRINFC_LLCP_PACKET_HEADER_SIZE;
+   if (psSequence != NULL)
+   {
+      nLength += PHFRINFC_LLCP_PACKET_SEQUENCE_SIZE;
+   }
+   if (psInfo != NULL)
+   {
+      nLength += psInfo->length;
+   }
+   if ((PHFRINFC_LLCP_AGF_LENGTH_SIZE + nLength + PHFRINFC_LLCP_AGF_LENGTH_SIZE +
+        PHFRINFC_LLCP_PACKET_HEADER_SIZE) > Llcp->sRemoteParams.miu)
+   {
+      return phFriNfc_Llcp_InternalSend(Llcp, psHeader, psSequence, psInfo);
+   }
+
+   /* Start aggregation after the room left for the AGF header */
+   psRawPacket->length = PHFRINFC_LLCP_PACKET_HEADER_SIZE;
+   Llcp->nAggregatedPdus = 0;
+   Llcp->bAggregating = TRUE;
+   phFriNfc_Llcp_AggregatePacket(Llcp, psHeader, psSequence, psInfo);
+
+   /* Pull the PDUs made ready by the upper layer */
+   while (Llcp->state == PHFRINFC_LLCP_STATE_OPERATION_SEND)
+   {
+      /* Aggregate the service frame saved during the previous turn, if any */
+      if (Llcp->psSendHeader != NULL)
+      {
+         if (!phFriNfc_Llcp_AggregatePacket(Llcp, Llcp->psSendHeader,
+                                            Llcp->psSendSequence, Llcp->psSendInfo))
+         {
+            /* No more room, keep it for the next turn */
+            break;
+         }
+         Llcp->psSendHeader = NULL;
+         Llcp->psSendSequence = NULL;
+         Llcp->psSendInfo = NULL;
+      }
+      if ((Llcp->pfSendCB == NULL) || (Llcp->pfSendTurnCB == NULL))
+      {
+         /* Nothing more is ready, or the upper layer cannot defer the */
+         /* completion of its PDUs until the frame is sent            */
+         break;
+      }
+      /* Release the aggregated service frame, the upper layer may   */
+      /* provide its next PDU from the callback and completes it     */
+      /* from the send turn callback, once the frame is sent         */
+      pfSendCB = Llcp->pfSendCB;
+      pSendContext = Llcp->pSendContext;
+      Llcp->pfSendCB = NULL;
+      Llcp->pSendContext = NULL;
+      Llcp->bTurnDeferred = TRUE;
+      (pfSendCB)(pSendContext, NFCSTATUS_SUCCESS);
+   }
+   Llcp->bAggregating = FALSE;
+
+   if (Llcp->state != PHFRINFC_LLCP_STATE_OPERATION_SEND)
+   {
+      /* Link deactivated by the upper layer meanwhile */
+      return NFCSTATUS_FAILED;
+   }
+
+   if (Llcp->nAggregatedPdus == 1)
+   {
+      /* Send the PDU alone, without the AGF encapsulation */
+      nOffset = PHFRINFC_LLCP_PACKET_HEADER_SIZE + PHFRINFC_LLCP_AGF_LENGTH_SIZE;
+      psRawPacket->length -= nOffset;
+      memmove(psRawPacket->buffer, psRawPacket->buffer + nOffset, psRawPacket->length);
+   }
+   else
+   {
+      sHeader.dsap  = PHFRINFC_LLCP_SAP_LINK;
+      sHeader.ssap  = PHFRINFC_LLCP_SAP_LINK;
+      sHeader.ptype = PHFRINFC_LLCP_PTYPE_AGF;
+      phFriNfc_Llcp_Header2Buffer(&sHeader, psRawPacket->buffer, 0);
+      Llcp->sSendStats.nAggregatedFrames++;
+   }
+
+   /* Handle Symmetry procedure */
+   phFriNfc_Llcp_ResetLTO(Llcp);
+
+   return phFriNfc_Llcp_SendRawPacket(Llcp, Llcp->nAggregatedPdus);
+}
+
+#endif /* #ifdef NXP_LLCP_AGF_SEND */
+
 /* ---------------------------- Public functions ------------------------------- */
 
 NFCSTATUS phFriNfc_Llcp_EncodeLinkParams( phNfc_sData_t                   *psRawBuffer,
@@ -1281,6 +1515,7 @@ NFCSTATUS phFriNfc_Llcp_Reset( phFriNfc_Llcp_t                 *Llcp,
    Llcp->sRxBuffer.buffer = pRxBuffer;
    Llcp->sRxBuffer.length = nRxBufferLength;
    Llcp->nRxBufferLength = nRxBufferLength;
+   Llcp->pRxBuffer = (uint8_t*)pRxBuffer;
    Llcp->sTxBuffer.buffer = pTxBuffer;
    Llcp->sTxBuffer.length = nTxBufferLength;
    Llcp->nTxBufferLength = nTxBufferLength;
@@ -1432,6 +1667,21 @@ NFCSTATUS phFriNfc_Llcp_Send( phFriNfc_Llcp_t                  *Llcp,
    Llcp->pfSendCB = pfSend_CB;
    Llcp->pSendContext = pContext;
 
+#ifdef NXP_LLCP_AGF_SEND
+   if (Llcp->bAggregating == TRUE)
+   {
+      /* Send turn in progress, aggregate the PDU if there is room left */
+      if (!phFriNfc_Llcp_AggregatePacket(Llcp, psHeader, psSequence, psInfo))
+      {
+         /* Save send params for the next turn */
+         Llcp->psSendHeader = psHeader;
+         Llcp->psSendSequence = psSequence;
+         Llcp->psSendInfo = phFriNfc_Llcp_BorrowSendInfo(Llcp, psInfo);
+      }
+      result = NFCSTATUS_PENDING;
+   }
+   else
+#endif /* #ifdef NXP_LLCP_AGF_SEND */
    if (Llcp->state == PHFRINFC_LLCP_STATE_OPERATION_SEND)
    {
       /* Ready to send */
@@ -1442,7 +1692,7 @@ NFCSTATUS phFriNfc_Llcp_Send( phFriNfc_Llcp_t                  *Llcp,
       /* Not ready to send, save send params for later use */
       Llcp->psSendHeader = psHeader;
       Llcp->psSendSequence = psSequence;
-      Llcp->psSendInfo = phFriNfc_Llcp_AllocateAndCopy(psInfo);
+      Llcp->psSendInfo = phFriNfc_Llcp_BorrowSendInfo(Llcp, psInfo);
       result = NFCSTATUS_PENDING;
    }
    else
@@ -1485,3 +1735,63 @@ NFCSTATUS phFriNfc_Llcp_Recv( phFriNfc_Llcp_t            *Llcp,
 
    return result;
 }
+
+
+#ifdef NXP_LLCP_AGF_SEND
+NFCSTATUS phFriNfc_Llcp_SetSendTurnCb( phFriNfc_Llcp_t               *Llcp,
+                                       phFriNfc_Llcp_SendTurn_CB_t   pfSendTurn_CB,
+                                       void                          *pContext )
+{
+   /* Check parameters */
+   if (Llcp == NULL)
+   {
+      return PHNFCSTVAL(CID_FRI_NFC_LLCP, NFCSTATUS_INVALID_PARAMETER);
+   }
+
+   Llcp->pfSendTurnCB = pfSendTurn_CB;
+   Llcp->pSendTurnContext = pContext;
+
+   return NFCSTATUS_SUCCESS;
+}
+
+
+bool_t phFriNfc_Llcp_IsAggregating( phFriNfc_Llcp_t *Llcp )
+{
+   return ((Llcp != NULL) && (Llcp->bAggregating == TRUE))?TRUE:FALSE;
+}
+#endif /* #ifdef NXP_LLCP_AGF_SEND */
+
+
+NFCSTATUS phFriNfc_Llcp_GetSendStats( phFriNfc_Llcp_t              *Llcp,
+                                      phFriNfc_Llcp_sSendStats_t   *psStats )
+{
+   /* Check parameters */
+   if ((Llcp == NULL) || (psStats == NULL))
+   {
+      return PHNFCSTVAL(CID_FRI_NFC_LLCP, NFCSTATUS_INVALID_PARAMETER);
+   }
+
+   memcpy(psStats, &Llcp->sSendStats, sizeof(phFriNfc_Llcp_sSendStats_t));
+   if ((Llcp->state == PHFRINFC_LLCP_STATE_OPERATION_RECV) ||
+       (Llcp->state == PHFRINFC_LLCP_STATE_OPERATION_SEND))
+   {
+      psStats->nElapsedTime = phOsalNfc_GetTime() - Llcp->nActivationTime;
+   }
+
+   return NFCSTATUS_SUCCESS;
+}
+
+
+NFCSTATUS phFriNfc_Llcp_GetSymmStats( phFriNfc_Llcp_t              *Llcp,
+                                      phFriNfc_Llcp_sSymmStats_t   *psStats )
+{
+   /* Check parameters */
+   if ((Llcp == NULL) || (psStats == NULL))
+   {
+      return PHNFCSTVAL(CID_FRI_NFC_LLCP, NFCSTATUS_INVALID_PARAMETER);
+   }
+
+   memcpy(psStats, &Llcp->sSymmStats, sizeof(phFriNfc_Llcp_sSymmStats_t));
+
+   return NFCSTATUS_SUCCESS;
+}
@@ -123,6 +123,10 @@ extern char phOsalNfc_DbgTraceBuffer[];
 #define PHFRINFC_LLCP_SAP_NUMBER                   0x40 /**< Number of possible SAP values (also first invalid value).*/
 #define PHFRINFC_LLCP_SAP_DEFAULT                  0xFF /**< Default number when a socket is created or reset */
 #define PHFRINFC_LLCP_SDP_ADVERTISED_NB            0x10 /**< Number of SDP advertised SAP slots */
+#define PHFRINFC_LLCP_SN_HASH_SIZE                 0x10 /**< Number of buckets of the service name registry (power of 2) */
+#define PHFRINFC_LLCP_REMOTE_SAP_CACHE_SIZE        0x08 /**< Number of remote SAPs remembered by the SDP client */
+#define PHFRINFC_LLCP_REMOTE_SAP_SN_MAX            0x40 /**< Longest service name remembered by the SDP client */
+#define PHFRINFC_LLCP_REMOTE_SAP_TTL               60000 /**< Default lifetime of a remembered remote SAP (ms) */
 /*@}*/
 
 /**
@@ -193,6 +197,7 @@ extern char phOsalNfc_DbgTraceBuffer[];
  /*@{*/
 #define PHFRINFC_LLCP_PACKET_HEADER_SIZE     2 /**< Size of the general packet header (DSAP+PTYPE+SSAP).*/
 #define PHFRINFC_LLCP_PACKET_SEQUENCE_SIZE   1 /**< Size of the sequence field, if present.*/
+#define PHFRINFC_LLCP_AGF_LENGTH_SIZE        2 /**< Size of the length field preceding each PDU of an AGF.*/
 #define PHFRINFC_LLCP_PACKET_MAX_SIZE        (PHFRINFC_LLCP_PACKET_HEADER_SIZE + \
                                              PHFRINFC_LLCP_PACKET_SEQUENCE_SIZE + \
                                              PHFRINFC_LLCP_MIU_DEFAULT + \
@@ -201,7 +206,7 @@ extern char phOsalNfc_DbgTraceBuffer[];
 
 /*========== MACROS ===========*/
 
-#define CHECK_SEND_RW(socket) ( (((socket)->socket_VS - (socket)->socket_VSA)  % 16) < (socket)->remoteRW )
+#define CHECK_SEND_RW(socket) ( ((16 + (socket)->socket_VS - (socket)->socket_VSA) % 16) < (socket)->remoteRW )
 
 /*========== ENUMERATES ===========*/
 
@@ -232,6 +237,11 @@ typedef void (*phFriNfc_Llcp_Send_CB_t) (
    NFCSTATUS                        status
 );
 
+typedef void (*phFriNfc_Llcp_SendTurn_CB_t) (
+   void                             *pContext,
+   NFCSTATUS                        status
+);
+
 typedef void (*phFriNfc_Llcp_Recv_CB_t) (
    void                             *pContext,
    phNfc_sData_t                    *psData,
@@ -298,6 +308,50 @@ typedef struct phFriNfc_Llcp_sRecvOperation
 
 } phFriNfc_Llcp_sRecvOperation_t;
 
+typedef struct phFriNfc_Llcp_sSendStats
+{
+   /**< Number of send turns carrying at least one PDU*/
+   uint32_t                         nSendTurns;
+
+   /**< Number of PDUs sent*/
+   uint32_t                         nSentPdus;
+
+   /**< Number of AGF frames sent*/
+   uint32_t                         nAggregatedFrames;
+
+   /**< Highest number of PDUs sent in a single send turn*/
+   uint32_t                         nMaxPdusPerTurn;
+
+   /**< Number of bytes sent, LLC headers included*/
+   uint32_t                         nSentBytes;
+
+   /**< Time elapsed since the link activation, in milliseconds*/
+   uint32_t                         nElapsedTime;
+
+   /**< Number of PDUs deferred to a later send turn, without allocation*/
+   uint32_t                         nDeferredPdus;
+
+} phFriNfc_Llcp_sSendStats_t;
+
+typedef struct phFriNfc_Llcp_sSymmStats
+{
+   /**< Number of SYMM PDUs sent*/
+   uint32_t                         nSymmSent;
+
+   /**< Number of SYMM PDUs received*/
+   uint32_t                         nSymmReceived;
+
+   /**< Number of frames sent carrying other PDUs*/
+   uint32_t                         nDataSent;
+
+   /**< Number of frames received carrying other PDUs*/
+   uint32_t                         nDataReceived;
+
+   /**< Number of SYMM answers delayed on an idle link*/
+   uint32_t                         nDelayedSymm;
+
+} phFriNfc_Llcp_sSymmStats_t;
+
 typedef struct phFriNfc_Llcp
 {
    /**< The current state*/
@@ -324,6 +378,9 @@ typedef struct phFriNfc_Llcp
    /**< Actual size of reception buffer*/
    uint16_t                        nRxBufferLength;
 
+   /**< Start of the reception buffer, the upper layers move sRxBuffer.buffer past the headers*/
+   uint8_t                         *pRxBuffer;
+
    /**< Internal emission buffer, its size may vary during time but not exceed nTxBufferSize*/
    phNfc_sData_t                   sTxBuffer;
 
@@ -378,12 +435,44 @@ typedef struct phFriNfc_Llcp
    /**< Pending send info*/
    phNfc_sData_t                    *psSendInfo;
 
+   /**< Descriptor of the pending send info, borrowing the caller buffer*/
+   phNfc_sData_t                    sSendInfo;
+
    /**< Receive callback*/
    phFriNfc_Llcp_Recv_CB_t          pfRecvCB;
 
    /**< Receive callback*/
    void                             *pRecvContext;
 
+#ifdef NXP_LLCP_AGF_SEND
+   /**< PDUs ready are aggregated in the emission buffer*/
+   bool_t                           bAggregating;
+
+   /**< Number of PDUs aggregated in the emission buffer*/
+   uint8_t                          nAggregatedPdus;
+
+   /**< Send callbacks called during the aggregation, completed by the send turn callback*/
+   bool_t                           bTurnDeferred;
+
+   /**< Send turn callback*/
+   phFriNfc_Llcp_SendTurn_CB_t      pfSendTurnCB;
+
+   /**< Send turn callback context*/
+   void                             *pSendTurnContext;
+#endif /* #ifdef NXP_LLCP_AGF_SEND */
+
+   /**< Link activation time, in milliseconds*/
+   uint32_t                         nActivationTime;
+
+   /**< Statistics of the send turns*/
+   phFriNfc_Llcp_sSendStats_t       sSendStats;
+
+   /**< Number of SYMM PDUs received since the last data PDU exchanged*/
+   uint8_t                          nSymmIdleCount;
+
+   /**< Statistics of the symmetry procedure*/
+   phFriNfc_Llcp_sSymmStats_t       sSymmStats;
+
 } phFriNfc_Llcp_t;
 
 /*========== UNIONS ===========*/
@@ -459,5 +548,41 @@ NFCSTATUS phFriNfc_Llcp_Recv( phFriNfc_Llcp_t            *Llcp,
                               phFriNfc_Llcp_Recv_CB_t    pfRecv_CB,
                               void                       *pContext );
 
+#ifdef NXP_LLCP_AGF_SEND
+/*!
+ * \brief Set the callback called once the MAC has sent the frame of a send
+ *        turn aggregating PDUs.
+ *
+ * While PDUs are aggregated, the send callback of each PDU is called as soon
+ * as it is copied in the frame, so that the next PDU can be given. The caller
+ * checks phFriNfc_Llcp_IsAggregating from its send callback and completes the
+ * PDU when this callback is called, with the status of the MAC send. Without
+ * this callback, the PDUs are not aggregated.
+ */
+NFCSTATUS phFriNfc_Llcp_SetSendTurnCb( phFriNfc_Llcp_t               *Llcp,
+                                       phFriNfc_Llcp_SendTurn_CB_t   pfSendTurn_CB,
+                                       void                          *pContext );
+
+/*!
+ * \brief Tell if the PDUs of a send turn are being aggregated.
+ */
+bool_t phFriNfc_Llcp_IsAggregating( phFriNfc_Llcp_t *Llcp );
+#endif /* #ifdef NXP_LLCP_AGF_SEND */
+
+/*!
+ * \brief Get the statistics of the send turns since the link activation.
+ *
+ * The PDUs per turn are given by nSentPdus / nSendTurns, and the throughput
+ * by nSentBytes / nElapsedTime.
+ */
+NFCSTATUS phFriNfc_Llcp_GetSendStats( phFriNfc_Llcp_t              *Llcp,
+                                      phFriNfc_Llcp_sSendStats_t   *psStats );
+
+/*!
+ * \brief Get the statistics of the symmetry procedure since the link activation.
+ */
+NFCSTATUS phFriNfc_Llcp_GetSymmStats( phFriNfc_Llcp_t              *Llcp,
+                                      phFriNfc_Llcp_sSymmStats_t   *psStats );
+
 
 #endif /* PHFRINFC_LLCP_H */
@@ -26,6 +26,7 @@
 /*include files*/
 #include <phFriNfc_LlcpMac.h>
 #include <phFriNfc_LlcpMacNfcip.h>
+#include <phFriNfc_LlcpMacLoopback.h>
 #include <phLibNfcStatus.h>
 #include <phLibNfc.h>
 #include <phLibNfc_Internal.h>
@@ -90,6 +91,12 @@ NFCSTATUS phFriNfc_LlcpMac_ChkLlcp (phFriNfc_LlcpMac_t                  *LlcpMac
       {
       case phHal_eNfcIP1_Initiator:
       case phHal_eNfcIP1_Target:
+         if(LlcpMac->MacType == phFriNfc_LlcpMac_eTypeLoopback)
+         {
+            /* Loopback mapping registered by the caller, keep it */
+            status  = LlcpMac->LlcpMacInterface.chk(LlcpMac,ChkLlcpMac_Cb,pContext);
+         }
+         else
          {
             /* Set the MAC mapping type detected */
             LlcpMac->MacType = phFriNfc_LlcpMac_eTypeNfcip;
@@ -89,7 +89,8 @@ typedef struct phFriNfc_LlcpMac phFriNfc_LlcpMac_t;
 typedef enum phFriNfc_LlcpMac_eType
 {
    phFriNfc_LlcpMac_eTypeNfcip,
-   phFriNfc_LlcpMac_eTypeIso14443   
+   phFriNfc_LlcpMac_eTypeIso14443,
+   phFriNfc_LlcpMac_eTypeLoopback
 }phFriNfc_LlcpMac_eType_t;
 
 /* Enum reperesents the different Peer type for a LLCP communication*/
@@ -0,0 +1,464 @@
+/*
+ * Copyright (C) 2010 NXP Semiconductors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/**
+ * \file  phFriNfc_LlcpMacLoopback.c
+ * \brief NFC LLCP MAC Mapping for an in-process loopback link.
+ *
+ * Project: NFC-FRI
+ *
+ */
+
+
+/*include files*/
+#include <phFriNfc_LlcpMac.h>
+#include <phFriNfc_LlcpMacLoopback.h>
+#include <phLibNfcStatus.h>
+#include <phLibNfc.h>
+#include <phLibNfc_Internal.h>
+#include <phOsalNfc_Timer.h>
+#include <string.h>
+
+/* Loss rate scale, the configured rate is given per thousand frames */
+#define PHFRINFC_LLCP_LOOPBACK_LOSS_SCALE   1000
+
+static void phFriNfc_LlcpMac_Loopback_Timer_CB(uint32_t TimerId, void *pContext);
+
+static void phFriNfc_LlcpMac_Loopback_TriggerRecvCb(phFriNfc_LlcpMac_t  *LlcpMac,
+                                                    NFCSTATUS           status)
+{
+   phFriNfc_LlcpMac_Reveive_CB_t pfReceiveCB;
+   void                          *pReceiveContext;
+
+   if (LlcpMac->MacReceive_Cb != NULL)
+   {
+      /* Save callback params */
+      pfReceiveCB = LlcpMac->MacReceive_Cb;
+      pReceiveContext = LlcpMac->MacReceive_Context;
+
+      /* Reset the pointer to the Receive Callback and Context*/
+      LlcpMac->MacReceive_Cb = NULL;
+      LlcpMac->MacReceive_Context = NULL;
+
+      /* Call the receive callback */
+      pfReceiveCB(pReceiveContext, status, LlcpMac->psReceiveBuffer);
+   }
+}
+
+static void phFriNfc_LlcpMac_Loopback_TriggerSendCb(phFriNfc_LlcpMac_t  *LlcpMac,
+                                                    NFCSTATUS           status)
+{
+   phFriNfc_LlcpMac_Send_CB_t pfSendCB;
+   void                       *pSendContext;
+
+   if (LlcpMac->MacSend_Cb != NULL)
+   {
+      /* Save context in local variables */
+      pfSendCB     = LlcpMac->MacSend_Cb;
+      pSendContext = LlcpMac->MacSend_Context;
+
+      /* Reset the pointer to the Send Callback */
+      LlcpMac->MacSend_Cb = NULL;
+      LlcpMac->MacSend_Context = NULL;
+
+      /* Call Send callback */
+      pfSendCB(pSendContext, status);
+   }
+}
+
+static uint32_t phFriNfc_LlcpMac_Loopback_GetDelay(phFriNfc_LlcpMac_sLoopback_t  *psLoopback,
+                                                   uint32_t                      nLength)
+{
+   uint32_t nDelay = psLoopback->sConfig.nLatency;
+
+   /* Add the time needed to clock the frame out at the link bitrate */
+   if (psLoopback->sConfig.nBitrate != 0)
+   {
+      nDelay += ((nLength * 8 * 1000) + psLoopback->sConfig.nBitrate - 1) / psLoopback->sConfig.nBitrate;
+   }
+
+   /* Always go through the timer, so that a frame is never delivered
+      from within the send call of the other side */
+   if (nDelay == 0)
+   {
+      nDelay = 1;
+   }
+
+   return nDelay;
+}
+
+static uint8_t phFriNfc_LlcpMac_Loopback_IsLost(phFriNfc_LlcpMac_sLoopback_t  *psLoopback)
+{
+   if (psLoopback->sConfig.nLossRate == 0)
+   {
+      return FALSE;
+   }
+
+   /* Linear congruential generator, the high bits are the most random ones */
+   psLoopback->nRandom = (psLoopback->nRandom * 1103515245) + 12345;
+
+   return (((psLoopback->nRandom >> 16) % PHFRINFC_LLCP_LOOPBACK_LOSS_SCALE) < psLoopback->sConfig.nLossRate);
+}
+
+static void phFriNfc_LlcpMac_Loopback_Deliver(phFriNfc_LlcpMac_sLoopback_t  *psLoopback)
+{
+   phFriNfc_LlcpMac_t   *LlcpMac     = psLoopback->psMac;
+   phFriNfc_LlcpMac_t   *PeerLlcpMac = psLoopback->psPeer->psMac;
+   phNfc_sData_t        *psFrame     = psLoopback->psInFlight;
+   NFCSTATUS            status       = NFCSTATUS_SUCCESS;
+
+   /* Wait until the frame has crossed the link and the peer listens */
+   if ((psFrame == NULL) || !psLoopback->bArrived ||
+       (PeerLlcpMac == NULL) || (PeerLlcpMac->MacReceive_Cb == NULL))
+   {
+      return;
+   }
+
+   if (psFrame->length > PeerLlcpMac->psReceiveBuffer->length)
+   {
+      status = PHNFCSTVAL(CID_FRI_NFC_LLCP_MAC, NFCSTATUS_BUFFER_TOO_SMALL);
+   }
+   else
+   {
+      memcpy(PeerLlcpMac->psReceiveBuffer->buffer, psFrame->buffer, psFrame->length);
+      PeerLlcpMac->psReceiveBuffer->length = psFrame->length;
+
+      psLoopback->sStats.nFramesDelivered++;
+      psLoopback->sStats.nBytesDelivered += psFrame->length;
+   }
+
+   /* The frame has been copied, the sender buffer can be reused */
+   psLoopback->psInFlight = NULL;
+   psLoopback->bArrived = FALSE;
+
+   phFriNfc_LlcpMac_Loopback_TriggerSendCb(LlcpMac, NFCSTATUS_SUCCESS);
+   phFriNfc_LlcpMac_Loopback_TriggerRecvCb(PeerLlcpMac, status);
+}
+
+static void phFriNfc_LlcpMac_Loopback_Timer_CB(uint32_t TimerId, void *pContext)
+{
+   phFriNfc_LlcpMac_sLoopback_t  *psLoopback = (phFriNfc_LlcpMac_sLoopback_t*)pContext;
+
+   PHNFC_UNUSED_VARIABLE(TimerId);
+
+   phOsalNfc_Timer_Stop(psLoopback->hDelayTimer);
+
+   if (psLoopback->psInFlight == NULL)
+   {
+      /* Link deactivated meanwhile */
+      return;
+   }
+
+   if (!psLoopback->bArrived)
+   {
+      if (phFriNfc_LlcpMac_Loopback_IsLost(psLoopback))
+      {
+         /* The sender cannot tell, the peer will notice through its LTO */
+         psLoopback->sStats.nFramesLost++;
+         psLoopback->psInFlight = NULL;
+         phFriNfc_LlcpMac_Loopback_TriggerSendCb(psLoopback->psMac, NFCSTATUS_SUCCESS);
+         return;
+      }
+      psLoopback->bArrived = TRUE;
+   }
+
+   phFriNfc_LlcpMac_Loopback_Deliver(psLoopback);
+}
+
+static NFCSTATUS phFriNfc_LlcpMac_Loopback_Chk(phFriNfc_LlcpMac_t                   *LlcpMac,
+                                               phFriNfc_LlcpMac_Chk_CB_t            ChkLlcpMac_Cb,
+                                               void                                 *pContext)
+{
+   NFCSTATUS                     status = NFCSTATUS_SUCCESS;
+   phFriNfc_LlcpMac_sLoopback_t  *psLoopback;
+   uint8_t Llcp_Magic_Number[] = {0x46,0x66,0x6D};
+
+   if(NULL == LlcpMac || NULL == ChkLlcpMac_Cb || NULL == pContext)
+   {
+      status = PHNFCSTVAL(CID_FRI_NFC_LLCP_MAC, NFCSTATUS_INVALID_PARAMETER);
+   }
+   else
+   {
+      psLoopback = (phFriNfc_LlcpMac_sLoopback_t*)LlcpMac->LowerDevice;
+
+      if ((psLoopback->psPeer != NULL) &&
+          (LlcpMac->psRemoteDevInfo->RemoteDevInfo.NfcIP_Info.ATRInfo_Length >= 3) &&
+          !memcmp(Llcp_Magic_Number,LlcpMac->psRemoteDevInfo->RemoteDevInfo.NfcIP_Info.ATRInfo,3))
+      {
+         LlcpMac->sConfigParam.buffer = &LlcpMac->psRemoteDevInfo->RemoteDevInfo.NfcIP_Info.ATRInfo[3] ;
+         LlcpMac->sConfigParam.length = (LlcpMac->psRemoteDevInfo->RemoteDevInfo.NfcIP_Info.ATRInfo_Length - 3);
+      }
+      else
+      {
+         status = PHNFCSTVAL(CID_FRI_NFC_LLCP_MAC, NFCSTATUS_FAILED);
+      }
+      ChkLlcpMac_Cb(pContext,status);
+   }
+
+   return status;
+}
+
+static NFCSTATUS phFriNfc_LlcpMac_Loopback_Activate (phFriNfc_LlcpMac_t   *LlcpMac)
+{
+   NFCSTATUS status  = NFCSTATUS_SUCCESS;
+
+   if(LlcpMac == NULL)
+   {
+      status = PHNFCSTVAL(CID_FRI_NFC_LLCP_MAC, NFCSTATUS_INVALID_PARAMETER);
+   }
+   else
+   {
+      LlcpMac->LinkState = phFriNfc_LlcpMac_eLinkActivated;
+      LlcpMac->LinkStatus_Cb(LlcpMac->LinkStatus_Context,
+                             LlcpMac->LinkState,
+                             &LlcpMac->sConfigParam,
+                             LlcpMac->PeerRemoteDevType);
+   }
+
+   return status;
+}
+
+static NFCSTATUS phFriNfc_LlcpMac_Loopback_Deactivate (phFriNfc_LlcpMac_t   *LlcpMac)
+{
+   NFCSTATUS                     status  = NFCSTATUS_SUCCESS;
+   phFriNfc_LlcpMac_sLoopback_t  *psLoopback;
+   phFriNfc_LlcpMac_t            *PeerLlcpMac;
+
+   if(NULL == LlcpMac)
+   {
+      status = PHNFCSTVAL(CID_FRI_NFC_LLCP_MAC, NFCSTATUS_INVALID_PARAMETER);
+   }
+   else
+   {
+      psLoopback = (phFriNfc_LlcpMac_sLoopback_t*)LlcpMac->LowerDevice;
+
+      /* Set the flag of LinkStatus to deactivate */
+      LlcpMac->LinkState = phFriNfc_LlcpMac_eLinkDeactivated;
+
+      /* Drop the frame on the link, if any */
+      phOsalNfc_Timer_Stop(psLoopback->hDelayTimer);
+      psLoopback->psInFlight = NULL;
+      psLoopback->bArrived = FALSE;
+
+      phFriNfc_LlcpMac_Loopback_TriggerSendCb(LlcpMac, NFCSTATUS_FAILED);
+      phFriNfc_LlcpMac_Loopback_TriggerRecvCb(LlcpMac, NFCSTATUS_FAILED);
+
+      LlcpMac->LinkStatus_Cb(LlcpMac->LinkStatus_Context,
+                             LlcpMac->LinkState,
+                             NULL,
+                             LlcpMac->PeerRemoteDevType);
+
+      /* The field is gone for the peer as well */
+      PeerLlcpMac = psLoopback->psPeer->psMac;
+      if ((PeerLlcpMac != NULL) && (PeerLlcpMac->LinkState == phFriNfc_LlcpMac_eLinkActivated))
+      {
+         phFriNfc_LlcpMac_Deactivate(PeerLlcpMac);
+      }
+   }
+
+   return status;
+}
+
+static NFCSTATUS phFriNfc_LlcpMac_Loopback_Send(phFriNfc_LlcpMac_t               *LlcpMac,
+                                                phNfc_sData_t                    *psData,
+                                                phFriNfc_LlcpMac_Send_CB_t       LlcpMacSend_Cb,
+                                                void                             *pContext)
+{
+   NFCSTATUS                     status = NFCSTATUS_PENDING;
+   phFriNfc_LlcpMac_sLoopback_t  *psLoopback;
+
+   if(NULL == LlcpMac || NULL == psData || NULL == LlcpMacSend_Cb || NULL == pContext)
+   {
+      status = PHNFCSTVAL(CID_FRI_NFC_LLCP_MAC, NFCSTATUS_INVALID_PARAMETER);
+   }
+   else if(LlcpMac->LinkState != phFriNfc_LlcpMac_eLinkActivated)
+   {
+      status = PHNFCSTVAL(CID_FRI_NFC_LLCP_MAC, NFCSTATUS_FAILED);
+   }
+   else if(LlcpMac->MacSend_Cb != NULL)
+   {
+      /*Previous callback is pending */
+      status = NFCSTATUS_REJECTED;
+   }
+   else
+   {
+      psLoopback = (phFriNfc_LlcpMac_sLoopback_t*)LlcpMac->LowerDevice;
+
+      /* Save the LlcpMacSend_Cb */
+      LlcpMac->MacSend_Cb = LlcpMacSend_Cb;
+      LlcpMac->MacSend_Context = pContext;
+
+      /* Borrow the sender buffer until the frame is copied to the peer */
+      psLoopback->psInFlight = psData;
+      psLoopback->bArrived = FALSE;
+      psLoopback->sStats.nFramesSent++;
+
+      phOsalNfc_Timer_Start(psLoopback->hDelayTimer,
+                            phFriNfc_LlcpMac_Loopback_GetDelay(psLoopback, psData->length),
+                            phFriNfc_LlcpMac_Loopback_Timer_CB,
+                            psLoopback);
+   }
+   return status;
+}
+
+static NFCSTATUS phFriNfc_LlcpMac_Loopback_Receive(phFriNfc_LlcpMac_t               *LlcpMac,
+                                                   phNfc_sData_t                    *psData,
+                                                   phFriNfc_LlcpMac_Reveive_CB_t    LlcpMacReceive_Cb,
+                                                   void                             *pContext)
+{
+   NFCSTATUS                     status = NFCSTATUS_PENDING;
+   phFriNfc_LlcpMac_sLoopback_t  *psPeer;
+
+   if(NULL == LlcpMac || NULL==psData || NULL == LlcpMacReceive_Cb || NULL == pContext)
+   {
+      status = PHNFCSTVAL(CID_FRI_NFC_LLCP_MAC, NFCSTATUS_INVALID_PARAMETER);
+   }
+   else if(LlcpMac->MacReceive_Cb != NULL)
+   {
+      /*Previous callback is pending */
+      status = NFCSTATUS_REJECTED;
+   }
+   else
+   {
+      /* Save the LlcpMacReceive_Cb */
+      LlcpMac->MacReceive_Cb = LlcpMacReceive_Cb;
+      LlcpMac->MacReceive_Context = pContext;
+
+      /* Save the pointer to the receive buffer */
+      LlcpMac->psReceiveBuffer= psData;
+
+      /* A frame already waiting on the link is handed over from the peer
+         timer, never from within this call */
+      psPeer = ((phFriNfc_LlcpMac_sLoopback_t*)LlcpMac->LowerDevice)->psPeer;
+      if ((psPeer->psInFlight != NULL) && psPeer->bArrived)
+      {
+         phOsalNfc_Timer_Start(psPeer->hDelayTimer,
+                               1,
+                               phFriNfc_LlcpMac_Loopback_Timer_CB,
+                               psPeer);
+      }
+   }
+   return status;
+}
+
+
+NFCSTATUS phFriNfc_LlcpMac_Loopback_Init(phFriNfc_LlcpMac_sLoopback_t              *psLoopbackA,
+                                         phFriNfc_LlcpMac_sLoopback_t              *psLoopbackB,
+                                         const phFriNfc_LlcpMac_sLoopbackConfig_t  *psConfig)
+{
+   if ((psLoopbackA == NULL) || (psLoopbackB == NULL) || (psLoopbackA == psLoopbackB) ||
+       ((psConfig != NULL) && (psConfig->nLossRate > PHFRINFC_LLCP_LOOPBACK_LOSS_SCALE)))
+   {
+      return PHNFCSTVAL(CID_FRI_NFC_LLCP_MAC, NFCSTATUS_INVALID_PARAMETER);
+   }
+
+   memset(psLoopbackA, 0x00, sizeof(phFriNfc_LlcpMac_sLoopback_t));
+   memset(psLoopbackB, 0x00, sizeof(phFriNfc_LlcpMac_sLoopback_t));
+
+   if (psConfig != NULL)
+   {
+      psLoopbackA->sConfig = *psConfig;
+      psLoopbackB->sConfig = *psConfig;
+   }
+
+   /* Both directions draw from distinct sequences */
+   psLoopbackA->nRandom = psLoopbackA->sConfig.nSeed;
+   psLoopbackB->nRandom = ~psLoopbackB->sConfig.nSeed;
+
+   psLoopbackA->psPeer = psLoopbackB;
+   psLoopbackB->psPeer = psLoopbackA;
+
+   psLoopbackA->hDelayTimer = phOsalNfc_Timer_Create();
+   psLoopbackB->hDelayTimer = phOsalNfc_Timer_Create();
+   if ((psLoopbackA->hDelayTimer == PH_OSALNFC_INVALID_TIMER_ID) ||
+       (psLoopbackB->hDelayTimer == PH_OSALNFC_INVALID_TIMER_ID))
+   {
+      phFriNfc_LlcpMac_Loopback_Release(psLoopbackA);
+      return PHNFCSTVAL(CID_FRI_NFC_LLCP_MAC, NFCSTATUS_INSUFFICIENT_RESOURCES);
+   }
+
+   return NFCSTATUS_SUCCESS;
+}
+
+NFCSTATUS phFriNfc_LlcpMac_Loopback_Release(phFriNfc_LlcpMac_sLoopback_t *psLoopback)
+{
+   phFriNfc_LlcpMac_sLoopback_t  *psEnds[2];
+   uint8_t                       i;
+
+   if ((psLoopback == NULL) || (psLoopback->psPeer == NULL))
+   {
+      return PHNFCSTVAL(CID_FRI_NFC_LLCP_MAC, NFCSTATUS_INVALID_PARAMETER);
+   }
+
+   psEnds[0] = psLoopback;
+   psEnds[1] = psLoopback->psPeer;
+
+   for (i=0; i<2; i++)
+   {
+      if (psEnds[i]->hDelayTimer != PH_OSALNFC_INVALID_TIMER_ID)
+      {
+         phOsalNfc_Timer_Stop(psEnds[i]->hDelayTimer);
+         phOsalNfc_Timer_Delete(psEnds[i]->hDelayTimer);
+         psEnds[i]->hDelayTimer = PH_OSALNFC_INVALID_TIMER_ID;
+      }
+      psEnds[i]->psInFlight = NULL;
+   }
+
+   return NFCSTATUS_SUCCESS;
+}
+
+NFCSTATUS phFriNfc_LlcpMac_Loopback_Register(phFriNfc_LlcpMac_t *LlcpMac)
+{
+   phFriNfc_LlcpMac_sLoopback_t  *psLoopback;
+
+   if ((LlcpMac == NULL) || (LlcpMac->LowerDevice == NULL))
+   {
+      return PHNFCSTVAL(CID_FRI_NFC_LLCP_MAC, NFCSTATUS_INVALID_PARAMETER);
+   }
+
+   psLoopback = (phFriNfc_LlcpMac_sLoopback_t*)LlcpMac->LowerDevice;
+   if (psLoopback->psPeer == NULL)
+   {
+      /* Not paired */
+      return PHNFCSTVAL(CID_FRI_NFC_LLCP_MAC, NFCSTATUS_INVALID_PARAMETER);
+   }
+   psLoopback->psMac = LlcpMac;
+
+   /* Set the MAC mapping type */
+   LlcpMac->MacType = phFriNfc_LlcpMac_eTypeLoopback;
+
+   LlcpMac->LlcpMacInterface.chk              = phFriNfc_LlcpMac_Loopback_Chk;
+   LlcpMac->LlcpMacInterface.activate         = phFriNfc_LlcpMac_Loopback_Activate;
+   LlcpMac->LlcpMacInterface.deactivate       = phFriNfc_LlcpMac_Loopback_Deactivate;
+   LlcpMac->LlcpMacInterface.send             = phFriNfc_LlcpMac_Loopback_Send;
+   LlcpMac->LlcpMacInterface.receive          = phFriNfc_LlcpMac_Loopback_Receive;
+
+   return NFCSTATUS_SUCCESS;
+}
+
+NFCSTATUS phFriNfc_LlcpMac_Loopback_GetStats(phFriNfc_LlcpMac_sLoopback_t       *psLoopback,
+                                             phFriNfc_LlcpMac_sLoopbackStats_t  *psStats)
+{
+   if ((psLoopback == NULL) || (psStats == NULL))
+   {
+      return PHNFCSTVAL(CID_FRI_NFC_LLCP_MAC, NFCSTATUS_INVALID_PARAMETER);
+   }
+
+   *psStats = psLoopback->sStats;
+
+   return NFCSTATUS_SUCCESS;
+}
@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2010 NXP Semiconductors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file  phFriNfc_LlcpMacLoopback.h
+ * \brief NFC LLCP MAC Mapping for an in-process loopback link.
+ *
+ * Project: NFC-FRI
+ *
+ */
+
+#ifndef PHFRINFC_LLCPMACLOOPBACK_H
+#define PHFRINFC_LLCPMACLOOPBACK_H
+
+
+/*include files*/
+#include <phNfcTypes.h>
+#include <phNfcLlcpTypes.h>
+#include <phNfcStatus.h>
+#include <phFriNfc.h>
+
+/**
+ * \name MAC Mapping for Loopback
+ *
+ * File: \ref phFriNfc_LlcpMacLoopback.h
+ *
+ */
+
+
+/** \defgroup grp_fri_nfc_llcp_macloopback Loopback MAC Mapping
+ *
+ *  The loopback mapping connects two LLCP stacks living in the same process
+ *  without any RF hardware. Each stack is reset with a loopback context as its
+ *  lower device, the two contexts are paired with
+ *  \ref phFriNfc_LlcpMac_Loopback_Init, and every frame sent by one side is
+ *  copied into the pending receive buffer of the other side once the
+ *  configured link delay has elapsed.
+ *
+ *  The remote device information given to \ref phFriNfc_Llcp_ChkLlcp is
+ *  used as for NFCIP: its RemDevType selects the role and its ATRInfo must
+ *  hold the LLCP magic number followed by the peer link parameters.
+ *
+ */
+
+/* Forward declaration */
+struct phFriNfc_LlcpMac;
+
+/**
+ * \ingroup grp_fri_nfc_llcp_macloopback
+ * \brief Loopback link characteristics.
+ */
+typedef struct phFriNfc_LlcpMac_sLoopbackConfig
+{
+   /** Fixed delay added to every frame, in milliseconds */
+   uint32_t    nLatency;
+
+   /** Simulated link bitrate in bits per second, 0 for an unlimited link */
+   uint32_t    nBitrate;
+
+   /** Proportion of frames lost on the link, per thousand */
+   uint16_t    nLossRate;
+
+   /** Seed of the pseudo random generator used for frame loss */
+   uint32_t    nSeed;
+
+}phFriNfc_LlcpMac_sLoopbackConfig_t;
+
+/**
+ * \ingroup grp_fri_nfc_llcp_macloopback
+ * \brief Loopback link counters, as seen from the sending side.
+ */
+typedef struct phFriNfc_LlcpMac_sLoopbackStats
+{
+   uint32_t    nFramesSent;
+   uint32_t    nFramesDelivered;
+   uint32_t    nFramesLost;
+   uint32_t    nBytesDelivered;
+
+}phFriNfc_LlcpMac_sLoopbackStats_t;
+
+/**
+ * \ingroup grp_fri_nfc_llcp_macloopback
+ * \brief One end of a loopback link.
+ *
+ * This context is owned by the caller and given as the lower device of
+ * \ref phFriNfc_Llcp_Reset.
+ */
+typedef struct phFriNfc_LlcpMac_sLoopback
+{
+   /** Other end of the link */
+   struct phFriNfc_LlcpMac_sLoopback   *psPeer;
+
+   /** MAC bound to this end, set by \ref phFriNfc_LlcpMac_Loopback_Register */
+   struct phFriNfc_LlcpMac             *psMac;
+
+   /** Link characteristics, shared by both directions */
+   phFriNfc_LlcpMac_sLoopbackConfig_t  sConfig;
+
+   /** Pseudo random generator state */
+   uint32_t                            nRandom;
+
+   /** Timer used to delay the frames sent from this end */
+   uint32_t                            hDelayTimer;
+
+   /** Frame sent from this end, held until the peer is ready to receive it */
+   phNfc_sData_t                       *psInFlight;
+   uint8_t                             bArrived;
+
+   phFriNfc_LlcpMac_sLoopbackStats_t   sStats;
+
+}phFriNfc_LlcpMac_sLoopback_t;
+
+
+/**
+ * \ingroup grp_fri_nfc_llcp_macloopback
+ * \brief Pair two loopback contexts.
+ *
+ * Both contexts are reset and linked to each other, and the delay timers are
+ * created. A NULL \p psConfig selects an ideal link.
+ *
+ * \param[in] psLoopbackA   One end of the link.
+ * \param[in] psLoopbackB   The other end of the link.
+ * \param[in] psConfig      The link characteristics.
+ *
+ * \retval NFCSTATUS_SUCCESS                  Operation successful.
+ * \retval NFCSTATUS_INVALID_PARAMETER        One or more of the supplied parameters
+ *                                            could not be properly interpreted.
+ * \retval NFCSTATUS_INSUFFICIENT_RESOURCES   No timer could be created.
+ */
+NFCSTATUS phFriNfc_LlcpMac_Loopback_Init(phFriNfc_LlcpMac_sLoopback_t              *psLoopbackA,
+                                         phFriNfc_LlcpMac_sLoopback_t              *psLoopbackB,
+                                         const phFriNfc_LlcpMac_sLoopbackConfig_t  *psConfig);
+
+/**
+ * \ingroup grp_fri_nfc_llcp_macloopback
+ * \brief Release the resources of a pair of loopback contexts.
+ *
+ * \param[in] psLoopback    Either end of the link.
+ *
+ * \retval NFCSTATUS_SUCCESS                  Operation successful.
+ * \retval NFCSTATUS_INVALID_PARAMETER        One or more of the supplied parameters
+ *                                            could not be properly interpreted.
+ */
+NFCSTATUS phFriNfc_LlcpMac_Loopback_Release(phFriNfc_LlcpMac_sLoopback_t *psLoopback);
+
+/**
+ * \ingroup grp_fri_nfc_llcp_macloopback
+ * \brief Select the loopback mapping for a MAC.
+ *
+ * Must be called after \ref phFriNfc_Llcp_Reset, with the loopback context
+ * given there as lower device, and before \ref phFriNfc_Llcp_ChkLlcp.
+ *
+ * \param[in] LlcpMac       The MAC to bind.
+ *
+ * \retval NFCSTATUS_SUCCESS                  Operation successful.
+ * \retval NFCSTATUS_INVALID_PARAMETER        One or more of the supplied parameters
+ *                                            could not be properly interpreted.
+ */
+NFCSTATUS phFriNfc_LlcpMac_Loopback_Register(struct phFriNfc_LlcpMac *LlcpMac);
+
+/**
+ * \ingroup grp_fri_nfc_llcp_macloopback
+ * \brief Get the counters of the frames sent from one end of the link.
+ *
+ * \param[in]  psLoopback   The sending end.
+ * \param[out] psStats      The counters.
+ *
+ * \retval NFCSTATUS_SUCCESS                  Operation successful.
+ * \retval NFCSTATUS_INVALID_PARAMETER        One or more of the supplied parameters
+ *                                            could not be properly interpreted.
+ */
+NFCSTATUS phFriNfc_LlcpMac_Loopback_GetStats(phFriNfc_LlcpMac_sLoopback_t       *psLoopback,
+                                             phFriNfc_LlcpMac_sLoopbackStats_t  *psStats);
+
+#endif /* PHFRINFC_LLCPMACLOOPBACK_H */
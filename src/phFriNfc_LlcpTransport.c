@@ -38,6 +38,12 @@
 /* Check if (a <= x < b) */
 #define IS_BETWEEN(x, a, b) (((x)>=(a)) && ((x)<(b)))
 
+/* End of a ready queue */
+#define PHFRINFC_LLCP_SCHED_NONE    0xFF
+
+/* End of a service name registry chain */
+#define PHFRINFC_LLCP_SN_NONE       0xFF
+
 static NFCSTATUS phFriNfc_LlcpTransport_RegisterName(phFriNfc_LlcpTransport_Socket_t*   pLlcpSocket,
                                                      uint8_t                            nSap,
                                                      phNfc_sData_t                      *psServiceName);
@@ -47,26 +53,457 @@ static NFCSTATUS phFriNfc_LlcpTransport_DiscoverServicesEx(phFriNfc_LlcpTranspor
 static void phFriNfc_LlcpTransport_Send_CB(void            *pContext,
                                            NFCSTATUS        status);
 
+#ifdef NXP_LLCP_AGF_SEND
+static void phFriNfc_LlcpTransport_SendTurn_CB(void            *pContext,
+                                               NFCSTATUS        status);
+#endif /* #ifdef NXP_LLCP_AGF_SEND */
+
+static phFriNfc_LlcpTransport_Socket_t* phFriNfc_LlcpTransport_NextReadySocket(phFriNfc_LlcpTransport_t *psTransport);
+
+static uint32_t phFriNfc_LlcpTransport_HashServiceName(phNfc_sData_t *psServiceName)
+{
+   uint32_t nHash = 0x811C9DC5; /* FNV-1a */
+   uint32_t i;
+
+   for (i=0 ; i<psServiceName->length ; i++)
+   {
+      nHash ^= psServiceName->buffer[i];
+      nHash *= 0x01000193;
+   }
+   return nHash;
+}
+
+static bool_t phFriNfc_LlcpTransport_MatchServiceName(phNfc_sData_t *psServiceName1,
+                                                      phNfc_sData_t *psServiceName2)
+{
+   return (psServiceName1->length == psServiceName2->length) &&
+          (memcmp(psServiceName1->buffer, psServiceName2->buffer, psServiceName1->length) == 0);
+}
+
+static void phFriNfc_LlcpTransport_ResetServiceNames(phFriNfc_LlcpTransport_t *psTransport)
+{
+   memset(psTransport->nServiceNameBuckets, PHFRINFC_LLCP_SN_NONE, sizeof(psTransport->nServiceNameBuckets));
+}
+
+static void phFriNfc_LlcpTransport_ClearCachedNames(phFriNfc_LlcpTransport_t *psTransport)
+{
+   phFriNfc_LlcpTransport_Socket_t     *pSocket;
+   phFriNfc_Llcp_CachedServiceName_t   *pCachedServiceName;
+   uint8_t                             index;
+   uint8_t                             i;
+
+   /* Give the shared names back to their sockets */
+   for(i=0 ; (psTransport->pSocketTable != NULL) && (i<psTransport->nSocketTableSize) ; i++)
+   {
+      pSocket = &psTransport->pSocketTable[i];
+      if (pSocket->bServiceNameCached)
+      {
+         index = psTransport->nCachedSapIndex[pSocket->socket_sSap];
+         if ((index != PHFRINFC_LLCP_SN_NONE) &&
+             (psTransport->pCachedServiceNames[index].sServiceName.buffer == pSocket->sServiceName.buffer))
+         {
+            psTransport->pCachedServiceNames[index].sServiceName.buffer = NULL;
+         }
+         pSocket->bServiceNameCached = FALSE;
+      }
+   }
+
+   /* Free the cached names */
+   for(i=0 ; (psTransport->pCachedServiceNames != NULL) && (i<psTransport->nCachedServiceNamesSize) ; i++)
+   {
+      pCachedServiceName = &psTransport->pCachedServiceNames[i];
+      if (pCachedServiceName->sServiceName.buffer != NULL)
+      {
+         phOsalNfc_FreeMemory(pCachedServiceName->sServiceName.buffer);
+      }
+      memset(pCachedServiceName, 0x00, sizeof(phFriNfc_Llcp_CachedServiceName_t));
+   }
+
+   memset(psTransport->nCachedNameBuckets, PHFRINFC_LLCP_SN_NONE, sizeof(psTransport->nCachedNameBuckets));
+   memset(psTransport->nCachedSapIndex, PHFRINFC_LLCP_SN_NONE, sizeof(psTransport->nCachedSapIndex));
+}
+
+phFriNfc_LlcpTransport_Socket_t* phFriNfc_LlcpTransport_FindServiceName(phFriNfc_LlcpTransport_t  *psTransport,
+                                                                        phNfc_sData_t             *psServiceName)
+{
+   phFriNfc_LlcpTransport_Socket_t  *pSocket;
+   uint32_t                         nHash = phFriNfc_LlcpTransport_HashServiceName(psServiceName);
+   uint8_t                          index;
+
+   /* Walk the chain of the bucket */
+   /* NOTE: a service name is unique among the bound and registered sockets */
+   for (index = psTransport->nServiceNameBuckets[nHash & (PHFRINFC_LLCP_SN_HASH_SIZE - 1)] ;
+        index != PHFRINFC_LLCP_SN_NONE ;
+        index = pSocket->nNextServiceName)
+   {
+      pSocket = &psTransport->pSocketTable[index];
+      if ((pSocket->nServiceNameHash == nHash) &&
+          ((pSocket->eSocket_State == phFriNfc_LlcpTransportSocket_eSocketBound) ||
+           (pSocket->eSocket_State == phFriNfc_LlcpTransportSocket_eSocketRegistered)) &&
+          phFriNfc_LlcpTransport_MatchServiceName(&pSocket->sServiceName, psServiceName))
+      {
+         return pSocket;
+      }
+   }
+
+   return NULL;
+}
+
+void phFriNfc_LlcpTransport_UnregisterName(phFriNfc_LlcpTransport_Socket_t  *pLlcpSocket)
+{
+   phFriNfc_LlcpTransport_t   *psTransport = pLlcpSocket->psTransport;
+   uint8_t                    *pnLink;
+
+   /* Unlink the socket from its bucket */
+   if (pLlcpSocket->bServiceNameIndexed)
+   {
+      pnLink = &psTransport->nServiceNameBuckets[pLlcpSocket->nServiceNameHash & (PHFRINFC_LLCP_SN_HASH_SIZE - 1)];
+      while (*pnLink != PHFRINFC_LLCP_SN_NONE)
+      {
+         if (*pnLink == pLlcpSocket->index)
+         {
+            *pnLink = pLlcpSocket->nNextServiceName;
+            break;
+         }
+         pnLink = &psTransport->pSocketTable[*pnLink].nNextServiceName;
+      }
+      pLlcpSocket->bServiceNameIndexed = FALSE;
+   }
+
+   /* Free the name, unless the SDP cache took it over */
+   if ((pLlcpSocket->sServiceName.buffer != NULL) && !pLlcpSocket->bServiceNameCached)
+   {
+      phOsalNfc_FreeMemory(pLlcpSocket->sServiceName.buffer);
+   }
+   pLlcpSocket->sServiceName.buffer = NULL;
+   pLlcpSocket->sServiceName.length = 0;
+   pLlcpSocket->bServiceNameCached = FALSE;
+}
+
+static void phFriNfc_LlcpTransport_IndexServiceName(phFriNfc_LlcpTransport_Socket_t  *pLlcpSocket)
+{
+   phFriNfc_LlcpTransport_t   *psTransport = pLlcpSocket->psTransport;
+   uint8_t                    nBucket;
+
+   pLlcpSocket->nServiceNameHash = phFriNfc_LlcpTransport_HashServiceName(&pLlcpSocket->sServiceName);
+   nBucket = (uint8_t)(pLlcpSocket->nServiceNameHash & (PHFRINFC_LLCP_SN_HASH_SIZE - 1));
+
+   /* Insert the socket at the head of its bucket */
+   pLlcpSocket->nNextServiceName = psTransport->nServiceNameBuckets[nBucket];
+   psTransport->nServiceNameBuckets[nBucket] = pLlcpSocket->index;
+   pLlcpSocket->bServiceNameIndexed = TRUE;
+}
+
+static phFriNfc_Llcp_CachedServiceName_t* phFriNfc_LlcpTransport_FindCachedName(phFriNfc_LlcpTransport_t  *psTransport,
+                                                                                phNfc_sData_t             *psServiceName)
+{
+   phFriNfc_Llcp_CachedServiceName_t   *pCachedServiceName;
+   uint32_t                            nHash = phFriNfc_LlcpTransport_HashServiceName(psServiceName);
+   uint8_t                             index;
+
+   for (index = psTransport->nCachedNameBuckets[nHash & (PHFRINFC_LLCP_SN_HASH_SIZE - 1)] ;
+        index != PHFRINFC_LLCP_SN_NONE ;
+        index = pCachedServiceName->nNext)
+   {
+      pCachedServiceName = &psTransport->pCachedServiceNames[index];
+      if ((pCachedServiceName->nHash == nHash) &&
+          phFriNfc_LlcpTransport_MatchServiceName(&pCachedServiceName->sServiceName, psServiceName))
+      {
+         return pCachedServiceName;
+      }
+   }
+
+   return NULL;
+}
+
+static void phFriNfc_LlcpTransport_CacheServiceName(phFriNfc_LlcpTransport_Socket_t  *pSocket)
+{
+   phFriNfc_LlcpTransport_t            *psTransport = pSocket->psTransport;
+   phFriNfc_Llcp_CachedServiceName_t   *pCachedServiceName;
+   uint8_t                             index;
+   uint8_t                             nBucket;
+
+   if (pSocket->bServiceNameCached ||
+       (pSocket->socket_sSap >= PHFRINFC_LLCP_SAP_NUMBER) ||
+       (psTransport->nCachedSapIndex[pSocket->socket_sSap] != PHFRINFC_LLCP_SN_NONE))
+   {
+      /* Already registered */
+      return;
+   }
+
+   /* Find a free entry */
+   for (index=0 ; index<psTransport->nCachedServiceNamesSize ; index++)
+   {
+      if (psTransport->pCachedServiceNames[index].sServiceName.buffer == NULL)
+      {
+         break;
+      }
+   }
+   if (index >= psTransport->nCachedServiceNamesSize)
+   {
+      /* Cache full */
+      return;
+   }
+
+   /* The cache takes over the socket name, no copy is needed */
+   pCachedServiceName = &psTransport->pCachedServiceNames[index];
+   pCachedServiceName->sServiceName = pSocket->sServiceName;
+   pCachedServiceName->nSap  = pSocket->socket_sSap;
+   pCachedServiceName->nHash = pSocket->nServiceNameHash;
+   pSocket->bServiceNameCached = TRUE;
+
+   nBucket = (uint8_t)(pCachedServiceName->nHash & (PHFRINFC_LLCP_SN_HASH_SIZE - 1));
+   pCachedServiceName->nNext = psTransport->nCachedNameBuckets[nBucket];
+   psTransport->nCachedNameBuckets[nBucket] = index;
+   psTransport->nCachedSapIndex[pCachedServiceName->nSap] = index;
+}
+
+static bool_t phFriNfc_LlcpTransport_GetPeerId(phFriNfc_LlcpTransport_t  *psTransport,
+                                               phNfc_sData_t             *psPeerId)
+{
+   phHal_sRemoteDevInformation_t  *psRemoteDevInfo = psTransport->pLlcp->MAC.psRemoteDevInfo;
+
+   /* The peer is known by its NFCID3, a peer drawing a random one is never matched */
+   if ((psRemoteDevInfo == NULL) ||
+       (psRemoteDevInfo->RemoteDevInfo.NfcIP_Info.NFCID_Length == 0) ||
+       (psRemoteDevInfo->RemoteDevInfo.NfcIP_Info.NFCID_Length > PHHAL_MAX_UID_LENGTH))
+   {
+      return FALSE;
+   }
+
+   psPeerId->buffer = psRemoteDevInfo->RemoteDevInfo.NfcIP_Info.NFCID;
+   psPeerId->length = psRemoteDevInfo->RemoteDevInfo.NfcIP_Info.NFCID_Length;
+   return TRUE;
+}
+
+static phFriNfc_LlcpTransport_RemoteSap_t* phFriNfc_LlcpTransport_FindRemoteSap(phFriNfc_LlcpTransport_t  *psTransport,
+                                                                               phNfc_sData_t             *psPeerId,
+                                                                               phNfc_sData_t             *psServiceName)
+{
+   phFriNfc_LlcpTransport_RemoteSap_t  *psEntry;
+   uint32_t                            nHash = phFriNfc_LlcpTransport_HashServiceName(psServiceName);
+   uint32_t                            nNow = phOsalNfc_GetTime();
+   uint8_t                             i;
+
+   for (i=0 ; i<PHFRINFC_LLCP_REMOTE_SAP_CACHE_SIZE ; i++)
+   {
+      psEntry = &psTransport->sRemoteSaps[i];
+      if (psEntry->nPeerIdLength == 0)
+      {
+         /* Free entry */
+         continue;
+      }
+      if ((nNow - psEntry->nTimestamp) > psTransport->nRemoteSapTtl)
+      {
+         /* Expired, the peer may have rebound its services since */
+         psEntry->nPeerIdLength = 0;
+         continue;
+      }
+      if ((psEntry->nHash == nHash) &&
+          (psEntry->nPeerIdLength == psPeerId->length) &&
+          (psEntry->nServiceNameLength == psServiceName->length) &&
+          !memcmp(psEntry->aPeerId, psPeerId->buffer, psPeerId->length) &&
+          !memcmp(psEntry->aServiceName, psServiceName->buffer, psServiceName->length))
+      {
+         return psEntry;
+      }
+   }
+
+   return NULL;
+}
+
+static phFriNfc_LlcpTransport_RemoteSap_t* phFriNfc_LlcpTransport_StoreRemoteSap(phFriNfc_LlcpTransport_t  *psTransport,
+                                                                                phNfc_sData_t             *psServiceName,
+                                                                                uint8_t                   nSap)
+{
+   phFriNfc_LlcpTransport_RemoteSap_t  *psEntry;
+   phNfc_sData_t                       sPeerId;
+   uint32_t                            nNow = phOsalNfc_GetTime();
+   uint8_t                             i;
+
+   if (!phFriNfc_LlcpTransport_GetPeerId(psTransport, &sPeerId) ||
+       (psServiceName->length == 0) ||
+       (psServiceName->length > PHFRINFC_LLCP_REMOTE_SAP_SN_MAX))
+   {
+      /* Not remembered */
+      return NULL;
+   }
+
+   psEntry = phFriNfc_LlcpTransport_FindRemoteSap(psTransport, &sPeerId, psServiceName);
+   if (psEntry == NULL)
+   {
+      /* Take a free entry, or else the oldest one */
+      psEntry = &psTransport->sRemoteSaps[0];
+      for (i=0 ; i<PHFRINFC_LLCP_REMOTE_SAP_CACHE_SIZE ; i++)
+      {
+         if (psTransport->sRemoteSaps[i].nPeerIdLength == 0)
+         {
+            psEntry = &psTransport->sRemoteSaps[i];
+            break;
+         }
+         if ((nNow - psTransport->sRemoteSaps[i].nTimestamp) > (nNow - psEntry->nTimestamp))
+         {
+            psEntry = &psTransport->sRemoteSaps[i];
+         }
+      }
+
+      memcpy(psEntry->aPeerId, sPeerId.buffer, sPeerId.length);
+      psEntry->nPeerIdLength = (uint8_t)sPeerId.length;
+      memcpy(psEntry->aServiceName, psServiceName->buffer, psServiceName->length);
+      psEntry->nServiceNameLength = (uint8_t)psServiceName->length;
+      psEntry->nHash = phFriNfc_LlcpTransport_HashServiceName(psServiceName);
+   }
+
+   psEntry->nSap = nSap;
+   psEntry->nTimestamp = nNow;
+
+   return psEntry;
+}
+
+static uint8_t phFriNfc_LlcpTransport_LookupRemoteSap(phFriNfc_LlcpTransport_Socket_t  *pLlcpSocket,
+                                                      phNfc_sData_t                    *psServiceName)
+{
+   phFriNfc_LlcpTransport_t            *psTransport = pLlcpSocket->psTransport;
+   phFriNfc_LlcpTransport_RemoteSap_t  *psEntry = NULL;
+   phNfc_sData_t                       sPeerId;
+
+   pLlcpSocket->nRemoteSapEntry = PHFRINFC_LLCP_SN_NONE;
+
+   if (phFriNfc_LlcpTransport_GetPeerId(psTransport, &sPeerId))
+   {
+      psEntry = phFriNfc_LlcpTransport_FindRemoteSap(psTransport, &sPeerId, psServiceName);
+   }
+   if (psEntry == NULL)
+   {
+      /* Reserve an entry, to be filled from the CC frame */
+      psEntry = phFriNfc_LlcpTransport_StoreRemoteSap(psTransport, psServiceName, 0);
+      if (psEntry == NULL)
+      {
+         return PHFRINFC_LLCP_SAP_DEFAULT;
+      }
+   }
+
+   pLlcpSocket->nRemoteSapEntry  = (uint8_t)(psEntry - psTransport->sRemoteSaps);
+   pLlcpSocket->nRemoteSapHash   = psEntry->nHash;
+   pLlcpSocket->bRemoteSapCached = (psEntry->nSap != 0);
+
+   return (psEntry->nSap != 0) ? psEntry->nSap : PHFRINFC_LLCP_SAP_DEFAULT;
+}
+
+static void phFriNfc_LlcpTransport_EndRemoteSapSession(phFriNfc_LlcpTransport_t  *psTransport)
+{
+   phFriNfc_LlcpTransport_RemoteSap_t  *psEntry;
+   uint8_t                             i;
+
+   /* Only the well-known SAPs are fixed, the peer may bind its other services
+      elsewhere in its next session */
+   for (i=0 ; i<PHFRINFC_LLCP_REMOTE_SAP_CACHE_SIZE ; i++)
+   {
+      psEntry = &psTransport->sRemoteSaps[i];
+      if ((psEntry->nSap < PHFRINFC_LLCP_SAP_WKS_FIRST) ||
+          (psEntry->nSap >= PHFRINFC_LLCP_SAP_SDP_ADVERTISED_FIRST))
+      {
+         psEntry->nPeerIdLength = 0;
+      }
+   }
+}
+
+void phFriNfc_LlcpTransport_UpdateRemoteSap(phFriNfc_LlcpTransport_Socket_t  *pLlcpSocket,
+                                            uint8_t                          nSap)
+{
+   phFriNfc_LlcpTransport_RemoteSap_t  *psEntry;
+
+   if (pLlcpSocket->nRemoteSapEntry == PHFRINFC_LLCP_SN_NONE)
+   {
+      /* Not connecting by name */
+      return;
+   }
+   psEntry = &pLlcpSocket->psTransport->sRemoteSaps[pLlcpSocket->nRemoteSapEntry];
+   pLlcpSocket->nRemoteSapEntry = PHFRINFC_LLCP_SN_NONE;
+
+   if ((psEntry->nPeerIdLength == 0) || (psEntry->nHash != pLlcpSocket->nRemoteSapHash))
+   {
+      /* Entry recycled meanwhile */
+      return;
+   }
+
+   if (nSap != 0)
+   {
+      psEntry->nSap = nSap;
+      psEntry->nTimestamp = phOsalNfc_GetTime();
+   }
+   else
+   {
+      /* Wrong or stale SAP, resolve the name again next time */
+      psEntry->nPeerIdLength = 0;
+   }
+}
+
+NFCSTATUS phFriNfc_LlcpTransport_RetryConnectByName(phFriNfc_LlcpTransport_Socket_t  *pLlcpSocket)
+{
+   phFriNfc_LlcpTransport_RemoteSap_t  *psEntry;
+   phNfc_sData_t                       sServiceName;
+
+   if ((pLlcpSocket->nRemoteSapEntry == PHFRINFC_LLCP_SN_NONE) || !pLlcpSocket->bRemoteSapCached)
+   {
+      /* The service name was already sent */
+      return PHNFCSTVAL(CID_FRI_NFC_LLCP_TRANSPORT, NFCSTATUS_FAILED);
+   }
+   pLlcpSocket->bRemoteSapCached = FALSE;
+
+   psEntry = &pLlcpSocket->psTransport->sRemoteSaps[pLlcpSocket->nRemoteSapEntry];
+   if ((psEntry->nPeerIdLength == 0) || (psEntry->nHash != pLlcpSocket->nRemoteSapHash))
+   {
+      /* Entry recycled meanwhile, the service name is lost */
+      pLlcpSocket->nRemoteSapEntry = PHFRINFC_LLCP_SN_NONE;
+      return PHNFCSTVAL(CID_FRI_NFC_LLCP_TRANSPORT, NFCSTATUS_FAILED);
+   }
+
+   /* Forget the stale SAP, the entry is filled again from the CC frame */
+   psEntry->nSap = 0;
+   sServiceName.buffer = psEntry->aServiceName;
+   sServiceName.length = psEntry->nServiceNameLength;
+
+   /* The send buffer was cut to the length of the first CONNECT */
+   pLlcpSocket->sSocketSendBuffer.length = pLlcpSocket->bufferSendMaxLength;
+
+   return phFriNfc_LlcpTransport_ConnectionOriented_Connect(pLlcpSocket,
+                                                            PHFRINFC_LLCP_SAP_DEFAULT,
+                                                            &sServiceName,
+                                                            pLlcpSocket->pfSocketConnect_Cb,
+                                                            pLlcpSocket->pConnectContext);
+}
+
+static uint32_t phFriNfc_LlcpTransport_GetSnlLength(phFriNfc_LlcpTransport_t *psTransport)
+{
+   /* Pack as many TLVs as the remote MIU allows */
+   uint32_t nLength = psTransport->pLlcp->sRemoteParams.miu;
+
+   if (nLength > sizeof(psTransport->pDiscoveryBuffer))
+   {
+      nLength = sizeof(psTransport->pDiscoveryBuffer);
+   }
+   return nLength;
+}
+
 static NFCSTATUS phFriNfc_LlcpTransport_GetFreeSap(phFriNfc_LlcpTransport_t * psTransport, phNfc_sData_t *psServiceName, uint8_t * pnSap)
 {
    uint8_t i;
    uint8_t sap;
    uint8_t min_sap_range, max_sap_range;
    phFriNfc_LlcpTransport_Socket_t* pSocketTable = psTransport->pSocketTable;
+   phFriNfc_Llcp_CachedServiceName_t* pCachedServiceName;
 
    /* Calculate authorized SAP range */
    if ((psServiceName != NULL) && (psServiceName->length > 0))
    {
       /* Make sure that we will return the same SAP if service name was already used in the past */
-      for(i=0 ; i<PHFRINFC_LLCP_SDP_ADVERTISED_NB ; i++)
+      pCachedServiceName = phFriNfc_LlcpTransport_FindCachedName(psTransport, psServiceName);
+      if (pCachedServiceName != NULL)
       {
-         if((psTransport->pCachedServiceNames[i].sServiceName.length > 0) &&
-            (memcmp(psTransport->pCachedServiceNames[i].sServiceName.buffer, psServiceName->buffer, psServiceName->length) == 0))
-         {
-            /* Service name matched in cached service names list */
-            *pnSap = psTransport->pCachedServiceNames[i].nSap;
-            return NFCSTATUS_SUCCESS;
-         }
+         /* Service name matched in cached service names list */
+         *pnSap = pCachedServiceName->nSap;
+         return NFCSTATUS_SUCCESS;
       }
 
       /* SDP advertised service */
@@ -83,8 +520,14 @@ static NFCSTATUS phFriNfc_LlcpTransport_GetFreeSap(phFriNfc_LlcpTransport_t * ps
    /* Try all possible SAPs */
    for(sap=min_sap_range ; sap<max_sap_range ; sap++)
    {
+      if (psTransport->nCachedSapIndex[sap] != PHFRINFC_LLCP_SN_NONE)
+      {
+         /* SAP is reserved for a cached service name */
+         continue;
+      }
+
       /* Go through socket list to check if current SAP is in use */
-      for(i=0 ; i<PHFRINFC_LLCP_NB_SOCKET_MAX ; i++)
+      for(i=0 ; i<psTransport->nSocketTableSize ; i++)
       {
          if((pSocketTable[i].eSocket_State >= phFriNfc_LlcpTransportSocket_eSocketBound) &&
             (pSocketTable[i].socket_sSap == sap))
@@ -94,7 +537,7 @@ static NFCSTATUS phFriNfc_LlcpTransport_GetFreeSap(phFriNfc_LlcpTransport_t * ps
          }
       }
 
-      if (i >= PHFRINFC_LLCP_NB_SOCKET_MAX)
+      if (i >= psTransport->nSocketTableSize)
       {
          /* No socket is using current SAP, proceed with binding */
          *pnSap = sap;
@@ -190,58 +633,22 @@ clean_and_return:
 static phFriNfc_LlcpTransport_Socket_t* phFriNfc_LlcpTransport_ServiceNameLoockup(phFriNfc_LlcpTransport_t *psTransport,
                                                                                   phNfc_sData_t            *pServiceName)
 {
-   uint32_t                            index;
-   uint8_t                             cacheIndex;
-   phFriNfc_Llcp_CachedServiceName_t * pCachedServiceName;
    phFriNfc_LlcpTransport_Socket_t *   pSocket;
 
    /* Search a socket with the SN */
-   for(index=0;index<PHFRINFC_LLCP_NB_SOCKET_MAX;index++)
+   pSocket = phFriNfc_LlcpTransport_FindServiceName(psTransport, pServiceName);
+
+   /* Test if the CO socket is in Listen state or the CL socket is bound */
+   if((pSocket != NULL) &&
+      (((pSocket->eSocket_Type == phFriNfc_LlcpTransport_eConnectionOriented)
+      && (pSocket->eSocket_State == phFriNfc_LlcpTransportSocket_eSocketRegistered))
+      || ((pSocket->eSocket_Type == phFriNfc_LlcpTransport_eConnectionLess)
+      && (pSocket->eSocket_State == phFriNfc_LlcpTransportSocket_eSocketBound))))
    {
-      pSocket = &psTransport->pSocketTable[index];
-      /* Test if the CO socket is in Listen state or the CL socket is bound
-         and if its SN is the good one */
-      if((((pSocket->eSocket_Type == phFriNfc_LlcpTransport_eConnectionOriented)
-         && (pSocket->eSocket_State == phFriNfc_LlcpTransportSocket_eSocketRegistered))
-         || ((pSocket->eSocket_Type == phFriNfc_LlcpTransport_eConnectionLess)
-         && (pSocket->eSocket_State == phFriNfc_LlcpTransportSocket_eSocketBound)))
-         &&
-         (pServiceName->length == pSocket->sServiceName.length)
-         && !memcmp(pServiceName->buffer, pSocket->sServiceName.buffer, pServiceName->length))
-      {
-         /* Add new entry to cached service name/sap if not already in table */
-         for(cacheIndex=0;cacheIndex<PHFRINFC_LLCP_SDP_ADVERTISED_NB;cacheIndex++)
-         {
-            pCachedServiceName = &psTransport->pCachedServiceNames[cacheIndex];
-            if (pCachedServiceName->sServiceName.buffer != NULL)
-            {
-               if ((pCachedServiceName->sServiceName.length == pServiceName->length) &&
-                   (memcmp(pCachedServiceName->sServiceName.buffer, pServiceName->buffer, pServiceName->length) == 0))
-               {
-                  /* Already registered */
-                  break;
-               }
-            }
-            else
-            {
-               /* Reached end of existing entries and not found the service name,
-                * => Add the new entry
-                */
-               pCachedServiceName->nSap = pSocket->socket_sSap;
-               pCachedServiceName->sServiceName.buffer = phOsalNfc_GetMemory(pServiceName->length);
-               if (pCachedServiceName->sServiceName.buffer == NULL)
-               {
-                  /* Unable to cache this entry, so report this service as not found */
-                  return NULL;
-               }
-               memcpy(pCachedServiceName->sServiceName.buffer, pServiceName->buffer, pServiceName->length);
-               pCachedServiceName->sServiceName.length = pServiceName->length;
-               break;
-            }
-         }
+      /* Add new entry to cached service name/sap if not already in table */
+      phFriNfc_LlcpTransport_CacheServiceName(pSocket);
 
-         return pSocket;
-      }
+      return pSocket;
    }
 
    return NULL;
@@ -266,7 +673,7 @@ static NFCSTATUS phFriNfc_LlcpTransport_DiscoveryAnswer(phFriNfc_LlcpTransport_t
 
       /* Prepare the info buffer */
       sInfoBuffer.buffer = psTransport->pDiscoveryBuffer;
-      sInfoBuffer.length = sizeof(psTransport->pDiscoveryBuffer);
+      sInfoBuffer.length = phFriNfc_LlcpTransport_GetSnlLength(psTransport);
 
       /* Encode as many requests as possible */
       nTlvOffset = 0;
@@ -401,14 +808,23 @@ static void Handle_Discovery_IncomingFrame(phFriNfc_LlcpTransport_t           *p
             }
             /* Decode TID and SAP */
             nTid = sValue.buffer[0];
-            if (nTid >= psTransport->nDiscoveryListSize)
+            if ((nTid >= psTransport->nDiscoveryListSize) ||
+                (psTransport->nDiscoveryResolved[nTid >> 3] & (1 << (nTid & 0x07))))
             {
-               /* Unkown TID, ignore it */
+               /* Unkown or already resolved TID, ignore it */
                break;
             }
             nSap = sValue.buffer[1];
             /* Save response */
             psTransport->pnDiscoverySapList[nTid] = nSap;
+            psTransport->nDiscoveryResolved[nTid >> 3] |= (1 << (nTid & 0x07));
+            if (nSap != 0)
+            {
+               /* Remember it for the next link sessions with this peer */
+               phFriNfc_LlcpTransport_StoreRemoteSap(psTransport,
+                                                     &psTransport->psDiscoveryServiceNameList[nTid],
+                                                     nSap);
+            }
             /* Update response counter */
             psTransport->nDiscoveryResOffset++;
             break;
@@ -554,6 +970,7 @@ static void phFriNfc_LlcpTransport_Send_CB(void            *pContext,
    void                             *pSavedContext;
    phFriNfc_LlcpTransport_Socket_t  *pCurrentSocket = NULL;
    uint8_t                          index;
+   uint8_t                          nServed;
 
    // Store callbacks and socket index, so they can safely be
    // overwritten by any code in the callback itself.
@@ -600,7 +1017,22 @@ static void phFriNfc_LlcpTransport_Send_CB(void            *pContext,
    /* 3 - Call the original callback */
    if (pfSavedCb != NULL)
    {
-      (*pfSavedCb)(pSavedContext, index, status);
+#ifdef NXP_LLCP_AGF_SEND
+      if ((phFriNfc_Llcp_IsAggregating(psTransport->pLlcp) == TRUE) &&
+          (psTransport->nDeferredSends < NXP_LLCP_AGF_MAX_PDUS))
+      {
+         /* The PDU is only copied in the AGF frame, call the callback */
+         /* once the frame is sent                                     */
+         psTransport->pfDeferredSendCb[psTransport->nDeferredSends] = pfSavedCb;
+         psTransport->pDeferredSendContext[psTransport->nDeferredSends] = pSavedContext;
+         psTransport->nDeferredSendIndex[psTransport->nDeferredSends] = index;
+         psTransport->nDeferredSends++;
+      }
+      else
+#endif /* #ifdef NXP_LLCP_AGF_SEND */
+      {
+         (*pfSavedCb)(pSavedContext, index, status);
+      }
    }
 
 
@@ -617,40 +1049,296 @@ static void phFriNfc_LlcpTransport_Send_CB(void            *pContext,
       result = phFriNfc_LlcpTransport_DiscoverServicesEx(psTransport);
    }
 
-   /* Init index */
-   index = psTransport->socketIndex;
-
-   /* Check all sockets for pending operation */
-   do
+   /* Serve the ready sockets, until one of them takes the link. A socket */
+   /* queued back with nothing sent is not served twice in this turn       */
+   for (nServed = 0; (nServed < psTransport->nSocketTableSize) && (psTransport->bSendPending == FALSE); nServed++)
+   {
+      pCurrentSocket = phFriNfc_LlcpTransport_NextReadySocket(psTransport);
+      if (pCurrentSocket == NULL)
+      {
+         /* No socket ready */
+         break;
+      }
+
+      /* Dispatch to the corresponding transport layer */
+      result = NFCSTATUS_FAILED;
+      if (pCurrentSocket->eSocket_Type == phFriNfc_LlcpTransport_eConnectionOriented)
+      {
+         result = phFriNfc_LlcpTransport_ConnectionOriented_HandlePendingOperations(pCurrentSocket);
+      }
+      else if (pCurrentSocket->eSocket_Type == phFriNfc_LlcpTransport_eConnectionLess)
+      {
+         result = phFriNfc_LlcpTransport_Connectionless_HandlePendingOperations(pCurrentSocket);
+      }
+
+      /* Queue the socket back if something else is pending */
+      phFriNfc_LlcpTransport_ScheduleSocket(pCurrentSocket);
+
+      if (result != NFCSTATUS_FAILED)
+      {
+         /* Stop looping if pending operation has been found */
+         break;
+      }
+   }
+}
+
+
+#ifdef NXP_LLCP_AGF_SEND
+static void phFriNfc_LlcpTransport_SendTurn_CB(void            *pContext,
+                                               NFCSTATUS        status)
+{
+   phFriNfc_LlcpTransport_t         *psTransport = (phFriNfc_LlcpTransport_t*)pContext;
+   phFriNfc_Llcp_LinkSend_CB_t      pfSavedCb[NXP_LLCP_AGF_MAX_PDUS];
+   void                             *pSavedContext[NXP_LLCP_AGF_MAX_PDUS];
+   uint8_t                          nSavedIndex[NXP_LLCP_AGF_MAX_PDUS];
+   uint8_t                          nSaved;
+   uint8_t                          i;
+
+   // Store the deferred callbacks, so that the callbacks can send
+   // again meanwhile.
+   nSaved = psTransport->nDeferredSends;
+   memcpy(pfSavedCb, psTransport->pfDeferredSendCb, nSaved * sizeof(phFriNfc_Llcp_LinkSend_CB_t));
+   memcpy(pSavedContext, psTransport->pDeferredSendContext, nSaved * sizeof(void*));
+   memcpy(nSavedIndex, psTransport->nDeferredSendIndex, nSaved);
+   psTransport->nDeferredSends = 0;
+
+   /* Complete the PDUs of the AGF frame, in their sending order */
+   for(i=0 ; i<nSaved ; i++)
+   {
+      (*pfSavedCb[i])(pSavedContext[i], nSavedIndex[i], status);
+   }
+}
+#endif /* #ifdef NXP_LLCP_AGF_SEND */
+
+
+static bool_t phFriNfc_LlcpTransport_IsSocketReady(phFriNfc_LlcpTransport_Socket_t *pSocket)
+{
+   if (pSocket->eSocket_Type == phFriNfc_LlcpTransport_eConnectionOriented)
+   {
+      return ((pSocket->bSocketSendPending == TRUE) && CHECK_SEND_RW(pSocket)) ||
+             (pSocket->bSocketRRPending == TRUE)     ||
+             (pSocket->bSocketRNRPending == TRUE)    ||
+             (pSocket->bSocketAcceptPending == TRUE) ||
+             (pSocket->bSocketConnectPending == TRUE)||
+             (pSocket->bSocketDiscPending == TRUE);
+   }
+   else if (pSocket->eSocket_Type == phFriNfc_LlcpTransport_eConnectionLess)
+   {
+      return (pSocket->pfSocketSend_Cb != NULL);
+   }
+   return FALSE;
+}
+
+
+void phFriNfc_LlcpTransport_ScheduleSocket(phFriNfc_LlcpTransport_Socket_t  *pLlcpSocket)
+{
+   phFriNfc_LlcpTransport_t   *psTransport = pLlcpSocket->psTransport;
+   uint8_t                    nPriority = (uint8_t)pLlcpSocket->ePriority;
+
+   /* Test and append under the same lock, so that a socket scheduled from */
+   /* two threads at once is only queued once                              */
+   pthread_mutex_lock(&psTransport->mutex);
+
+   if ((pLlcpSocket->bSocketReady == TRUE) ||
+       !phFriNfc_LlcpTransport_IsSocketReady(pLlcpSocket))
+   {
+      /* Already queued or nothing to send */
+      pthread_mutex_unlock(&psTransport->mutex);
+      return;
+   }
+
+   /* Append the socket to the ready queue of its priority */
+   pLlcpSocket->bSocketReady = TRUE;
+   pLlcpSocket->nNextReady   = PHFRINFC_LLCP_SCHED_NONE;
+   pLlcpSocket->nReadyTime   = phOsalNfc_GetTime();
+   if (psTransport->nReadyTail[nPriority] == PHFRINFC_LLCP_SCHED_NONE)
+   {
+      psTransport->nReadyHead[nPriority] = pLlcpSocket->index;
+   }
+   else
+   {
+      psTransport->pSocketTable[psTransport->nReadyTail[nPriority]].nNextReady = pLlcpSocket->index;
+   }
+   psTransport->nReadyTail[nPriority] = pLlcpSocket->index;
+
+   pthread_mutex_unlock(&psTransport->mutex);
+}
+
+
+static void phFriNfc_LlcpTransport_ResetSchedCredits(phFriNfc_LlcpTransport_t *psTransport)
+{
+   psTransport->nReadyCredits[phFriNfc_LlcpTransport_ePriorityHigh]   = NXP_LLCP_SCHED_WEIGHT_HIGH;
+   psTransport->nReadyCredits[phFriNfc_LlcpTransport_ePriorityNormal] = NXP_LLCP_SCHED_WEIGHT_NORMAL;
+   psTransport->nReadyCredits[phFriNfc_LlcpTransport_ePriorityLow]    = NXP_LLCP_SCHED_WEIGHT_LOW;
+}
+
+
+static phFriNfc_LlcpTransport_Socket_t* phFriNfc_LlcpTransport_NextReadySocket(phFriNfc_LlcpTransport_t *psTransport)
+{
+   phFriNfc_LlcpTransport_Socket_t  *pSocket = NULL;
+   uint8_t                          nPriority;
+   uint8_t                          nPass;
+   uint32_t                         nDelay;
+
+   pthread_mutex_lock(&psTransport->mutex);
+
+   /* Take the head of the highest priority queue having credits left, */
+   /* credits are given back once all the ready queues have used them  */
+   for (nPass = 0; (nPass < 2) && (pSocket == NULL); nPass++)
+   {
+      for (nPriority = 0; nPriority < phFriNfc_LlcpTransport_ePriorityNb; nPriority++)
+      {
+         if ((psTransport->nReadyHead[nPriority] != PHFRINFC_LLCP_SCHED_NONE) &&
+             (psTransport->nReadyCredits[nPriority] > 0))
+         {
+            pSocket = &psTransport->pSocketTable[psTransport->nReadyHead[nPriority]];
+            psTransport->nReadyCredits[nPriority]--;
+
+            /* Remove the socket from the queue */
+            psTransport->nReadyHead[nPriority] = pSocket->nNextReady;
+            if (psTransport->nReadyHead[nPriority] == PHFRINFC_LLCP_SCHED_NONE)
+            {
+               psTransport->nReadyTail[nPriority] = PHFRINFC_LLCP_SCHED_NONE;
+            }
+            pSocket->bSocketReady = FALSE;
+            pSocket->nNextReady   = PHFRINFC_LLCP_SCHED_NONE;
+            break;
+         }
+      }
+      if (pSocket == NULL)
+      {
+         phFriNfc_LlcpTransport_ResetSchedCredits(psTransport);
+      }
+   }
+
+   pthread_mutex_unlock(&psTransport->mutex);
+
+   if (pSocket != NULL)
+   {
+      /* Update the queueing delay of the socket */
+      nDelay = phOsalNfc_GetTime() - pSocket->nReadyTime;
+      pSocket->sSchedStats.nScheduled++;
+      pSocket->sSchedStats.nTotalDelay += nDelay;
+      if (nDelay > pSocket->sSchedStats.nMaxDelay)
+      {
+         pSocket->sSchedStats.nMaxDelay = nDelay;
+      }
+   }
+
+   return pSocket;
+}
+
+
+/**
+* \ingroup grp_fri_nfc
+* \brief <b>Free the tables allocated by the transport</b>.
+*
+* Frees the cached service names, the service name and the receive window
+* buffer table of each socket, then the socket table and the SDP cache. The
+* transport has to be reset again before it is used.
+*
+* \param[in]  pLlcpTransport        A pointer to a phFriNfc_LlcpTransport_t.
+*/
+void phFriNfc_LlcpTransport_Release (phFriNfc_LlcpTransport_t  *pLlcpTransport)
+{
+   uint8_t i;
+
+   /* Free the cached names first, the sockets then own all their names */
+   phFriNfc_LlcpTransport_ClearCachedNames(pLlcpTransport);
+
+   if (pLlcpTransport->pSocketTable != NULL)
+   {
+      for(i=0;i<pLlcpTransport->nSocketTableSize;i++)
+      {
+         if (pLlcpTransport->pSocketTable[i].sServiceName.buffer != NULL)
+         {
+            phOsalNfc_FreeMemory(pLlcpTransport->pSocketTable[i].sServiceName.buffer);
+         }
+         if (pLlcpTransport->pSocketTable[i].psRwBufferPool != NULL)
+         {
+            phOsalNfc_FreeMemory(pLlcpTransport->pSocketTable[i].psRwBufferPool);
+         }
+      }
+      phOsalNfc_FreeMemory(pLlcpTransport->pSocketTable);
+      pLlcpTransport->pSocketTable = NULL;
+   }
+   pLlcpTransport->nSocketTableSize = 0;
+
+   if (pLlcpTransport->pCachedServiceNames != NULL)
    {
-      /* Modulo-increment index */
-      index = (index + 1) % PHFRINFC_LLCP_NB_SOCKET_MAX;
+      phOsalNfc_FreeMemory(pLlcpTransport->pCachedServiceNames);
+      pLlcpTransport->pCachedServiceNames = NULL;
+   }
+   pLlcpTransport->nCachedServiceNamesSize = 0;
+}
 
-      pCurrentSocket = &psTransport->pSocketTable[index];
 
-      /* Dispatch to the corresponding transport layer */
-      if (pCurrentSocket->eSocket_Type == phFriNfc_LlcpTransport_eConnectionOriented)
+static NFCSTATUS phFriNfc_LlcpTransport_AllocTables (phFriNfc_LlcpTransport_t                  *pLlcpTransport,
+                                                     const phFriNfc_LlcpTransport_sConfig_t    *psConfig)
+{
+   uint8_t nSocketTableSize = PHFRINFC_LLCP_NB_SOCKET_MAX;
+   uint8_t nCachedServiceNamesSize = PHFRINFC_LLCP_SDP_ADVERTISED_NB;
+
+   /* Get the table sizes from the configuration */
+   if ((psConfig != NULL) && (psConfig->nSocketTableSize != 0))
+   {
+      nSocketTableSize = psConfig->nSocketTableSize;
+      if (nSocketTableSize > PHFRINFC_LLCP_NB_SOCKET_LIMIT)
       {
-         result = phFriNfc_LlcpTransport_ConnectionOriented_HandlePendingOperations(pCurrentSocket);
+         nSocketTableSize = PHFRINFC_LLCP_NB_SOCKET_LIMIT;
       }
-      else if (pCurrentSocket->eSocket_Type == phFriNfc_LlcpTransport_eConnectionLess)
+   }
+   if ((psConfig != NULL) && (psConfig->nCachedServiceNamesSize != 0))
+   {
+      /* NOTE: there cannot be more cached names than SDP advertised SAPs */
+      nCachedServiceNamesSize = psConfig->nCachedServiceNamesSize;
+      if (nCachedServiceNamesSize > PHFRINFC_LLCP_SDP_ADVERTISED_NB)
       {
-         result = phFriNfc_LlcpTransport_Connectionless_HandlePendingOperations(pCurrentSocket);
+         nCachedServiceNamesSize = PHFRINFC_LLCP_SDP_ADVERTISED_NB;
       }
+   }
 
-      if (result != NFCSTATUS_FAILED)
+   /* Keep the current tables if their size is unchanged */
+   if ((pLlcpTransport->pSocketTable != NULL) &&
+       (pLlcpTransport->nSocketTableSize == nSocketTableSize) &&
+       (pLlcpTransport->pCachedServiceNames != NULL) &&
+       (pLlcpTransport->nCachedServiceNamesSize == nCachedServiceNamesSize))
+   {
+      return NFCSTATUS_SUCCESS;
+   }
+   phFriNfc_LlcpTransport_Release(pLlcpTransport);
+
+   pLlcpTransport->pSocketTable = (phFriNfc_LlcpTransport_Socket_t*)phOsalNfc_GetMemory(
+                                     nSocketTableSize * sizeof(phFriNfc_LlcpTransport_Socket_t));
+   pLlcpTransport->pCachedServiceNames = (phFriNfc_Llcp_CachedServiceName_t*)phOsalNfc_GetMemory(
+                                     nCachedServiceNamesSize * sizeof(phFriNfc_Llcp_CachedServiceName_t));
+   if ((pLlcpTransport->pSocketTable == NULL) || (pLlcpTransport->pCachedServiceNames == NULL))
+   {
+      if (pLlcpTransport->pSocketTable != NULL)
       {
-         /* Stop looping if pending operation has been found */
-         break;
+         phOsalNfc_FreeMemory(pLlcpTransport->pSocketTable);
+         pLlcpTransport->pSocketTable = NULL;
+      }
+      if (pLlcpTransport->pCachedServiceNames != NULL)
+      {
+         phOsalNfc_FreeMemory(pLlcpTransport->pCachedServiceNames);
+         pLlcpTransport->pCachedServiceNames = NULL;
       }
+      return PHNFCSTVAL(CID_FRI_NFC_LLCP_TRANSPORT, NFCSTATUS_INSUFFICIENT_RESOURCES);
+   }
+   memset(pLlcpTransport->pSocketTable, 0x00, nSocketTableSize * sizeof(phFriNfc_LlcpTransport_Socket_t));
+   memset(pLlcpTransport->pCachedServiceNames, 0x00, nCachedServiceNamesSize * sizeof(phFriNfc_Llcp_CachedServiceName_t));
+   pLlcpTransport->nSocketTableSize = nSocketTableSize;
+   pLlcpTransport->nCachedServiceNamesSize = nCachedServiceNamesSize;
 
-   } while(index != psTransport->socketIndex);
+   return NFCSTATUS_SUCCESS;
 }
 
 
 /* TODO: comment function Transport reset */
-NFCSTATUS phFriNfc_LlcpTransport_Reset (phFriNfc_LlcpTransport_t      *pLlcpTransport,
-                                        phFriNfc_Llcp_t               *pLlcp)
+NFCSTATUS phFriNfc_LlcpTransport_Reset (phFriNfc_LlcpTransport_t                  *pLlcpTransport,
+                                        phFriNfc_Llcp_t                           *pLlcp,
+                                        const phFriNfc_LlcpTransport_sConfig_t    *psConfig)
 {
    NFCSTATUS status = NFCSTATUS_SUCCESS;
    uint8_t i;
@@ -660,6 +1348,11 @@ NFCSTATUS phFriNfc_LlcpTransport_Reset (phFriNfc_LlcpTransport_t      *pLlcpTran
    {
       status = PHNFCSTVAL(CID_FRI_NFC_LLCP_TRANSPORT, NFCSTATUS_INVALID_PARAMETER);
    }
+   /* Allocate the socket table and the SDP cache */
+   else if((status = phFriNfc_LlcpTransport_AllocTables(pLlcpTransport, psConfig)) != NFCSTATUS_SUCCESS)
+   {
+      /* Not enough memory for the configured tables */
+   }
    else
    {
       /* Reset Transport structure */ 
@@ -672,12 +1365,35 @@ NFCSTATUS phFriNfc_LlcpTransport_Reset (phFriNfc_LlcpTransport_t      *pLlcpTran
       pLlcpTransport->socketIndex      = FALSE;
       pLlcpTransport->LinkStatusError  = 0;
       pLlcpTransport->pfDiscover_Cb    = NULL;
+#ifdef NXP_LLCP_AGF_SEND
+      pLlcpTransport->nDeferredSends   = 0;
+      phFriNfc_Llcp_SetSendTurnCb(pLlcp, phFriNfc_LlcpTransport_SendTurn_CB, pLlcpTransport);
+#endif /* #ifdef NXP_LLCP_AGF_SEND */
+
+      /* Empty the ready queues */
+      for(i=0;i<phFriNfc_LlcpTransport_ePriorityNb;i++)
+      {
+         pLlcpTransport->nReadyHead[i] = PHFRINFC_LLCP_SCHED_NONE;
+         pLlcpTransport->nReadyTail[i] = PHFRINFC_LLCP_SCHED_NONE;
+      }
+      phFriNfc_LlcpTransport_ResetSchedCredits(pLlcpTransport);
 
       /* Initialize cached service name/sap table */
-      memset(pLlcpTransport->pCachedServiceNames, 0x00, sizeof(phFriNfc_Llcp_CachedServiceName_t)*PHFRINFC_LLCP_SDP_ADVERTISED_NB);
+      phFriNfc_LlcpTransport_ClearCachedNames(pLlcpTransport);
+
+      /* Forget the remote SAPs */
+      memset(pLlcpTransport->sRemoteSaps, 0x00, sizeof(pLlcpTransport->sRemoteSaps));
+      pLlcpTransport->nRemoteSapTtl = PHFRINFC_LLCP_REMOTE_SAP_TTL;
+      if ((psConfig != NULL) && (psConfig->nRemoteSapTtl != 0))
+      {
+         pLlcpTransport->nRemoteSapTtl = psConfig->nRemoteSapTtl;
+      }
+
+      /* Empty the service name registry */
+      phFriNfc_LlcpTransport_ResetServiceNames(pLlcpTransport);
 
       /* Reset all the socket info in the table */
-      for(i=0;i<PHFRINFC_LLCP_NB_SOCKET_MAX;i++)
+      for(i=0;i<pLlcpTransport->nSocketTableSize;i++)
       {
          pLlcpTransport->pSocketTable[i].eSocket_State                  = phFriNfc_LlcpTransportSocket_eSocketDefault;
          pLlcpTransport->pSocketTable[i].eSocket_Type                   = phFriNfc_LlcpTransport_eDefaultType;
@@ -706,6 +1422,9 @@ NFCSTATUS phFriNfc_LlcpTransport_Reset (phFriNfc_LlcpTransport_t      *pLlcpTran
          pLlcpTransport->pSocketTable[i].bSocketAcceptPending           = FALSE;
          pLlcpTransport->pSocketTable[i].bSocketRRPending               = FALSE;
          pLlcpTransport->pSocketTable[i].bSocketRNRPending              = FALSE;
+         pLlcpTransport->pSocketTable[i].ePriority                      = phFriNfc_LlcpTransport_ePriorityNormal;
+         pLlcpTransport->pSocketTable[i].bSocketReady                   = FALSE;
+         pLlcpTransport->pSocketTable[i].nNextReady                     = PHFRINFC_LLCP_SCHED_NONE;
          pLlcpTransport->pSocketTable[i].psTransport                    = pLlcpTransport;
          pLlcpTransport->pSocketTable[i].pfSocketSend_Cb                = NULL;
          pLlcpTransport->pSocketTable[i].pfSocketRecv_Cb                = NULL;
@@ -724,14 +1443,21 @@ NFCSTATUS phFriNfc_LlcpTransport_Reset (phFriNfc_LlcpTransport_t      *pLlcpTran
          pLlcpTransport->pSocketTable[i].index                          = 0;
          pLlcpTransport->pSocketTable[i].indexRwRead                    = 0;
          pLlcpTransport->pSocketTable[i].indexRwWrite                   = 0;
+         pLlcpTransport->pSocketTable[i].sSocketRwBufferTable           = &pLlcpTransport->pSocketTable[i].sSocketRwBuffer;
 
          memset(&pLlcpTransport->pSocketTable[i].sSocketOption, 0x00, sizeof(phFriNfc_LlcpTransport_sSocketOptions_t));
+         memset(&pLlcpTransport->pSocketTable[i].sSchedStats, 0x00, sizeof(phFriNfc_LlcpTransport_sSocketSchedStats_t));
+         memset(&pLlcpTransport->pSocketTable[i].sRecvStats, 0x00, sizeof(phFriNfc_LlcpTransport_sSocketRecvStats_t));
 
          if (pLlcpTransport->pSocketTable[i].sServiceName.buffer != NULL) {
             phOsalNfc_FreeMemory(pLlcpTransport->pSocketTable[i].sServiceName.buffer);
          }
          pLlcpTransport->pSocketTable[i].sServiceName.buffer = NULL;
          pLlcpTransport->pSocketTable[i].sServiceName.length = 0;
+         pLlcpTransport->pSocketTable[i].bServiceNameIndexed = FALSE;
+         pLlcpTransport->pSocketTable[i].nNextServiceName = PHFRINFC_LLCP_SN_NONE;
+         pLlcpTransport->pSocketTable[i].nRemoteSapEntry = PHFRINFC_LLCP_SN_NONE;
+         pLlcpTransport->pSocketTable[i].bRemoteSapCached = FALSE;
       }
 
       /* Start The Receive Loop */
@@ -746,7 +1472,6 @@ NFCSTATUS phFriNfc_LlcpTransport_Reset (phFriNfc_LlcpTransport_t      *pLlcpTran
 NFCSTATUS phFriNfc_LlcpTransport_CloseAll (phFriNfc_LlcpTransport_t *pLlcpTransport)
 {
    NFCSTATUS                           status = NFCSTATUS_SUCCESS;
-   phFriNfc_Llcp_CachedServiceName_t * pCachedServiceName;
    uint8_t                             i;
 
    /* Check for NULL pointers */
@@ -756,7 +1481,7 @@ NFCSTATUS phFriNfc_LlcpTransport_CloseAll (phFriNfc_LlcpTransport_t *pLlcpTransp
    }
 
    /* Close all sockets */
-   for(i=0;i<PHFRINFC_LLCP_NB_SOCKET_MAX;i++)
+   for(i=0;i<pLlcpTransport->nSocketTableSize;i++)
    {
       if(pLlcpTransport->pSocketTable[i].eSocket_Type == phFriNfc_LlcpTransport_eConnectionOriented)
       {
@@ -782,18 +1507,10 @@ NFCSTATUS phFriNfc_LlcpTransport_CloseAll (phFriNfc_LlcpTransport_t *pLlcpTransp
    }
 
    /* Reset cached service name/sap table */
-   for(i=0;i<PHFRINFC_LLCP_SDP_ADVERTISED_NB;i++)
-   {
-      pCachedServiceName = &pLlcpTransport->pCachedServiceNames[i];
+   phFriNfc_LlcpTransport_ClearCachedNames(pLlcpTransport);
 
-      pCachedServiceName->nSap = 0;
-      if (pCachedServiceName->sServiceName.buffer != NULL)
-      {
-         phOsalNfc_FreeMemory(pCachedServiceName->sServiceName.buffer);
-         pCachedServiceName->sServiceName.buffer = NULL;
-      }
-      pCachedServiceName->sServiceName.length = 0;
-   }
+   /* The link session is over */
+   phFriNfc_LlcpTransport_EndRemoteSapSession(pLlcpTransport);
 
    return status;
 }
@@ -853,7 +1570,7 @@ NFCSTATUS phFriNfc_LlcpTransport_SendFrameReject(phFriNfc_LlcpTransport_t
    uint8_t     socketFound = FALSE;
 
    /* Search a socket waiting for a FRAME */
-   for(index=0;index<PHFRINFC_LLCP_NB_SOCKET_MAX;index++)
+   for(index=0;index<psTransport->nSocketTableSize;index++)
    {
       /* Test if the socket is in connected state and if its SSAP and DSAP are valid */
       if(psTransport->pSocketTable[index].socket_sSap == dsap
@@ -1071,6 +1788,258 @@ NFCSTATUS phFriNfc_LlcpTransport_SocketGetRemoteOptions(phFriNfc_LlcpTransport_S
 }
 
 
+/**
+* \ingroup grp_fri_nfc
+* \brief <b>Set the scheduling priority of a socket</b>.
+*
+* The ready sockets of each priority are served in turn, up to the weight of
+* the priority, before the ready sockets of the lower priorities.
+*
+* \param[in]  pLlcpSocket           A pointer to a phFriNfc_LlcpTransport_Socket_t.
+* \param[in]  ePriority             The scheduling priority of the socket.
+*
+* \retval NFCSTATUS_SUCCESS                  Operation successful.
+* \retval NFCSTATUS_INVALID_PARAMETER        One or more of the supplied parameters
+*                                            could not be properly interpreted.
+*/
+NFCSTATUS phFriNfc_LlcpTransport_SetSocketPriority(phFriNfc_LlcpTransport_Socket_t            *pLlcpSocket,
+                                                   phFriNfc_LlcpTransport_eSocketPriority_t   ePriority)
+{
+   NFCSTATUS status = NFCSTATUS_SUCCESS;
+
+   /* Check for NULL pointers */
+   if (pLlcpSocket == NULL || ePriority >= phFriNfc_LlcpTransport_ePriorityNb)
+   {
+      status = PHNFCSTVAL(CID_FRI_NFC_LLCP_TRANSPORT, NFCSTATUS_INVALID_PARAMETER);
+   }
+   else
+   {
+      /* NOTE: a socket already queued keeps its place until its next send turn */
+      pLlcpSocket->ePriority = ePriority;
+   }
+
+   return status;
+}
+
+
+/**
+* \ingroup grp_fri_nfc
+* \brief <b>Get the scheduling statistics of a socket</b>.
+*
+* \param[in]  pLlcpSocket           A pointer to a phFriNfc_LlcpTransport_Socket_t.
+* \param[out] psStats               A pointer to be filled with the queueing delays of the socket.
+*
+* \retval NFCSTATUS_SUCCESS                  Operation successful.
+* \retval NFCSTATUS_INVALID_PARAMETER        One or more of the supplied parameters
+*                                            could not be properly interpreted.
+*/
+NFCSTATUS phFriNfc_LlcpTransport_GetSocketSchedStats(phFriNfc_LlcpTransport_Socket_t              *pLlcpSocket,
+                                                     phFriNfc_LlcpTransport_sSocketSchedStats_t   *psStats)
+{
+   NFCSTATUS status = NFCSTATUS_SUCCESS;
+
+   /* Check for NULL pointers */
+   if (pLlcpSocket == NULL || psStats == NULL)
+   {
+      status = PHNFCSTVAL(CID_FRI_NFC_LLCP_TRANSPORT, NFCSTATUS_INVALID_PARAMETER);
+   }
+   else
+   {
+      memcpy(psStats, &pLlcpSocket->sSchedStats, sizeof(phFriNfc_LlcpTransport_sSocketSchedStats_t));
+   }
+
+   return status;
+}
+
+
+/**
+* \ingroup grp_fri_nfc
+* \brief <b>Set up the table of receive window buffers of a socket</b>.
+*
+* A receive window of one buffer uses the descriptor embedded in the socket.
+* A larger table is allocated only when nRw exceeds the one already kept with
+* the socket slot, which is reused until the transport is released.
+*
+* \param[in]  pLlcpSocket           A pointer to a phFriNfc_LlcpTransport_Socket_t.
+* \param[in]  nRw                   The receive window size of the socket.
+*
+* \retval NFCSTATUS_SUCCESS                  Operation successful.
+* \retval NFCSTATUS_INSUFFICIENT_RESOURCES   The table could not be allocated.
+*/
+NFCSTATUS phFriNfc_LlcpTransport_AllocRwBufferTable(phFriNfc_LlcpTransport_Socket_t  *pLlcpSocket,
+                                                    uint8_t                          nRw)
+{
+   phNfc_sData_t  *psRwBufferPool;
+
+   if (nRw <= 1)
+   {
+      /* A single buffer is embedded in the socket */
+      pLlcpSocket->sSocketRwBufferTable = &pLlcpSocket->sSocketRwBuffer;
+      return NFCSTATUS_SUCCESS;
+   }
+
+   if (nRw > pLlcpSocket->nRwBufferPoolSize)
+   {
+      /* Grow the table kept with the socket slot */
+      psRwBufferPool = (phNfc_sData_t*)phOsalNfc_GetMemory(nRw * sizeof(phNfc_sData_t));
+      if (psRwBufferPool == NULL)
+      {
+         return PHNFCSTVAL(CID_FRI_NFC_LLCP_TRANSPORT, NFCSTATUS_INSUFFICIENT_RESOURCES);
+      }
+      if (pLlcpSocket->psRwBufferPool != NULL)
+      {
+         phOsalNfc_FreeMemory(pLlcpSocket->psRwBufferPool);
+      }
+      pLlcpSocket->psRwBufferPool = psRwBufferPool;
+      pLlcpSocket->nRwBufferPoolSize = nRw;
+   }
+   memset(pLlcpSocket->psRwBufferPool, 0x00, nRw * sizeof(phNfc_sData_t));
+   pLlcpSocket->sSocketRwBufferTable = pLlcpSocket->psRwBufferPool;
+
+   return NFCSTATUS_SUCCESS;
+}
+
+
+/**
+* \ingroup grp_fri_nfc
+* \brief <b>Get the memory used by a socket</b>.
+*
+* \param[in]  pLlcpSocket           A pointer to a phFriNfc_LlcpTransport_Socket_t.
+* \param[out] psMemory              A pointer to be filled with the memory used by the socket.
+*
+* \retval NFCSTATUS_SUCCESS                  Operation successful.
+* \retval NFCSTATUS_INVALID_PARAMETER        One or more of the supplied parameters
+*                                            could not be properly interpreted.
+*/
+NFCSTATUS phFriNfc_LlcpTransport_GetSocketMemory(phFriNfc_LlcpTransport_Socket_t          *pLlcpSocket,
+                                                 phFriNfc_LlcpTransport_sSocketMemory_t   *psMemory)
+{
+   NFCSTATUS status = NFCSTATUS_SUCCESS;
+
+   /* Check for NULL pointers */
+   if (pLlcpSocket == NULL || psMemory == NULL)
+   {
+      status = PHNFCSTVAL(CID_FRI_NFC_LLCP_TRANSPORT, NFCSTATUS_INVALID_PARAMETER);
+   }
+   else
+   {
+      psMemory->nSocketBytes  = sizeof(phFriNfc_LlcpTransport_Socket_t);
+      psMemory->nRwTableBytes = pLlcpSocket->nRwBufferPoolSize * sizeof(phNfc_sData_t);
+      if (pLlcpSocket->eSocket_Type == phFriNfc_LlcpTransport_eConnectionOriented)
+      {
+         psMemory->nBufferBytes = pLlcpSocket->bufferSendMaxLength +
+                                  pLlcpSocket->bufferRwMaxLength +
+                                  pLlcpSocket->bufferLinearLength;
+      }
+      else if (pLlcpSocket->eSocket_Type == phFriNfc_LlcpTransport_eConnectionLess)
+      {
+         /* NOTE: the extra byte is used to store SSAP */
+         psMemory->nBufferBytes = pLlcpSocket->localRW *
+                                  (pLlcpSocket->psTransport->pLlcp->sLocalParams.miu + 1);
+      }
+      else
+      {
+         psMemory->nBufferBytes = 0;
+      }
+   }
+
+   return status;
+}
+
+
+/**
+* \ingroup grp_fri_nfc
+* \brief <b>Get the receive statistics of a socket</b>.
+*
+* \param[in]  pLlcpSocket           A pointer to a phFriNfc_LlcpTransport_Socket_t.
+* \param[out] psStats               A pointer to be filled with the I frames received by the socket.
+*
+* \retval NFCSTATUS_SUCCESS                  Operation successful.
+* \retval NFCSTATUS_INVALID_PARAMETER        One or more of the supplied parameters
+*                                            could not be properly interpreted.
+*/
+NFCSTATUS phFriNfc_LlcpTransport_GetSocketRecvStats(phFriNfc_LlcpTransport_Socket_t             *pLlcpSocket,
+                                                    phFriNfc_LlcpTransport_sSocketRecvStats_t   *psStats)
+{
+   NFCSTATUS status = NFCSTATUS_SUCCESS;
+
+   /* Check for NULL pointers */
+   if (pLlcpSocket == NULL || psStats == NULL)
+   {
+      status = PHNFCSTVAL(CID_FRI_NFC_LLCP_TRANSPORT, NFCSTATUS_INVALID_PARAMETER);
+   }
+   else
+   {
+      memcpy(psStats, &pLlcpSocket->sRecvStats, sizeof(phFriNfc_LlcpTransport_sSocketRecvStats_t));
+   }
+
+   return status;
+}
+
+
+/**
+* \ingroup grp_fri_nfc
+* \brief <b>Get the socket options of a bulk transfer</b>.
+*
+* This function gives the largest MIU, up to the local link MIU, and RW, up to
+* PHFRINFC_LLCP_RW_MAX, that a connection-oriented socket can use with a working
+* buffer of the given length. Giving the socket (rw + 1) * miu bytes of it leaves
+* no linear buffer, so that the I frames are received straight into the receive
+* buffer of the application or into the receive window buffers.
+*
+* \param[in]  psTransport           A pointer to a phFriNfc_LlcpTransport_t.
+* \param[in]  nWorkingBufferLength  The length of the working buffer of the socket.
+* \param[out] psOptions             A pointer to be filled with the socket options.
+*
+* \retval NFCSTATUS_SUCCESS                  Operation successful.
+* \retval NFCSTATUS_INVALID_PARAMETER        One or more of the supplied parameters
+*                                            could not be properly interpreted.
+* \retval NFCSTATUS_BUFFER_TOO_SMALL         The working buffer cannot hold a send
+*                                            buffer and a receive window of default MIU.
+*/
+NFCSTATUS phFriNfc_LlcpTransport_GetBulkSocketOptions(phFriNfc_LlcpTransport_t                  *psTransport,
+                                                      uint32_t                                  nWorkingBufferLength,
+                                                      phFriNfc_LlcpTransport_sSocketOptions_t   *psOptions)
+{
+   uint32_t miu;
+   uint32_t rw;
+
+   /* Check for NULL pointers */
+   if ((psTransport == NULL) || (psTransport->pLlcp == NULL) || (psOptions == NULL))
+   {
+      return PHNFCSTVAL(CID_FRI_NFC_LLCP_TRANSPORT, NFCSTATUS_INVALID_PARAMETER);
+   }
+
+   /* Start from the local link MIU */
+   miu = psTransport->pLlcp->sLocalParams.miu;
+   if (miu > PHFRINFC_LLCP_MIU_MAX)
+   {
+      miu = PHFRINFC_LLCP_MIU_MAX;
+   }
+
+   /* The working buffer holds the send buffer and RW receive buffers */
+   if ((nWorkingBufferLength / miu) < 2)
+   {
+      /* Keep a receive window of one frame with a smaller MIU */
+      miu = nWorkingBufferLength / 2;
+      if (miu < PHFRINFC_LLCP_MIU_DEFAULT)
+      {
+         return PHNFCSTVAL(CID_FRI_NFC_LLCP_TRANSPORT, NFCSTATUS_BUFFER_TOO_SMALL);
+      }
+   }
+   rw = (nWorkingBufferLength / miu) - 1;
+   if (rw > PHFRINFC_LLCP_RW_MAX)
+   {
+      rw = PHFRINFC_LLCP_RW_MAX;
+   }
+
+   psOptions->miu = (uint16_t)miu;
+   psOptions->rw  = (uint8_t)rw;
+
+   return NFCSTATUS_SUCCESS;
+}
+
+
 static NFCSTATUS phFriNfc_LlcpTransport_DiscoverServicesEx(phFriNfc_LlcpTransport_t *psTransport)
 {
    NFCSTATUS         result = NFCSTATUS_PENDING;
@@ -1088,12 +2057,20 @@ static NFCSTATUS phFriNfc_LlcpTransport_DiscoverServicesEx(phFriNfc_LlcpTranspor
 
       /* Prepare the info buffer */
       sInfoBuffer.buffer = psTransport->pDiscoveryBuffer;
-      sInfoBuffer.length = sizeof(psTransport->pDiscoveryBuffer);
+      sInfoBuffer.length = phFriNfc_LlcpTransport_GetSnlLength(psTransport);
 
       /* Encode as many requests as possible */
       nTlvOffset = 0;
       while(psTransport->nDiscoveryReqOffset < psTransport->nDiscoveryListSize)
       {
+         if (psTransport->nDiscoveryResolved[psTransport->nDiscoveryReqOffset >> 3] &
+             (1 << (psTransport->nDiscoveryReqOffset & 0x07)))
+         {
+            /* Already known for this peer */
+            psTransport->nDiscoveryReqOffset++;
+            continue;
+         }
+
          /* Get current service name and try to encode it in SNL frame */
          psServiceName = &psTransport->psDiscoveryServiceNameList[psTransport->nDiscoveryReqOffset];
          result = phFriNfc_LlcpTransport_EncodeSdreqTlv(&sInfoBuffer,
@@ -1115,6 +2092,13 @@ static NFCSTATUS phFriNfc_LlcpTransport_DiscoverServicesEx(phFriNfc_LlcpTranspor
       /* Update buffer length to match real TLV size */
       sInfoBuffer.length = nTlvOffset;
 
+      if (nTlvOffset == 0)
+      {
+         /* Nothing left to ask */
+         clearSendPending(psTransport);
+         return NFCSTATUS_PENDING;
+      }
+
       /* Send SNL frame */
       result =  phFriNfc_Llcp_Send(psTransport->pLlcp,
                                    &psTransport->sLlcpHeader,
@@ -1142,7 +2126,10 @@ NFCSTATUS phFriNfc_LlcpTransport_DiscoverServices( phFriNfc_LlcpTransport_t  *pL
                                                    pphFriNfc_Cr_t            pDiscover_Cb,
                                                    void                      *pContext )
 {
-   NFCSTATUS         result = NFCSTATUS_FAILED;
+   NFCSTATUS                           result = NFCSTATUS_FAILED;
+   phFriNfc_LlcpTransport_RemoteSap_t  *psEntry;
+   phNfc_sData_t                       sPeerId;
+   uint8_t                             i;
 
    /* Save request details */
    pLlcpTransport->psDiscoveryServiceNameList = psServiceNameList;
@@ -1154,6 +2141,31 @@ NFCSTATUS phFriNfc_LlcpTransport_DiscoverServices( phFriNfc_LlcpTransport_t  *pL
    /* Reset internal counters */
    pLlcpTransport->nDiscoveryReqOffset = 0;
    pLlcpTransport->nDiscoveryResOffset = 0;
+   memset(pLlcpTransport->nDiscoveryResolved, 0x00, sizeof(pLlcpTransport->nDiscoveryResolved));
+
+   /* Answer from the SAPs learnt in the previous link sessions with this peer */
+   if (phFriNfc_LlcpTransport_GetPeerId(pLlcpTransport, &sPeerId))
+   {
+      for (i=0 ; i<nListSize ; i++)
+      {
+         psEntry = phFriNfc_LlcpTransport_FindRemoteSap(pLlcpTransport, &sPeerId, &psServiceNameList[i]);
+         if ((psEntry != NULL) && (psEntry->nSap != 0))
+         {
+            pnSapList[i] = psEntry->nSap;
+            pLlcpTransport->nDiscoveryResolved[i >> 3] |= (1 << (i & 0x07));
+            pLlcpTransport->nDiscoveryResOffset++;
+         }
+      }
+   }
+
+   if (pLlcpTransport->nDiscoveryResOffset >= nListSize)
+   {
+      /* Everything known, no SNL round trip */
+      pLlcpTransport->pfDiscover_Cb = NULL;
+      pLlcpTransport->pDiscoverContext = NULL;
+      pDiscover_Cb(pContext, NFCSTATUS_SUCCESS);
+      return NFCSTATUS_PENDING;
+   }
 
    /* Perform request */
    result = phFriNfc_LlcpTransport_DiscoverServicesEx(pLlcpTransport);
@@ -1254,11 +2266,16 @@ NFCSTATUS phFriNfc_LlcpTransport_Socket(phFriNfc_LlcpTransport_t
             /* Store the context of the upper layer */
             pLlcpTransport->pSocketTable[index].pContext   = pContext;
 
+            /* Schedule with the default priority */
+            pLlcpTransport->pSocketTable[index].ePriority  = phFriNfc_LlcpTransport_ePriorityNormal;
+            memset(&pLlcpTransport->pSocketTable[index].sSchedStats, 0x00, sizeof(phFriNfc_LlcpTransport_sSocketSchedStats_t));
+            memset(&pLlcpTransport->pSocketTable[index].sRecvStats, 0x00, sizeof(phFriNfc_LlcpTransport_sSocketRecvStats_t));
+
             /* Set the pointers to the different working buffers */
             if (eType == phFriNfc_LlcpTransport_eConnectionOriented)
             {
                 /* Test the socket options */
-                if (psOptions->rw > PHFRINFC_LLCP_RW_MAX)
+                if ((psOptions->rw > PHFRINFC_LLCP_RW_MAX) || (psOptions->miu > PHFRINFC_LLCP_MIU_MAX))
                 {
                     status = PHNFCSTVAL(CID_FRI_NFC_LLCP_TRANSPORT, NFCSTATUS_INVALID_PARAMETER);
                     return status;
@@ -1285,6 +2302,12 @@ NFCSTATUS phFriNfc_LlcpTransport_Socket(phFriNfc_LlcpTransport_t
                 }
 
                 /* Set the pointer and the length for the Receive Window Buffer */
+                status = phFriNfc_LlcpTransport_AllocRwBufferTable(&pLlcpTransport->pSocketTable[index],
+                                                                   pLlcpTransport->pSocketTable[index].localRW);
+                if (status != NFCSTATUS_SUCCESS)
+                {
+                    return status;
+                }
                 for(cpt=0;cpt<pLlcpTransport->pSocketTable[index].localRW;cpt++)
                 {
                     pLlcpTransport->pSocketTable[index].sSocketRwBufferTable[cpt].buffer = psWorkingBuffer->buffer + (cpt*pLlcpTransport->pSocketTable[index].sSocketOption.miu);
@@ -1327,6 +2350,12 @@ NFCSTATUS phFriNfc_LlcpTransport_Socket(phFriNfc_LlcpTransport_t
                }
 
                /* Set the pointers and the lengths for buffering */
+               status = phFriNfc_LlcpTransport_AllocRwBufferTable(&pLlcpTransport->pSocketTable[index],
+                                                                  pLlcpTransport->pSocketTable[index].localRW);
+               if (status != NFCSTATUS_SUCCESS)
+               {
+                  return status;
+               }
                for(cpt=0 ; cpt<pLlcpTransport->pSocketTable[index].localRW ; cpt++)
                {
                   pLlcpTransport->pSocketTable[index].sSocketRwBufferTable[cpt].buffer = psWorkingBuffer->buffer + (cpt*(pLlcpTransport->pLlcp->sLocalParams.miu + 1));
@@ -1349,7 +2378,7 @@ NFCSTATUS phFriNfc_LlcpTransport_Socket(phFriNfc_LlcpTransport_t
          {
             index++;
          }
-      }while(index<PHFRINFC_LLCP_NB_SOCKET_MAX);
+      }while(index<pLlcpTransport->nSocketTableSize);
       
       status = PHNFCSTVAL(CID_FRI_NFC_LLCP_TRANSPORT, NFCSTATUS_INSUFFICIENT_RESOURCES);
    }
@@ -1468,7 +2497,7 @@ NFCSTATUS phFriNfc_LlcpTransport_Bind(phFriNfc_LlcpTransport_Socket_t    *pLlcpS
       else
       {
          /* Test if the nSap it is used by another socket */
-         for(i=0;i<PHFRINFC_LLCP_NB_SOCKET_MAX;i++)
+         for(i=0;i<pLlcpSocket->psTransport->nSocketTableSize;i++)
          {
             if(pLlcpSocket->psTransport->pSocketTable[i].socket_sSap == nSap)
             {
@@ -1573,65 +2602,37 @@ static NFCSTATUS phFriNfc_LlcpTransport_RegisterName(phFriNfc_LlcpTransport_Sock
                                                      uint8_t                            nSap,
                                                      phNfc_sData_t                      *psServiceName)
 {
-   phFriNfc_LlcpTransport_t *       psTransport = pLlcpSocket->psTransport;
-   uint8_t                          index;
-   uint8_t                          bSnMatch, bSapMatch;
+   phFriNfc_LlcpTransport_t *          psTransport = pLlcpSocket->psTransport;
+   phFriNfc_Llcp_CachedServiceName_t * pCachedServiceName;
 
-   /* Check in cache if sap has been used for different service name */
-   for(index=0 ; index<PHFRINFC_LLCP_SDP_ADVERTISED_NB ; index++)
-   {
-      if(psTransport->pCachedServiceNames[index].sServiceName.length == 0)
-      {
-         /* Reached end of table */
-         break;
-      }
+   /* Drop the previous name of the socket */
+   phFriNfc_LlcpTransport_UnregisterName(pLlcpSocket);
 
-      bSnMatch = (memcmp(psTransport->pCachedServiceNames[index].sServiceName.buffer, psServiceName->buffer, psServiceName->length) == 0);
-      bSapMatch = psTransport->pCachedServiceNames[index].nSap == nSap;
-      if(bSnMatch && bSapMatch)
+   /* Handle service with no name */
+   if (psServiceName != NULL)
+   {
+      /* Check in cache if sap has been used for different service name */
+      pCachedServiceName = phFriNfc_LlcpTransport_FindCachedName(psTransport, psServiceName);
+      if (pCachedServiceName != NULL)
       {
-         /* Request match cache */
-         break;
+         if (pCachedServiceName->nSap != nSap)
+         {
+            /* Request mismatch with cache */
+            return NFCSTATUS_INVALID_PARAMETER;
+         }
       }
-      else if((bSnMatch && !bSapMatch) || (!bSnMatch && bSapMatch))
+      else if ((nSap < PHFRINFC_LLCP_SAP_NUMBER) &&
+               (psTransport->nCachedSapIndex[nSap] != PHFRINFC_LLCP_SN_NONE))
       {
          /* Request mismatch with cache */
          return NFCSTATUS_INVALID_PARAMETER;
       }
-   }
 
-   /* Handle service with no name */
-   if (psServiceName == NULL)
-   {
-      if (pLlcpSocket->sServiceName.buffer != NULL)
-      {
-         phOsalNfc_FreeMemory(pLlcpSocket->sServiceName.buffer);
-      }
-      pLlcpSocket->sServiceName.buffer = NULL;
-      pLlcpSocket->sServiceName.length = 0;
-   }
-   else
-   {
       /* Check if name already in use */
-      for(index=0;index<PHFRINFC_LLCP_NB_SOCKET_MAX;index++)
+      if (phFriNfc_LlcpTransport_FindServiceName(psTransport, psServiceName) != NULL)
       {
-         phFriNfc_LlcpTransport_Socket_t* pCurrentSocket = &pLlcpSocket->psTransport->pSocketTable[index];
-
-         if(   (pCurrentSocket->eSocket_State != phFriNfc_LlcpTransportSocket_eSocketBound)
-            && (pCurrentSocket->eSocket_State != phFriNfc_LlcpTransportSocket_eSocketRegistered))
-         {
-            /* Only bound or listening sockets may have a service name */
-            continue;
-         }
-         if(pCurrentSocket->sServiceName.length != psServiceName->length) {
-            /* Service name do not match, check next */
-            continue;
-         }
-         if(memcmp(pCurrentSocket->sServiceName.buffer, psServiceName->buffer, psServiceName->length) == 0)
-         {
-            /* Service name already in use */
-            return NFCSTATUS_INVALID_PARAMETER;
-         }
+         /* Service name already in use */
+         return NFCSTATUS_INVALID_PARAMETER;
       }
 
       /* Store the listen socket SN */
@@ -1639,9 +2640,13 @@ static NFCSTATUS phFriNfc_LlcpTransport_RegisterName(phFriNfc_LlcpTransport_Sock
       pLlcpSocket->sServiceName.buffer = phOsalNfc_GetMemory(psServiceName->length);
       if (pLlcpSocket->sServiceName.buffer == NULL)
       {
+          pLlcpSocket->sServiceName.length = 0;
           return NFCSTATUS_NOT_ENOUGH_MEMORY;
       }
       memcpy(pLlcpSocket->sServiceName.buffer, psServiceName->buffer, psServiceName->length);
+
+      /* Index the socket SN */
+      phFriNfc_LlcpTransport_IndexServiceName(pLlcpSocket);
    }
 
    return NFCSTATUS_SUCCESS;
@@ -1694,7 +2699,7 @@ NFCSTATUS phFriNfc_LlcpTransport_Accept(phFriNfc_LlcpTransport_Socket_t*
       status = PHNFCSTVAL(CID_FRI_NFC_LLCP_TRANSPORT, NFCSTATUS_INVALID_PARAMETER);
    }
    /* Test the socket options */
-   else if(psOptions->rw > PHFRINFC_LLCP_RW_MAX)
+   else if((psOptions->rw > PHFRINFC_LLCP_RW_MAX) || (psOptions->miu > PHFRINFC_LLCP_MIU_MAX))
    {
       status = PHNFCSTVAL(CID_FRI_NFC_LLCP_TRANSPORT, NFCSTATUS_INVALID_PARAMETER);
    }
@@ -1852,6 +2857,8 @@ NFCSTATUS phFriNfc_LlcpTransport_Connect( phFriNfc_LlcpTransport_Socket_t*
       }
       else
       {
+         pLlcpSocket->nRemoteSapEntry = PHFRINFC_LLCP_SN_NONE;
+         pLlcpSocket->bRemoteSapCached = FALSE;
          status = phFriNfc_LlcpTransport_ConnectionOriented_Connect(pLlcpSocket,
                                                                     nSap,
                                                                     NULL,
@@ -1896,6 +2903,7 @@ NFCSTATUS phFriNfc_LlcpTransport_ConnectByUri(phFriNfc_LlcpTransport_Socket_t*
    NFCSTATUS status = NFCSTATUS_SUCCESS;
    uint8_t i;
    uint8_t nLocalSap;
+   uint8_t nRemoteSap;
 
    /* Check for NULL pointers */
    if(pLlcpSocket == NULL || pConnect_RspCb == NULL || pContext == NULL)
@@ -1938,9 +2946,11 @@ NFCSTATUS phFriNfc_LlcpTransport_ConnectByUri(phFriNfc_LlcpTransport_Socket_t*
       }
       else
       {
+         /* Skip the CONNECT by name when the peer SAP is already known */
+         nRemoteSap = phFriNfc_LlcpTransport_LookupRemoteSap(pLlcpSocket, psUri);
          status = phFriNfc_LlcpTransport_ConnectionOriented_Connect(pLlcpSocket,
-                                                                    PHFRINFC_LLCP_SAP_DEFAULT,
-                                                                    psUri,
+                                                                    nRemoteSap,
+                                                                    (nRemoteSap == PHFRINFC_LLCP_SAP_DEFAULT) ? psUri : NULL,
                                                                     pConnect_RspCb,
                                                                     pContext);
       }
@@ -51,6 +51,9 @@ typedef struct phFriNfc_LlcpTransport_Socket phFriNfc_LlcpTransport_Socket_t;
 struct phFriNfc_Llcp_CachedServiceName;
 typedef struct phFriNfc_Llcp_CachedServiceName phFriNfc_Llcp_CachedServiceName_t;
 
+struct phFriNfc_LlcpTransport_RemoteSap;
+typedef struct phFriNfc_LlcpTransport_RemoteSap phFriNfc_LlcpTransport_RemoteSap_t;
+
 /*========== ENUMERATES ===========*/
 
 /* Enum reperesents the different LLCP Link status*/
@@ -165,6 +168,17 @@ struct phFriNfc_LlcpTransport_Socket
    uint8_t                                        socket_dSap;
    // TODO: copy service name (could be deallocated by upper layer)
    phNfc_sData_t                                  sServiceName;
+   /* Service name registry links */
+   uint32_t                                       nServiceNameHash;
+   uint8_t                                        nNextServiceName;
+   bool_t                                         bServiceNameIndexed;
+   /* Service name buffer owned by the SDP cache */
+   bool_t                                         bServiceNameCached;
+   /* Remote SAP entry of the service this socket connects to by name */
+   uint8_t                                        nRemoteSapEntry;
+   uint32_t                                       nRemoteSapHash;
+   /* The CONNECT was sent to a remembered SAP, without the service name */
+   bool_t                                         bRemoteSapCached;
    uint8_t                                        remoteRW;
    uint8_t                                        localRW;
    uint16_t                                       remoteMIU;
@@ -184,6 +198,16 @@ struct phFriNfc_LlcpTransport_Socket
    bool_t                                        bSocketRRPending;
    bool_t                                        bSocketRNRPending;
 
+   /* Scheduling related fields */
+   phFriNfc_LlcpTransport_eSocketPriority_t      ePriority;
+   bool_t                                        bSocketReady;
+   uint8_t                                       nNextReady;
+   uint32_t                                      nReadyTime;
+   phFriNfc_LlcpTransport_sSocketSchedStats_t    sSchedStats;
+
+   /* Receive statistics */
+   phFriNfc_LlcpTransport_sSocketRecvStats_t     sRecvStats;
+
    /* Buffers */
    phNfc_sData_t                                  sSocketSendBuffer;
    phNfc_sData_t                                  sSocketLinearBuffer;
@@ -215,8 +239,13 @@ struct phFriNfc_LlcpTransport_Socket
    pphFriNfc_LlcpTransportSocketConnectCb_t       pfSocketConnect_Cb;
    pphFriNfc_LlcpTransportSocketDisconnectCb_t    pfSocketDisconnect_Cb;
 
-   /* Table of PHFRINFC_LLCP_RW_MAX Receive Windows Buffers */
-   phNfc_sData_t                                  sSocketRwBufferTable[PHFRINFC_LLCP_RW_MAX];
+   /* Table of localRW Receive Windows Buffers */
+   phNfc_sData_t                                  *sSocketRwBufferTable;
+   /* Receive Window Buffer used when localRW is 0 or 1 */
+   phNfc_sData_t                                  sSocketRwBuffer;
+   /* Table allocated when localRW is greater than 1 */
+   phNfc_sData_t                                  *psRwBufferPool;
+   uint8_t                                        nRwBufferPoolSize;
 
    /* Pointer a the socket table */
    phFriNfc_LlcpTransport_t                       *psTransport;
@@ -239,18 +268,42 @@ struct phFriNfc_Llcp_CachedServiceName
 {
    phNfc_sData_t                         sServiceName;
    uint8_t                               nSap;
+   uint32_t                              nHash;
+   uint8_t                               nNext;
+};
+
+/**
+ * \ingroup grp_fri_nfc_llcp_mac
+ * \brief Remote SAP resolved by the SDP client, for a given peer and service name
+ */
+struct phFriNfc_LlcpTransport_RemoteSap
+{
+   uint8_t                               aPeerId[PHHAL_MAX_UID_LENGTH];
+   uint8_t                               nPeerIdLength;
+   uint8_t                               aServiceName[PHFRINFC_LLCP_REMOTE_SAP_SN_MAX];
+   uint8_t                               nServiceNameLength;
+   uint32_t                              nHash;
+   uint8_t                               nSap;        /* 0 while a CONNECT by name is in progress */
+   uint32_t                              nTimestamp;
 };
 
 
 /**
  * \ingroup grp_fri_nfc_llcp_mac
- * \brief Declaration of a TRANSPORT Type with a table of PHFRINFC_LLCP_NB_SOCKET_DEFAULT sockets
+ * \brief Declaration of a TRANSPORT Type with a table of nSocketTableSize sockets
  *        and a pointer a Llcp layer
  */
 struct phFriNfc_LlcpTransport 
 {
-   phFriNfc_LlcpTransport_Socket_t       pSocketTable[PHFRINFC_LLCP_NB_SOCKET_MAX];
-   phFriNfc_Llcp_CachedServiceName_t     pCachedServiceNames[PHFRINFC_LLCP_SDP_ADVERTISED_NB];
+   phFriNfc_LlcpTransport_Socket_t       *pSocketTable;
+   uint8_t                               nSocketTableSize;
+   phFriNfc_Llcp_CachedServiceName_t     *pCachedServiceNames;
+   uint8_t                               nCachedServiceNamesSize;
+
+   /**< Service name registry, hashed on the service names */
+   uint8_t                               nServiceNameBuckets[PHFRINFC_LLCP_SN_HASH_SIZE];
+   uint8_t                               nCachedNameBuckets[PHFRINFC_LLCP_SN_HASH_SIZE];
+   uint8_t                               nCachedSapIndex[PHFRINFC_LLCP_SAP_NUMBER];
    phFriNfc_Llcp_t                       *pLlcp;
    pthread_mutex_t                       mutex;
    bool_t                                bSendPending;
@@ -263,6 +316,19 @@ struct phFriNfc_LlcpTransport
 
    uint8_t                               socketIndex;
 
+#ifdef NXP_LLCP_AGF_SEND
+   /**< Send callbacks of the PDUs aggregated in the frame being sent */
+   phFriNfc_Llcp_LinkSend_CB_t           pfDeferredSendCb[NXP_LLCP_AGF_MAX_PDUS];
+   void                                  *pDeferredSendContext[NXP_LLCP_AGF_MAX_PDUS];
+   uint8_t                               nDeferredSendIndex[NXP_LLCP_AGF_MAX_PDUS];
+   uint8_t                               nDeferredSends;
+#endif /* #ifdef NXP_LLCP_AGF_SEND */
+
+   /**< Ready queues of the sockets, one per priority */
+   uint8_t                               nReadyHead[phFriNfc_LlcpTransport_ePriorityNb];
+   uint8_t                               nReadyTail[phFriNfc_LlcpTransport_ePriorityNb];
+   uint8_t                               nReadyCredits[phFriNfc_LlcpTransport_ePriorityNb];
+
    /**< Info field of pending FRMR packet*/
    uint8_t                               FrmrInfoBuffer[4];
    phFriNfc_Llcp_sPacketHeader_t         sLlcpHeader;
@@ -285,11 +351,17 @@ struct phFriNfc_LlcpTransport
    uint8_t                               nDiscoveryResTidList[PHFRINFC_LLCP_SNL_RESPONSE_MAX];
    uint8_t                               nDiscoveryResSapList[PHFRINFC_LLCP_SNL_RESPONSE_MAX];
    uint8_t                               nDiscoveryResListSize;
+   /**< Requests already resolved, by TID */
+   uint8_t                               nDiscoveryResolved[PHFRINFC_LLCP_SNL_RESPONSE_MAX / 8];
 
-   uint8_t                               pDiscoveryBuffer[PHFRINFC_LLCP_MIU_DEFAULT];
+   uint8_t                               pDiscoveryBuffer[PHFRINFC_LLCP_MIU_MAX];
    pphFriNfc_Cr_t                        pfDiscover_Cb;
    void                                  *pDiscoverContext;
 
+   /**< Remote SAPs learnt by the SDP client, only well-known SAPs outlive the link session */
+   phFriNfc_LlcpTransport_RemoteSap_t    sRemoteSaps[PHFRINFC_LLCP_REMOTE_SAP_CACHE_SIZE];
+   uint32_t                              nRemoteSapTtl;
+
 };
 
 /*
@@ -302,13 +374,96 @@ bool_t testAndSetSendPending(phFriNfc_LlcpTransport_t* transport);
 
 void clearSendPending(phFriNfc_LlcpTransport_t* transport);
 
+/**
+* \ingroup grp_fri_nfc
+* \brief <b>Queue a socket having a pending operation for the next send turns</b>.
+*
+* Nothing is done if the socket is already queued or has nothing to send.
+*/
+void phFriNfc_LlcpTransport_ScheduleSocket(phFriNfc_LlcpTransport_Socket_t  *pLlcpSocket);
+
+/**
+* \ingroup grp_fri_nfc
+* \brief <b>Find the bound or registered socket having a service name</b>.
+*
+*/
+phFriNfc_LlcpTransport_Socket_t* phFriNfc_LlcpTransport_FindServiceName(phFriNfc_LlcpTransport_t  *psTransport,
+                                                                        phNfc_sData_t             *psServiceName);
+
+/**
+* \ingroup grp_fri_nfc
+* \brief <b>Remove the service name of a socket from the registry and free it</b>.
+*
+*/
+void phFriNfc_LlcpTransport_UnregisterName(phFriNfc_LlcpTransport_Socket_t  *pLlcpSocket);
+
+/**
+* \ingroup grp_fri_nfc
+* \brief <b>Record the outcome of a CONNECT sent by service name</b>.
+*
+* The remote SAP is learnt from the CC frame, or forgotten (nSap = 0) when the
+* connection fails.
+*
+*/
+void phFriNfc_LlcpTransport_UpdateRemoteSap(phFriNfc_LlcpTransport_Socket_t  *pLlcpSocket,
+                                            uint8_t                          nSap);
+
+/**
+* \ingroup grp_fri_nfc
+* \brief <b>Send again a CONNECT refused on a remembered SAP, by service name</b>.
+*
+* The peer may have rebound the service since its SAP was learnt. The CONNECT is
+* then sent to the SDP SAP with the SN TLV, and the remote SAP is learnt again from
+* the CC frame. The connect callback and context of the socket are kept.
+*
+* \param[in] pLlcpSocket   A pointer to the socket which received the DM frame.
+*
+* \retval NFCSTATUS_PENDING            The CONNECT is sent again.
+* \retval NFCSTATUS_FAILED             The CONNECT was not sent to a remembered SAP,
+*                                      or it could not be sent again.
+*/
+NFCSTATUS phFriNfc_LlcpTransport_RetryConnectByName(phFriNfc_LlcpTransport_Socket_t  *pLlcpSocket);
+
+/**
+* \ingroup grp_fri_nfc
+* \brief <b>Set up the table of receive window buffers of a socket</b>.
+*
+* A receive window of one buffer uses the descriptor embedded in the socket.
+* A larger table is allocated only when nRw exceeds the one already kept with
+* the socket slot, which is reused until the transport is released.
+*
+* \param[in]  pLlcpSocket           A pointer to a phFriNfc_LlcpTransport_Socket_t.
+* \param[in]  nRw                   The receive window size of the socket.
+*
+* \retval NFCSTATUS_SUCCESS                  Operation successful.
+* \retval NFCSTATUS_INSUFFICIENT_RESOURCES   The table could not be allocated.
+*/
+NFCSTATUS phFriNfc_LlcpTransport_AllocRwBufferTable(phFriNfc_LlcpTransport_Socket_t  *pLlcpSocket,
+                                                    uint8_t                          nRw);
+
  /**
 * \ingroup grp_fri_nfc
-* \brief <b>Create a socket on a LLCP-connected device</b>.
+* \brief <b>Reset the transport and allocate its tables</b>.
+*
+* The socket table and the SDP cache are sized from psConfig (NULL for the
+* defaults), and reallocated only when the sizes change.
+*/
+NFCSTATUS phFriNfc_LlcpTransport_Reset (phFriNfc_LlcpTransport_t                  *pLlcpSocketTable,
+                                        phFriNfc_Llcp_t                           *pLlcp,
+                                        const phFriNfc_LlcpTransport_sConfig_t    *psConfig);
+
+
+/**
+* \ingroup grp_fri_nfc
+* \brief <b>Free the tables allocated by the transport</b>.
+*
+* Frees the cached service names, the service name and the receive window
+* buffer table of each socket, then the socket table and the SDP cache. The
+* transport has to be reset again before it is used.
 *
+* \param[in]  pLlcpTransport        A pointer to a phFriNfc_LlcpTransport_t.
 */
-NFCSTATUS phFriNfc_LlcpTransport_Reset (phFriNfc_LlcpTransport_t      *pLlcpSocketTable,
-                                        phFriNfc_Llcp_t               *pLlcp);
+void phFriNfc_LlcpTransport_Release (phFriNfc_LlcpTransport_t  *pLlcpTransport);
 
 
 /**
@@ -422,6 +577,94 @@ NFCSTATUS phFriNfc_LlcpTransport_SocketGetRemoteOptions(phFriNfc_LlcpTransport_S
                                                         phLibNfc_Llcp_sSocketOptions_t*    psRemoteOptions);
 
 
+/**
+* \ingroup grp_fri_nfc
+* \brief <b>Set the scheduling priority of a socket</b>.
+*
+* The ready sockets of each priority are served in turn, up to the weight of
+* the priority, before the ready sockets of the lower priorities.
+*
+* \param[in]  pLlcpSocket           A pointer to a phFriNfc_LlcpTransport_Socket_t.
+* \param[in]  ePriority             The scheduling priority of the socket.
+*
+* \retval NFCSTATUS_SUCCESS                  Operation successful.
+* \retval NFCSTATUS_INVALID_PARAMETER        One or more of the supplied parameters
+*                                            could not be properly interpreted.
+*/
+NFCSTATUS phFriNfc_LlcpTransport_SetSocketPriority(phFriNfc_LlcpTransport_Socket_t            *pLlcpSocket,
+                                                   phFriNfc_LlcpTransport_eSocketPriority_t   ePriority);
+
+
+/**
+* \ingroup grp_fri_nfc
+* \brief <b>Get the scheduling statistics of a socket</b>.
+*
+* \param[in]  pLlcpSocket           A pointer to a phFriNfc_LlcpTransport_Socket_t.
+* \param[out] psStats               A pointer to be filled with the queueing delays of the socket.
+*
+* \retval NFCSTATUS_SUCCESS                  Operation successful.
+* \retval NFCSTATUS_INVALID_PARAMETER        One or more of the supplied parameters
+*                                            could not be properly interpreted.
+*/
+NFCSTATUS phFriNfc_LlcpTransport_GetSocketSchedStats(phFriNfc_LlcpTransport_Socket_t              *pLlcpSocket,
+                                                     phFriNfc_LlcpTransport_sSocketSchedStats_t   *psStats);
+
+
+/**
+* \ingroup grp_fri_nfc
+* \brief <b>Get the memory used by a socket</b>.
+*
+* \param[in]  pLlcpSocket           A pointer to a phFriNfc_LlcpTransport_Socket_t.
+* \param[out] psMemory              A pointer to be filled with the memory used by the socket.
+*
+* \retval NFCSTATUS_SUCCESS                  Operation successful.
+* \retval NFCSTATUS_INVALID_PARAMETER        One or more of the supplied parameters
+*                                            could not be properly interpreted.
+*/
+NFCSTATUS phFriNfc_LlcpTransport_GetSocketMemory(phFriNfc_LlcpTransport_Socket_t          *pLlcpSocket,
+                                                 phFriNfc_LlcpTransport_sSocketMemory_t   *psMemory);
+
+
+/**
+* \ingroup grp_fri_nfc
+* \brief <b>Get the receive statistics of a socket</b>.
+*
+* \param[in]  pLlcpSocket           A pointer to a phFriNfc_LlcpTransport_Socket_t.
+* \param[out] psStats               A pointer to be filled with the I frames received by the socket.
+*
+* \retval NFCSTATUS_SUCCESS                  Operation successful.
+* \retval NFCSTATUS_INVALID_PARAMETER        One or more of the supplied parameters
+*                                            could not be properly interpreted.
+*/
+NFCSTATUS phFriNfc_LlcpTransport_GetSocketRecvStats(phFriNfc_LlcpTransport_Socket_t             *pLlcpSocket,
+                                                    phFriNfc_LlcpTransport_sSocketRecvStats_t   *psStats);
+
+
+/**
+* \ingroup grp_fri_nfc
+* \brief <b>Get the socket options of a bulk transfer</b>.
+*
+* This function gives the largest MIU, up to the local link MIU, and RW, up to
+* PHFRINFC_LLCP_RW_MAX, that a connection-oriented socket can use with a working
+* buffer of the given length. Giving the socket (rw + 1) * miu bytes of it leaves
+* no linear buffer, so that the I frames are received straight into the receive
+* buffer of the application or into the receive window buffers.
+*
+* \param[in]  psTransport           A pointer to a phFriNfc_LlcpTransport_t.
+* \param[in]  nWorkingBufferLength  The length of the working buffer of the socket.
+* \param[out] psOptions             A pointer to be filled with the socket options.
+*
+* \retval NFCSTATUS_SUCCESS                  Operation successful.
+* \retval NFCSTATUS_INVALID_PARAMETER        One or more of the supplied parameters
+*                                            could not be properly interpreted.
+* \retval NFCSTATUS_BUFFER_TOO_SMALL         The working buffer cannot hold a send
+*                                            buffer and a receive window of default MIU.
+*/
+NFCSTATUS phFriNfc_LlcpTransport_GetBulkSocketOptions(phFriNfc_LlcpTransport_t                  *psTransport,
+                                                      uint32_t                                  nWorkingBufferLength,
+                                                      phFriNfc_LlcpTransport_sSocketOptions_t   *psOptions);
+
+
  /**
 * \ingroup grp_fri_nfc
 * \brief <b>Create a socket on a LLCP-connected device</b>.
@@ -313,6 +313,7 @@ static NFCSTATUS phFriNfc_Llcp_Send_ReceiveReady_Frame(phFriNfc_LlcpTransport_So
    if(testAndSetSendPending(pLlcpSocket->psTransport))
    {
       pLlcpSocket->bSocketRRPending = TRUE;
+      phFriNfc_LlcpTransport_ScheduleSocket(pLlcpSocket);
       status = NFCSTATUS_PENDING;
    }
    else
@@ -354,6 +355,7 @@ static NFCSTATUS phFriNfc_Llcp_Send_ReceiveNotReady_Frame(phFriNfc_LlcpTransport
    if(testAndSetSendPending(pLlcpSocket->psTransport))
    {
       pLlcpSocket->bSocketRNRPending = TRUE;
+      phFriNfc_LlcpTransport_ScheduleSocket(pLlcpSocket);
       status = NFCSTATUS_PENDING;
    }
    else
@@ -506,31 +508,25 @@ static void Handle_ConnectionFrame(phFriNfc_LlcpTransport_t      *psTransport,
       if(dsap == PHFRINFC_LLCP_SAP_SDP)
       {
          /* Search a socket with the SN */
-         for(index=0;index<PHFRINFC_LLCP_NB_SOCKET_MAX;index++)
-         {
-            /* Test if the socket is in Listen state and if its SN is the good one */
-            if(psTransport->pSocketTable[index].bSocketListenPending 
-               &&  (sServiceName.length == psTransport->pSocketTable[index].sServiceName.length) 
-               && !memcmp(sServiceName.buffer,psTransport->pSocketTable[index].sServiceName.buffer,sServiceName.length))
-            {
-               /* socket with the SN found */
-               socketFound = TRUE;
+         psLocalLlcpSocket = phFriNfc_LlcpTransport_FindServiceName(psTransport, &sServiceName);
 
-               psLocalLlcpSocket = &psTransport->pSocketTable[index];
+         /* Test if the socket is in Listen state */
+         if((psLocalLlcpSocket != NULL) && psLocalLlcpSocket->bSocketListenPending)
+         {
+            /* socket with the SN found */
+            socketFound = TRUE;
 
-               /* Get the new ssap number, it is the ssap number of the socket found */
-               dsap = psLocalLlcpSocket->socket_sSap;
-               /* Get the ListenCB of the socket */
-               pListen_Cb = psLocalLlcpSocket->pfSocketListen_Cb;
-               pListenContext = psLocalLlcpSocket->pListenContext;
-               break;
-            }
+            /* Get the new ssap number, it is the ssap number of the socket found */
+            dsap = psLocalLlcpSocket->socket_sSap;
+            /* Get the ListenCB of the socket */
+            pListen_Cb = psLocalLlcpSocket->pfSocketListen_Cb;
+            pListenContext = psLocalLlcpSocket->pListenContext;
          }
      } 
      else
      {
         /* Search a socket with the DSAP */
-        for(index=0;index<PHFRINFC_LLCP_NB_SOCKET_MAX;index++)
+        for(index=0;index<psTransport->nSocketTableSize;index++)
         {
            /* Test if the socket is in Listen state and if its port number is the good one */
            if(psTransport->pSocketTable[index].bSocketListenPending && psTransport->pSocketTable[index].socket_sSap == dsap)
@@ -556,7 +552,7 @@ static void Handle_ConnectionFrame(phFriNfc_LlcpTransport_t      *psTransport,
       socketFound = FALSE;
 
       /* Search a socket free and no socket connect on this DSAP*/
-      for(index=0;index<PHFRINFC_LLCP_NB_SOCKET_MAX;index++)
+      for(index=0;index<psTransport->nSocketTableSize;index++)
       {
          if(psTransport->pSocketTable[index].eSocket_State == phFriNfc_LlcpTransportSocket_eSocketDefault && socketFound != TRUE)
          {
@@ -673,7 +669,7 @@ static void Handle_ConnectionCompleteFrame(phFriNfc_LlcpTransport_t      *psTran
    else
    {
       /* Search a socket in connecting state and with the good SSAP */
-      for(index=0;index<PHFRINFC_LLCP_NB_SOCKET_MAX;index++)
+      for(index=0;index<psTransport->nSocketTableSize;index++)
       {
          /* Test if the socket is in Connecting state and if its SSAP number is the good one */
          if(psTransport->pSocketTable[index].eSocket_State  == phFriNfc_LlcpTransportSocket_eSocketConnecting 
@@ -706,6 +702,9 @@ static void Handle_ConnectionCompleteFrame(phFriNfc_LlcpTransport_t      *psTran
          psLocalLlcpSocket->remoteMIU  = remoteMIU;
          psLocalLlcpSocket->remoteRW   = remoteRW;
 
+         /* Remember the SAP of the service for the next connections by name */
+         phFriNfc_LlcpTransport_UpdateRemoteSap(psLocalLlcpSocket, ssap);
+
          /* Call the Connect CB and reset callback info */
          psLocalLlcpSocket->pfSocketConnect_Cb(psLocalLlcpSocket->pConnectContext,0x00,NFCSTATUS_SUCCESS);
          psLocalLlcpSocket->pfSocketConnect_Cb = NULL;
@@ -730,7 +729,7 @@ static void Handle_DisconnectFrame(phFriNfc_LlcpTransport_t      *psTransport,
    phFriNfc_LlcpTransport_Socket_t*   psLocalLlcpSocket = NULL;
 
    /* Search a socket in connected state and the good SSAP */
-   for(index=0;index<PHFRINFC_LLCP_NB_SOCKET_MAX;index++)
+   for(index=0;index<psTransport->nSocketTableSize;index++)
    {
       /* Test if the socket is in Connected state and if its SSAP number is the good one */
       if(psTransport->pSocketTable[index].eSocket_State == phFriNfc_LlcpTransportSocket_eSocketConnected 
@@ -832,7 +831,7 @@ static void Handle_DisconnetModeFrame(phFriNfc_LlcpTransport_t      *psTransport
    else
    {
       /* Search a socket waiting for a DM (Disconnecting State) */
-      for(index=0;index<PHFRINFC_LLCP_NB_SOCKET_MAX;index++)
+      for(index=0;index<psTransport->nSocketTableSize;index++)
       {
          /* Test if the socket is in Disconnecting  or connecting state and if its SSAP number is the good one */
          if((psTransport->pSocketTable[index].eSocket_State   == phFriNfc_LlcpTransportSocket_eSocketDisconnecting 
@@ -876,13 +875,26 @@ static void Handle_DisconnetModeFrame(phFriNfc_LlcpTransport_t      *psTransport
          case PHFRINFC_LLCP_DM_OPCODE_SAP_NOT_FOUND:
          case PHFRINFC_LLCP_DM_OPCODE_SOCKET_NOT_AVAILABLE:
             {
+               pphFriNfc_LlcpTransportSocketConnectCb_t  pfConnect_Cb = psLocalLlcpSocket->pfSocketConnect_Cb;
+               void                                      *pConnectContext = psLocalLlcpSocket->pConnectContext;
+
+               /* A remembered SAP may be stale, ask again by service name */
+               if(phFriNfc_LlcpTransport_RetryConnectByName(psLocalLlcpSocket) == NFCSTATUS_PENDING)
+               {
+                  break;
+               }
+
                /* Set the socket state to bound */
                psLocalLlcpSocket->eSocket_State = phFriNfc_LlcpTransportSocket_eSocketCreated;
-               if(psLocalLlcpSocket->pfSocketConnect_Cb != NULL)
+
+               /* Do not trust the remote SAP used for this service anymore */
+               phFriNfc_LlcpTransport_UpdateRemoteSap(psLocalLlcpSocket, 0);
+
+               if(pfConnect_Cb != NULL)
                {
                   /* Call Connect CB */
-                  psLocalLlcpSocket->pfSocketConnect_Cb(psLocalLlcpSocket->pConnectContext,dmOpCode,NFCSTATUS_FAILED);
                   psLocalLlcpSocket->pfSocketConnect_Cb = NULL;
+                  pfConnect_Cb(pConnectContext,dmOpCode,NFCSTATUS_FAILED);
                }
             }break;
          }
@@ -924,7 +936,7 @@ static void Handle_Receive_IFrame(phFriNfc_LlcpTransport_t      *psTransport,
    psData->length = psData->length - PHFRINFC_LLCP_PACKET_SEQUENCE_SIZE;
 
    /* Search a socket waiting for an I FRAME (Connected State) */
-   for(index=0;index<PHFRINFC_LLCP_NB_SOCKET_MAX;index++)
+   for(index=0;index<psTransport->nSocketTableSize;index++)
    {
       /* Test if the socket is in connected state and if its SSAP and DSAP are valid */
       if((  (psTransport->pSocketTable[index].eSocket_State == phFriNfc_LlcpTransportSocket_eSocketConnected)
@@ -1015,6 +1027,9 @@ static void Handle_Receive_IFrame(phFriNfc_LlcpTransport_t      *psTransport,
         /* Update VSA */
         psLocalLlcpSocket->socket_VSA = (uint8_t)sLlcpLocalSequence.nr;
 
+        /* Queue the socket if a send was waiting for the window to open */
+        phFriNfc_LlcpTransport_ScheduleSocket(psLocalLlcpSocket);
+
         /* Test if the Linear Buffer length is null */
         if(psLocalLlcpSocket->bufferLinearLength == 0)
         {
@@ -1027,6 +1042,7 @@ static void Handle_Receive_IFrame(phFriNfc_LlcpTransport_t      *psTransport,
                /* Save I_FRAME into the Receive Buffer */
                memcpy(psLocalLlcpSocket->sSocketRecvBuffer->buffer,psData->buffer,psData->length);
                psLocalLlcpSocket->sSocketRecvBuffer->length = psData->length;
+               psLocalLlcpSocket->sRecvStats.nDirectFrames++;
 
                /* Update VR */
                psLocalLlcpSocket->socket_VR = (psLocalLlcpSocket->socket_VR+1)%16;
@@ -1063,6 +1079,7 @@ static void Handle_Receive_IFrame(phFriNfc_LlcpTransport_t      *psTransport,
                      /* Save I_FRAME into the RW Buffers */
                      memcpy(psLocalLlcpSocket->sSocketRwBufferTable[(psLocalLlcpSocket->indexRwWrite%psLocalLlcpSocket->localRW)].buffer,psData->buffer,psData->length);
                      psLocalLlcpSocket->sSocketRwBufferTable[(psLocalLlcpSocket->indexRwWrite%psLocalLlcpSocket->localRW)].length = psData->length;
+                     psLocalLlcpSocket->sRecvStats.nStagedFrames++;
 
                      if(psLocalLlcpSocket->ReceiverBusyCondition != TRUE)
                      {
@@ -1076,32 +1093,32 @@ static void Handle_Receive_IFrame(phFriNfc_LlcpTransport_t      *psTransport,
                      psLocalLlcpSocket->indexRwWrite++;
                   }
                }
+               else
+               {
+                  /* No room left, I_FRAME dropped */
+                  psLocalLlcpSocket->sRecvStats.nDroppedFrames++;
+               }
             }
         }
         else
         {
-           /* Copy the buffer into the RW buffer */
-           memcpy(psLocalLlcpSocket->sSocketRwBufferTable[(psLocalLlcpSocket->indexRwWrite%psLocalLlcpSocket->localRW)].buffer,psData->buffer,psData->length);
-
-           /* Update the length */
-           psLocalLlcpSocket->sSocketRwBufferTable[(psLocalLlcpSocket->indexRwWrite%psLocalLlcpSocket->localRW)].length = psData->length;
-
            /* Test the length of the available place in the linear buffer */
            dataLengthAvailable = phFriNfc_Llcp_CyclicFifoAvailable(&psLocalLlcpSocket->sCyclicFifoBuffer);
 
-           if(dataLengthAvailable >= psLocalLlcpSocket->sSocketRwBufferTable[(psLocalLlcpSocket->indexRwWrite%psLocalLlcpSocket->localRW)].length)
+           /* Test if the I_FRAME can go straight into the linear buffer */
+           /* NOTE: frames staged in the RW buffers must be delivered first */
+           if((psLocalLlcpSocket->indexRwWrite == psLocalLlcpSocket->indexRwRead) &&
+              (dataLengthAvailable >= psData->length))
            {
               /* Store Data into the linear buffer */
               dataLengthWrite = phFriNfc_Llcp_CyclicFifoWrite(&psLocalLlcpSocket->sCyclicFifoBuffer,
-                                                              psLocalLlcpSocket->sSocketRwBufferTable[(psLocalLlcpSocket->indexRwWrite%psLocalLlcpSocket->localRW)].buffer,
-                                                              psLocalLlcpSocket->sSocketRwBufferTable[(psLocalLlcpSocket->indexRwWrite%psLocalLlcpSocket->localRW)].length);
+                                                              psData->buffer,
+                                                              psData->length);
+              psLocalLlcpSocket->sRecvStats.nDirectFrames++;
 
               /* Update VR */
               psLocalLlcpSocket->socket_VR = (psLocalLlcpSocket->socket_VR+1)%16;
 
-              /* Update the length */
-              psLocalLlcpSocket->sSocketRwBufferTable[(psLocalLlcpSocket->indexRwWrite%psLocalLlcpSocket->localRW)].length = 0x00;
-
               /* Test if a Receive Pending*/
               if(psLocalLlcpSocket->bSocketRecvPending == TRUE)
               {
@@ -1132,21 +1149,32 @@ static void Handle_Receive_IFrame(phFriNfc_LlcpTransport_t      *psTransport,
                  status = phFriNfc_Llcp_Send_ReceiveReady_Frame(psLocalLlcpSocket);
               }
            }
-           else
+           /* Test if RW is full */
+           else if((psLocalLlcpSocket->indexRwWrite - psLocalLlcpSocket->indexRwRead)<psLocalLlcpSocket->localRW)
            {
-               if(psLocalLlcpSocket->ReceiverBusyCondition != TRUE)
-               {
-                  /* Receiver Busy condition */
-                  psLocalLlcpSocket->ReceiverBusyCondition = TRUE;
+              /* Save I_FRAME into the RW Buffers until the linear buffer is read */
+              memcpy(psLocalLlcpSocket->sSocketRwBufferTable[(psLocalLlcpSocket->indexRwWrite%psLocalLlcpSocket->localRW)].buffer,psData->buffer,psData->length);
+              psLocalLlcpSocket->sSocketRwBufferTable[(psLocalLlcpSocket->indexRwWrite%psLocalLlcpSocket->localRW)].length = psData->length;
+              psLocalLlcpSocket->sRecvStats.nStagedFrames++;
 
-                  /* Send RNR */
-                  status = phFriNfc_Llcp_Send_ReceiveNotReady_Frame(psLocalLlcpSocket);
-               }
+              if(psLocalLlcpSocket->ReceiverBusyCondition != TRUE)
+              {
+                 /* Receiver Busy condition */
+                 psLocalLlcpSocket->ReceiverBusyCondition = TRUE;
+
+                 /* Send RNR */
+                 status = phFriNfc_Llcp_Send_ReceiveNotReady_Frame(psLocalLlcpSocket);
+              }
 
               /* Update the RW write index */
               psLocalLlcpSocket->indexRwWrite++;
            }
-         }
+           else
+           {
+              /* No room left, I_FRAME dropped */
+              psLocalLlcpSocket->sRecvStats.nDroppedFrames++;
+           }
+        }
       }
    }
    else
@@ -1178,7 +1206,7 @@ static void Handle_ReceiveReady_Frame(phFriNfc_LlcpTransport_t      *psTransport
    phFriNfc_Llcp_Buffer2Sequence( psData->buffer, offset, &sLlcpLocalSequence);
 
    /* Search a socket waiting for an RR FRAME (Connected State) */
-   for(index=0;index<PHFRINFC_LLCP_NB_SOCKET_MAX;index++)
+   for(index=0;index<psTransport->nSocketTableSize;index++)
    {
       /* Test if the socket is in connected state and if its SSAP and DSAP are valid */
       if(psTransport->pSocketTable[index].eSocket_State  == phFriNfc_LlcpTransportSocket_eSocketConnected 
@@ -1249,6 +1277,9 @@ static void Handle_ReceiveReady_Frame(phFriNfc_LlcpTransport_t      *psTransport
          /* Update VSA */
          psLocalLlcpSocket->socket_VSA = (uint8_t)sLlcpLocalSequence.nr;
 
+         /* Queue the socket if a send was waiting for the window to open */
+         phFriNfc_LlcpTransport_ScheduleSocket(psLocalLlcpSocket);
+
          /* Test if a send is pendind */
          if(psLocalLlcpSocket->bSocketSendPending == TRUE)
          {
@@ -1296,7 +1327,7 @@ static void Handle_ReceiveNotReady_Frame(phFriNfc_LlcpTransport_t      *psTransp
    phFriNfc_Llcp_Buffer2Sequence( psData->buffer, offset, &sLlcpLocalSequence);
 
    /* Search a socket waiting for an RNR FRAME (Connected State) */
-   for(index=0;index<PHFRINFC_LLCP_NB_SOCKET_MAX;index++)
+   for(index=0;index<psTransport->nSocketTableSize;index++)
    {
       /* Test if the socket is in connected state and if its SSAP and DSAP are valid */
       if(psTransport->pSocketTable[index].eSocket_State  == phFriNfc_LlcpTransportSocket_eSocketConnected 
@@ -1364,6 +1395,9 @@ static void Handle_ReceiveNotReady_Frame(phFriNfc_LlcpTransport_t      *psTransp
          /* Update VSA */
          psLocalLlcpSocket->socket_VSA = (uint8_t)sLlcpLocalSequence.nr;
 
+         /* Queue the socket if a send was waiting for the window to open */
+         phFriNfc_LlcpTransport_ScheduleSocket(psLocalLlcpSocket);
+
          /* Test if a send is pendind */
          if(psLocalLlcpSocket->bSocketSendPending == TRUE && CHECK_SEND_RW(psLocalLlcpSocket))
          {
@@ -1394,7 +1428,7 @@ static void Handle_FrameReject_Frame(phFriNfc_LlcpTransport_t      *psTransport,
    uint8_t     socketFound = FALSE;
 
    /* Search a socket waiting for a FRAME */
-   for(index=0;index<PHFRINFC_LLCP_NB_SOCKET_MAX;index++)
+   for(index=0;index<psTransport->nSocketTableSize;index++)
    {
       /* Test if the socket is in connected state and if its SSAP and DSAP are valid */
       if(psTransport->pSocketTable[index].socket_sSap == dsap
@@ -1669,7 +1703,15 @@ NFCSTATUS phFriNfc_LlcpTransport_ConnectionOriented_Accept(phFriNfc_LlcpTranspor
    pLlcpSocket ->localMIUX = (pLlcpSocket->sSocketOption.miu - PHFRINFC_LLCP_MIU_DEFAULT) & PHFRINFC_LLCP_TLV_MIUX_MASK;
    pLlcpSocket ->localRW   = pLlcpSocket->sSocketOption.rw & PHFRINFC_LLCP_TLV_RW_MASK;
 
+   /* Count the I frames of the new connection only */
+   memset(&pLlcpSocket->sRecvStats, 0x00, sizeof(phFriNfc_LlcpTransport_sSocketRecvStats_t));
+
    /* Set the pointer and the length for the Receive Window Buffer */
+   status = phFriNfc_LlcpTransport_AllocRwBufferTable(pLlcpSocket, pLlcpSocket->localRW);
+   if (status != NFCSTATUS_SUCCESS)
+   {
+      goto clean_and_return;
+   }
    for(i=0;i<pLlcpSocket->localRW;i++)
    {
       pLlcpSocket->sSocketRwBufferTable[i].buffer = psWorkingBuffer->buffer + (i*pLlcpSocket->sSocketOption.miu);
@@ -1751,6 +1793,7 @@ NFCSTATUS phFriNfc_LlcpTransport_ConnectionOriented_Accept(phFriNfc_LlcpTranspor
    if(testAndSetSendPending(pLlcpSocket->psTransport))
    {
       pLlcpSocket->bSocketAcceptPending = TRUE;
+      phFriNfc_LlcpTransport_ScheduleSocket(pLlcpSocket);
 
       /* Update Send Buffer length value */
       pLlcpSocket->sSocketSendBuffer.length = offset;
@@ -1945,10 +1988,15 @@ NFCSTATUS phFriNfc_LlcpTransport_ConnectionOriented_Connect( phFriNfc_LlcpTransp
    if(testAndSetSendPending(pLlcpSocket->psTransport))
    {
       pLlcpSocket->bSocketConnectPending =  TRUE;
+      phFriNfc_LlcpTransport_ScheduleSocket(pLlcpSocket);
 
       /* Update Send Buffer length value */
       pLlcpSocket->sSocketSendBuffer.length = offset;
 
+      /* Set the socket in connecting state now, so that its implicitly bound
+         SAP is not given to another socket before the CONNECT is sent */
+      pLlcpSocket->eSocket_State = phFriNfc_LlcpTransportSocket_eSocketConnecting;
+
       status = NFCSTATUS_PENDING;
    }
    else
@@ -2055,6 +2103,7 @@ NFCSTATUS phLibNfc_LlcpTransport_ConnectionOriented_Disconnect(phFriNfc_LlcpTran
    if( testAndSetSendPending(pLlcpSocket->psTransport))
    {
       pLlcpSocket->bSocketDiscPending =  TRUE;
+      phFriNfc_LlcpTransport_ScheduleSocket(pLlcpSocket);
       status = NFCSTATUS_PENDING;
    }
    else
@@ -2114,11 +2163,7 @@ static void phFriNfc_LlcpTransport_ConnectionOriented_DisconnectClose_CB(void*
 
       memset(&pLlcpSocket->sSocketOption, 0x00, sizeof(phFriNfc_LlcpTransport_sSocketOptions_t));
 
-      if (pLlcpSocket->sServiceName.buffer != NULL) {
-          phOsalNfc_FreeMemory(pLlcpSocket->sServiceName.buffer);
-      }
-      pLlcpSocket->sServiceName.buffer = NULL;
-      pLlcpSocket->sServiceName.length = 0;
+      phFriNfc_LlcpTransport_UnregisterName(pLlcpSocket);
    }
    else
    {
@@ -2178,11 +2223,7 @@ NFCSTATUS phFriNfc_LlcpTransport_ConnectionOriented_Close(phFriNfc_LlcpTransport
 
       memset(&pLlcpSocket->sSocketOption, 0x00, sizeof(phFriNfc_LlcpTransport_sSocketOptions_t));
 
-      if (pLlcpSocket->sServiceName.buffer != NULL) {
-          phOsalNfc_FreeMemory(pLlcpSocket->sServiceName.buffer);
-      }
-      pLlcpSocket->sServiceName.buffer = NULL;
-      pLlcpSocket->sServiceName.length = 0;
+      phFriNfc_LlcpTransport_UnregisterName(pLlcpSocket);
    }
    return NFCSTATUS_SUCCESS;
 } 
@@ -2251,6 +2292,7 @@ NFCSTATUS phFriNfc_LlcpTransport_ConnectionOriented_Send(phFriNfc_LlcpTransport_
       {
          /* Set Send pending */
          pLlcpSocket->bSocketSendPending = TRUE;
+         phFriNfc_LlcpTransport_ScheduleSocket(pLlcpSocket);
 
          /* Set status */
          status = NFCSTATUS_PENDING;
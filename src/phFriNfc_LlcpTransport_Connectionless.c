@@ -75,7 +75,7 @@ void Handle_Connectionless_IncommingFrame(phFriNfc_LlcpTransport_t      *pLlcpTr
    uint8_t                           writeIndex;
 
    /* Look through the socket table for a match */
-   for(i=0;i<PHFRINFC_LLCP_NB_SOCKET_MAX;i++)
+   for(i=0;i<pLlcpTransport->nSocketTableSize;i++)
    {
       if(pLlcpTransport->pSocketTable[i].socket_sSap == dsap)
       {
@@ -205,11 +205,7 @@ NFCSTATUS phFriNfc_LlcpTransport_Connectionless_Close(phFriNfc_LlcpTransport_Soc
 
    memset(&pLlcpSocket->sSocketOption, 0x00, sizeof(phFriNfc_LlcpTransport_sSocketOptions_t));
 
-   if (pLlcpSocket->sServiceName.buffer != NULL) {
-       phOsalNfc_FreeMemory(pLlcpSocket->sServiceName.buffer);
-   }
-   pLlcpSocket->sServiceName.buffer = NULL;
-   pLlcpSocket->sServiceName.length = 0;
+   phFriNfc_LlcpTransport_UnregisterName(pLlcpSocket);
 
    return NFCSTATUS_SUCCESS;
 }
@@ -259,6 +255,7 @@ NFCSTATUS phFriNfc_LlcpTransport_Connectionless_SendTo(phFriNfc_LlcpTransport_So
       /* Save the request so it can be handled in phFriNfc_LlcpTransport_Connectionless_HandlePendingOperations() */
       pLlcpSocket->sSocketSendBuffer = *psBuffer;
       pLlcpSocket->socket_dSap      = nSap;
+      phFriNfc_LlcpTransport_ScheduleSocket(pLlcpSocket);
       status = NFCSTATUS_PENDING;
    }
    else
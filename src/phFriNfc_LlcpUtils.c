@@ -194,10 +194,10 @@ void phFriNfc_Llcp_CyclicFifoInit(P_UTIL_FIFO_BUFFER   pUtilFifo,
                                   uint32_t             buffLength)
 {
    pUtilFifo->pBuffStart = (uint8_t *)pBuffStart;
-   pUtilFifo->pBuffEnd   = (uint8_t *)pBuffStart + buffLength-1;
-   pUtilFifo->pIn        = (uint8_t *)pBuffStart;
-   pUtilFifo->pOut       = (uint8_t *)pBuffStart;
-   pUtilFifo->bFull      = FALSE;
+   pUtilFifo->nSize      = buffLength;
+   pUtilFifo->nIn        = 0;
+   pUtilFifo->nOut       = 0;
+   pUtilFifo->nCount     = 0;
 }
 
 /**
@@ -205,9 +205,9 @@ void phFriNfc_Llcp_CyclicFifoInit(P_UTIL_FIFO_BUFFER   pUtilFifo,
  */
 void phFriNfc_Llcp_CyclicFifoClear(P_UTIL_FIFO_BUFFER pUtilFifo)
 {
-   pUtilFifo->pIn = pUtilFifo->pBuffStart;
-   pUtilFifo->pOut = pUtilFifo->pBuffStart;
-   pUtilFifo->bFull      = FALSE;
+   pUtilFifo->nIn        = 0;
+   pUtilFifo->nOut       = 0;
+   pUtilFifo->nCount     = 0;
 }
 
 /**
@@ -217,35 +217,33 @@ uint32_t phFriNfc_Llcp_CyclicFifoWrite(P_UTIL_FIFO_BUFFER   pUtilFifo,
                                        uint8_t              *pData,
                                        uint32_t             dataLength)
 {
-   uint32_t dataLengthWritten = 0;
-   uint8_t * pNext;
+   uint32_t dataLengthWritten;
+   uint32_t spanLength;
 
-   while(dataLengthWritten < dataLength)
+   /* Write as much as the available room */
+   dataLengthWritten = pUtilFifo->nSize - pUtilFifo->nCount;
+   if (dataLengthWritten > dataLength)
    {
-      pNext = (uint8_t*)pUtilFifo->pIn+1;
-
-      if(pNext > pUtilFifo->pBuffEnd)
-      {
-         //Wrap around
-         pNext = pUtilFifo->pBuffStart;
-      }
-
-      if(pUtilFifo->bFull)
-      {
-         //Full
-         break;
-      }
-
-      if(pNext == pUtilFifo->pOut)
-      {
-         // Trigger Full flag
-         pUtilFifo->bFull = TRUE;
-      }
-
-      dataLengthWritten++;
-      *pNext = *pData++;
-      pUtilFifo->pIn = pNext;
+      dataLengthWritten = dataLength;
    }
+   if (dataLengthWritten == 0)
+   {
+      return 0;
+   }
+
+   /* First span, up to the end of the buffer */
+   spanLength = pUtilFifo->nSize - pUtilFifo->nIn;
+   if (spanLength > dataLengthWritten)
+   {
+      spanLength = dataLengthWritten;
+   }
+   memcpy(pUtilFifo->pBuffStart + pUtilFifo->nIn, pData, spanLength);
+
+   /* Second span, wrapped around to the start of the buffer */
+   memcpy(pUtilFifo->pBuffStart, pData + spanLength, dataLengthWritten - spanLength);
+
+   pUtilFifo->nIn = (pUtilFifo->nIn + dataLengthWritten) % pUtilFifo->nSize;
+   pUtilFifo->nCount += dataLengthWritten;
 
    return dataLengthWritten;
 }
@@ -257,101 +255,89 @@ uint32_t phFriNfc_Llcp_CyclicFifoFifoRead(P_UTIL_FIFO_BUFFER   pUtilFifo,
                                           uint8_t              *pBuffer,
                                           uint32_t             dataLength)
 {
-   uint32_t  dataLengthRead = 0;
-   uint8_t * pNext;
+   uint32_t  dataLengthRead;
+   uint32_t  spanLength;
+   uint8_t   *pSpan;
+
+   /* Read as much as stored */
+   dataLengthRead = pUtilFifo->nCount;
+   if (dataLengthRead > dataLength)
+   {
+      dataLengthRead = dataLength;
+   }
 
-   while(dataLengthRead < dataLength)
+   /* First span, up to the end of the buffer */
+   spanLength = phFriNfc_Llcp_CyclicFifoPeek(pUtilFifo, &pSpan);
+   if (spanLength > dataLengthRead)
    {
-      if((pUtilFifo->pOut == pUtilFifo->pIn) && (pUtilFifo->bFull == FALSE))
-      {
-         //No more bytes in buffer
-         break;
-      }
-      else
-      {
-         dataLengthRead++;
-
-         if(pUtilFifo->pOut == pUtilFifo->pBuffEnd)
-         {
-            /* Wrap around */
-            pNext = pUtilFifo->pBuffStart;
-         }
-         else
-         {
-            pNext = (uint8_t*)pUtilFifo->pOut + 1;
-         }
-
-         *pBuffer++ = *pNext;
-
-         pUtilFifo->pOut = pNext;
-
-         pUtilFifo->bFull = FALSE;
-      }
+      spanLength = dataLengthRead;
    }
+   memcpy(pBuffer, pSpan, spanLength);
 
-   return dataLengthRead;
+   /* Second span, wrapped around to the start of the buffer */
+   memcpy(pBuffer + spanLength, pUtilFifo->pBuffStart, dataLengthRead - spanLength);
+
+   return phFriNfc_Llcp_CyclicFifoCommit(pUtilFifo, dataLengthRead);
 }
 
 /**
- * Returns the number of bytes currently stored in Fifo Cyclic Buffer.
+ * Gives the contiguous span of bytes at the head of the Fifo Cyclic Buffer,
+ * without removing them.
  */
-uint32_t phFriNfc_Llcp_CyclicFifoUsage(P_UTIL_FIFO_BUFFER pUtilFifo)
+uint32_t phFriNfc_Llcp_CyclicFifoPeek(P_UTIL_FIFO_BUFFER   pUtilFifo,
+                                      uint8_t              **ppData)
 {
-   uint32_t dataLength;
-   uint8_t * pIn        = (uint8_t *)pUtilFifo->pIn;
-   uint8_t * pOut       = (uint8_t *)pUtilFifo->pOut;
+   uint32_t spanLength;
 
-   if (pUtilFifo->bFull)
-   {
-      dataLength = pUtilFifo->pBuffEnd - pUtilFifo->pBuffStart + 1;
-   }
-   else
+   *ppData = pUtilFifo->pBuffStart + pUtilFifo->nOut;
+
+   spanLength = pUtilFifo->nSize - pUtilFifo->nOut;
+   if (spanLength > pUtilFifo->nCount)
    {
-      if(pIn >= pOut)
-      {
-         dataLength = pIn - pOut;
-      }
-      else
-      {
-         dataLength = pUtilFifo->pBuffEnd - pOut;
-         dataLength += (pIn+1) - pUtilFifo->pBuffStart;
-      }
+      spanLength = pUtilFifo->nCount;
    }
 
-   return dataLength;
+   return spanLength;
 }
 
-
 /**
- * Returns the available room for writing in Fifo Cyclic Buffer.
+ * Removes up to dataLength bytes from the head of the Fifo Cyclic Buffer.
  */
-uint32_t phFriNfc_Llcp_CyclicFifoAvailable(P_UTIL_FIFO_BUFFER pUtilFifo)
+uint32_t phFriNfc_Llcp_CyclicFifoCommit(P_UTIL_FIFO_BUFFER   pUtilFifo,
+                                        uint32_t             dataLength)
 {
-   uint32_t dataLength;
-   uint32_t  size;
-   uint8_t * pIn         = (uint8_t *)pUtilFifo->pIn;
-   uint8_t * pOut        = (uint8_t *)pUtilFifo->pOut;
-
-   if (pUtilFifo->bFull)
+   if (dataLength > pUtilFifo->nCount)
    {
-      dataLength = 0;
+      dataLength = pUtilFifo->nCount;
    }
-   else
+   if (dataLength == 0)
    {
-      if(pIn >= pOut)
-      {
-         size = pUtilFifo->pBuffEnd - pUtilFifo->pBuffStart + 1;
-         dataLength = size - (pIn - pOut);
-      }
-      else
-      {
-         dataLength = pOut - pIn;
-      }
+      return 0;
    }
 
+   pUtilFifo->nOut = (pUtilFifo->nOut + dataLength) % pUtilFifo->nSize;
+   pUtilFifo->nCount -= dataLength;
+
    return dataLength;
 }
 
+/**
+ * Returns the number of bytes currently stored in Fifo Cyclic Buffer.
+ */
+uint32_t phFriNfc_Llcp_CyclicFifoUsage(P_UTIL_FIFO_BUFFER pUtilFifo)
+{
+   return pUtilFifo->nCount;
+}
+
+
+/**
+ * Returns the available room for writing in Fifo Cyclic Buffer.
+ */
+uint32_t phFriNfc_Llcp_CyclicFifoAvailable(P_UTIL_FIFO_BUFFER pUtilFifo)
+{
+   return pUtilFifo->nSize - pUtilFifo->nCount;
+}
+
 
 
 uint32_t phFriNfc_Llcp_Header2Buffer( phFriNfc_Llcp_sPacketHeader_t *psHeader, uint8_t *pBuffer, uint32_t nOffset )
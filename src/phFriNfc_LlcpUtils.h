@@ -41,15 +41,15 @@
 
 /**
  * UTIL_FIFO_BUFFER - A Cyclic FIFO buffer
- * If pIn == pOut the buffer is empty.
+ * If nCount == 0 the buffer is empty, if nCount == nSize it is full.
  */
 typedef struct UTIL_FIFO_BUFFER
 {
    uint8_t          *pBuffStart;    /* Points to first valid location in buffer */
-   uint8_t          *pBuffEnd;      /* Points to last valid location in buffer */
-   volatile uint8_t *pIn;           /* Points to 1 before where the next TU1 will enter buffer */
-   volatile uint8_t *pOut;          /* Points to 1 before where the next TU1 will leave buffer */
-   volatile bool_t  bFull;         /* TRUE if buffer is full */
+   uint32_t         nSize;          /* Number of valid locations in buffer */
+   uint32_t         nIn;            /* Index where the next byte will enter buffer */
+   uint32_t         nOut;           /* Index where the next byte will leave buffer */
+   uint32_t         nCount;         /* Number of bytes stored in buffer */
 }UTIL_FIFO_BUFFER, *P_UTIL_FIFO_BUFFER;
 
 
@@ -108,6 +108,20 @@ uint32_t phFriNfc_Llcp_CyclicFifoFifoRead(P_UTIL_FIFO_BUFFER     sUtilFifo,
                                           uint8_t              *pBuffer,
                                           uint32_t             dataLength);
 
+/**
+ * Gives the contiguous span of bytes at the head of the Fifo Cyclic Buffer,
+ * without removing them. Returns the span length (0 if the buffer is empty).
+ */
+uint32_t phFriNfc_Llcp_CyclicFifoPeek(P_UTIL_FIFO_BUFFER     sUtilFifo,
+                                      uint8_t              **ppData);
+
+/**
+ * Removes up to dataLength bytes from the head of the Fifo Cyclic Buffer,
+ * once consumed through phFriNfc_Llcp_CyclicFifoPeek.
+ */
+uint32_t phFriNfc_Llcp_CyclicFifoCommit(P_UTIL_FIFO_BUFFER     sUtilFifo,
+                                        uint32_t             dataLength);
+
 /**
  * Returns the number of bytes currently stored in Fifo Cyclic Buffer.
  */
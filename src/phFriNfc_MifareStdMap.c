@@ -76,6 +76,12 @@ static NFCSTATUS phFriNfc_MifStd_H_WrABlock(phFriNfc_NdefMap_t *NdefMap);
  */
 static NFCSTATUS phFriNfc_MifStd_H_AuthSector(phFriNfc_NdefMap_t *NdefMap);
 
+/*!
+ * \brief \copydoc page_ovr Helper function for Mifare Std. This function gives  
+ *  the key to authenticate the sector of the current block with.
+ */
+static uint8_t phFriNfc_MifStd_H_GetAuthKey(phFriNfc_NdefMap_t *NdefMap);
+
 /*!
  * \brief \copydoc page_ovr Helper function for Mifare 4k Check Ndef to 
  *  get the next AID blocks
@@ -907,6 +913,12 @@ void phFriNfc_MifareStdMap_Process( void       *Context,
 
     NdefMap = (phFriNfc_NdefMap_t *)Context;
 
+    if((Status & PHNFCSTBLOWER) != (NFCSTATUS_SUCCESS & PHNFCSTBLOWER))
+    {
+        /* The card leaves the authenticated state on any error */
+        NdefMap->StdMifareContainer.AuthKey = PH_FRINFC_MIFARESTD_AUTH_KEY_NONE;
+    }
+
     if((Status & PHNFCSTBLOWER) == (NFCSTATUS_SUCCESS & PHNFCSTBLOWER))
     {
         switch(NdefMap->State)
@@ -1203,6 +1215,8 @@ void phFriNfc_MifareStdMap_Process( void       *Context,
             case PH_FRINFC_NDEFMAP_STATE_WRITE_SEC:
                 /* Set flag for writing of Acs bit */
                 NdefMap->StdMifareContainer.WriteAcsBitFlag = PH_FRINFC_MIFARESTD_FLAG1;
+                /* The new access conditions apply from the next authentication */
+                NdefMap->StdMifareContainer.AuthKey = PH_FRINFC_MIFARESTD_AUTH_KEY_NONE;
 
                 /* The first NDEF sector is already made read only,
                    set card state to read only and proceed*/
@@ -1542,91 +1556,133 @@ static NFCSTATUS phFriNfc_MifStd_H_WrABlock(phFriNfc_NdefMap_t *NdefMap)
 static NFCSTATUS phFriNfc_MifStd_H_AuthSector(phFriNfc_NdefMap_t *NdefMap)
 {
     NFCSTATUS                   status = NFCSTATUS_PENDING;
-    
-    /* set the data for additional data exchange*/
-    NdefMap->psDepAdditionalInfo.DepFlags.MetaChaining = 0;
-    NdefMap->psDepAdditionalInfo.DepFlags.NADPresent = 0;
-    NdefMap->psDepAdditionalInfo.NAD = 0;
-    NdefMap->MapCompletionInfo.CompletionRoutine = phFriNfc_MifareStdMap_Process;
-    NdefMap->MapCompletionInfo.Context = NdefMap;
-    
-    *NdefMap->SendRecvLength = NdefMap->TempReceiveLength;
-    NdefMap->State = PH_FRINFC_NDEFMAP_STATE_AUTH;
+    uint8_t                     BlockNo = 0,
+                                AuthKey = 0;
 
-    /* Authenticate */ 
-#ifndef PH_HAL4_ENABLE
-    NdefMap->Cmd.MfCmd = phHal_eMifareCmdListMifareAuthentA;
-#else
-    NdefMap->Cmd.MfCmd = phHal_eMifareAuthentA;
-#endif
-    NdefMap->SendRecvBuf[PH_FRINFC_MIFARESTD_VAL0] = 
-                            ((NdefMap->TLVStruct.NdefTLVAuthFlag == 
-                                PH_FRINFC_MIFARESTD_FLAG1)?
-                                NdefMap->TLVStruct.NdefTLVBlock:
-                                NdefMap->StdMifareContainer.currentBlock);
+    BlockNo = ((NdefMap->TLVStruct.NdefTLVAuthFlag == 
+                    PH_FRINFC_MIFARESTD_FLAG1)?
+                    NdefMap->TLVStruct.NdefTLVBlock:
+                    NdefMap->StdMifareContainer.currentBlock);
+    AuthKey = phFriNfc_MifStd_H_GetAuthKey(NdefMap);
 
-    /* if MAD blocks then authentication key is 
-        0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5 else
-        0xD3, 0xF7, 0xD3, 0xF7, 0xD3, 0xF7 */
-    if(( (NdefMap->StdMifareContainer.currentBlock != PH_FRINFC_MIFARESTD_MAD_BLK0) && 
-        (NdefMap->StdMifareContainer.currentBlock != PH_FRINFC_MIFARESTD_MAD_BLK1) &&
-        (NdefMap->StdMifareContainer.currentBlock != PH_FRINFC_MIFARESTD_MAD_BLK2) &&
-        (NdefMap->StdMifareContainer.currentBlock != PH_FRINFC_MIFARESTD_MAD_BLK64) && 
-        (NdefMap->StdMifareContainer.currentBlock != PH_FRINFC_MIFARESTD_MAD_BLK65) && 
-        (NdefMap->StdMifareContainer.currentBlock != PH_FRINFC_MIFARESTD_MAD_BLK66)) || 
-        (NdefMap->TLVStruct.NdefTLVAuthFlag == 
-                                (uint8_t)PH_FRINFC_MIFARESTD_FLAG1))
-    {   
-        NdefMap->SendRecvBuf[1] = PH_FRINFC_NDEFMAP_MIFARESTD_AUTH_NDEFSECT1; /* 0xD3 */
-        NdefMap->SendRecvBuf[2] = PH_FRINFC_NDEFMAP_MIFARESTD_AUTH_NDEFSECT2; /* 0xF7 */
-        NdefMap->SendRecvBuf[3] = PH_FRINFC_NDEFMAP_MIFARESTD_AUTH_NDEFSECT1; /* 0xD3 */
-        NdefMap->SendRecvBuf[4] = PH_FRINFC_NDEFMAP_MIFARESTD_AUTH_NDEFSECT2; /* 0xF7 */
-        NdefMap->SendRecvBuf[5] = PH_FRINFC_NDEFMAP_MIFARESTD_AUTH_NDEFSECT1; /* 0xD3 */
-        NdefMap->SendRecvBuf[6] = PH_FRINFC_NDEFMAP_MIFARESTD_AUTH_NDEFSECT2; /* 0xF7 */
+    if((AuthKey == NdefMap->StdMifareContainer.AuthKey) &&
+        (phFriNfc_MifStd_H_GetSect(BlockNo) == 
+        NdefMap->StdMifareContainer.AuthSector))
+    {
+        /* The sector is still authenticated with this key, so
+            continue as if the authentication had just completed */
+        NdefMap->StdMifareContainer.AuthSkipped++;
+        NdefMap->StdMifareContainer.FirstReadFlag = PH_FRINFC_MIFARESTD_FLAG0;
+        status = phFriNfc_MifStd_H_ProAuth(NdefMap);
     }
     else
-    {       
-        NdefMap->SendRecvBuf[1] = PH_FRINFC_NDEFMAP_MIFARESTD_AUTH_MADSECT1; /* 0xA0 */
-        NdefMap->SendRecvBuf[2] = PH_FRINFC_NDEFMAP_MIFARESTD_AUTH_MADSECT2; /* 0xA1 */
-        NdefMap->SendRecvBuf[3] = PH_FRINFC_NDEFMAP_MIFARESTD_AUTH_MADSECT3; /* 0xA2 */
-        NdefMap->SendRecvBuf[4] = PH_FRINFC_NDEFMAP_MIFARESTD_AUTH_MADSECT4; /* 0xA3 */
-        NdefMap->SendRecvBuf[5] = PH_FRINFC_NDEFMAP_MIFARESTD_AUTH_MADSECT5; /* 0xA4 */
-        NdefMap->SendRecvBuf[6] = PH_FRINFC_NDEFMAP_MIFARESTD_AUTH_MADSECT6; /* 0xA5 */
-    }
-
-    if (NdefMap->CardType == PH_FRINFC_NDEFMAP_MIFARE_STD_1K_CARD ||
-        NdefMap->CardType == PH_FRINFC_NDEFMAP_MIFARE_STD_4K_CARD)
     {
-        if (NdefMap->StdMifareContainer.ReadOnlySectorIndex &&
-            NdefMap->StdMifareContainer.SectorTrailerBlockNo ==  NdefMap->StdMifareContainer.currentBlock)
-        {
-            memcpy (&NdefMap->SendRecvBuf[1], &NdefMap->StdMifareContainer.UserScrtKeyB[0], PH_FRINFC_MIFARESTD_KEY_LEN);
+        /* set the data for additional data exchange*/
+        NdefMap->psDepAdditionalInfo.DepFlags.MetaChaining = 0;
+        NdefMap->psDepAdditionalInfo.DepFlags.NADPresent = 0;
+        NdefMap->psDepAdditionalInfo.NAD = 0;
+        NdefMap->MapCompletionInfo.CompletionRoutine = phFriNfc_MifareStdMap_Process;
+        NdefMap->MapCompletionInfo.Context = NdefMap;
+        
+        *NdefMap->SendRecvLength = NdefMap->TempReceiveLength;
+        NdefMap->State = PH_FRINFC_NDEFMAP_STATE_AUTH;
 
-            /* Authenticate with KeyB*/
+        /* Authenticate */ 
 #ifndef PH_HAL4_ENABLE
-            NdefMap->Cmd.MfCmd = phHal_eMifareCmdListMifareAuthentB;
+        NdefMap->Cmd.MfCmd = ((AuthKey == PH_FRINFC_MIFARESTD_AUTH_KEY_SCRT_B)?
+                                phHal_eMifareCmdListMifareAuthentB:
+                                phHal_eMifareCmdListMifareAuthentA);
 #else
-            NdefMap->Cmd.MfCmd = phHal_eMifareAuthentB;
+        NdefMap->Cmd.MfCmd = ((AuthKey == PH_FRINFC_MIFARESTD_AUTH_KEY_SCRT_B)?
+                                phHal_eMifareAuthentB:
+                                phHal_eMifareAuthentA);
 #endif
+        NdefMap->SendRecvBuf[PH_FRINFC_MIFARESTD_VAL0] = BlockNo;
+
+        switch(AuthKey)
+        {
+            case PH_FRINFC_MIFARESTD_AUTH_KEY_MAD:
+                NdefMap->SendRecvBuf[1] = PH_FRINFC_NDEFMAP_MIFARESTD_AUTH_MADSECT1; /* 0xA0 */
+                NdefMap->SendRecvBuf[2] = PH_FRINFC_NDEFMAP_MIFARESTD_AUTH_MADSECT2; /* 0xA1 */
+                NdefMap->SendRecvBuf[3] = PH_FRINFC_NDEFMAP_MIFARESTD_AUTH_MADSECT3; /* 0xA2 */
+                NdefMap->SendRecvBuf[4] = PH_FRINFC_NDEFMAP_MIFARESTD_AUTH_MADSECT4; /* 0xA3 */
+                NdefMap->SendRecvBuf[5] = PH_FRINFC_NDEFMAP_MIFARESTD_AUTH_MADSECT5; /* 0xA4 */
+                NdefMap->SendRecvBuf[6] = PH_FRINFC_NDEFMAP_MIFARESTD_AUTH_MADSECT6; /* 0xA5 */
+                break;
+
+            case PH_FRINFC_MIFARESTD_AUTH_KEY_SCRT_B:
+                (void)memcpy(&NdefMap->SendRecvBuf[1], 
+                            &NdefMap->StdMifareContainer.UserScrtKeyB[0], 
+                            PH_FRINFC_MIFARESTD_KEY_LEN);
+                break;
+
+            default:
+                NdefMap->SendRecvBuf[1] = PH_FRINFC_NDEFMAP_MIFARESTD_AUTH_NDEFSECT1; /* 0xD3 */
+                NdefMap->SendRecvBuf[2] = PH_FRINFC_NDEFMAP_MIFARESTD_AUTH_NDEFSECT2; /* 0xF7 */
+                NdefMap->SendRecvBuf[3] = PH_FRINFC_NDEFMAP_MIFARESTD_AUTH_NDEFSECT1; /* 0xD3 */
+                NdefMap->SendRecvBuf[4] = PH_FRINFC_NDEFMAP_MIFARESTD_AUTH_NDEFSECT2; /* 0xF7 */
+                NdefMap->SendRecvBuf[5] = PH_FRINFC_NDEFMAP_MIFARESTD_AUTH_NDEFSECT1; /* 0xD3 */
+                NdefMap->SendRecvBuf[6] = PH_FRINFC_NDEFMAP_MIFARESTD_AUTH_NDEFSECT2; /* 0xF7 */
+                break;
         }
-    }
 
-    NdefMap->SendLength = MIFARE_AUTHENTICATE_CMD_LENGTH;
-    *NdefMap->SendRecvLength = NdefMap->TempReceiveLength;
-    /* Call the Overlapped HAL Transceive function */ 
-    status = phFriNfc_OvrHal_Transceive(    NdefMap->LowerDevice,
-                                            &NdefMap->MapCompletionInfo,
-                                            NdefMap->psRemoteDevInfo,
-                                            NdefMap->Cmd,
-                                            &NdefMap->psDepAdditionalInfo,
-                                            NdefMap->SendRecvBuf,
-                                            NdefMap->SendLength,
-                                            NdefMap->SendRecvBuf,
-                                            NdefMap->SendRecvLength);
+        /* The sector is taken as authenticated from now on, a failure
+            of the authentication makes the process forget it */
+        NdefMap->StdMifareContainer.AuthSector = phFriNfc_MifStd_H_GetSect(BlockNo);
+        NdefMap->StdMifareContainer.AuthKey = AuthKey;
+        NdefMap->StdMifareContainer.AuthCount++;
+
+        NdefMap->SendLength = MIFARE_AUTHENTICATE_CMD_LENGTH;
+        *NdefMap->SendRecvLength = NdefMap->TempReceiveLength;
+        /* Call the Overlapped HAL Transceive function */ 
+        status = phFriNfc_OvrHal_Transceive(    NdefMap->LowerDevice,
+                                                &NdefMap->MapCompletionInfo,
+                                                NdefMap->psRemoteDevInfo,
+                                                NdefMap->Cmd,
+                                                &NdefMap->psDepAdditionalInfo,
+                                                NdefMap->SendRecvBuf,
+                                                NdefMap->SendLength,
+                                                NdefMap->SendRecvBuf,
+                                                NdefMap->SendRecvLength);
+        if(status != NFCSTATUS_PENDING)
+        {
+            NdefMap->StdMifareContainer.AuthKey = PH_FRINFC_MIFARESTD_AUTH_KEY_NONE;
+        }
+    }
     
     return status;
 }
 
+static uint8_t phFriNfc_MifStd_H_GetAuthKey(phFriNfc_NdefMap_t *NdefMap)
+{
+    uint8_t     AuthKey = PH_FRINFC_MIFARESTD_AUTH_KEY_NDEF;
+
+    /* if MAD blocks then authentication key is 
+        0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5 else
+        0xD3, 0xF7, 0xD3, 0xF7, 0xD3, 0xF7 */
+    if(( (NdefMap->StdMifareContainer.currentBlock == PH_FRINFC_MIFARESTD_MAD_BLK0) || 
+        (NdefMap->StdMifareContainer.currentBlock == PH_FRINFC_MIFARESTD_MAD_BLK1) ||
+        (NdefMap->StdMifareContainer.currentBlock == PH_FRINFC_MIFARESTD_MAD_BLK2) ||
+        (NdefMap->StdMifareContainer.currentBlock == PH_FRINFC_MIFARESTD_MAD_BLK64) || 
+        (NdefMap->StdMifareContainer.currentBlock == PH_FRINFC_MIFARESTD_MAD_BLK65) || 
+        (NdefMap->StdMifareContainer.currentBlock == PH_FRINFC_MIFARESTD_MAD_BLK66)) && 
+        (NdefMap->TLVStruct.NdefTLVAuthFlag != 
+                                (uint8_t)PH_FRINFC_MIFARESTD_FLAG1))
+    {
+        AuthKey = PH_FRINFC_MIFARESTD_AUTH_KEY_MAD;
+    }
+
+    /* The sector trailers converted to read only are written with key B */
+    if ((NdefMap->CardType == PH_FRINFC_NDEFMAP_MIFARE_STD_1K_CARD ||
+        NdefMap->CardType == PH_FRINFC_NDEFMAP_MIFARE_STD_4K_CARD) &&
+        (NdefMap->StdMifareContainer.ReadOnlySectorIndex &&
+        NdefMap->StdMifareContainer.SectorTrailerBlockNo ==  NdefMap->StdMifareContainer.currentBlock))
+    {
+        AuthKey = PH_FRINFC_MIFARESTD_AUTH_KEY_SCRT_B;
+    }
+    return AuthKey;
+}
+
 static void phFriNfc_MifStd_H_Complete(phFriNfc_NdefMap_t  *NdefMap,
                                         NFCSTATUS            Result)
 {
@@ -5958,6 +6014,8 @@ static NFCSTATUS phFriNfc_MifStd_H_CallDisCon(phFriNfc_NdefMap_t   *NdefMap)
     NFCSTATUS   Result = NFCSTATUS_SUCCESS;
     /*Set Ndef State*/
     NdefMap->State = PH_FRINFC_NDEFMAP_STATE_DISCONNECT;
+    /* The card is reactivated, no sector stays authenticated */
+    NdefMap->StdMifareContainer.AuthKey = PH_FRINFC_MIFARESTD_AUTH_KEY_NONE;
     NdefMap->MapCompletionInfo.CompletionRoutine = phFriNfc_MifareStdMap_Process;
     NdefMap->MapCompletionInfo.Context = NdefMap; 
 
@@ -6341,4 +6399,12 @@ static NFCSTATUS phFriNfc_MifStd_H_ProWrSectorTrailor(phFriNfc_NdefMap_t *NdefMa
     return status;
 }
 
+void phFriNfc_MifareStdMap_ResetAuth(phFriNfc_NdefMap_t      *NdefMap)
+{
+    if(NdefMap != NULL)
+    {
+        NdefMap->StdMifareContainer.AuthKey = PH_FRINFC_MIFARESTD_AUTH_KEY_NONE;
+    }
+}
+
 #endif  /* PH_FRINFC_MAP_MIFARESTD_DISABLED */
@@ -239,6 +239,10 @@
 #define PH_FRINFC_MIFARESTD_MASK_GPB_RD                   0x0C /*!< Mask 0xOC for GPB byte */
 #define PH_FRINFC_MIFARESTD_GPB_RD_WR_VAL                 0x00 /*!< GPB Read Write value */
 #define PH_FRINFC_MIFARESTD_KEY_LEN                       0x06 /*!< MIFARE Std key length */
+#define PH_FRINFC_MIFARESTD_AUTH_KEY_NONE                 0x00 /*!< No sector authenticated */
+#define PH_FRINFC_MIFARESTD_AUTH_KEY_MAD                  0x01 /*!< Key A of the MAD sectors */
+#define PH_FRINFC_MIFARESTD_AUTH_KEY_NDEF                 0x02 /*!< Key A of the NFC Forum sectors */
+#define PH_FRINFC_MIFARESTD_AUTH_KEY_SCRT_B               0x03 /*!< Secret key B given by the application */
 
 /*@}*/
 
@@ -394,4 +398,19 @@ void phFriNfc_MifareStdMap_Process( void       *Context,
  */
 NFCSTATUS phFriNfc_MifareStdMap_ConvertToReadOnly(phFriNfc_NdefMap_t      *NdefMap, const uint8_t *ScrtKeyB);
 
+#ifndef PH_FRINFC_MAP_MIFARESTD_DISABLED
+/*!
+ *
+ * The function makes the component forget the sector authenticated on the card.
+ * It shall be called whenever the card may have been accessed by another
+ * component, reactivated or replaced, so that the next access to a sector
+ * authenticates it again.
+ *
+ * \param[in] NdefMap Pointer to a valid instance of the \ref phFriNfc_NdefMap_t structure describing
+ *                    the component context.
+ *
+ */
+void phFriNfc_MifareStdMap_ResetAuth(phFriNfc_NdefMap_t      *NdefMap);
+#endif  /* PH_FRINFC_MAP_MIFARESTD_DISABLED */
+
 #endif /* PHFRINFC_MIFARESTDMAP_H */
@@ -161,6 +161,14 @@ static NFCSTATUS phFriNfc_MfUL_H_UpdateWrLen(phFriNfc_NdefMap_t *NdefMap);
  */
 static NFCSTATUS phFriNfc_MfUL_H_WrTermTLV(phFriNfc_NdefMap_t   *NdefMap);
 
+/*!
+ * \brief \copydoc page_ovr Helper function for Mifare UL function. This 
+ * function compares the block in the send buffer with the known content
+ * of the NDEF TLV, or updates the known content with it
+ */
+static uint8_t phFriNfc_MfUL_H_DiffBlock(phFriNfc_NdefMap_t   *NdefMap,
+                                         uint8_t              Update);
+
 #ifdef LOCK_BITS_CHECK_ENABLE 
     static 
     void
@@ -177,6 +185,27 @@ static NFCSTATUS  phFriNfc_MfUL_H_SelectSector(phFriNfc_NdefMap_t  *NdefMap,
                                                    uint8_t              CmdNo,
                                                    uint8_t              NextState);
 
+#ifdef NXP_MFUL_FAST_READ
+/*!
+ * \brief \copydoc page_ovr Helper function for Mifare UL function. This 
+ * function sends GET_VERSION, to know if the card supports FAST_READ
+ */
+static NFCSTATUS  phFriNfc_MfUL_H_GetVersion(phFriNfc_NdefMap_t  *NdefMap);
+
+/*!
+ * \brief \copydoc page_ovr Helper function for Mifare UL function. This 
+ * function gives the number of pages of the next FAST_READ, 0 to READ
+ */
+static uint8_t phFriNfc_MfUL_H_FastReadPages(phFriNfc_NdefMap_t  *NdefMap);
+
+/*!
+ * \brief \copydoc page_ovr Helper function for Mifare UL function. This 
+ * function gives the FAST_READ support known without GET_VERSION, from the
+ * UID and SAK of the card or from the last GET_VERSION of the same card
+ */
+static uint8_t phFriNfc_MfUL_H_KnownVersion(phFriNfc_NdefMap_t  *NdefMap);
+#endif /* #ifdef NXP_MFUL_FAST_READ */
+
 
 
 static void phFriNfc_MfUL_H_UpdateCrc( uint8_t ch, 
@@ -228,6 +257,9 @@ NFCSTATUS phFriNfc_MifareUL_H_Reset(phFriNfc_NdefMap_t        *NdefMap)
         NdefMap->MifareULContainer.ReadBufIndex = PH_FRINFC_NDEFMAP_MFUL_VAL0;
         NdefMap->MifareULContainer.ReadWriteCompleteFlag = PH_FRINFC_NDEFMAP_MFUL_FLAG0;
         NdefMap->MifareULContainer.RemainingSize = PH_FRINFC_NDEFMAP_MFUL_VAL0;
+        NdefMap->MifareULContainer.FastRead = PH_FRINFC_NDEFMAP_MFUL_FASTRD_UNKNOWN;
+        NdefMap->MifareULContainer.FastReadPages = PH_FRINFC_NDEFMAP_MFUL_VAL0;
+        NdefMap->ReActivate = PH_FRINFC_NDEFMAP_MFUL_FLAG0;
 
         /* Fill all the structure related buffer to ZERO */
         (void)memset(NdefMap->TLVStruct.NdefTLVBuffer, 
@@ -356,6 +388,8 @@ NFCSTATUS phFriNfc_MifareUL_WrNdef( phFriNfc_NdefMap_t  *NdefMap,
             /*  To return actual number of bytes read to the caller */
             NdefMap->WrNdefPacketLength = PacketDataLength ;
             *NdefMap->WrNdefPacketLength = 0;
+            NdefMap->WrBlocksWritten = PH_FRINFC_NDEFMAP_MFUL_VAL0;
+            NdefMap->WrBlocksSkipped = PH_FRINFC_NDEFMAP_MFUL_VAL0;
 
             if( (Offset == PH_FRINFC_NDEFMAP_SEEK_BEGIN) || ( NdefMap->PrevOperation == 
                 PH_FRINFC_NDEFMAP_READ_OPE))
@@ -594,6 +628,40 @@ void phFriNfc_MifareUL_Process( void        *Context,
 
     NdefMap = (phFriNfc_NdefMap_t *)Context;    
 
+#ifdef NXP_MFUL_FAST_READ
+    if (NdefMap->State == PH_FRINFC_NDEFMAP_MFUL_STATE_GET_VERSION)
+    {
+        if ((Status == NFCSTATUS_SUCCESS) && 
+            (*NdefMap->SendRecvLength >= PH_FRINFC_NDEFMAP_MFUL_VERSION_LEN))
+        {
+            NdefMap->MifareULContainer.FastRead = (uint8_t)
+                (((NdefMap->SendRecvBuf[PH_FRINFC_NDEFMAP_MFUL_VERSION_VENDOR] == 
+                PH_FRINFC_NDEFMAP_MFUL_VENDOR_NXP) && 
+                ((NdefMap->SendRecvBuf[PH_FRINFC_NDEFMAP_MFUL_VERSION_TYPE] == 
+                PH_FRINFC_NDEFMAP_MFUL_TYPE_ULTRALIGHT) || 
+                (NdefMap->SendRecvBuf[PH_FRINFC_NDEFMAP_MFUL_VERSION_TYPE] == 
+                PH_FRINFC_NDEFMAP_MFUL_TYPE_NTAG)))?
+                PH_FRINFC_NDEFMAP_MFUL_FASTRD_SUPPORTED:
+                PH_FRINFC_NDEFMAP_MFUL_FASTRD_UNSUPPORTED);
+        }
+        else
+        {
+            /* No version: the card went idle on the unknown command */
+            NdefMap->MifareULContainer.FastRead = 
+                                PH_FRINFC_NDEFMAP_MFUL_FASTRD_UNSUPPORTED;
+            NdefMap->ReActivate = PH_FRINFC_NDEFMAP_MFUL_FLAG1;
+        }
+        /* Do not ask the same card again on its next checks */
+        (void)memcpy(NdefMap->MifareULContainer.VersionUid, 
+                    NdefMap->psRemoteDevInfo->RemoteDevInfo.Iso14443A_Info.Uid, 
+                    PH_FRINFC_NDEFMAP_MFUL_UID_LEN);
+        NdefMap->MifareULContainer.VersionFastRead = 
+                                NdefMap->MifareULContainer.FastRead;
+        /* The check itself has already succeeded */
+        phFriNfc_MifareUL_H_Complete(NdefMap, NFCSTATUS_SUCCESS);
+    }
+    else
+#endif /* #ifdef NXP_MFUL_FAST_READ */
     if ( Status == NFCSTATUS_SUCCESS )
     {
         switch (NdefMap->State)
@@ -641,9 +709,21 @@ void phFriNfc_MifareUL_Process( void        *Context,
 
 
             case PH_FRINFC_NDEFMAP_MFUL_STATE_READ:
-                /* check the received bytes size equals 16 bytes*/
-                if (*NdefMap->SendRecvLength == 
-                    PH_FRINFC_NDEFMAP_MFUL_RDBYTES_16)
+                /* check the received bytes size equals 16 bytes, or the pages
+                    asked by FAST_READ, followed by their CRC if not removed */
+                TemLength = (uint16_t)((NdefMap->MifareULContainer.FastReadPages == 
+                            PH_FRINFC_NDEFMAP_MFUL_VAL0)?
+                            PH_FRINFC_NDEFMAP_MFUL_RDBYTES_16:
+                            (NdefMap->MifareULContainer.FastReadPages * 
+                            PH_FRINFC_NDEFMAP_MFUL_VAL4));
+                if ((NdefMap->MifareULContainer.FastReadPages != 
+                    PH_FRINFC_NDEFMAP_MFUL_VAL0) && 
+                    (*NdefMap->SendRecvLength == 
+                    (TemLength + PH_FRINFC_NDEFMAP_MFUL_VAL2)))
+                {
+                    *NdefMap->SendRecvLength = TemLength;
+                }
+                if (*NdefMap->SendRecvLength == TemLength)
                 {
                     if(NdefMap->MifareULContainer.ReadBufIndex < 
                         (NdefMap->TLVStruct.ActualSize + (((NdefMap->TLVStruct.NdefTLVBlock - 
@@ -1453,16 +1533,46 @@ static NFCSTATUS   phFriNfc_MfUL_H_Rd16Bytes( phFriNfc_NdefMap_t  *NdefMap)
         NdefMap->psDepAdditionalInfo.DepFlags.MetaChaining = PH_FRINFC_NDEFMAP_MFUL_VAL0;
         NdefMap->psDepAdditionalInfo.DepFlags.NADPresent = PH_FRINFC_NDEFMAP_MFUL_VAL0;
         NdefMap->psDepAdditionalInfo.NAD = PH_FRINFC_NDEFMAP_MFUL_VAL0;
-        NdefMap->SendRecvBuf[PH_FRINFC_NDEFMAP_MFUL_VAL0] = 
-                                NdefMap->MifareULContainer.CurrentBlock;
-        NdefMap->SendLength = PH_FRINFC_NDEFMAP_MFUL_VAL1;
         *NdefMap->SendRecvLength = NdefMap->TempReceiveLength;
-        /*
-         * Changed 
-         * Description: replace with  phHal_eMifareRead
-         */
+        NdefMap->MifareULContainer.FastReadPages = PH_FRINFC_NDEFMAP_MFUL_VAL0;
+#ifdef NXP_MFUL_FAST_READ
+        NdefMap->MifareULContainer.FastReadPages = 
+                                phFriNfc_MfUL_H_FastReadPages(NdefMap);
+        if (NdefMap->MifareULContainer.FastReadPages != PH_FRINFC_NDEFMAP_MFUL_VAL0)
+        {
+            /* FAST_READ from the current block, framed as the sector select */
+            NdefMap->SendRecvBuf[PH_FRINFC_NDEFMAP_MFUL_VAL0] = 0x00;
+            NdefMap->SendRecvBuf[PH_FRINFC_NDEFMAP_MFUL_VAL1] = 0x00;
+            NdefMap->SendRecvBuf[PH_FRINFC_NDEFMAP_MFUL_VAL2] = 
+                                PH_FRINFC_NDEFMAP_MFUL_CMD_FAST_READ;
+            NdefMap->SendRecvBuf[PH_FRINFC_NDEFMAP_MFUL_VAL3] = 
+                                NdefMap->MifareULContainer.CurrentBlock;
+            NdefMap->SendRecvBuf[PH_FRINFC_NDEFMAP_MFUL_VAL4] = (uint8_t)
+                                (NdefMap->MifareULContainer.CurrentBlock + 
+                                NdefMap->MifareULContainer.FastReadPages - 1);
+            NdefMap->SendLength = PH_FRINFC_NDEFMAP_MFUL_VAL5;
+
+            phFriNfc_MfUL_H_ComputeCrc(CRC_A, &NdefMap->SendRecvBuf[PH_FRINFC_NDEFMAP_MFUL_VAL2], 
+                    NdefMap->SendLength - 2, 
+                    &NdefMap->SendRecvBuf[NdefMap->SendLength], 
+                    &NdefMap->SendRecvBuf[NdefMap->SendLength + 1]);
+            NdefMap->SendLength += PH_FRINFC_NDEFMAP_MFUL_VAL2;
+
+            NdefMap->Cmd.MfCmd = phHal_eMifareRaw;
+        }
+        else
+#endif /* #ifdef NXP_MFUL_FAST_READ */
+        {
+            NdefMap->SendRecvBuf[PH_FRINFC_NDEFMAP_MFUL_VAL0] = 
+                                    NdefMap->MifareULContainer.CurrentBlock;
+            NdefMap->SendLength = PH_FRINFC_NDEFMAP_MFUL_VAL1;
+            /*
+             * Changed 
+             * Description: replace with  phHal_eMifareRead
+             */
 
-        NdefMap->Cmd.MfCmd =  phHal_eMifareRead;
+            NdefMap->Cmd.MfCmd =  phHal_eMifareRead;
+        }
         
         /* Call the overlapped HAL Transceive function */ 
         Result = phFriNfc_OvrHal_Transceive(    NdefMap->LowerDevice,
@@ -1499,6 +1609,11 @@ static NFCSTATUS   phFriNfc_MfUL_H_Wr4bytes(  phFriNfc_NdefMap_t  *NdefMap)
     NdefMap->MapCompletionInfo.Context = NdefMap;
 
     NdefMap->SendLength = PH_FRINFC_NDEFMAP_MFUL_WR_A_BLK;
+
+    /* Keep the known content of the card in line with the block written */
+    (void)phFriNfc_MfUL_H_DiffBlock(NdefMap, PH_FRINFC_NDEFMAP_MFUL_FLAG1);
+    NdefMap->WrBlocksWritten++;
+
     /*Call the Overlapped HAL Transceive function */ 
     Result = phFriNfc_OvrHal_Transceive(NdefMap->LowerDevice,
                                         &NdefMap->MapCompletionInfo,
@@ -2174,6 +2289,136 @@ static NFCSTATUS  phFriNfc_MfUL_H_SelectSector(phFriNfc_NdefMap_t  *NdefMap,
      return Result;
 }
 
+#ifdef NXP_MFUL_FAST_READ
+static NFCSTATUS  phFriNfc_MfUL_H_GetVersion(phFriNfc_NdefMap_t  *NdefMap)
+{
+    NFCSTATUS   Result = NFCSTATUS_SUCCESS;
+
+    /* set the data for additional data exchange */
+    NdefMap->psDepAdditionalInfo.DepFlags.MetaChaining = PH_FRINFC_NDEFMAP_MFUL_VAL0;
+    NdefMap->psDepAdditionalInfo.DepFlags.NADPresent = PH_FRINFC_NDEFMAP_MFUL_VAL0;
+    NdefMap->psDepAdditionalInfo.NAD = PH_FRINFC_NDEFMAP_MFUL_VAL0;
+
+    NdefMap->State = PH_FRINFC_NDEFMAP_MFUL_STATE_GET_VERSION;
+
+    NdefMap->SendRecvBuf[PH_FRINFC_NDEFMAP_MFUL_VAL0] = 0x00;
+    NdefMap->SendRecvBuf[PH_FRINFC_NDEFMAP_MFUL_VAL1] = 0x00;
+    NdefMap->SendRecvBuf[PH_FRINFC_NDEFMAP_MFUL_VAL2] = 
+                                PH_FRINFC_NDEFMAP_MFUL_CMD_GET_VERSION;
+    NdefMap->SendLength = PH_FRINFC_NDEFMAP_MFUL_VAL3;
+
+    /* Calculate CRC */
+    phFriNfc_MfUL_H_ComputeCrc(CRC_A, &NdefMap->SendRecvBuf[PH_FRINFC_NDEFMAP_MFUL_VAL2], 
+            NdefMap->SendLength - 2, 
+            &NdefMap->SendRecvBuf[NdefMap->SendLength], 
+            &NdefMap->SendRecvBuf[NdefMap->SendLength + 1]);
+    NdefMap->SendLength += PH_FRINFC_NDEFMAP_MFUL_VAL2; 
+
+    *NdefMap->SendRecvLength = NdefMap->TempReceiveLength;
+
+    NdefMap->Cmd.MfCmd = phHal_eMifareRaw;
+
+    /* Call the overlapped HAL Transceive function */ 
+    Result = phFriNfc_OvrHal_Transceive(     NdefMap->LowerDevice,
+                                             &NdefMap->MapCompletionInfo,
+                                             NdefMap->psRemoteDevInfo,
+                                             NdefMap->Cmd,
+                                             &NdefMap->psDepAdditionalInfo,
+                                             NdefMap->SendRecvBuf,
+                                             NdefMap->SendLength,
+                                             NdefMap->SendRecvBuf,
+                                             NdefMap->SendRecvLength);
+    return Result;
+}
+
+static uint8_t phFriNfc_MfUL_H_FastReadPages(phFriNfc_NdefMap_t  *NdefMap)
+{
+    uint16_t    Target = PH_FRINFC_NDEFMAP_MFUL_VAL0,
+                Pages = PH_FRINFC_NDEFMAP_MFUL_VAL0,
+                LastBlock = PH_FRINFC_NDEFMAP_MFUL_VAL0;
+
+    if ((NdefMap->MifareULContainer.FastRead == 
+        PH_FRINFC_NDEFMAP_MFUL_FASTRD_SUPPORTED) && 
+        (NdefMap->MifareULContainer.CurrentSector == PH_FRINFC_NDEFMAP_MFUL_VAL0))
+    {
+        /* Bytes still to be read, as counted by the read state */
+        Target = (uint16_t)(NdefMap->TLVStruct.ActualSize + 
+                (((NdefMap->TLVStruct.NdefTLVBlock - PH_FRINFC_NDEFMAP_MFUL_BLOCK4) 
+                * PH_FRINFC_NDEFMAP_MFUL_VAL4) + (NdefMap->TLVStruct.NdefTLVByte - 1) + 4));
+        if (Target > NdefMap->MifareULContainer.ReadBufIndex)
+        {
+            Pages = (uint16_t)(((Target - NdefMap->MifareULContainer.ReadBufIndex) + 
+                    PH_FRINFC_NDEFMAP_MFUL_VAL3) / PH_FRINFC_NDEFMAP_MFUL_VAL4);
+        }
+
+        /* Never beyond the data area of the card, the frame or the read buffer */
+        LastBlock = (uint16_t)(PH_FRINFC_NDEFMAP_MFUL_BLOCK4 - 1 + 
+                    (NdefMap->CardMemSize / PH_FRINFC_NDEFMAP_MFUL_VAL4));
+        if (LastBlock > 0xFF)
+        {
+            LastBlock = 0xFF;
+        }
+        if (Pages > NXP_MFUL_FAST_READ_PAGES)
+        {
+            Pages = NXP_MFUL_FAST_READ_PAGES;
+        }
+        if (Pages > (NdefMap->TempReceiveLength / PH_FRINFC_NDEFMAP_MFUL_VAL4))
+        {
+            Pages = (uint16_t)(NdefMap->TempReceiveLength / PH_FRINFC_NDEFMAP_MFUL_VAL4);
+        }
+        if (Pages > ((PH_FRINFC_NDEFMAP_MFUL_64BYTES_BUF - 
+            NdefMap->MifareULContainer.ReadBufIndex) / PH_FRINFC_NDEFMAP_MFUL_VAL4))
+        {
+            Pages = (uint16_t)((PH_FRINFC_NDEFMAP_MFUL_64BYTES_BUF - 
+                    NdefMap->MifareULContainer.ReadBufIndex) / PH_FRINFC_NDEFMAP_MFUL_VAL4);
+        }
+        if (NdefMap->MifareULContainer.CurrentBlock > LastBlock)
+        {
+            Pages = PH_FRINFC_NDEFMAP_MFUL_VAL0;
+        }
+        else if (Pages > (LastBlock - NdefMap->MifareULContainer.CurrentBlock + 1))
+        {
+            Pages = (uint16_t)(LastBlock - NdefMap->MifareULContainer.CurrentBlock + 1);
+        }
+
+        /* A READ does as well for 4 pages or less, and wraps around the
+            end of the card where FAST_READ fails */
+        if (Pages <= PH_FRINFC_NDEFMAP_MFUL_VAL4)
+        {
+            Pages = PH_FRINFC_NDEFMAP_MFUL_VAL0;
+        }
+    }
+    return (uint8_t)Pages;
+}
+
+static uint8_t phFriNfc_MfUL_H_KnownVersion(phFriNfc_NdefMap_t  *NdefMap)
+{
+    uint8_t     FastRead = PH_FRINFC_NDEFMAP_MFUL_FASTRD_UNKNOWN;
+    phHal_sIso14443AInfo_t  *psIso14443AInfo = 
+                    &NdefMap->psRemoteDevInfo->RemoteDevInfo.Iso14443A_Info;
+
+    if ((psIso14443AInfo->UidLength != PH_FRINFC_NDEFMAP_MFUL_UID_LEN) || 
+        (psIso14443AInfo->Uid[PH_FRINFC_NDEFMAP_MFUL_VAL0] != 
+        PH_FRINFC_NDEFMAP_MFUL_VENDOR_NXP) || 
+        (psIso14443AInfo->Sak != PH_FRINFC_NDEFMAP_MFUL_SAK))
+    {
+        /* Not an NXP Type 2 Tag, no UL EV1 nor NTAG */
+        FastRead = PH_FRINFC_NDEFMAP_MFUL_FASTRD_UNSUPPORTED;
+    }
+    else if (0 == memcmp(NdefMap->MifareULContainer.VersionUid, 
+                        psIso14443AInfo->Uid, PH_FRINFC_NDEFMAP_MFUL_UID_LEN))
+    {
+        /* Identified by a previous check, UNKNOWN if never identified */
+        FastRead = NdefMap->MifareULContainer.VersionFastRead;
+    }
+    else
+    {
+        /* GET_VERSION needed */
+    }
+    return FastRead;
+}
+#endif /* #ifdef NXP_MFUL_FAST_READ */
+
 
 static NFCSTATUS   phFriNfc_MfUL_H_RdCardfindNdefTLV( phFriNfc_NdefMap_t  *NdefMap,
                                                    uint8_t              BlockNo)
@@ -2407,6 +2652,37 @@ static void phFriNfc_MfUL_H_UpdateLen(phFriNfc_NdefMap_t        *NdefMap,
                 Result = PHNFCSTVAL(CID_FRI_NFC_NDEF_MAP, 
                                     NFCSTATUS_NO_NDEF_SUPPORT);
             }
+#ifdef NXP_MFUL_FAST_READ
+            else if ((NdefMap->MifareULContainer.FastRead == 
+                    PH_FRINFC_NDEFMAP_MFUL_FASTRD_UNKNOWN) && 
+                    (NdefMap->CardMemSize > PH_FRINFC_NDEFMAP_STMFUL_MAX_CARD_SZ))
+            {
+                /* NXP cards larger than the Mifare UL may be UL EV1 or NTAG,
+                    identify them once the check has succeeded, if their
+                    message needs more than one READ */
+                NdefMap->MifareULContainer.FastRead = 
+                                phFriNfc_MfUL_H_KnownVersion(NdefMap);
+                if ((NdefMap->MifareULContainer.FastRead == 
+                    PH_FRINFC_NDEFMAP_MFUL_FASTRD_UNKNOWN) && 
+                    ((NdefMap->TLVStruct.ActualSize + 
+                    ((NdefMap->TLVStruct.NdefTLVBlock - PH_FRINFC_NDEFMAP_MFUL_BLOCK4) 
+                    * PH_FRINFC_NDEFMAP_MFUL_VAL4) + (NdefMap->TLVStruct.NdefTLVByte - 1) + 4) > 
+                    PH_FRINFC_NDEFMAP_MFUL_RDBYTES_16))
+                {
+                    Result = phFriNfc_MfUL_H_GetVersion(NdefMap);
+                    if (Result == NFCSTATUS_PENDING)
+                    {
+                        *CRFlag = PH_FRINFC_NDEFMAP_MFUL_FLAG0;
+                    }
+                    else
+                    {
+                        NdefMap->MifareULContainer.FastRead = 
+                                    PH_FRINFC_NDEFMAP_MFUL_FASTRD_UNSUPPORTED;
+                        Result = NFCSTATUS_SUCCESS;
+                    }
+                }
+            }
+#endif /* #ifdef NXP_MFUL_FAST_READ */
             break;
 
         case PH_FRINFC_NDEFMAP_READ_OPE:
@@ -2454,6 +2730,7 @@ static NFCSTATUS phFriNfc_MfUL_H_CopyRdBytes(phFriNfc_NdefMap_t  *NdefMap)
 {
     NFCSTATUS Result = NFCSTATUS_SUCCESS;
     uint16_t localCurrentBlock;
+    uint8_t BlocksRead;
 
 #ifndef NDEF_READ_CHANGE
 	uint16_t			v_field_byte = 0;
@@ -2523,17 +2800,23 @@ static NFCSTATUS phFriNfc_MfUL_H_CopyRdBytes(phFriNfc_NdefMap_t  *NdefMap)
     NdefMap->MifareULContainer.ReadBufIndex=NdefMap->MifareULContainer.ReadBufIndex +*NdefMap->SendRecvLength;
 #endif /* #ifndef NDEF_READ_CHANGE */
 
+    /* A READ returns 4 blocks, a FAST_READ the blocks it asked */
+    BlocksRead = ((NdefMap->MifareULContainer.FastReadPages == 
+                    PH_FRINFC_NDEFMAP_MFUL_VAL0)?
+                    PH_FRINFC_NDEFMAP_MFUL_BLOCK4:
+                    NdefMap->MifareULContainer.FastReadPages);
+
     localCurrentBlock = NdefMap->MifareULContainer.CurrentBlock+
                             (uint8_t)((NdefMap->MifareULContainer.ReadBufIndex != 
                             NdefMap->CardMemSize)?
-                            PH_FRINFC_NDEFMAP_MFUL_BLOCK4:
+                            BlocksRead:
                             PH_FRINFC_NDEFMAP_MFUL_VAL0);
     if (localCurrentBlock < 256)
     {
         NdefMap->MifareULContainer.CurrentBlock =  NdefMap->MifareULContainer.CurrentBlock+
                             (uint8_t)((NdefMap->MifareULContainer.ReadBufIndex != 
                             NdefMap->CardMemSize)?
-                            PH_FRINFC_NDEFMAP_MFUL_BLOCK4:
+                            BlocksRead:
                             PH_FRINFC_NDEFMAP_MFUL_VAL0);
     }
     else 
@@ -2962,6 +3245,12 @@ static NFCSTATUS phFriNfc_MfUL_H_fillSendBufToWr(phFriNfc_NdefMap_t *NdefMap)
     uint16_t    RemainingBytes = PH_FRINFC_NDEFMAP_MFUL_VAL0,
                 BytesToWrite = PH_FRINFC_NDEFMAP_MFUL_VAL0;
     uint8_t     index = PH_FRINFC_NDEFMAP_MFUL_VAL0;
+    /* A block carrying the remaining L bytes is always written, the
+        length is set to 0 before the data blocks are written */
+    uint8_t     SkipAllowed = (uint8_t)((NdefMap->NumOfLReminWrite == 
+                                PH_FRINFC_NDEFMAP_MFUL_VAL0)?
+                                PH_FRINFC_NDEFMAP_MFUL_FLAG1:
+                                PH_FRINFC_NDEFMAP_MFUL_FLAG0);
     
     RemainingBytes = (uint16_t)(( (NdefMap->ApduBufferSize - NdefMap->ApduBuffIndex) <= 
                         NdefMap->MifareULContainer.RemainingSize)?
@@ -3119,11 +3408,79 @@ static NFCSTATUS phFriNfc_MfUL_H_fillSendBufToWr(phFriNfc_NdefMap_t *NdefMap)
 
     NdefMap->NumOfLReminWrite = 0;
     
-    /* Start writing to the current block */
-    Result = phFriNfc_MfUL_H_Wr4bytes(NdefMap);
+    if ((SkipAllowed == PH_FRINFC_NDEFMAP_MFUL_FLAG1) && 
+        (phFriNfc_MfUL_H_DiffBlock(NdefMap, PH_FRINFC_NDEFMAP_MFUL_FLAG0) == 
+        PH_FRINFC_NDEFMAP_MFUL_FLAG1))
+    {
+        /* The card already holds this block, continue as if it was
+            written. The length is always written last, so the chain
+            ends with a write to the card */
+        NdefMap->WrBlocksSkipped++;
+        Result = phFriNfc_MfUL_H_ProWrittenBytes(NdefMap);
+    }
+    else
+    {
+        /* Start writing to the current block */
+        Result = phFriNfc_MfUL_H_Wr4bytes(NdefMap);
+    }
 
     return Result; 
 }
+
+static uint8_t phFriNfc_MfUL_H_DiffBlock(phFriNfc_NdefMap_t   *NdefMap,
+                                         uint8_t              Update)
+{
+    uint8_t     Unchanged = PH_FRINFC_NDEFMAP_MFUL_FLAG0,
+                i = PH_FRINFC_NDEFMAP_MFUL_VAL0;
+    uint32_t    TLVOffset = PH_FRINFC_NDEFMAP_MFUL_VAL0,
+                BlockOffset = PH_FRINFC_NDEFMAP_MFUL_VAL0,
+                ImageIndex = PH_FRINFC_NDEFMAP_MFUL_VAL0;
+
+    /* Only the cards with the NDEF TLV in the sector 0 are handled */
+    if ((NdefMap->DiffImage != NULL) && 
+        (NdefMap->TLVStruct.NdefTLVSector == PH_FRINFC_NDEFMAP_MFUL_VAL0) && 
+        (NdefMap->MifareULContainer.CurrentSector == PH_FRINFC_NDEFMAP_MFUL_VAL0))
+    {
+        /* Offset of the T byte of the NDEF TLV in the card */
+        TLVOffset = ((NdefMap->TLVStruct.NdefTLVBlock * 
+                    PH_FRINFC_NDEFMAP_MFUL_BYTE4) + 
+                    (NdefMap->TLVStruct.NdefTLVByte - 
+                    PH_FRINFC_NDEFMAP_MFUL_VAL1));
+        BlockOffset = (NdefMap->SendRecvBuf[PH_FRINFC_NDEFMAP_MFUL_VAL0] * 
+                    PH_FRINFC_NDEFMAP_MFUL_BYTE4);
+
+        /* The block can be skipped only if all its bytes are known */
+        Unchanged = (uint8_t)(((BlockOffset >= TLVOffset) && 
+                    ((BlockOffset + PH_FRINFC_NDEFMAP_MFUL_BYTE4) <= 
+                    (TLVOffset + NdefMap->DiffImageLength)))?
+                    PH_FRINFC_NDEFMAP_MFUL_FLAG1:
+                    PH_FRINFC_NDEFMAP_MFUL_FLAG0);
+
+        for (i = PH_FRINFC_NDEFMAP_MFUL_VAL0; i < PH_FRINFC_NDEFMAP_MFUL_BYTE4; i++)
+        {
+            if (((BlockOffset + i) >= TLVOffset) && 
+                ((BlockOffset + i) < (TLVOffset + NdefMap->DiffImageLength)))
+            {
+                ImageIndex = ((BlockOffset + i) - TLVOffset);
+                if (Update == PH_FRINFC_NDEFMAP_MFUL_FLAG1)
+                {
+                    NdefMap->DiffImage[ImageIndex] = 
+                        NdefMap->SendRecvBuf[(i + PH_FRINFC_NDEFMAP_MFUL_VAL1)];
+                }
+                else if (NdefMap->DiffImage[ImageIndex] != 
+                        NdefMap->SendRecvBuf[(i + PH_FRINFC_NDEFMAP_MFUL_VAL1)])
+                {
+                    Unchanged = PH_FRINFC_NDEFMAP_MFUL_FLAG0;
+                }
+                else
+                {
+                    /* Byte unchanged */
+                }
+            }
+        }
+    }
+    return Unchanged;
+}
 static NFCSTATUS phFriNfc_MfUL_H_WrTermTLV(phFriNfc_NdefMap_t   *NdefMap)
 {
     NFCSTATUS   Result = NFCSTATUS_SUCCESS;
@@ -65,6 +65,7 @@
 #define PH_FRINFC_NDEFMAP_MFUL_STATE_SELECT_SECTOR_RW_2		 16   /*!< to send sector select command 2 for resetting sector 0 */
 #define PH_FRINFC_NDEFMAP_MFUL_STATE_SELECT_SECTOR_WRITE_INIT_1       17   /*!< to send sector select command 1 for resetting sector 0 */
 #define PH_FRINFC_NDEFMAP_MFUL_STATE_SELECT_SECTOR_WRITE_INIT_2		 18   /*!< to send sector select command 2 for resetting sector 0 */
+#define PH_FRINFC_NDEFMAP_MFUL_STATE_GET_VERSION                 19   /*!< to identify the Tag after the check */
 
 
 /*@}*/
@@ -152,6 +153,27 @@
 #define PH_FRINFC_NDEFMAP_MFUL_WR_BUF_STR               0x04 /*!< To store the block of data written to the card */
 /*@}*/
 
+/*!
+ * \name Mifare UL EV1 and NTAG - GET_VERSION and FAST_READ constants
+ *
+ */
+/*@{*/
+#define PH_FRINFC_NDEFMAP_MFUL_CMD_GET_VERSION          0x60 /*!< GET_VERSION command code */
+#define PH_FRINFC_NDEFMAP_MFUL_CMD_FAST_READ            0x3A /*!< FAST_READ command code */
+#define PH_FRINFC_NDEFMAP_MFUL_VERSION_LEN              0x08 /*!< Length of the GET_VERSION response */
+#define PH_FRINFC_NDEFMAP_MFUL_VERSION_VENDOR           0x01 /*!< Index of the vendor ID in the response */
+#define PH_FRINFC_NDEFMAP_MFUL_VERSION_TYPE             0x02 /*!< Index of the product type in the response */
+#define PH_FRINFC_NDEFMAP_MFUL_VENDOR_NXP               0x04 /*!< Vendor ID of NXP */
+#define PH_FRINFC_NDEFMAP_MFUL_TYPE_ULTRALIGHT          0x03 /*!< Product type of the Mifare UL EV1 */
+#define PH_FRINFC_NDEFMAP_MFUL_TYPE_NTAG                0x04 /*!< Product type of the NTAG */
+#define PH_FRINFC_NDEFMAP_MFUL_SAK                      0x00 /*!< SAK of the Mifare UL, UL EV1 and NTAG */
+#define PH_FRINFC_NDEFMAP_MFUL_UID_LEN                  0x07 /*!< Length of the UID of the NXP Type 2 Tags,
+                                                                  starting with the NXP manufacturer code */
+#define PH_FRINFC_NDEFMAP_MFUL_FASTRD_UNKNOWN           0x00 /*!< GET_VERSION not sent yet */
+#define PH_FRINFC_NDEFMAP_MFUL_FASTRD_SUPPORTED         0x01 /*!< FAST_READ used for the NDEF reads */
+#define PH_FRINFC_NDEFMAP_MFUL_FASTRD_UNSUPPORTED       0x02 /*!< READ used for the NDEF reads */
+/*@}*/
+
 /*!
  * \brief \copydoc page_reg Resets the component instance to the initial state and lets the component forget about
  *        the list of registered items. Moreover, the lower device is set.
@@ -499,6 +499,15 @@ typedef struct phFriNfc_MifareStdCont
     uint8_t             SectorTrailerBlockNo;
     /** Secret key B to given by the application */
     uint8_t             UserScrtKeyB[6];
+    /** Sector authenticated by the last successful authentication */
+    uint8_t             AuthSector;
+    /** Key used for AuthSector, none if no sector is authenticated */
+    uint8_t             AuthKey;
+    /** Number of authentication commands sent to the card */
+    uint32_t            AuthCount;
+    /** Number of authentications skipped as the sector was already
+        authenticated with the same key */
+    uint32_t            AuthSkipped;
 }phFriNfc_MifareStdCont_t;
 /*@}*/
 #endif  /* PH_FRINFC_MAP_MIFARESTD_DISABLED */
@@ -560,6 +569,14 @@ typedef struct phFriNfc_MifareULCont
     uint8_t             ReadWriteCompleteFlag;
     /** Buffer to store 4 bytes of data which is written to a block */
     uint8_t             Buffer[PH_FRINFC_NDEFMAP_MFUL_4BYTES_BUF];
+    /** FAST_READ support of the card, as reported by GET_VERSION */
+    uint8_t             FastRead;
+    /** number of pages asked by the pending FAST_READ, 0 for a READ */
+    uint8_t             FastReadPages;
+    /** UID of the card identified by the last GET_VERSION and its FAST_READ
+        support, kept across the checks to identify a card only once */
+    uint8_t             VersionUid[PHHAL_MAX_UID_LENGTH];
+    uint8_t             VersionFastRead;
 }phFriNfc_MifareULCont_t;
 #endif  /* PH_FRINFC_MAP_MIFAREUL_DISABLED */
 
@@ -878,6 +895,25 @@ typedef struct phFriNfc_NdefMap
     /**\internal used to remember number of L byte Remaining to be written */
     uint16_t                        NumOfLReminWrite;
 
+    /** \internal  Known content of the NDEF TLV on the card, starting at its
+                   T byte, or NULL. The Mifare UL write operation does not
+                   write again the data blocks found unchanged in it, and
+                   keeps it in line with the blocks written. */
+    uint8_t                         *DiffImage;
+
+    /** \internal  Number of bytes in DiffImage */
+    uint32_t                        DiffImageLength;
+
+    /** \internal  Blocks written and blocks found unchanged by the last
+                   Mifare UL write operation */
+    uint16_t                        WrBlocksWritten;
+    uint16_t                        WrBlocksSkipped;
+
+    /** \internal  Set when a command not supported by the card left it
+                   idle: the card must be activated again before the next
+                   operation */
+    uint8_t                         ReActivate;
+
     /** \internal  Pointer Used to remeber and return how many bytes were read,
                    to update the PacketDataLength in case of Read operation */
     /*  Fix for 0000238: [gk] MAP: Number of bytes actually read out is
@@ -46,6 +46,24 @@
 /* Harsha: To Fix: 0000358: phFriNfc_NdefRecord.h: includes should be moved */
 #include <string.h>
 
+/* The record at Index continues the payload of a chunked record */
+#define PH_FRINFC_NDEFRECORD_IN_CHUNK(Records, Index) \
+    ((uint8_t)(((Index) != 0) && \
+               (((Records)[(Index) - 1].Flags & PH_FRINFC_NDEFRECORD_FLAGS_CF) != 0)))
+
+/*
+ *  Sub function of the Message functions. It checks one record and encodes its header
+ *  (flags, type length, payload length and optional ID length) with the flags chosen for its
+ *  position in the message. InChunk tells that the previous record has the CF flag set.
+ *  Header receives at least PH_FRINFC_NDEFRECORD_HEADER_MAX bytes.
+ */
+static NFCSTATUS phFriNfc_NdefRecord_EncodeHeader(phFriNfc_NdefRecord_t *Record,
+                                                  uint8_t               Flags,
+                                                  uint8_t               InChunk,
+                                                  uint8_t               *Header,
+                                                  uint8_t               *HeaderLength,
+                                                  uint32_t              *RecordLength);
+
 
 /*!
  *
@@ -99,6 +117,7 @@
                 IDLength = 0;
     uint32_t    Count = 0,              
                 PayloadLength = 0,
+                HeaderLength = 0,
                 BytesTraversed = 0;
     
     /*  Validate the input parameters */
@@ -168,10 +187,11 @@
     }
 
     /* First Record i.e., MB = 1, TNF != 0x05 and TypeLength = 0 */
-    if ( (*Buffer & PH_FRINFC_NDEFRECORD_FLAGS_MB) == PH_FRINFC_NDEFRECORD_FLAGS_MB &&
+    if ( BufferLength < PH_FRINFC_NDEFRECORD_BUF_INC2 ||
+        ((*Buffer & PH_FRINFC_NDEFRECORD_FLAGS_MB) == PH_FRINFC_NDEFRECORD_FLAGS_MB &&
          (*Buffer & PH_FRINFC_NDEFRECORD_TNFBYTE_MASK) != PH_FRINFC_NDEFRECORD_TNF_UNKNOWN &&
          (*Buffer & PH_FRINFC_NDEFRECORD_TNFBYTE_MASK) != PH_FRINFC_NDEFRECORD_TNF_EMPTY &&
-         *(Buffer + 1) == 0)
+         *(Buffer + 1) == 0))
     {
         Status = PHNFCSTVAL(CID_FRI_NFC_NDEF_RECORD, 
                             NFCSTATUS_INVALID_FORMAT);
@@ -224,6 +244,20 @@
             }
         }
         
+        /* Flags, type length, payload length and optional ID length bytes
+            must all be in the buffer before they are decoded */
+        HeaderLength = PH_FRINFC_NDEFRECORD_BUF_INC2 +
+                       (((*Buffer & PH_FRINFC_NDEFRECORD_FLAGS_SR) == PH_FRINFC_NDEFRECORD_FLAGS_SR)?
+                        PH_FRINFC_NDEFRECORD_BUF_INC1 : PHFRINFCNDEFRECORD_NORMAL_RECORD_BYTE) +
+                       (((*Buffer & PH_FRINFC_NDEFRECORD_FLAGS_IL) == PH_FRINFC_NDEFRECORD_FLAGS_IL)?
+                        PH_FRINFC_NDEFRECORD_BUF_INC1 : 0);
+        if (HeaderLength > (BufferLength - BytesTraversed))
+        {
+            Status = PHNFCSTVAL(CID_FRI_NFC_NDEF_RECORD, 
+                                NFCSTATUS_INVALID_FORMAT);
+            break;
+        }
+
         /* To Calculate the IDLength and PayloadLength for 
             short or normal record */
         Status = phFriNfc_NdefRecord_RecordIDCheck (    Buffer,
@@ -317,6 +351,17 @@
             }   /*  if (NoOfRecordsReturnFlag == 0)  */
         }   /*  if (Count > 0)  */
 
+        /*  A 32 bit payload length can not wrap the bytes traversed
+            around: check it against the bytes left in the buffer. */
+        HeaderLength += (uint32_t)TypeLength + IDLength;
+        if (HeaderLength > (BufferLength - BytesTraversed) ||
+            PayloadLength > (BufferLength - BytesTraversed - HeaderLength))
+        {
+            Status = PHNFCSTVAL(CID_FRI_NFC_NDEF_RECORD, 
+                            NFCSTATUS_INVALID_FORMAT);
+            break;
+        }
+
         /*  Calculate the bytes already traversed. */
         BytesTraversed = (BytesTraversed + PayloadLengthByte + IDLengthByte + TypeLength 
                          + IDLength + TypeLengthByte + PayloadLength 
@@ -523,6 +568,373 @@ NFCSTATUS phFriNfc_NdefRecord_Parse(phFriNfc_NdefRecord_t *Record,
 }
 
 
+/*!
+ *  Prepare a single pass traversal of a (possibly still incomplete) NDEF message.
+ *  See \ref phFriNfc_NdefRecord_IteratorNext.
+ */
+NFCSTATUS phFriNfc_NdefRecord_IteratorInit(phFriNfc_NdefRecord_Iterator_t *Iterator,
+                                           uint8_t                        *Buffer,
+                                           uint32_t                       BufferLength,
+                                           uint32_t                       ValidLength)
+{
+    NFCSTATUS   Status = NFCSTATUS_SUCCESS;
+
+    if (Iterator == NULL || Buffer == NULL || BufferLength == 0 ||
+        ValidLength > BufferLength)
+    {
+        Status = PHNFCSTVAL(CID_FRI_NFC_NDEF_RECORD, 
+                            NFCSTATUS_INVALID_PARAMETER);
+    }
+    else
+    {
+        Iterator->Buffer = Buffer;
+        Iterator->BufferLength = BufferLength;
+        Iterator->ValidLength = ValidLength;
+        Iterator->Offset = 0;
+        Iterator->Count = 0;
+        Iterator->PrevFlags = 0;
+        Iterator->Status = NFCSTATUS_SUCCESS;
+    }
+    return Status;
+}
+
+
+/*!
+ *  Make more bytes of the NDEF message available to the iterator.
+ */
+NFCSTATUS phFriNfc_NdefRecord_IteratorFeed(phFriNfc_NdefRecord_Iterator_t *Iterator,
+                                           uint32_t                       ValidLength)
+{
+    NFCSTATUS   Status = NFCSTATUS_SUCCESS;
+
+    if (Iterator == NULL || ValidLength < Iterator->ValidLength ||
+        ValidLength > Iterator->BufferLength)
+    {
+        Status = PHNFCSTVAL(CID_FRI_NFC_NDEF_RECORD, 
+                            NFCSTATUS_INVALID_PARAMETER);
+    }
+    else
+    {
+        Iterator->ValidLength = ValidLength;
+    }
+    return Status;
+}
+
+
+/*!
+ *  Validate and decode the next record of the message. The checks are the ones done by
+ *  \ref phFriNfc_NdefRecord_GetRecords, applied to one record at a time, so that both
+ *  functions accept and reject exactly the same messages. In addition a record header
+ *  running past the end of the message is reported as a format error instead of being read.
+ */
+NFCSTATUS phFriNfc_NdefRecord_IteratorNext(phFriNfc_NdefRecord_Iterator_t *Iterator,
+                                           phFriNfc_NdefRecord_t          *Record)
+{
+    NFCSTATUS   Status = NFCSTATUS_SUCCESS;
+    uint8_t     *RawRecord,
+                Header,
+                PayloadLengthByte = 0,
+                TypeLengthByte = 0,
+                TypeLength = 0,
+                IDLengthByte = 0,
+                IDLength = 0;
+    uint32_t    PayloadLength = 0,
+                HeaderLength,
+                Remaining;
+
+    if (Iterator == NULL || Record == NULL)
+    {
+        return PHNFCSTVAL(CID_FRI_NFC_NDEF_RECORD, 
+                          NFCSTATUS_INVALID_PARAMETER);
+    }
+
+    /* End of message or error already reached */
+    if (Iterator->Status != NFCSTATUS_SUCCESS)
+    {
+        return Iterator->Status;
+    }
+
+    if (Iterator->Offset >= Iterator->ValidLength)
+    {
+        return PHNFCSTVAL(CID_FRI_NFC_NDEF_RECORD, 
+                          NFCSTATUS_MORE_INFORMATION);
+    }
+
+    RawRecord = Iterator->Buffer + Iterator->Offset;
+    Header = *RawRecord;
+    Remaining = Iterator->BufferLength - Iterator->Offset;
+
+    /* Flags, type length, payload length and optional ID length bytes */
+    HeaderLength = PH_FRINFC_NDEFRECORD_BUF_INC2 +
+                   (((Header & PH_FRINFC_NDEFRECORD_FLAGS_SR) == PH_FRINFC_NDEFRECORD_FLAGS_SR)?
+                    PH_FRINFC_NDEFRECORD_BUF_INC1 : PHFRINFCNDEFRECORD_NORMAL_RECORD_BYTE) +
+                   (((Header & PH_FRINFC_NDEFRECORD_FLAGS_IL) == PH_FRINFC_NDEFRECORD_FLAGS_IL)?
+                    PH_FRINFC_NDEFRECORD_BUF_INC1 : 0);
+
+    if (HeaderLength > Remaining)
+    {
+        Status = PHNFCSTVAL(CID_FRI_NFC_NDEF_RECORD, 
+                            NFCSTATUS_INVALID_FORMAT);
+    }
+    else if (HeaderLength > (Iterator->ValidLength - Iterator->Offset))
+    {
+        return PHNFCSTVAL(CID_FRI_NFC_NDEF_RECORD, 
+                          NFCSTATUS_MORE_INFORMATION);
+    }
+    else if (Iterator->Count == 0)
+    {
+        /* First record: MB set, TNF neither reserved nor unchanged, and a
+            type present unless TNF is empty or unknown */
+        if ((Header & PH_FRINFC_NDEFRECORD_FLAGS_MB) != PH_FRINFC_NDEFRECORD_FLAGS_MB ||
+            (Header & PH_FRINFC_NDEFRECORD_TNFBYTE_MASK) == PH_FRINFC_NDEFRECORD_TNF_RESERVED ||
+            (Header & PH_FRINFC_NDEFRECORD_TNF_UNCHANGED) == PH_FRINFC_NDEFRECORD_TNF_UNCHANGED ||
+            ((Header & PH_FRINFC_NDEFRECORD_TNFBYTE_MASK) != PH_FRINFC_NDEFRECORD_TNF_UNKNOWN &&
+             (Header & PH_FRINFC_NDEFRECORD_TNFBYTE_MASK) != PH_FRINFC_NDEFRECORD_TNF_EMPTY &&
+             *(RawRecord + PH_FRINFC_NDEFRECORD_BUF_INC1) == 0))
+        {
+            Status = PHNFCSTVAL(CID_FRI_NFC_NDEF_RECORD, 
+                                NFCSTATUS_INVALID_FORMAT);
+        }
+    }
+    else
+    {
+        /* Not a first record: no MB, no IL on a middle chunk, and TNF unchanged
+            exactly when the previous record is chunked */
+        if (((Header & PH_FRINFC_NDEFRECORD_FLAGS_CF) == PH_FRINFC_NDEFRECORD_FLAGS_CF && 
+             (Header & PH_FRINFC_NDEFRECORD_FLAGS_IL) == PH_FRINFC_NDEFRECORD_FLAGS_IL && 
+             (Header & PH_FRINFC_NDEFRECORD_TNFBYTE_MASK) == PH_FRINFC_NDEFRECORD_TNF_UNCHANGED) || 
+            (Header & PH_FRINFC_NDEFRECORD_FLAGS_MB) == PH_FRINFC_NDEFRECORD_FLAGS_MB ||
+            (((Iterator->PrevFlags & PH_FRINFC_NDEFRECORD_FLAGS_CF) == PH_FRINFC_NDEFRECORD_FLAGS_CF) !=
+             ((Header & PH_FRINFC_NDEFRECORD_TNFBYTE_MASK) == PH_FRINFC_NDEFRECORD_TNF_UNCHANGED)))
+        {
+            Status = PHNFCSTVAL(CID_FRI_NFC_NDEF_RECORD, 
+                                NFCSTATUS_INVALID_FORMAT);
+        }
+    }
+
+    /* A chunked record can not end the message */
+    if (Status == NFCSTATUS_SUCCESS &&
+        (Header & PH_FRINFC_NDEFRECORD_FLAGS_CF) == PH_FRINFC_NDEFRECORD_FLAGS_CF &&
+        (Header & PH_FRINFC_NDEFRECORD_FLAGS_ME) == PH_FRINFC_NDEFRECORD_FLAGS_ME)
+    {
+        Status = PHNFCSTVAL(CID_FRI_NFC_NDEF_RECORD, 
+                            NFCSTATUS_INVALID_FORMAT);
+    }
+
+    if (Status == NFCSTATUS_SUCCESS)
+    {
+        Status = phFriNfc_NdefRecord_RecordIDCheck (    RawRecord,
+                                                        &TypeLength,
+                                                        &TypeLengthByte,
+                                                        &PayloadLengthByte,
+                                                        &PayloadLength,
+                                                        &IDLengthByte,
+                                                        &IDLength);
+    }
+
+    /* Last chunk: no type and no ID */
+    if (Status == NFCSTATUS_SUCCESS && Iterator->Count > 0 &&
+        (Iterator->PrevFlags & PH_FRINFC_NDEFRECORD_FLAGS_CF) == PH_FRINFC_NDEFRECORD_FLAGS_CF &&
+        (Header & PH_FRINFC_NDEFRECORD_FLAGS_CF) != PH_FRINFC_NDEFRECORD_FLAGS_CF &&
+        (TypeLength != 0 || IDLength != 0))
+    {
+        Status = PHNFCSTVAL(CID_FRI_NFC_NDEF_RECORD, 
+                            NFCSTATUS_INVALID_FORMAT);
+    }
+
+    if (Status == NFCSTATUS_SUCCESS)
+    {
+        /* The record must end inside the message, and the message must end
+            with the ME record */
+        HeaderLength += (uint32_t)TypeLength + IDLength;
+        if (HeaderLength > Remaining ||
+            PayloadLength > (Remaining - HeaderLength) ||
+            ((PayloadLength == (Remaining - HeaderLength)) &&
+             (Header & PH_FRINFC_NDEFRECORD_FLAGS_ME) != PH_FRINFC_NDEFRECORD_FLAGS_ME))
+        {
+            Status = PHNFCSTVAL(CID_FRI_NFC_NDEF_RECORD, 
+                                NFCSTATUS_INVALID_FORMAT);
+        }
+    }
+
+    if (Status != NFCSTATUS_SUCCESS)
+    {
+        Iterator->Status = Status;
+        return Status;
+    }
+
+    if ((HeaderLength + PayloadLength) > (Iterator->ValidLength - Iterator->Offset))
+    {
+        return PHNFCSTVAL(CID_FRI_NFC_NDEF_RECORD, 
+                          NFCSTATUS_MORE_INFORMATION);
+    }
+
+    Record->Flags = (uint8_t)(Header & PH_FRINFC_NDEFRECORD_FLAG_MASK);
+    Record->Tnf = (uint8_t)(Header & PH_FRINFC_NDEFRECORD_TNFBYTE_MASK);
+    Record->TypeLength = TypeLength;
+    Record->IdLength = IDLength;
+    Record->PayloadLength = PayloadLength;
+
+    RawRecord = (RawRecord + PayloadLengthByte + IDLengthByte + TypeLengthByte + 
+                 PH_FRINFC_NDEFRECORD_BUF_INC1);
+    Record->Type = ((TypeLength != 0)? RawRecord : NULL);
+    RawRecord = RawRecord + TypeLength;
+    Record->Id = ((IDLength != 0)? RawRecord : NULL);
+    Record->PayloadData = RawRecord + IDLength;
+
+    Iterator->Offset += HeaderLength + PayloadLength;
+    Iterator->PrevFlags = Header;
+    Iterator->Count++;
+
+    if ((Header & PH_FRINFC_NDEFRECORD_FLAGS_ME) == PH_FRINFC_NDEFRECORD_FLAGS_ME)
+    {
+        /* Further calls report the end of the message */
+        Iterator->Status = PHNFCSTVAL(CID_FRI_NFC_NDEF_RECORD, 
+                                      NFCSTATUS_EOF_NDEF_CONTAINER_REACHED);
+    }
+    return NFCSTATUS_SUCCESS;
+}
+
+
+/*!
+ *  Return the next logical record, merging chunk sequences. The chunks are walked once to
+ *  validate them and size the payload, and a second time to copy them when needed.
+ */
+NFCSTATUS phFriNfc_NdefRecord_Reassemble(phFriNfc_NdefRecord_Iterator_t *Iterator,
+                                         phFriNfc_NdefRecord_t          *Record,
+                                         phFriNfc_NdefRecord_Arena_t    *Arena,
+                                         phNfc_sData_t                  *Segments,
+                                         uint32_t                       *NumberOfSegments)
+{
+    NFCSTATUS                       Status = NFCSTATUS_SUCCESS;
+    phFriNfc_NdefRecord_Iterator_t  Start;
+    phFriNfc_NdefRecord_t           Chunk;
+    uint32_t                        MaxSegments = 0,
+                                    ChunkCount = 1,
+                                    Filled = 0,
+                                    Index;
+    uint8_t                         *PayloadData;
+
+    if (Iterator == NULL || Record == NULL ||
+        (Segments != NULL && NumberOfSegments == NULL))
+    {
+        return PHNFCSTVAL(CID_FRI_NFC_NDEF_RECORD, 
+                          NFCSTATUS_INVALID_PARAMETER);
+    }
+    if (Segments != NULL)
+    {
+        MaxSegments = *NumberOfSegments;
+    }
+
+    Start = *Iterator;
+    Status = phFriNfc_NdefRecord_IteratorNext(Iterator, Record);
+    if (Status != NFCSTATUS_SUCCESS)
+    {
+        return Status;
+    }
+
+    if (MaxSegments > 0)
+    {
+        Segments[0].buffer = Record->PayloadData;
+        Segments[0].length = Record->PayloadLength;
+    }
+    PayloadData = Record->PayloadData;
+    if (Record->PayloadLength != 0)
+    {
+        Filled = 1;
+    }
+
+    /* Walk the rest of the chunk sequence; IteratorNext already checks
+        that every chunk is TNF unchanged and that the last one has no CF */
+    Chunk.Flags = Record->Flags;
+    while ((Chunk.Flags & PH_FRINFC_NDEFRECORD_FLAGS_CF) == PH_FRINFC_NDEFRECORD_FLAGS_CF)
+    {
+        Status = phFriNfc_NdefRecord_IteratorNext(Iterator, &Chunk);
+        if (Status != NFCSTATUS_SUCCESS)
+        {
+            break;
+        }
+        if (ChunkCount < MaxSegments)
+        {
+            Segments[ChunkCount].buffer = Chunk.PayloadData;
+            Segments[ChunkCount].length = Chunk.PayloadLength;
+        }
+        if (Chunk.PayloadLength != 0)
+        {
+            PayloadData = Chunk.PayloadData;
+            Filled++;
+        }
+        /* Can not overflow: all chunks lie in the same buffer */
+        Record->PayloadLength += Chunk.PayloadLength;
+        Record->Flags |= (uint8_t)(Chunk.Flags & PH_FRINFC_NDEFRECORD_FLAGS_ME);
+        ChunkCount++;
+    }
+
+    if (Status == NFCSTATUS_SUCCESS && ChunkCount > 1)
+    {
+        Record->Flags &= (uint8_t)~PH_FRINFC_NDEFRECORD_FLAGS_CF;
+        if (Record->PayloadLength > 0xFF)
+        {
+            /* The merged payload no longer fits a short record */
+            Record->Flags &= (uint8_t)~PH_FRINFC_NDEFRECORD_FLAGS_SR;
+        }
+
+        if (Filled <= 1)
+        {
+            /* Payload in one piece, point to it in place */
+            Record->PayloadData = PayloadData;
+        }
+        else if (Arena != NULL)
+        {
+            if (Arena->Buffer == NULL || Arena->Used > Arena->Length ||
+                Record->PayloadLength > (Arena->Length - Arena->Used))
+            {
+                Status = PHNFCSTVAL(CID_FRI_NFC_NDEF_RECORD, 
+                                    NFCSTATUS_BUFFER_TOO_SMALL);
+            }
+            else
+            {
+                /* Second walk, copying each chunk payload */
+                Record->PayloadData = Arena->Buffer + Arena->Used;
+                *Iterator = Start;
+                for (Index = 0; Index < ChunkCount; Index++)
+                {
+                    (void)phFriNfc_NdefRecord_IteratorNext(Iterator, &Chunk);
+                    (void)memcpy(Arena->Buffer + Arena->Used, Chunk.PayloadData, 
+                                 Chunk.PayloadLength);
+                    Arena->Used += Chunk.PayloadLength;
+                }
+            }
+        }
+        else if (ChunkCount <= MaxSegments)
+        {
+            /* Scattered payload, only described by the segments */
+            Record->PayloadData = NULL;
+        }
+        else
+        {
+            Status = PHNFCSTVAL(CID_FRI_NFC_NDEF_RECORD, 
+                                NFCSTATUS_BUFFER_TOO_SMALL);
+        }
+    }
+
+    if (Status == NFCSTATUS_SUCCESS)
+    {
+        if (NumberOfSegments != NULL)
+        {
+            *NumberOfSegments = ChunkCount;
+        }
+    }
+    else if (PHNFCSTATUS(Status) == NFCSTATUS_MORE_INFORMATION ||
+             PHNFCSTATUS(Status) == NFCSTATUS_BUFFER_TOO_SMALL)
+    {
+        /* Try again later from the first chunk */
+        *Iterator = Start;
+    }
+    return Status;
+}
+
+
 
 /*!
  *  The function writes one NDEF record to a specified memory location. Called within a loop, it is possible to
@@ -681,6 +1093,310 @@ NFCSTATUS phFriNfc_NdefRecord_Parse(phFriNfc_NdefRecord_t *Record,
     return (PHNFCSTVAL(CID_NFC_NONE, NFCSTATUS_SUCCESS));
 }
 
+
+/*!
+ *  Compute the size of the message built from an array of records.
+ */
+NFCSTATUS phFriNfc_NdefRecord_GetMessageLength(phFriNfc_NdefRecord_t *Records,
+                                               uint32_t              NumberOfRecords,
+                                               uint32_t              *MessageLength)
+{
+    NFCSTATUS   Status = NFCSTATUS_SUCCESS;
+    uint8_t     Header[PH_FRINFC_NDEFRECORD_HEADER_MAX],
+                HeaderLength = 0,
+                Flags;
+    uint32_t    Index,
+                RecordLength = 0,
+                Total = 0;
+
+    if (Records == NULL || NumberOfRecords == 0 || MessageLength == NULL)
+    {
+        return (PHNFCSTVAL(CID_FRI_NFC_NDEF_RECORD, NFCSTATUS_INVALID_PARAMETER));
+    }
+
+    for (Index = 0; (Index < NumberOfRecords) && (Status == NFCSTATUS_SUCCESS); Index++)
+    {
+        Flags = (uint8_t)(((Index == 0)? PH_FRINFC_NDEFRECORD_FLAGS_MB : 0) |
+                          ((Index == (NumberOfRecords - 1))? PH_FRINFC_NDEFRECORD_FLAGS_ME : 0));
+        Status = phFriNfc_NdefRecord_EncodeHeader(&Records[Index], Flags, 
+                                                  PH_FRINFC_NDEFRECORD_IN_CHUNK(Records, Index), Header, 
+                                                  &HeaderLength, &RecordLength);
+        if (Status == NFCSTATUS_SUCCESS)
+        {
+            if (RecordLength > (0xFFFFFFFFU - Total))
+            {
+                /* The message would not fit any buffer */
+                Status = PHNFCSTVAL(CID_FRI_NFC_NDEF_RECORD, NFCSTATUS_INVALID_PARAMETER);
+            }
+            else
+            {
+                Total += RecordLength;
+            }
+        }
+    }
+
+    if (Status == NFCSTATUS_SUCCESS)
+    {
+        *MessageLength = Total;
+    }
+    return Status;
+}
+
+
+/*!
+ *  Serialise an array of records as one NDEF message, choosing the MB, ME, SR and IL flags.
+ *  The size is checked first so that nothing is written if the buffer is too small.
+ */
+NFCSTATUS phFriNfc_NdefRecord_GenerateMessage(phFriNfc_NdefRecord_t *Records,
+                                              uint32_t              NumberOfRecords,
+                                              phNfc_sData_t         *Message)
+{
+    NFCSTATUS   Status = NFCSTATUS_SUCCESS;
+    uint8_t     Header[PH_FRINFC_NDEFRECORD_HEADER_MAX],
+                *Buffer,
+                HeaderLength = 0,
+                Flags;
+    uint32_t    Index,
+                RecordLength = 0,
+                MessageLength = 0;
+
+    if (Message == NULL || Message->buffer == NULL)
+    {
+        return (PHNFCSTVAL(CID_FRI_NFC_NDEF_RECORD, NFCSTATUS_INVALID_PARAMETER));
+    }
+
+    Status = phFriNfc_NdefRecord_GetMessageLength(Records, NumberOfRecords, &MessageLength);
+    if (Status != NFCSTATUS_SUCCESS)
+    {
+        return Status;
+    }
+    if (MessageLength > Message->length)
+    {
+        return (PHNFCSTVAL(CID_FRI_NFC_NDEF_RECORD, NFCSTATUS_BUFFER_TOO_SMALL));
+    }
+
+    Buffer = Message->buffer;
+    for (Index = 0; Index < NumberOfRecords; Index++)
+    {
+        Flags = (uint8_t)(((Index == 0)? PH_FRINFC_NDEFRECORD_FLAGS_MB : 0) |
+                          ((Index == (NumberOfRecords - 1))? PH_FRINFC_NDEFRECORD_FLAGS_ME : 0));
+        /* Already checked by GetMessageLength */
+        (void)phFriNfc_NdefRecord_EncodeHeader(&Records[Index], Flags, 
+                                                  PH_FRINFC_NDEFRECORD_IN_CHUNK(Records, Index), Header, 
+                                               &HeaderLength, &RecordLength);
+        (void)memcpy(Buffer, Header, HeaderLength);
+        Buffer += HeaderLength;
+        RecordLength -= HeaderLength;
+
+        if (Header[PH_FRINFC_NDEFRECORD_BUF_INC1] != 0)
+        {
+            (void)memcpy(Buffer, Records[Index].Type, Records[Index].TypeLength);
+            Buffer += Records[Index].TypeLength;
+            RecordLength -= Records[Index].TypeLength;
+        }
+        if ((Header[0] & PH_FRINFC_NDEFRECORD_FLAGS_IL) != 0)
+        {
+            (void)memcpy(Buffer, Records[Index].Id, Records[Index].IdLength);
+            Buffer += Records[Index].IdLength;
+            RecordLength -= Records[Index].IdLength;
+        }
+        /* What is left is the payload */
+        if (RecordLength != 0)
+        {
+            (void)memcpy(Buffer, Records[Index].PayloadData, RecordLength);
+            Buffer += RecordLength;
+        }
+    }
+
+    Message->length = MessageLength;
+    return Status;
+}
+
+
+/*!
+ *  Describe an NDEF message as a list of segments, without copying the payloads.
+ */
+NFCSTATUS phFriNfc_NdefRecord_GenerateMessageVector(phFriNfc_NdefRecord_t *Records,
+                                                    uint32_t              NumberOfRecords,
+                                                    phNfc_sData_t         *Headers,
+                                                    phNfc_sData_t         *Segments,
+                                                    uint32_t              *NumberOfSegments)
+{
+    NFCSTATUS   Status = NFCSTATUS_SUCCESS;
+    uint8_t     Header[PH_FRINFC_NDEFRECORD_HEADER_MAX],
+                HeaderLength = 0,
+                TypeLength,
+                IdLength,
+                Flags;
+    uint32_t    Index,
+                RecordLength = 0,
+                Used = 0,
+                Count = 0,
+                Start;
+
+    if (Records == NULL || NumberOfRecords == 0 || Headers == NULL || 
+        Headers->buffer == NULL || Segments == NULL || NumberOfSegments == NULL)
+    {
+        return (PHNFCSTVAL(CID_FRI_NFC_NDEF_RECORD, NFCSTATUS_INVALID_PARAMETER));
+    }
+
+    for (Index = 0; (Index < NumberOfRecords) && (Status == NFCSTATUS_SUCCESS); Index++)
+    {
+        Flags = (uint8_t)(((Index == 0)? PH_FRINFC_NDEFRECORD_FLAGS_MB : 0) |
+                          ((Index == (NumberOfRecords - 1))? PH_FRINFC_NDEFRECORD_FLAGS_ME : 0));
+        Status = phFriNfc_NdefRecord_EncodeHeader(&Records[Index], Flags, 
+                                                  PH_FRINFC_NDEFRECORD_IN_CHUNK(Records, Index), Header, 
+                                                  &HeaderLength, &RecordLength);
+        if (Status != NFCSTATUS_SUCCESS)
+        {
+            break;
+        }
+
+        TypeLength = Header[PH_FRINFC_NDEFRECORD_BUF_INC1];
+        IdLength = (uint8_t)(((Header[0] & PH_FRINFC_NDEFRECORD_FLAGS_IL) != 0)? 
+                             Records[Index].IdLength : 0);
+        RecordLength -= (uint32_t)HeaderLength + TypeLength + IdLength;
+
+        if (((uint32_t)HeaderLength + TypeLength + IdLength) > (Headers->length - Used) ||
+            (Count + ((RecordLength != 0)? 2 : 1)) > *NumberOfSegments)
+        {
+            Status = PHNFCSTVAL(CID_FRI_NFC_NDEF_RECORD, NFCSTATUS_BUFFER_TOO_SMALL);
+            break;
+        }
+
+        /* Header, type and ID are small: pack them in the header buffer */
+        Start = Used;
+        (void)memcpy(Headers->buffer + Used, Header, HeaderLength);
+        Used += HeaderLength;
+        if (TypeLength != 0)
+        {
+            (void)memcpy(Headers->buffer + Used, Records[Index].Type, TypeLength);
+            Used += TypeLength;
+        }
+        if (IdLength != 0)
+        {
+            (void)memcpy(Headers->buffer + Used, Records[Index].Id, IdLength);
+            Used += IdLength;
+        }
+        Segments[Count].buffer = Headers->buffer + Start;
+        Segments[Count].length = Used - Start;
+        Count++;
+
+        /* The payload stays in the caller buffer */
+        if (RecordLength != 0)
+        {
+            Segments[Count].buffer = Records[Index].PayloadData;
+            Segments[Count].length = RecordLength;
+            Count++;
+        }
+    }
+
+    if (Status == NFCSTATUS_SUCCESS)
+    {
+        Headers->length = Used;
+        *NumberOfSegments = Count;
+    }
+    return Status;
+}
+
+
+/* Check a record and encode its header for the given position in a message */
+static NFCSTATUS phFriNfc_NdefRecord_EncodeHeader(phFriNfc_NdefRecord_t *Record,
+                                                  uint8_t               Flags,
+                                                  uint8_t               InChunk,
+                                                  uint8_t               *Header,
+                                                  uint8_t               *HeaderLength,
+                                                  uint32_t              *RecordLength)
+{
+    uint8_t     Tnf = (uint8_t)(Record->Tnf & PH_FRINFC_NDEFRECORD_TNFBYTE_MASK),
+                TypeLength = Record->TypeLength,
+                IdLength = Record->IdLength,
+                Index = 0;
+    uint32_t    PayloadLength = Record->PayloadLength;
+
+    if (Tnf == PH_FRINFC_NDEFRECORD_TNF_RESERVED)
+    {
+        return (PHNFCSTVAL(CID_FRI_NFC_NDEF_RECORD, NFCSTATUS_INVALID_FORMAT));
+    }
+
+    /* A chunked record can not end the message */
+    Flags |= (uint8_t)(Record->Flags & PH_FRINFC_NDEFRECORD_FLAGS_CF);
+    if ((Flags & PH_FRINFC_NDEFRECORD_FLAGS_CF) != 0 &&
+        (Flags & PH_FRINFC_NDEFRECORD_FLAGS_ME) != 0)
+    {
+        return (PHNFCSTVAL(CID_FRI_NFC_NDEF_RECORD, NFCSTATUS_INVALID_FORMAT));
+    }
+
+    /* Fields that the TNF does not allow are dropped, as by Generate */
+    if (Tnf == PH_FRINFC_NDEFRECORD_TNF_EMPTY)
+    {
+        TypeLength = 0;
+        IdLength = 0;
+        PayloadLength = 0;
+    }
+    else if (Tnf == PH_FRINFC_NDEFRECORD_TNF_UNKNOWN || 
+             Tnf == PH_FRINFC_NDEFRECORD_TNF_UNCHANGED)
+    {
+        TypeLength = 0;
+    }
+
+    /* The rules of phFriNfc_NdefRecord_GetRecords: only the records continuing
+        a chunked payload have the unchanged TNF, and they have no ID. A first
+        record of a TNF that needs a type can not be type-less */
+    if ((InChunk != 0) != (Tnf == PH_FRINFC_NDEFRECORD_TNF_UNCHANGED))
+    {
+        return (PHNFCSTVAL(CID_FRI_NFC_NDEF_RECORD, NFCSTATUS_INVALID_FORMAT));
+    }
+    if ((Tnf == PH_FRINFC_NDEFRECORD_TNF_UNCHANGED && IdLength != 0) ||
+        ((Flags & PH_FRINFC_NDEFRECORD_FLAGS_MB) != 0 && TypeLength == 0 &&
+         Tnf != PH_FRINFC_NDEFRECORD_TNF_EMPTY && Tnf != PH_FRINFC_NDEFRECORD_TNF_UNKNOWN))
+    {
+        return (PHNFCSTVAL(CID_FRI_NFC_NDEF_RECORD, NFCSTATUS_INVALID_FORMAT));
+    }
+
+    if ((TypeLength != 0 && Record->Type == NULL) ||
+        (IdLength != 0 && Record->Id == NULL) ||
+        (PayloadLength != 0 && Record->PayloadData == NULL))
+    {
+        return (PHNFCSTVAL(CID_FRI_NFC_NDEF_RECORD, NFCSTATUS_INVALID_PARAMETER));
+    }
+
+    if (PayloadLength <= PH_FRINFC_NDEFRECORD_SHORT_MAX)
+    {
+        Flags |= PH_FRINFC_NDEFRECORD_FLAGS_SR;
+    }
+    if (IdLength != 0)
+    {
+        Flags |= PH_FRINFC_NDEFRECORD_FLAGS_IL;
+    }
+
+    Header[Index++] = (uint8_t)(Flags | Tnf);
+    Header[Index++] = TypeLength;
+    if ((Flags & PH_FRINFC_NDEFRECORD_FLAGS_SR) != 0)
+    {
+        Header[Index++] = (uint8_t)PayloadLength;
+    }
+    else
+    {
+        Header[Index++] = (uint8_t)(PayloadLength >> PHNFCSTSHL24);
+        Header[Index++] = (uint8_t)(PayloadLength >> PHNFCSTSHL16);
+        Header[Index++] = (uint8_t)(PayloadLength >> PHNFCSTSHL8);
+        Header[Index++] = (uint8_t)PayloadLength;
+    }
+    if (IdLength != 0)
+    {
+        Header[Index++] = IdLength;
+    }
+    *HeaderLength = Index;
+
+    if (PayloadLength > (0xFFFFFFFFU - Index - TypeLength - IdLength))
+    {
+        return (PHNFCSTVAL(CID_FRI_NFC_NDEF_RECORD, NFCSTATUS_INVALID_PARAMETER));
+    }
+    *RecordLength = Index + TypeLength + IdLength + PayloadLength;
+    return NFCSTATUS_SUCCESS;
+}
+
 /* Calculate the Flags of the record */
 static uint8_t phFriNfc_NdefRecord_RecordFlag ( uint8_t    *Record)
 {
@@ -113,6 +113,8 @@
 #define PH_FRINFC_NDEFRECORD_BUF_INC5           5               /** \internal Increment Buffer Address by 5 */
 #define PH_FRINFC_NDEFRECORD_BUF_TNF_VALUE      ((uint8_t)0x00) /** \internal If TNF = Empty, Unknown and Unchanged, the id, type and payload length is ZERO  */
 #define PH_FRINFC_NDEFRECORD_FLAG_MASK          ((uint8_t)0xF8) /** \internal To Mask the Flag Byte */
+#define PH_FRINFC_NDEFRECORD_HEADER_MAX         7               /** \internal Flags, type, payload (normal record) and ID lengths */
+#define PH_FRINFC_NDEFRECORD_SHORT_MAX          0xFFU           /** \internal Largest payload of a short record */
 
 
 
@@ -229,6 +231,61 @@ typedef struct phFriNfc_NdefRecord
 } phFriNfc_NdefRecord_t;
 
 
+/**
+ *\ingroup grp_lib_nfc
+ *\brief <b> NFC NDEF Record iterator structure definition.</b>
+ *
+ * State of a single pass traversal of an NDEF message, see
+ * \ref phFriNfc_NdefRecord_IteratorInit. The members are private to the library.
+ */
+typedef struct phFriNfc_NdefRecord_Iterator
+{
+    /** The data buffer holding the NDEF Message */
+    uint8_t                *Buffer;
+
+    /** Length of the complete NDEF Message */
+    uint32_t                BufferLength;
+
+    /** Number of bytes of the message already present in the buffer */
+    uint32_t                ValidLength;
+
+    /** Offset of the next record to decode */
+    uint32_t                Offset;
+
+    /** Number of records returned so far */
+    uint32_t                Count;
+
+    /** Header byte of the last record returned */
+    uint8_t                 PrevFlags;
+
+    /** Sticky status, set once the end of the message or an error is reached */
+    NFCSTATUS               Status;
+
+} phFriNfc_NdefRecord_Iterator_t;
+
+
+/**
+ *\ingroup grp_lib_nfc
+ *\brief <b> NFC NDEF Record arena structure definition.</b>
+ *
+ * Caller owned memory, used by \ref phFriNfc_NdefRecord_Reassemble to hold the payload
+ * of chunked records. The library only advances \b Used; the caller resets it to zero
+ * once the reassembled records are no longer needed.
+ */
+typedef struct phFriNfc_NdefRecord_Arena
+{
+    /** Start of the arena memory */
+    uint8_t                *Buffer;
+
+    /** Size of the arena memory */
+    uint32_t                Length;
+
+    /** Number of bytes already handed out */
+    uint32_t                Used;
+
+} phFriNfc_NdefRecord_Arena_t;
+
+
 #ifndef PH_FRINFC_EXCLUDE_FROM_TESTFW /* */
 
 
@@ -429,6 +486,199 @@ typedef struct phFriNfc_NdefRecord
 										);
 
 
+ /**
+ *\ingroup grp_lib_nfc
+ *
+ *\brief <b>NDEF Record \b Iterator \b Init function</b>
+ *
+ *  Prepare a single pass traversal of an NDEF message. The message does not need to be
+ *  complete: only the first \p ValidLength bytes of the buffer have to hold data, the
+ *  rest can be made known later with \ref phFriNfc_NdefRecord_IteratorFeed while the
+ *  message is still being read from the tag or the peer.
+ *
+ * \param[out] pIterator            The iterator to initialise.
+ * \param[in]  pBuffer              The data buffer, able to hold the whole NDEF Message.
+ * \param[in]  BufferLength         The length of the whole NDEF Message.
+ * \param[in]  ValidLength          The number of bytes already present in the buffer.
+ *
+ * \retval NFCSTATUS_SUCCESS            Operation successful.
+ * \retval NFCSTATUS_INVALID_PARAMETER  At least one parameter of the function is invalid.
+ */
+ NFCSTATUS phFriNfc_NdefRecord_IteratorInit(phFriNfc_NdefRecord_Iterator_t*  pIterator,
+                                            uint8_t*                         pBuffer,
+                                            uint32_t                         BufferLength,
+                                            uint32_t                         ValidLength);
+
+ /**
+ *\ingroup grp_lib_nfc
+ *
+ *\brief <b>NDEF Record \b Iterator \b Feed function</b>
+ *
+ *  Tell the iterator that more bytes of the NDEF Message are present in the buffer.
+ *
+ * \param[in,out] pIterator         The iterator.
+ * \param[in]     ValidLength       The number of bytes now present in the buffer; it can not
+ *                                  decrease and can not exceed the message length.
+ *
+ * \retval NFCSTATUS_SUCCESS            Operation successful.
+ * \retval NFCSTATUS_INVALID_PARAMETER  At least one parameter of the function is invalid.
+ */
+ NFCSTATUS phFriNfc_NdefRecord_IteratorFeed(phFriNfc_NdefRecord_Iterator_t*  pIterator,
+                                            uint32_t                         ValidLength);
+
+ /**
+ *\ingroup grp_lib_nfc
+ *
+ *\brief <b>NDEF Record \b Iterator \b Next function</b>
+ *
+ *  Validate and decode the next record of the message in one step. This gives the same
+ *  result as \ref phFriNfc_NdefRecord_GetRecords followed by \ref phFriNfc_NdefRecord_Parse
+ *  on each record, but the message is walked only once and records are returned as soon
+ *  as their bytes are present. The record members point into the original buffer; \b Id
+ *  and \b Type are NULL when the record has none.
+ *
+ * \param[in,out] pIterator         The iterator.
+ * \param[out]    pRecord           The decoded record.
+ *
+ * \retval NFCSTATUS_SUCCESS                    A record has been returned.
+ * \retval NFCSTATUS_MORE_INFORMATION           The next record is not entirely present in the buffer
+ *                                              yet. Call again after \ref phFriNfc_NdefRecord_IteratorFeed.
+ * \retval NFCSTATUS_EOF_NDEF_CONTAINER_REACHED  The record holding the ME flag has already been returned.
+ * \retval NFCSTATUS_INVALID_PARAMETER          At least one parameter of the function is invalid.
+ * \retval NFCSTATUS_INVALID_FORMAT             The message breaks one of the rules listed for
+ *                                              \ref phFriNfc_NdefRecord_GetRecords. The error is
+ *                                              returned again by any further call.
+ */
+ NFCSTATUS phFriNfc_NdefRecord_IteratorNext(phFriNfc_NdefRecord_Iterator_t*  pIterator,
+                                            phFriNfc_NdefRecord_t*           pRecord);
+
+
+ /**
+ *\ingroup grp_lib_nfc
+ *
+ *\brief <b>NDEF Record \b Reassemble function</b>
+ *
+ *  Return the next \b logical record of the message: a record that is not chunked is returned
+ *  as by \ref phFriNfc_NdefRecord_IteratorNext, while a sequence of chunks (CF set, followed by
+ *  TNF unchanged records up to the first record without CF) is merged into one record. The merged
+ *  record takes TNF, Type and ID from the first chunk, has the CF flag cleared, and its
+ *  payload is the concatenation of the chunk payloads.
+ *
+ *  The payload is not copied when a single chunk carries payload bytes: \b PayloadData then
+ *  points into the message buffer. Otherwise the chunk payloads are copied into \p pArena.
+ *  Without an arena, \b PayloadData is set to NULL and the payload is only described by
+ *  \p pSegments, which lists the chunk payloads in the message buffer (zero copy).
+ *
+ *  The merged record can be handed to \ref phFriNfc_NdefReg_DispatchRecord.
+ *
+ * \param[in,out] pIterator         The iterator, see \ref phFriNfc_NdefRecord_IteratorInit.
+ * \param[out]    pRecord           The (merged) record.
+ * \param[in,out] pArena            Memory receiving the merged payload, or NULL.
+ * \param[out]    pSegments         Array receiving the payload of each chunk, or NULL. It is
+ *                                  filled up to \p pNumberOfSegments entries.
+ * \param[in,out] pNumberOfSegments Size of the \p pSegments array; set to the number of chunks
+ *                                  of the record. May be NULL when \p pSegments is NULL.
+ *
+ * \retval NFCSTATUS_SUCCESS                    A record has been returned.
+ * \retval NFCSTATUS_BUFFER_TOO_SMALL           The payload has to be copied but the arena is
+ *                                              too small, or there is no arena and the
+ *                                              segment array is too small. The iterator is
+ *                                              not moved.
+ * \retval Other                                As for \ref phFriNfc_NdefRecord_IteratorNext. On
+ *                                              NFCSTATUS_MORE_INFORMATION the iterator is not moved,
+ *                                              the call is to be repeated once the whole chunk
+ *                                              sequence is present.
+ */
+ NFCSTATUS phFriNfc_NdefRecord_Reassemble(phFriNfc_NdefRecord_Iterator_t*  pIterator,
+                                          phFriNfc_NdefRecord_t*           pRecord,
+                                          phFriNfc_NdefRecord_Arena_t*     pArena,
+                                          phNfc_sData_t*                   pSegments,
+                                          uint32_t*                        pNumberOfSegments);
+
+
+ /**
+ *\ingroup grp_lib_nfc
+ *
+ *\brief <b>NDEF Record \b Get \b Message \b Length function</b>
+ *
+ *  Compute the exact size of the NDEF message that \ref phFriNfc_NdefRecord_GenerateMessage
+ *  builds from the given records.
+ *
+ * \param[in]  pRecords             Array of records, filled as for \b Composition.
+ * \param[in]  NumberOfRecords      Number of records in the array.
+ * \param[out] pMessageLength       Size of the message.
+ *
+ * \retval NFCSTATUS_SUCCESS            Operation successful.
+ * \retval NFCSTATUS_INVALID_PARAMETER  At least one parameter of the function is invalid.
+ * \retval NFCSTATUS_INVALID_FORMAT     A record has the reserved TNF, the last record is chunked, a
+ *                                     record continuing a chunk does not have the unchanged TNF or
+ *                                     has an ID, the unchanged TNF is used elsewhere, or the first
+ *                                     record has no type while its TNF needs one.
+ */
+ NFCSTATUS phFriNfc_NdefRecord_GetMessageLength(phFriNfc_NdefRecord_t*  pRecords,
+                                                uint32_t                NumberOfRecords,
+                                                uint32_t*               pMessageLength);
+
+ /**
+ *\ingroup grp_lib_nfc
+ *
+ *\brief <b>NDEF Record \b Generate \b Message function</b>
+ *
+ *  Serialise a whole NDEF message in one call. Unlike \ref phFriNfc_NdefRecord_Generate the
+ *  encoding flags are chosen by the library: MB is set on the first record and ME on the last,
+ *  SR when the payload is at most 255 bytes and IL when an ID is given. Only the CF flag is
+ *  taken from the \b Flags of the records. The records are not modified.
+ *
+ * \param[in]     pRecords          Array of records, filled as for \b Composition.
+ * \param[in]     NumberOfRecords   Number of records in the array.
+ * \param[in,out] psMessage         Buffer receiving the message. On input \b length is the size of
+ *                                  \b buffer, on output the size of the message. The structure can
+ *                                  then be given as is to \ref phLibNfc_Ndef_Write.
+ *
+ * \retval NFCSTATUS_SUCCESS            Operation successful.
+ * \retval NFCSTATUS_INVALID_PARAMETER  At least one parameter of the function is invalid.
+ * \retval NFCSTATUS_INVALID_FORMAT     A record has the reserved TNF, the last record is chunked, a
+ *                                     record continuing a chunk does not have the unchanged TNF or
+ *                                     has an ID, the unchanged TNF is used elsewhere, or the first
+ *                                     record has no type while its TNF needs one.
+ * \retval NFCSTATUS_BUFFER_TOO_SMALL   The buffer can not hold the message. Nothing is written.
+ */
+ NFCSTATUS phFriNfc_NdefRecord_GenerateMessage(phFriNfc_NdefRecord_t*  pRecords,
+                                               uint32_t                NumberOfRecords,
+                                               phNfc_sData_t*          psMessage);
+
+ /**
+ *\ingroup grp_lib_nfc
+ *
+ *\brief <b>NDEF Record \b Generate \b Message \b Vector function</b>
+ *
+ *  Same encoding as \ref phFriNfc_NdefRecord_GenerateMessage, but the payloads are not copied:
+ *  the headers, types and IDs are packed into \p psHeaders and the message is described by a
+ *  list of segments, alternately pointing into \p psHeaders and to the payload buffers of the
+ *  records. At most 2 segments per record are needed.
+ *
+ * \param[in]     pRecords          Array of records, filled as for \b Composition.
+ * \param[in]     NumberOfRecords   Number of records in the array.
+ * \param[in,out] psHeaders         Buffer receiving the headers. On input \b length is the size of
+ *                                  \b buffer, on output the number of bytes used.
+ * \param[out]    pSegments         Array receiving the segments of the message, in order.
+ * \param[in,out] pNumberOfSegments Size of the \p pSegments array; set to the number of segments used.
+ *
+ * \retval NFCSTATUS_SUCCESS            Operation successful.
+ * \retval NFCSTATUS_INVALID_PARAMETER  At least one parameter of the function is invalid.
+ * \retval NFCSTATUS_INVALID_FORMAT     A record has the reserved TNF, the last record is chunked, a
+ *                                     record continuing a chunk does not have the unchanged TNF or
+ *                                     has an ID, the unchanged TNF is used elsewhere, or the first
+ *                                     record has no type while its TNF needs one.
+ * \retval NFCSTATUS_BUFFER_TOO_SMALL   The header buffer or the segment array is too small.
+ */
+ NFCSTATUS phFriNfc_NdefRecord_GenerateMessageVector(phFriNfc_NdefRecord_t*  pRecords,
+                                                     uint32_t                NumberOfRecords,
+                                                     phNfc_sData_t*          psHeaders,
+                                                     phNfc_sData_t*          pSegments,
+                                                     uint32_t*               pNumberOfSegments);
+
+
 /*  Helper function Prototypes - Used only internally   */
  
 /** \internal
@@ -492,6 +742,7 @@ static NFCSTATUS phFriNfc_NdefRecord_RecordIDCheck (uint8_t*	   pRecord,
 													uint8_t*	   pIDLengthByte,
 													uint8_t*	   pIDLength
 													);
+
 /** \internal
  *
  *  This is a sub function to the Parse Function. This function will get only Type Name Format bits in a Packet
@@ -39,6 +39,12 @@
 /* Harsha: To Fix: 0000358: phFriNfc_NdefRecord.h: includes should be moved */
 #include <string.h>
 static int16_t phFriNfc_NdefReg_Strncmp (const int8_t *s1, const int8_t *s2, uint32_t count);
+static uint32_t phFriNfc_NdefReg_TypeKey (uint8_t Tnf, const uint8_t *Type, uint8_t TypeLength);
+
+/*  Match keys are FNV-1a hashes; one bit of the node filter per key */
+#define PH_FRINFC_NDEFREG_KEY_BASIS     0x811C9DC5U    /**< \internal */
+#define PH_FRINFC_NDEFREG_KEY_PRIME     0x01000193U    /**< \internal */
+#define PH_FRINFC_NDEFREG_KEY_BIT(Key)  ((uint32_t)1 << ((Key) & 0x1FU))  /**< \internal */
 
 /*********  String functions *********/
 
@@ -64,7 +70,9 @@ int16_t  phFriNfc_NdefReg_Strnicmp(const int8_t *s1, const int8_t *s2, uint32_t
     }
     while ( (c1 == c2) && (c1 != '\0') && (c2 != '\0') && (count > 0) );
 
-    if ( (count == 0) || (c1 == c2) )
+    /*  The last compared characters decide: count reaching zero after a
+        mismatch on the last character is not a match */
+    if ( c1 == c2 )
         returnvalue = 0;
 
     else if ( (c1 > c2) )
@@ -75,6 +83,36 @@ int16_t  phFriNfc_NdefReg_Strnicmp(const int8_t *s1, const int8_t *s2, uint32_t
     return(returnvalue);
 }
 
+/*  Key shared by all the types that the string functions above consider equal
+    for a given TNF: case folded as in phFriNfc_NdefReg_Strnicmp, stopping at
+    the first NUL character, and ignoring the type of absolute URIs */
+static uint32_t phFriNfc_NdefReg_TypeKey (uint8_t Tnf, const uint8_t *Type, uint8_t TypeLength)
+{
+    uint32_t    key = PH_FRINFC_NDEFREG_KEY_BASIS;
+    uint8_t     index;
+    int8_t      c;
+
+    key = (key ^ (Tnf & PH_FRINFC_NDEFRECORD_TNF_MASK)) * PH_FRINFC_NDEFREG_KEY_PRIME;
+    key = (key ^ TypeLength) * PH_FRINFC_NDEFREG_KEY_PRIME;
+    if((Tnf & PH_FRINFC_NDEFRECORD_TNF_MASK) != PH_FRINFC_NDEFRECORD_TNF_ABSURI && Type != NULL)
+    {
+        for(index = 0; index < TypeLength; index++)
+        {
+            c = (int8_t)Type[index];
+            if(c == '\0')
+            {
+                break;
+            }
+            if(c >= 97)
+            {
+                c = (c - 32);
+            }
+            key = (key ^ (uint8_t)c) * PH_FRINFC_NDEFREG_KEY_PRIME;
+        }
+    }
+    return(key);
+}
+
 /*********  REGISTRY AND LISTENER MODULE *********/
 
 NFCSTATUS phFriNfc_NdefReg_Reset(phFriNfc_NdefReg_t         *NdefReg,
@@ -116,6 +154,7 @@ NFCSTATUS phFriNfc_NdefReg_AddCb(phFriNfc_NdefReg_t     *NdefReg,
                                  phFriNfc_NdefReg_Cb_t  *NdefCb)
 {
     NFCSTATUS status = NFCSTATUS_SUCCESS;
+    uint8_t   index;
 
     if(  NdefReg == NULL || NdefCb ==NULL)
     {
@@ -126,6 +165,21 @@ NFCSTATUS phFriNfc_NdefReg_AddCb(phFriNfc_NdefReg_t     *NdefReg,
         /*  Check whether we can accomodate all these records in a single node */
         if(NdefCb->NumberOfRTDs <= PH_FRINFC_NDEFREG_MAX_RTD_REGISTERED)
         {
+            /*  Index the RTDs once, so that dispatching only compares keys.
+                Only TNF 0x01 to 0x04 can ever match a record. */
+            NdefCb->KeyFilter = 0;
+            for(index = 0; index < NdefCb->NumberOfRTDs; index++)
+            {
+                NdefCb->NdefTypeKey[index] = phFriNfc_NdefReg_TypeKey(NdefCb->Tnf[index],
+                                                                      NdefCb->NdefType[index],
+                                                                      NdefCb->NdeftypeLength[index]);
+                if(NdefCb->Tnf[index] >= PH_FRINFC_NDEFRECORD_TNF_NFCWELLKNOWN &&
+                   NdefCb->Tnf[index] <= PH_FRINFC_NDEFRECORD_TNF_NFCEXT)
+                {
+                    NdefCb->KeyFilter |= PH_FRINFC_NDEFREG_KEY_BIT(NdefCb->NdefTypeKey[index]);
+                }
+            }
+
             /*  Yes, all these Records can be accomodated in a single node */
             /* No existing node. This will be the first Node    */
             if(NdefReg->NdefTypeList==NULL)
@@ -292,11 +346,19 @@ uint8_t phFriNfc_NdefReg_Process(phFriNfc_NdefReg_t  *NdefReg,
     {
         case PH_FRINFC_NDEFREG_STATE_DIS_RCD:
 
+        NdefReg->RecordKey = phFriNfc_NdefReg_TypeKey(NdefReg->RecordsExtracted->Tnf,
+                                                      NdefReg->RecordsExtracted->Type,
+                                                      NdefReg->RecordsExtracted->TypeLength);
+
         /* for START ( each node in the list NdefReg->NdefTypeList), do the following */
-        for(index=0;index<NdefReg->NdefTypeList->NumberOfRTDs;index++)
+        for(index=0;
+            (NdefReg->NdefTypeList->KeyFilter & PH_FRINFC_NDEFREG_KEY_BIT(NdefReg->RecordKey)) &&
+            index<NdefReg->NdefTypeList->NumberOfRTDs;
+            index++)
         {
-            /* First, Match should be done with The TNF*/
-            if( (NdefReg->NdefTypeList->Tnf[index] & PH_FRINFC_NDEFRECORD_TNF_MASK ) ==
+            /* First, Match should be done with The key and the TNF*/
+            if( NdefReg->NdefTypeList->NdefTypeKey[index] == NdefReg->RecordKey &&
+                (NdefReg->NdefTypeList->Tnf[index] & PH_FRINFC_NDEFRECORD_TNF_MASK ) ==
                 (NdefReg->RecordsExtracted->Tnf & PH_FRINFC_NDEFRECORD_TNF_MASK ) )
             {
                 /* Second, Match should be done with The Typelength*/
@@ -468,6 +530,21 @@ uint8_t phFriNfc_NdefReg_Process(phFriNfc_NdefReg_t  *NdefReg,
             }
 
             NdefReg->newRecordextracted = 1;
+            NdefReg->RecordKey = phFriNfc_NdefReg_TypeKey(NdefReg->RecordsExtracted->Tnf,
+                                                          NdefReg->RecordsExtracted->Type,
+                                                          NdefReg->RecordsExtracted->TypeLength);
+
+            if((NdefReg->RecordsExtracted->Tnf & PH_FRINFC_NDEFRECORD_TNF_MASK ) !=
+                PH_FRINFC_NDEFRECORD_TNF_UNCHANGED &&
+               (NdefReg->NdefTypeList->KeyFilter & PH_FRINFC_NDEFREG_KEY_BIT(NdefReg->RecordKey)) == 0)
+            {
+                /*  None of the RTDs of this node can match: skip them, doing
+                    what the RTD loop would do for a non matching record */
+                TnfMatchFound = 0;
+                NdefReg->MainTnfFound = 0;
+                NdefReg->validPreviousTnf = NdefReg->RecordsExtracted->Tnf;
+                NdefReg->RtdIndex = NdefReg->NdefTypeList->NumberOfRTDs;
+            }
 
             /*  for each RTD in the present node */
             while(NdefReg->RtdIndex < NdefReg->NdefTypeList->NumberOfRTDs)
@@ -500,7 +577,8 @@ uint8_t phFriNfc_NdefReg_Process(phFriNfc_NdefReg_t  *NdefReg,
                     /* First, Match should be done with The TNF*/
                     /* Second, Match should be done with The Typelength*/
                         /* Third, Match should be done with The Type*/
-                    if((NdefReg->NdefTypeList->Tnf[NdefReg->RtdIndex] &
+                    if(NdefReg->NdefTypeList->NdefTypeKey[NdefReg->RtdIndex] == NdefReg->RecordKey &&
+                        (NdefReg->NdefTypeList->Tnf[NdefReg->RtdIndex] &
                         PH_FRINFC_NDEFRECORD_TNF_MASK ) ==
                         (NdefReg->RecordsExtracted->Tnf & PH_FRINFC_NDEFRECORD_TNF_MASK ) &&
                         (NdefReg->NdefTypeList->NdeftypeLength[NdefReg->RtdIndex] ==
@@ -211,6 +211,18 @@ typedef struct phFriNfc_NdefReg_Cb
      */
     void                        *CbContext;
 
+    /** \internal
+     * Match key of each RTD (TNF, length and case folded type), computed by
+     * \ref phFriNfc_NdefReg_AddCb.
+     */
+    uint32_t                     NdefTypeKey[PH_FRINFC_NDEFREG_MAX_RTD_REGISTERED];
+
+    /** \internal
+     * One bit per match key present in \ref phFriNfc_NdefReg_Cb_t::NdefTypeKey, used to
+     * skip the node quickly when a record can not match any of its RTDs.
+     */
+    uint32_t                     KeyFilter;
+
     /** \internal
      * This member is required by the library to link to the previous registered item. In case of the
      * first item this member is NULL.
@@ -270,6 +282,9 @@ typedef struct phFriNfc_NdefReg
         being processed is newly extracted */
     uint8_t                     newRecordextracted;/**< \internal */
 
+    /*  Match key of the record being processed */
+    uint32_t                    RecordKey;        /**< \internal */
+
 }phFriNfc_NdefReg_t;
 
 
@@ -321,6 +336,7 @@ NFCSTATUS phFriNfc_NdefReg_Reset(phFriNfc_NdefReg_t          *NdefReg,
  * Adds an NDEF type listener to the (internal) list of listeners:
  * The registering caller or embedding SW must create an instance of \ref phFriNfc_NdefReg_Cb_t and
  * hand the reference over to this function. The library does no allocation of memory.
+ * The RTDs of the listener are indexed here: they must not be changed while it is registered.
  *
  * \param[in] NdefReg Pointer to an initialised instance of \ref phFriNfc_NdefReg_t that holds the
  *            context of the current component instance.
@@ -406,7 +422,8 @@ NFCSTATUS phFriNfc_NdefReg_DispatchPacket(phFriNfc_NdefReg_t    *NdefReg,
  * The function performs a reset of the state. It starts the action (state machine). For actual
  * processing a periodic call of \ref phFriNfc_NdefReg_Process has to be done. This
  * function compares the given record with the registered RTDs and if a match is found it calls
- * the related callback.
+ * the related callback. Chunked payloads are best merged first with
+ * \ref phFriNfc_NdefRecord_Reassemble, so that listeners receive one complete record.
  *
  * \param[in] NdefReg Pointer to an initialised instance of \ref phFriNfc_NdefReg_t that holds the
  *            context of this component.
@@ -168,6 +168,8 @@ NFCSTATUS phFriNfc_OvrHal_Transceive(phFriNfc_OvrHal_t              *OvrHal,
             OvrHal->pndef_recv_length = RecvLength;
             phFriNfc_OvrHal_SetComplInfo(OvrHal,CompletionInfo, PH_FRINFC_OVRHAL_TRX);
             
+            OvrHal->TransceiveCount++;
+
             /* Call the HAL 4.0 Transceive Function */
             status = phHal4Nfc_Transceive (OvrHal->psHwReference, 
                                             &OvrHal->TranceiveInfo, RemoteDevInfo, 
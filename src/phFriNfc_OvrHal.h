@@ -268,6 +268,11 @@ typedef struct phFriNfc_OvrHal
     phHal4Nfc_TransactInfo_t     TransactInfo;
 
     uint16_t                     *pndef_recv_length;
+
+    /** Number of transceive operations handed to the HAL since the context
+     *  was cleared.
+     */
+    uint32_t                     TransceiveCount;
 } phFriNfc_OvrHal_t;
 
 /**
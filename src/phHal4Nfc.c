@@ -1246,6 +1246,11 @@ static void phHal4Nfc_HandleEvent(
                     gpphHal4Nfc_Hwref,
                     &(Hal4Ctxt->psADDCtxtInfo->sADDCfg)
                     ); 
+                if(NFCSTATUS_PENDING == RetStatus)
+                {
+                    Hal4Ctxt->psADDCtxtInfo->ConfiguredDuration
+                        = Hal4Ctxt->psADDCtxtInfo->sADDCfg.Duration;
+                }
                 Hal4Ctxt->Hal4NextState = (NFCSTATUS_PENDING == RetStatus?
                                                 eHal4StateConfiguring:
                                                 Hal4Ctxt->Hal4NextState);
@@ -307,6 +307,48 @@ typedef struct phHal4Nfc_TransactInfo{
     phHal_eRFDevType_t               remotePCDType;
 }phHal4Nfc_TransactInfo_t;
 
+/**
+* \ingroup grp_mw_external_hal_funcs
+*
+* Polling profiles applied to the discovery configuration
+*
+* \if hal
+* \ref phHal4Nfc_SetPollProfile,phHal4Nfc_GetPollProfileStats
+* \endif
+*
+*/
+typedef enum{
+    eHal4PollProfileCustom = 0x00,  /**<Discovery configuration of the upper
+                                        layer used as it is */
+    eHal4PollProfileFastTap,        /**<Only Type A/B polling with a short
+                                        idle period, for the lowest detection
+                                        latency */
+    eHal4PollProfileFullSweep,      /**<All the reader technologies polled */
+    eHal4PollProfileLowPower,       /**<Long idle period between the polling
+                                        cycles, for the lowest power */
+    eHal4PollProfileAdaptive,       /**<Short idle period after a recent
+                                        detection, long idle period when
+                                        no target was detected recently */
+    eHal4PollProfileMax
+} phHal4Nfc_ePollProfile_t;
+
+/**
+* \ingroup grp_mw_external_hal_funcs
+*
+* Statistics of a polling profile, all the durations are in milliseconds.
+* The discovery duty cycle of the profile is PollTime / ProfileTime.
+*
+*/
+typedef struct phHal4Nfc_PollProfileStats{
+    uint32_t        DetectCount;     /**<Number of detected targets */
+    uint32_t        DetectTimeTotal; /**<Sum of the time-to-detect */
+    uint32_t        DetectTimeMax;   /**<Longest time-to-detect */
+    uint32_t        PollTime;        /**<Time the discovery wheel ran */
+    uint32_t        ProfileTime;     /**<Time the profile was selected */
+    uint32_t        Duration;        /**<Last idle period applied, in
+                                         microseconds */
+}phHal4Nfc_PollProfileStats_t;
+
 /*preliminary definitions end*/
 
 /* -----------------Exported Functions----------------------------------*/
@@ -475,6 +517,70 @@ extern NFCSTATUS phHal4Nfc_ConfigureDiscovery(
                         pphHal4Nfc_GenCallback_t       pConfigCallback,
                         void                           *pContext
                         );
+
+/**
+*  \if hal
+*   \ingroup grp_hal_common
+*  \else
+*   \ingroup grp_mw_external_hal_funcs
+*  \endif
+*
+*  This function selects the polling profile applied to the discovery
+*  configuration. The profile takes effect at the next call of
+*  \ref phHal4Nfc_ConfigureDiscovery with NFC_DISCOVERY_CONFIG.
+*
+*  \param[in] psHwReference         Hardware reference, pointer to the
+*                                   \ref phHal_sHwReference_t structure.
+*
+*  \param[in] ePollProfile          Polling profile to be selected.
+*
+*  \retval NFCSTATUS_SUCCESS                   Profile selected.
+*
+*  \retval NFCSTATUS_INVALID_PARAMETER         One or more of the supplied
+*                                              parameters could not be properly
+*                                              interpreted.
+*
+*  \retval NFCSTATUS_NOT_INITIALISED           Hal is not initialized.
+*
+*  \retval NFCSTATUS_INSUFFICIENT_RESOURCES    System Resources insufficient.
+*
+*/
+extern NFCSTATUS phHal4Nfc_SetPollProfile(
+                        phHal_sHwReference_t          *psHwReference,
+                        phHal4Nfc_ePollProfile_t       ePollProfile
+                        );
+
+/**
+*  \if hal
+*   \ingroup grp_hal_common
+*  \else
+*   \ingroup grp_mw_external_hal_funcs
+*  \endif
+*
+*  This function retrieves the time-to-detect and the discovery duty cycle
+*  statistics of a polling profile.
+*
+*  \param[in] psHwReference         Hardware reference, pointer to the
+*                                   \ref phHal_sHwReference_t structure.
+*
+*  \param[in] ePollProfile          Polling profile of the statistics.
+*
+*  \param[out] psStats              Statistics of the polling profile.
+*
+*  \retval NFCSTATUS_SUCCESS                   Statistics retrieved.
+*
+*  \retval NFCSTATUS_INVALID_PARAMETER         One or more of the supplied
+*                                              parameters could not be properly
+*                                              interpreted.
+*
+*  \retval NFCSTATUS_NOT_INITIALISED           Hal is not initialized.
+*
+*/
+extern NFCSTATUS phHal4Nfc_GetPollProfileStats(
+                        phHal_sHwReference_t          *psHwReference,
+                        phHal4Nfc_ePollProfile_t       ePollProfile,
+                        phHal4Nfc_PollProfileStats_t  *psStats
+                        );
 /**
 *  \if hal
 *   \ingroup grp_hal_common
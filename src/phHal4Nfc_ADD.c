@@ -38,6 +38,19 @@
 #define     NXP_MIN_UID_LEN         0x07U
 /* --------------------Structures and enumerations --------------------------*/
 
+/*Allocates the ADD context if not already allocated*/
+static NFCSTATUS phHal4Nfc_AllocADDCtxt(phHal4Nfc_Hal4Ctxt_t  *Hal4Ctxt);
+
+/*Applies the selected polling profile to the ADD configuration*/
+static void phHal4Nfc_ApplyPollProfile(
+                            pphHal4Nfc_ADDCtxtInfo_t  psADDCtxtInfo
+                            );
+
+/*Duration of the adaptive profile, from the time of the last detection*/
+static uint32_t phHal4Nfc_AdaptiveDuration(
+                            pphHal4Nfc_ADDCtxtInfo_t  psADDCtxtInfo
+                            );
+
 NFCSTATUS phHal4Nfc_ConfigParameters(                       
                         phHal_sHwReference_t     *psHwReference,
                         phHal_eConfigType_t       CfgType,
@@ -227,21 +240,8 @@ NFCSTATUS phHal4Nfc_ConfigureDiscovery(
         }
         else if(Hal4Ctxt->Hal4CurrentState >= eHal4StateOpenAndReady)
         {
-            if (NULL == Hal4Ctxt->psADDCtxtInfo)
+            if(NFCSTATUS_SUCCESS != phHal4Nfc_AllocADDCtxt(Hal4Ctxt))
             {
-                Hal4Ctxt->psADDCtxtInfo= (pphHal4Nfc_ADDCtxtInfo_t)
-                    phOsalNfc_GetMemory((uint32_t)
-                    (sizeof(phHal4Nfc_ADDCtxtInfo_t)));
-                if(NULL != Hal4Ctxt->psADDCtxtInfo)
-                {
-                    (void)memset(Hal4Ctxt->psADDCtxtInfo,0,
-                        sizeof(phHal4Nfc_ADDCtxtInfo_t)
-                        );
-                }
-            }
-            if(NULL == Hal4Ctxt->psADDCtxtInfo)
-            {
-                phOsalNfc_RaiseException(phOsalNfc_e_NoMemory,0);
                 CfgStatus= PHNFCSTVAL(CID_NFC_HAL ,
                     NFCSTATUS_INSUFFICIENT_RESOURCES);
             }
@@ -268,6 +268,8 @@ NFCSTATUS phHal4Nfc_ConfigureDiscovery(
                         sizeof(phHal_sADD_Cfg_t)
                         );    
                     PHDBG_INFO("Hal4:Finished copying sADDCfg");                    
+                    /*Override the configuration with the polling profile*/
+                    phHal4Nfc_ApplyPollProfile(Hal4Ctxt->psADDCtxtInfo);
                     Hal4Ctxt->psADDCtxtInfo->smx_discovery = FALSE;
 #ifdef UPDATE_NFC_ACTIVE
                     Hal4Ctxt->psADDCtxtInfo->sADDCfg.PollDevInfo.PollCfgInfo.EnableNfcActive
@@ -287,6 +289,11 @@ NFCSTATUS phHal4Nfc_ConfigureDiscovery(
                         (void *)psHwReference,
                         &(Hal4Ctxt->psADDCtxtInfo->sADDCfg)
                         );/*Configure HCI Discovery*/                    
+                    if(NFCSTATUS_PENDING == CfgStatus)
+                    {
+                        Hal4Ctxt->psADDCtxtInfo->ConfiguredDuration
+                            = Hal4Ctxt->psADDCtxtInfo->sADDCfg.Duration;
+                    }
                     break;
                 case NFC_DISCOVERY_STOP:
                     break;
@@ -294,11 +301,39 @@ NFCSTATUS phHal4Nfc_ConfigureDiscovery(
                 case NFC_DISCOVERY_RESUME:
                     PHDBG_INFO("Hal4:Call to NFC_DISCOVERY_RESUME");
                     Hal4Ctxt->psADDCtxtInfo->nbr_of_devices = 0;
-                    CfgStatus = phHciNfc_Restart_Discovery (
-                                    (void *)Hal4Ctxt->psHciHandle,
-                                    (void *)psHwReference,      
-                                    FALSE
-                                    );
+                    if(eHal4PollProfileAdaptive 
+                                == Hal4Ctxt->psADDCtxtInfo->ePollProfile)
+                    {
+                        Hal4Ctxt->psADDCtxtInfo->sADDCfg.Duration
+                            = phHal4Nfc_AdaptiveDuration(Hal4Ctxt->psADDCtxtInfo);
+                        Hal4Ctxt->psADDCtxtInfo->sProfileStats[
+                            eHal4PollProfileAdaptive].Duration
+                            = Hal4Ctxt->psADDCtxtInfo->sADDCfg.Duration;
+                    }
+                    if(Hal4Ctxt->psADDCtxtInfo->sADDCfg.Duration
+                        != Hal4Ctxt->psADDCtxtInfo->ConfiguredDuration)
+                    {
+                        /*The Restart keeps the duration configured in the
+                          HCI, reconfigure to write the new PL_DURATION*/
+                        CfgStatus = phHciNfc_Config_Discovery(
+                            (void *)Hal4Ctxt->psHciHandle,
+                            (void *)psHwReference,
+                            &(Hal4Ctxt->psADDCtxtInfo->sADDCfg)
+                            );
+                        if(NFCSTATUS_PENDING == CfgStatus)
+                        {
+                            Hal4Ctxt->psADDCtxtInfo->ConfiguredDuration
+                                = Hal4Ctxt->psADDCtxtInfo->sADDCfg.Duration;
+                        }
+                    }
+                    else
+                    {
+                        CfgStatus = phHciNfc_Restart_Discovery (
+                                        (void *)Hal4Ctxt->psHciHandle,
+                                        (void *)psHwReference,      
+                                        FALSE
+                                        );
+                    }
                     break;
                 default:
                     break;
@@ -307,9 +342,15 @@ NFCSTATUS phHal4Nfc_ConfigureDiscovery(
                    Returns status as Pending */
                 if ( NFCSTATUS_PENDING == CfgStatus )
                 {
+                    /*The polling profile may override the reader
+                      technologies requested by the upper layer*/
                     (void)memcpy((void *)
                         &(Hal4Ctxt->psADDCtxtInfo->sCurrentPollConfig),
-                        (void *)&(discoveryCfg->PollDevInfo.PollCfgInfo),
+                        (eHal4PollProfileCustom ==
+                            Hal4Ctxt->psADDCtxtInfo->ePollProfile)?
+                        (void *)&(discoveryCfg->PollDevInfo.PollCfgInfo):
+                        (void *)&(Hal4Ctxt->psADDCtxtInfo->
+                                        sADDCfg.PollDevInfo.PollCfgInfo),
                         sizeof(phHal_sPollDevInfo_t)
                         );  
                     PHDBG_INFO("Hal4:Finished copying PollCfgInfo");
@@ -338,6 +379,240 @@ NFCSTATUS phHal4Nfc_ConfigureDiscovery(
 }
 
 
+/*Allocates the ADD context if not already allocated*/
+static NFCSTATUS phHal4Nfc_AllocADDCtxt(phHal4Nfc_Hal4Ctxt_t  *Hal4Ctxt)
+{
+    NFCSTATUS Status = NFCSTATUS_SUCCESS;
+    if (NULL == Hal4Ctxt->psADDCtxtInfo)
+    {
+        Hal4Ctxt->psADDCtxtInfo= (pphHal4Nfc_ADDCtxtInfo_t)
+            phOsalNfc_GetMemory((uint32_t)
+            (sizeof(phHal4Nfc_ADDCtxtInfo_t)));
+        if(NULL != Hal4Ctxt->psADDCtxtInfo)
+        {
+            (void)memset(Hal4Ctxt->psADDCtxtInfo,0,
+                sizeof(phHal4Nfc_ADDCtxtInfo_t)
+                );
+            Hal4Ctxt->psADDCtxtInfo->ProfileStartTime = phOsalNfc_GetTime();
+        }
+    }
+    if(NULL == Hal4Ctxt->psADDCtxtInfo)
+    {
+        phOsalNfc_RaiseException(phOsalNfc_e_NoMemory,0);
+        Status= PHNFCSTVAL(CID_NFC_HAL ,
+            NFCSTATUS_INSUFFICIENT_RESOURCES);
+    }
+    return Status;
+}
+
+
+/*Applies the selected polling profile to the ADD configuration*/
+static void phHal4Nfc_ApplyPollProfile(
+                            pphHal4Nfc_ADDCtxtInfo_t  psADDCtxtInfo
+                            )
+{
+    phHal_sADD_Cfg_t *psADDCfg = &(psADDCtxtInfo->sADDCfg);
+    phHal_sPollDevInfo_t *psPollCfg = &(psADDCfg->PollDevInfo.PollCfgInfo);
+    /*Reader technologies are only overridden when polling is enabled*/
+    uint8_t ReaderEnabled = (uint8_t)(psPollCfg->EnableIso14443A 
+                                || psPollCfg->EnableIso14443B
+                                || psPollCfg->EnableFelica212 
+                                || psPollCfg->EnableFelica424
+                                || psPollCfg->EnableIso15693);
+    switch(psADDCtxtInfo->ePollProfile)
+    {
+    case eHal4PollProfileFastTap:
+        if(TRUE == ReaderEnabled)
+        {
+            psPollCfg->EnableFelica212 = FALSE;
+            psPollCfg->EnableFelica424 = FALSE;
+            psPollCfg->EnableIso15693 = FALSE;
+        }
+        psADDCfg->Duration = NXP_POLL_FAST_TAP_DURATION;
+        break;
+    case eHal4PollProfileFullSweep:
+        if(TRUE == ReaderEnabled)
+        {
+            psPollCfg->EnableIso14443A = TRUE;
+            psPollCfg->EnableIso14443B = TRUE;
+            psPollCfg->EnableFelica212 = TRUE;
+            psPollCfg->EnableFelica424 = TRUE;
+            psPollCfg->EnableIso15693 = TRUE;
+        }
+        psADDCfg->Duration = NXP_POLL_FULL_SWEEP_DURATION;
+        break;
+    case eHal4PollProfileLowPower:
+        psADDCfg->Duration = NXP_POLL_LOW_POWER_DURATION;
+        break;
+    case eHal4PollProfileAdaptive:
+        psADDCfg->Duration = phHal4Nfc_AdaptiveDuration(psADDCtxtInfo);
+        break;
+    case eHal4PollProfileCustom:
+    default:
+        break;
+    }
+    psADDCtxtInfo->sProfileStats[psADDCtxtInfo->ePollProfile].Duration
+                                                    = psADDCfg->Duration;
+    return;
+}
+
+
+/*Duration of the adaptive profile, from the time of the last detection*/
+static uint32_t phHal4Nfc_AdaptiveDuration(
+                            pphHal4Nfc_ADDCtxtInfo_t  psADDCtxtInfo
+                            )
+{
+    /*Tighten the loop after a recent detection, relax it when idle*/
+    return ((0 != psADDCtxtInfo->LastDetectTime)
+                && ((phOsalNfc_GetTime() - psADDCtxtInfo->LastDetectTime)
+                                        < NXP_POLL_ADAPTIVE_IDLE_TIME))?
+                NXP_POLL_FAST_TAP_DURATION:NXP_POLL_LOW_POWER_DURATION;
+}
+
+
+/*Marks the start of the discovery wheel for the polling profile statistics*/
+void phHal4Nfc_PollProfileStart(
+                            pphHal4Nfc_ADDCtxtInfo_t  psADDCtxtInfo
+                            )
+{
+    if((NULL != psADDCtxtInfo) && (FALSE == psADDCtxtInfo->IsPollRunning))
+    {
+        psADDCtxtInfo->IsPollRunning = TRUE;
+        psADDCtxtInfo->PollStartTime = phOsalNfc_GetTime();
+    }
+    return;
+}
+
+
+/*Marks the stop of the discovery wheel, with or without a detected target*/
+void phHal4Nfc_PollProfileStop(
+                            pphHal4Nfc_ADDCtxtInfo_t  psADDCtxtInfo,
+                            uint8_t                   Detected
+                            )
+{
+    phHal4Nfc_PollProfileStats_t *psStats = NULL;
+    uint32_t Now = 0;
+    uint32_t Elapsed = 0;
+    if((NULL != psADDCtxtInfo) && (TRUE == psADDCtxtInfo->IsPollRunning))
+    {
+        psStats = &(psADDCtxtInfo->sProfileStats[psADDCtxtInfo->ePollProfile]);
+        Now = phOsalNfc_GetTime();
+        Elapsed = Now - psADDCtxtInfo->PollStartTime;
+        psADDCtxtInfo->IsPollRunning = FALSE;
+        psStats->PollTime += Elapsed;
+        if(TRUE == Detected)
+        {
+            psStats->DetectCount++;
+            psStats->DetectTimeTotal += Elapsed;
+            if(Elapsed > psStats->DetectTimeMax)
+            {
+                psStats->DetectTimeMax = Elapsed;
+            }
+            psADDCtxtInfo->LastDetectTime = Now;
+            /*Tightened loop, written to the HCI on the next resume*/
+            if(eHal4PollProfileAdaptive == psADDCtxtInfo->ePollProfile)
+            {
+                psADDCtxtInfo->sADDCfg.Duration
+                            = phHal4Nfc_AdaptiveDuration(psADDCtxtInfo);
+                psStats->Duration = psADDCtxtInfo->sADDCfg.Duration;
+            }
+        }
+    }
+    return;
+}
+
+
+/**Select the polling profile*/
+NFCSTATUS phHal4Nfc_SetPollProfile(
+                        phHal_sHwReference_t          *psHwReference,
+                        phHal4Nfc_ePollProfile_t       ePollProfile
+                        )
+{
+    NFCSTATUS Status = NFCSTATUS_SUCCESS;
+    phHal4Nfc_Hal4Ctxt_t *Hal4Ctxt = NULL;
+    pphHal4Nfc_ADDCtxtInfo_t psADDCtxtInfo = NULL;
+    uint32_t Now = 0;
+    if((NULL == psHwReference) || (ePollProfile >= eHal4PollProfileMax))
+    {
+        phOsalNfc_RaiseException(phOsalNfc_e_PrecondFailed,1);
+        Status = PHNFCSTVAL(CID_NFC_HAL , NFCSTATUS_INVALID_PARAMETER);
+    }
+    else if((NULL == psHwReference->hal_context)
+            || (((phHal4Nfc_Hal4Ctxt_t *)
+                    psHwReference->hal_context)->Hal4CurrentState 
+                                        < eHal4StateOpenAndReady))
+    {
+        phOsalNfc_RaiseException(phOsalNfc_e_PrecondFailed,1);
+        Status = PHNFCSTVAL(CID_NFC_HAL , NFCSTATUS_NOT_INITIALISED);
+    }
+    else
+    {
+        Hal4Ctxt = psHwReference->hal_context;
+        Status = phHal4Nfc_AllocADDCtxt(Hal4Ctxt);
+        if(NFCSTATUS_SUCCESS == Status)
+        {
+            psADDCtxtInfo = Hal4Ctxt->psADDCtxtInfo;
+            Now = phOsalNfc_GetTime();
+            /*Close the accounting of the previous profile*/
+            psADDCtxtInfo->sProfileStats[psADDCtxtInfo->ePollProfile].ProfileTime
+                                    += Now - psADDCtxtInfo->ProfileStartTime;
+            if(TRUE == psADDCtxtInfo->IsPollRunning)
+            {
+                psADDCtxtInfo->sProfileStats[psADDCtxtInfo->ePollProfile].PollTime
+                                    += Now - psADDCtxtInfo->PollStartTime;
+                psADDCtxtInfo->PollStartTime = Now;
+            }
+            psADDCtxtInfo->ProfileStartTime = Now;
+            psADDCtxtInfo->ePollProfile = ePollProfile;
+        }
+    }
+    return Status;
+}
+
+
+/**Retrieve the statistics of a polling profile*/
+NFCSTATUS phHal4Nfc_GetPollProfileStats(
+                        phHal_sHwReference_t          *psHwReference,
+                        phHal4Nfc_ePollProfile_t       ePollProfile,
+                        phHal4Nfc_PollProfileStats_t  *psStats
+                        )
+{
+    NFCSTATUS Status = NFCSTATUS_SUCCESS;
+    pphHal4Nfc_ADDCtxtInfo_t psADDCtxtInfo = NULL;
+    uint32_t Now = 0;
+    if((NULL == psHwReference) || (NULL == psStats)
+        || (ePollProfile >= eHal4PollProfileMax))
+    {
+        phOsalNfc_RaiseException(phOsalNfc_e_PrecondFailed,1);
+        Status = PHNFCSTVAL(CID_NFC_HAL , NFCSTATUS_INVALID_PARAMETER);
+    }
+    else if((NULL == psHwReference->hal_context)
+            || (NULL == ((phHal4Nfc_Hal4Ctxt_t *)
+                    psHwReference->hal_context)->psADDCtxtInfo))
+    {
+        Status = PHNFCSTVAL(CID_NFC_HAL , NFCSTATUS_NOT_INITIALISED);
+    }
+    else
+    {
+        psADDCtxtInfo = ((phHal4Nfc_Hal4Ctxt_t *)
+                            psHwReference->hal_context)->psADDCtxtInfo;
+        (void)memcpy(psStats, &(psADDCtxtInfo->sProfileStats[ePollProfile]),
+                        sizeof(phHal4Nfc_PollProfileStats_t));
+        /*Include the time elapsed in the current profile*/
+        if(ePollProfile == psADDCtxtInfo->ePollProfile)
+        {
+            Now = phOsalNfc_GetTime();
+            psStats->ProfileTime += Now - psADDCtxtInfo->ProfileStartTime;
+            if(TRUE == psADDCtxtInfo->IsPollRunning)
+            {
+                psStats->PollTime += Now - psADDCtxtInfo->PollStartTime;
+            }
+        }
+    }
+    return Status;
+}
+
+
 /*Configuration completion handler*/
 void phHal4Nfc_ConfigureComplete(phHal4Nfc_Hal4Ctxt_t  *Hal4Ctxt,
                                  void                  *pInfo,
@@ -352,11 +627,13 @@ void phHal4Nfc_ConfigureComplete(phHal4Nfc_Hal4Ctxt_t  *Hal4Ctxt,
     if((type == NFC_NOTIFY_POLL_ENABLED) ||(type == NFC_NOTIFY_POLL_RESTARTED))
     {
         Hal4Ctxt->psADDCtxtInfo->IsPollConfigured = TRUE;
+        phHal4Nfc_PollProfileStart(Hal4Ctxt->psADDCtxtInfo);
         PHDBG_INFO("Hal4:Poll Config Complete");
     }
     else
     {
         Hal4Ctxt->psADDCtxtInfo->IsPollConfigured = FALSE;
+        phHal4Nfc_PollProfileStop(Hal4Ctxt->psADDCtxtInfo,FALSE);
         PHDBG_WARNING("Hal4:Poll disabled,config success or config error");
     }
     if(NULL != Hal4Ctxt->sUpperLayerInfo.pConfigCallback)
@@ -442,6 +719,8 @@ void phHal4Nfc_TargetDiscoveryComplete(
     /*remote device info*/
     phHal_sRemoteDevInformation_t *psRemoteDevInfo = NULL;
     status = ((phNfc_sCompletionInfo_t *)pInfo)->status;
+    /*Account the time-to-detect of the polling profile*/
+    phHal4Nfc_PollProfileStop(Hal4Ctxt->psADDCtxtInfo,TRUE);
     /*Update Hal4 state*/
     Hal4Ctxt->Hal4CurrentState = eHal4StateTargetDiscovered;
     Hal4Ctxt->Hal4NextState  = eHal4StateInvalid;
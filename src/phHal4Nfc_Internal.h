@@ -134,6 +134,20 @@ typedef struct phHal4Nfc_ADDCtxtInfo{
     phHal_sPollDevInfo_t             sCurrentPollConfig;
     /*Set when Poll Configured and reset when polling is disabled.*/
     uint8_t                          IsPollConfigured;
+    /*Polling profile applied to the ADD configuration*/
+    phHal4Nfc_ePollProfile_t         ePollProfile;
+    /*Time at which the polling profile was selected*/
+    uint32_t                         ProfileStartTime;
+    /*Set while the discovery wheel is running*/
+    uint8_t                          IsPollRunning;
+    /*Time at which the discovery wheel was started*/
+    uint32_t                         PollStartTime;
+    /*Time of the most recent target detection*/
+    uint32_t                         LastDetectTime;
+    /*Polling loop duration last configured in the HCI*/
+    uint32_t                         ConfiguredDuration;
+    /*Statistics of the polling profiles*/
+    phHal4Nfc_PollProfileStats_t     sProfileStats[eHal4PollProfileMax];
 }phHal4Nfc_ADDCtxtInfo_t,*pphHal4Nfc_ADDCtxtInfo_t;
 
 /**Context info for HAL4 connect/disconnect*/
@@ -270,6 +284,17 @@ extern void phHal4Nfc_TargetDiscoveryComplete(
                             void *pInfo
                             );
 
+/*Marks the start of the discovery wheel for the polling profile statistics*/
+extern void phHal4Nfc_PollProfileStart(
+                            pphHal4Nfc_ADDCtxtInfo_t  psADDCtxtInfo
+                            );
+
+/*Marks the stop of the discovery wheel, with or without a detected target*/
+extern void phHal4Nfc_PollProfileStop(
+                            pphHal4Nfc_ADDCtxtInfo_t  psADDCtxtInfo,
+                            uint8_t                   Detected
+                            );
+
 /*Event handler routine for Emulation*/
 extern void phHal4Nfc_HandleEmulationEvent(
                         phHal4Nfc_Hal4Ctxt_t  *Hal4Ctxt,
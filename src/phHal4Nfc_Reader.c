@@ -1285,6 +1285,11 @@ void phHal4Nfc_DisconnectComplete(
         }while(--(Hal4Ctxt->psADDCtxtInfo->nbr_of_devices));
         
         Hal4Ctxt->sTgtConnectInfo.psConnectedDevice = NULL;
+        /*The discovery wheel is restarted on release of the target*/
+        if(NFC_SMARTMX_RELEASE != Hal4Ctxt->sTgtConnectInfo.ReleaseType)
+        {
+            phHal4Nfc_PollProfileStart(Hal4Ctxt->psADDCtxtInfo);
+        }
         /*Disconnect successful.Go to Ready state*/
         Hal4Ctxt->Hal4CurrentState = Hal4Ctxt->Hal4NextState;        
         Hal4Ctxt->sTgtConnectInfo.pUpperDisconnectCb = NULL;
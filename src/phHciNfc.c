@@ -126,6 +126,9 @@ phHciNfc_Config_Emulation (
             psHciContext->hci_mode = hciMode_Reset;
             psHciContext->p_hw_ref = pHwRef;
             psHciContext->host_rf_type = phHal_eUnknown_DevType;
+#ifdef NXP_HCI_SEQ_PROFILE
+            psHciContext->prof_seq = HCI_INVALID_SEQ;
+#endif
             HCI_PRINT("HCI Initialisation in Progress.... \n");
 
 #ifdef ESTABLISH_SESSION
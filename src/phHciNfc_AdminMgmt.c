@@ -919,6 +919,11 @@ phHciNfc_Recv_Admin_Response(
                 }
                 case ADM_CLEAR_ALL_PIPE:
                 {
+#ifdef NXP_HCI_REG_CACHE
+                    /* The Session is reset, flush the Registry Cache */
+                    phHciNfc_RegCache_Invalidate( psHciContext,
+                                        (uint8_t) HCI_UNKNOWN_PIPE_ID );
+#endif
                     break;
                 }
                 default:
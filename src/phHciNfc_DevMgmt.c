@@ -361,6 +361,11 @@ phHciNfc_DevMgmt_Update_PipeInfo(
              * Managment Gate */
             pPipeInfo->recv_resp = &phHciNfc_Recv_DevMgmt_Response;
             pPipeInfo->recv_event = &phHciNfc_Recv_DevMgmt_Event;
+#ifdef NXP_HCI_REG_CACHE
+            /* The EEPROM CRC only changes with an EEPROM write */
+            pPipeInfo->reg_cache_mask =
+                            PHHCINFC_REG_CACHE_BIT(DEVICE_INFO_EEPROM_INDEX);
+#endif
         }
     }
 
@@ -409,6 +414,10 @@ phHciNfc_DevMgmt_Update_PipeInfo(
             params[i++] = value;
             p_pipe_info->param_info = &params;
             p_pipe_info->param_length = i ;
+#ifdef NXP_HCI_REG_CACHE
+            /* The EEPROM write modifies the cached EEPROM CRC */
+            phHciNfc_RegCache_Invalidate( psHciContext, pipe_id );
+#endif
             status = phHciNfc_Send_DevMgmt_Command( psHciContext, pHwRef, 
                                                 pipe_id, (uint8_t)NXP_DBG_WRITE );
         }
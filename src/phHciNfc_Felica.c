@@ -212,6 +212,13 @@ phHciNfc_Felica_Update_PipeInfo(
         pPipeInfo->recv_resp = phHciNfc_Recv_Felica_Response;
         /* Update the event Receive routine of the Felica Gate */
         pPipeInfo->recv_event = phHciNfc_Recv_Felica_Event;
+#ifdef NXP_HCI_REG_CACHE
+        /* Registry describing the activated Target */
+        pPipeInfo->reg_cache_mask =
+                        PHHCINFC_REG_CACHE_BIT(NXP_FEL_SYS_CODE)
+                        | PHHCINFC_REG_CACHE_BIT(NXP_FEL_CURRENTIDM)
+                        | PHHCINFC_REG_CACHE_BIT(NXP_FEL_CURRENTPMM);
+#endif
     }
 
     return status;
@@ -308,6 +315,15 @@ phHciNfc_Felica_Info_Sequence (
         else
         {
             HCI_DEBUG ("HCI : p_fel_info->current_seq : %02X\n", p_fel_info->current_seq);
+#ifdef NXP_HCI_FAST_RESELECT
+            /* Skip the Registry reads of a Target already activated */
+            if ((FELICA_CURRENTPMM == p_fel_info->current_seq)
+                && (NFCSTATUS_SUCCESS == phHciNfc_ReaderMgmt_Restore_Target(
+                            psHciContext, &(p_fel_info->felica_info))))
+            {
+                p_fel_info->current_seq = FELICA_END_SEQUENCE;
+            }
+#endif
             switch(p_fel_info->current_seq)
             {
                 case FELICA_SYSTEMCODE:
@@ -374,6 +390,10 @@ phHciNfc_Felica_Info_Sequence (
                     p_fel_info->current_seq = FELICA_SYSTEMCODE;
                     p_fel_info->next_seq = FELICA_SYSTEMCODE;
                     status = NFCSTATUS_SUCCESS;
+#ifdef NXP_HCI_FAST_RESELECT
+                    phHciNfc_ReaderMgmt_Store_Target(psHciContext, 
+                                    &(p_fel_info->felica_info));
+#endif
                     HCI_DEBUG ("HCI : p_fel_info->felica_info.RemDevType : %02X\n", p_fel_info->felica_info.RemDevType);
                     HCI_DEBUG ("HCI : status notified: %02X\n", CompInfo.status);
                     /* Notify to the upper layer */
@@ -78,6 +78,15 @@ static phHciNfc_sContext_t        *gpsHciContext= NULL;
 
 #endif /* (NXP_NFC_HCI_TIMER == 1) */
 
+#ifdef NXP_HCI_REG_CACHE
+
+#include <phOsalNfc_Timer.h>
+/** \internal Timer used to deliver the Responses built
+ * from the HCI Registry Cache */
+static uint32_t                    hci_cache_timer_id = NXP_INVALID_TIMER_ID;
+
+#endif /* #ifdef NXP_HCI_REG_CACHE */
+
 
 /*
 ################################################################################
@@ -95,6 +104,41 @@ phHciNfc_Response_Timeout (
 
 #endif /* (NXP_NFC_HCI_TIMER == 1) */
 
+#ifdef NXP_HCI_REG_CACHE
+
+static
+phHciNfc_Reg_Cache_t *
+phHciNfc_RegCache_Find (
+                                phHciNfc_Pipe_Info_t    *p_pipe_info,
+                                uint8_t                 reg_index
+                        );
+
+static
+void
+phHciNfc_RegCache_Store (
+                                phHciNfc_Pipe_Info_t    *p_pipe_info,
+                                uint8_t                 reg_index,
+                                uint8_t                 *p_value,
+                                uint16_t                length
+                        );
+
+static
+NFCSTATUS
+phHciNfc_RegCache_Send (
+                                phHciNfc_sContext_t     *psHciContext,
+                                phHciNfc_Pipe_Info_t    *p_pipe_info,
+                                phHciNfc_Reg_Cache_t    *p_entry
+                        );
+
+static
+void
+phHciNfc_RegCache_Deliver (
+                                uint32_t                timer_id,
+                                void                    *pContext
+                        );
+
+#endif /* #ifdef NXP_HCI_REG_CACHE */
+
 /**
  * \ingroup grp_hci_nfc
  *
@@ -198,6 +242,14 @@ phHciNfc_Process_Command (
                          );
 
 
+static
+phHciNfc_Pipe_Info_t *
+phHciNfc_Dispatch_Pipe(
+                                phHciNfc_sContext_t     *psHciContext,
+                                uint8_t                 pipe_id,
+                                uint8_t                 msg_type
+                         );
+
 static
 void
 phHciNfc_Reset_Pipe_MsgInfo(    
@@ -312,6 +364,258 @@ phHciNfc_Response_Timeout (
 #endif /* (NXP_NFC_HCI_TIMER == 1) */
 
 
+#ifdef NXP_HCI_REG_CACHE
+
+static
+phHciNfc_Reg_Cache_t *
+phHciNfc_RegCache_Find (
+                                phHciNfc_Pipe_Info_t    *p_pipe_info,
+                                uint8_t                 reg_index
+                        )
+{
+    phHciNfc_Reg_Cache_t    *p_entry = NULL;
+    uint8_t                 i = 0;
+
+    for(i = 0; (i < NXP_HCI_REG_CACHE_ENTRIES) && (NULL == p_entry); i++)
+    {
+        if( (TRUE == p_pipe_info->reg_cache[i].valid)
+            && (reg_index == p_pipe_info->reg_cache[i].reg_index)
+          )
+        {
+            p_entry = &p_pipe_info->reg_cache[i];
+        }
+    }
+    return p_entry;
+}
+
+
+static
+void
+phHciNfc_RegCache_Store (
+                                phHciNfc_Pipe_Info_t    *p_pipe_info,
+                                uint8_t                 reg_index,
+                                uint8_t                 *p_value,
+                                uint16_t                length
+                        )
+{
+    phHciNfc_Reg_Cache_t    *p_entry = NULL;
+
+    if( (reg_index < (sizeof(uint32_t) * 8))
+        && ( 0 != (p_pipe_info->reg_cache_mask
+                            & PHHCINFC_REG_CACHE_BIT(reg_index)))
+        && ( length <= sizeof(p_pipe_info->reg_cache[0].value) )
+      )
+    {
+        p_entry = phHciNfc_RegCache_Find( p_pipe_info, reg_index );
+        if( NULL == p_entry )
+        {
+            /* Replace the entries of the pipe in Round Robin order */
+            p_entry = &p_pipe_info->reg_cache[p_pipe_info->reg_cache_next];
+            p_pipe_info->reg_cache_next = (uint8_t)
+                ((p_pipe_info->reg_cache_next + 1) % NXP_HCI_REG_CACHE_ENTRIES);
+        }
+        (void)memcpy( p_entry->value, p_value, length );
+        p_entry->length = (uint8_t)length;
+        p_entry->reg_index = reg_index;
+        p_entry->valid = TRUE;
+    }
+    return;
+}
+
+
+/*!
+ * \brief Serves the Get Parameter from the HCI Registry Cache.
+ *
+ * This function builds the Response of the Get Parameter command from the
+ * cached Registry value. The Response is delivered through a timer so that
+ * the Gate Sequences always complete asynchronously, as they do for the
+ * Responses received from the Host Controller.
+ */
+
+static
+NFCSTATUS
+phHciNfc_RegCache_Send (
+                                phHciNfc_sContext_t     *psHciContext,
+                                phHciNfc_Pipe_Info_t    *p_pipe_info,
+                                phHciNfc_Reg_Cache_t    *p_entry
+                        )
+{
+    phHciNfc_HCP_Packet_t   *hcp_packet = NULL;
+    NFCSTATUS               status = NFCSTATUS_PENDING;
+
+    if ( NXP_INVALID_TIMER_ID == hci_cache_timer_id )
+    {
+        hci_cache_timer_id = phOsalNfc_Timer_Create( );
+    }
+
+    if ( NXP_INVALID_TIMER_ID == hci_cache_timer_id )
+    {
+        status = PHNFCSTVAL(CID_NFC_HCI, NFCSTATUS_INSUFFICIENT_RESOURCES);
+    }
+    else
+    {
+        hcp_packet = (phHciNfc_HCP_Packet_t *) psHciContext->cache_resp;
+        /* Construct the HCP Response Frame */
+        phHciNfc_Build_HCPFrame(hcp_packet, HCP_CHAINBIT_DEFAULT,
+                        p_pipe_info->pipe.pipe_id, HCP_MSG_TYPE_RESPONSE, ANY_OK);
+        phHciNfc_Append_HCPFrame((uint8_t *)hcp_packet->msg.message.payload,
+                        0, p_entry->value, p_entry->length);
+        psHciContext->cache_resp_len = (uint8_t)
+                                    (HCP_HEADER_LEN + p_entry->length);
+        psHciContext->cache_resp_pipe = p_pipe_info->pipe.pipe_id;
+        psHciContext->reg_cache_hits++;
+
+        phOsalNfc_Timer_Start( hci_cache_timer_id, NXP_HCI_REG_CACHE_DELAY,
+                    phHciNfc_RegCache_Deliver, (void *)psHciContext );
+        HCI_DEBUG(" HCI : Registry %X of Pipe %X served from Cache \n",
+                    p_entry->reg_index, p_pipe_info->pipe.pipe_id);
+    }
+    return status;
+}
+
+
+static
+void
+phHciNfc_RegCache_Deliver (
+                                uint32_t                timer_id,
+                                void                    *pContext
+                        )
+{
+    phHciNfc_sContext_t     *psHciContext = (phHciNfc_sContext_t *)pContext;
+    NFCSTATUS               status = NFCSTATUS_SUCCESS;
+    uint8_t                 length = 0;
+
+    phOsalNfc_Timer_Stop( timer_id );
+
+    if( (NULL != psHciContext)
+        && (timer_id == hci_cache_timer_id)
+        && (HCP_ZERO_LEN != psHciContext->cache_resp_len)
+      )
+    {
+        length = psHciContext->cache_resp_len;
+        psHciContext->cache_resp_len = HCP_ZERO_LEN;
+
+        status = phHciNfc_Process_Response( psHciContext,
+                        psHciContext->p_hw_ref, psHciContext->cache_resp, length );
+        if( ( NFCSTATUS_SUCCESS != status )
+            && (NFCSTATUS_PENDING != status )
+          )
+        {
+            phHciNfc_Error_Sequence( psHciContext, psHciContext->p_hw_ref,
+                                                        status, NULL, 0 );
+        }
+    }
+    return;
+}
+
+
+/*!
+ * \brief Invalidates the HCI Registry Cache of a Pipe.
+ *
+ * This function invalidates the Registry values cached for a pipe or for
+ * all the pipes, when the pipe_id is HCI_UNKNOWN_PIPE_ID.
+ */
+
+void
+phHciNfc_RegCache_Invalidate(
+                    phHciNfc_sContext_t         *psHciContext,
+                    uint8_t                     pipe_id
+               )
+{
+    phHciNfc_Pipe_Info_t    *p_pipe_info = NULL;
+    uint8_t                 i = 0;
+
+    if( NULL != psHciContext )
+    {
+        for(i = 0; i < PHHCINFC_MAX_PIPE; i++)
+        {
+            p_pipe_info = psHciContext->p_pipe_list[i];
+            if( (NULL != p_pipe_info)
+                && ( ((uint8_t)HCI_UNKNOWN_PIPE_ID == pipe_id)
+                    || (i == pipe_id) )
+              )
+            {
+                (void)memset( p_pipe_info->reg_cache, 0,
+                                    sizeof(p_pipe_info->reg_cache) );
+                p_pipe_info->reg_cache_next = 0;
+            }
+        }
+    }
+    return;
+}
+
+
+/*!
+ * \brief Invalidates the HCI Registry Cache describing the Target.
+ *
+ * This function invalidates the Registry values cached for the pipes of
+ * the RF Reader and the NFC-IP1 Gates, whenever the Target in the field
+ * is discovered, activated, released or lost.
+ */
+
+void
+phHciNfc_RegCache_Invalidate_Target(
+                    phHciNfc_sContext_t         *psHciContext
+               )
+{
+    phHciNfc_Pipe_Info_t    *p_pipe_info = NULL;
+    uint8_t                 i = 0;
+
+    if( NULL != psHciContext )
+    {
+        for(i = 0; i < PHHCINFC_MAX_PIPE; i++)
+        {
+            p_pipe_info = psHciContext->p_pipe_list[i];
+            if( NULL != p_pipe_info )
+            {
+                switch( p_pipe_info->pipe.dest.gate_id )
+                {
+                    case phHciNfc_RFReaderAGate:
+                    case phHciNfc_RFReaderBGate:
+                    case phHciNfc_ISO15693Gate:
+                    case phHciNfc_RFReaderFGate:
+                    case phHciNfc_JewelReaderGate:
+                    case phHciNfc_NFCIP1InitRFGate:
+                    case phHciNfc_NFCIP1TargetRFGate:
+                    {
+                        phHciNfc_RegCache_Invalidate( psHciContext, i );
+                        break;
+                    }
+                    default:
+                    {
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    return;
+}
+
+
+void
+phHciNfc_RegCache_Get_Stats(
+                    phHciNfc_sContext_t         *psHciContext,
+                    uint32_t                    *p_hits,
+                    uint32_t                    *p_misses
+               )
+{
+    if( NULL != psHciContext )
+    {
+        if( NULL != p_hits )
+        {
+            *p_hits = psHciContext->reg_cache_hits;
+        }
+        if( NULL != p_misses )
+        {
+            *p_misses = psHciContext->reg_cache_misses;
+        }
+    }
+    return;
+}
+
+#endif /* #ifdef NXP_HCI_REG_CACHE */
+
 
 /*!
  * \brief Allocation of the HCI Interface resources.
@@ -374,6 +678,18 @@ phHciNfc_Response_Timeout (
 
 #endif /* (NXP_NFC_HCI_TIMER == 1) */
 
+#ifdef NXP_HCI_REG_CACHE
+
+    if ( NXP_INVALID_TIMER_ID != hci_cache_timer_id )
+    {
+        /* Stop and Un-Intialise the Registry Cache Timer */
+        phOsalNfc_Timer_Stop( hci_cache_timer_id );
+        phOsalNfc_Timer_Delete( hci_cache_timer_id );
+        hci_cache_timer_id = NXP_INVALID_TIMER_ID;
+    }
+
+#endif /* #ifdef NXP_HCI_REG_CACHE */
+
 
     if(NULL != (*ppsHciContext)->p_admin_info)
     {
@@ -904,6 +1220,10 @@ phHciNfc_Receive(
     uint8_t                 instruction=0;
     uint8_t                 pipe_id = (uint8_t)HCI_UNKNOWN_PIPE_ID;
     phHciNfc_Pipe_Info_t    *p_pipe_info = NULL;
+#ifdef NXP_HCI_REG_CACHE
+    uint8_t                 prev_msg = MSG_INSTRUCTION_UNKNWON;
+    uint8_t                 reg_index = 0;
+#endif
 
     NFCSTATUS               status = NFCSTATUS_SUCCESS;
 
@@ -927,27 +1247,47 @@ phHciNfc_Receive(
 
 #endif /* (NXP_NFC_HCI_TIMER == 1) */
     
+    p_pipe_info = phHciNfc_Dispatch_Pipe( psHciContext, pipe_id,
+                                            HCP_MSG_TYPE_RESPONSE );
     if (pipe_id >=  PHHCINFC_MAX_PIPE )
     {
         status = PHNFCSTVAL(CID_NFC_HCI, NFCSTATUS_INVALID_HCI_INFORMATION);
     }
     else if( ((uint8_t) ANY_OK != instruction)
         && ( (pipe_id !=    PIPETYPE_STATIC_ADMIN )
-        && ( ADM_CLEAR_ALL_PIPE != (psHciContext->p_pipe_list[pipe_id])->prev_msg ))
+        && ( ( NULL == p_pipe_info )
+            || ( ADM_CLEAR_ALL_PIPE != p_pipe_info->prev_msg )))
         )
     {
         status = phHciNfc_Error_Response( psHciContext, pHwRef, pdata, length );
     }
     else
     {
-        p_pipe_info = psHciContext->p_pipe_list[pipe_id];
         if( ( NULL != p_pipe_info )
             &&   ( HCP_MSG_TYPE_COMMAND == p_pipe_info->sent_msg_type  )
             &&   ( NULL != p_pipe_info->recv_resp )
         )
         {
-            status = psHciContext->p_pipe_list[pipe_id]->recv_resp( psHciContext,
+#ifdef NXP_HCI_REG_CACHE
+            prev_msg = p_pipe_info->prev_msg;
+            reg_index = p_pipe_info->reg_index;
+#endif
+            status = p_pipe_info->recv_resp( psHciContext,
                                                             pHwRef, pdata, length );
+#ifdef NXP_HCI_REG_CACHE
+            /* Cache the Registry value read from the Host Controller */
+            if( (NFCSTATUS_SUCCESS == status)
+                && ((uint8_t) ANY_OK == instruction)
+                && (ANY_GET_PARAMETER == prev_msg)
+                && ((uint8_t *)pdata != psHciContext->cache_resp)
+                && (length >= HCP_HEADER_LEN)
+              )
+            {
+                phHciNfc_RegCache_Store( p_pipe_info, reg_index,
+                            &((uint8_t *)pdata)[HCP_HEADER_LEN],
+                            (uint16_t)(length - HCP_HEADER_LEN) );
+            }
+#endif
         }
         else
         {
@@ -973,6 +1313,91 @@ phHciNfc_Receive(
 }
 
 
+/*!
+ * \brief Retrieves the pipe to which the received HCP Message is dispatched.
+ *
+ * The pipe list is indexed by the pipe identifier and holds the Gate
+ * handlers registered when the pipe was created or updated, hence no
+ * Gate lookup is needed to route the Message.
+ */
+
+static
+phHciNfc_Pipe_Info_t *
+phHciNfc_Dispatch_Pipe(
+                                phHciNfc_sContext_t     *psHciContext,
+                                uint8_t                 pipe_id,
+                                uint8_t                 msg_type
+                         )
+{
+    phHciNfc_Pipe_Info_t    *p_pipe_info = NULL;
+#ifdef NXP_HCI_DISPATCH_STATS
+    pphHciNfc_Pipe_Receive_t recv_handler = NULL;
+#endif
+
+    if ( pipe_id < PHHCINFC_MAX_PIPE )
+    {
+        p_pipe_info = psHciContext->p_pipe_list[pipe_id];
+    }
+#ifdef NXP_HCI_DISPATCH_STATS
+    if ( NULL != p_pipe_info )
+    {
+        recv_handler = ( HCP_MSG_TYPE_RESPONSE == msg_type )?
+                            p_pipe_info->recv_resp:
+                       ( HCP_MSG_TYPE_EVENT == msg_type )?
+                            p_pipe_info->recv_event: p_pipe_info->recv_cmd;
+    }
+    if ( NULL == recv_handler )
+    {
+        psHciContext->dispatch_unrouted++;
+    }
+    else if ( HCP_MSG_TYPE_RESPONSE == msg_type )
+    {
+        psHciContext->dispatch_stats[pipe_id].resp_count++;
+    }
+    else if ( HCP_MSG_TYPE_EVENT == msg_type )
+    {
+        psHciContext->dispatch_stats[pipe_id].event_count++;
+    }
+    else
+    {
+        psHciContext->dispatch_stats[pipe_id].cmd_count++;
+    }
+#else
+    PHNFC_UNUSED_VARIABLE(msg_type);
+#endif /* #ifdef NXP_HCI_DISPATCH_STATS */
+
+    return p_pipe_info;
+}
+
+
+#ifdef NXP_HCI_DISPATCH_STATS
+
+NFCSTATUS
+phHciNfc_Get_Dispatch_Stats(
+                    phHciNfc_sContext_t         *psHciContext,
+                    uint8_t                     pipe_id,
+                    phHciNfc_Dispatch_Stats_t   *p_stats
+               )
+{
+    NFCSTATUS               status = NFCSTATUS_SUCCESS;
+
+    if( (NULL == psHciContext) || (NULL == p_stats)
+        || (pipe_id >= PHHCINFC_MAX_PIPE) )
+    {
+        status = PHNFCSTVAL(CID_NFC_HCI, NFCSTATUS_INVALID_PARAMETER);
+    }
+    else
+    {
+        (void)memcpy( p_stats, &psHciContext->dispatch_stats[pipe_id],
+                        sizeof(phHciNfc_Dispatch_Stats_t) );
+    }
+
+    return status;
+}
+
+#endif /* #ifdef NXP_HCI_DISPATCH_STATS */
+
+
 static
  NFCSTATUS
  phHciNfc_Error_Response (
@@ -1087,7 +1512,8 @@ static
     }
     else
     {
-        p_pipe_info = psHciContext->p_pipe_list[pipe_id];
+        p_pipe_info = phHciNfc_Dispatch_Pipe( psHciContext, pipe_id,
+                                                HCP_MSG_TYPE_EVENT );
     }
 
     if( (p_pipe_info != NULL ) )
@@ -1205,7 +1631,8 @@ static
     }
     else
     {
-        p_pipe_info = psHciContext->p_pipe_list[pipe_id];
+        p_pipe_info = phHciNfc_Dispatch_Pipe( psHciContext, pipe_id,
+                                                HCP_MSG_TYPE_COMMAND );
     }
 
     if( (p_pipe_info != NULL )
@@ -1358,6 +1785,9 @@ void
     phHciNfc_HCP_Packet_t   *hcp_packet = NULL;
     phHciNfc_HCP_Message_t  *hcp_message = NULL;
     phHciNfc_Pipe_Info_t    *p_pipe_info = NULL;
+#ifdef NXP_HCI_REG_CACHE
+    phHciNfc_Reg_Cache_t    *p_reg_cache = NULL;
+#endif
     uint16_t                 length = 0;
     uint16_t                 i=0;
     NFCSTATUS               status = NFCSTATUS_SUCCESS;
@@ -1392,10 +1822,28 @@ void
                                             i, (uint8_t *)p_pipe_info->param_info,
                                             p_pipe_info->param_length);
                 length =(uint16_t)(length + i + p_pipe_info->param_length);
+#ifdef NXP_HCI_REG_CACHE
+                /* The Registry value is modified, remove it from the cache */
+                p_reg_cache = phHciNfc_RegCache_Find( p_pipe_info,
+                                                p_pipe_info->reg_index );
+                if( NULL != p_reg_cache )
+                {
+                    p_reg_cache->valid = FALSE;
+                }
+                p_reg_cache = NULL;
+#endif
                 break;
             }
             case ANY_GET_PARAMETER:
             {
+#ifdef NXP_HCI_REG_CACHE
+                p_reg_cache = phHciNfc_RegCache_Find( p_pipe_info,
+                                                p_pipe_info->reg_index );
+                if( NULL == p_reg_cache )
+                {
+                    psHciContext->reg_cache_misses++;
+                }
+#endif
 
                 hcp_packet = (phHciNfc_HCP_Packet_t *) psHciContext->send_buffer;
                 /* Construct the HCP Frame */
@@ -1429,8 +1877,20 @@ void
             p_pipe_info->prev_msg = cmd;
             psHciContext->tx_total = length;
             psHciContext->response_pending = TRUE ;
-            /* Send the Constructed HCP packet to the lower layer */
-            status = phHciNfc_Send_HCP( psHciContext, pHwRef );
+#ifdef NXP_HCI_REG_CACHE
+            if( NULL != p_reg_cache )
+            {
+                psHciContext->tx_total = 0 ;
+                /* Serve the Registry value from the cache */
+                status = phHciNfc_RegCache_Send( psHciContext,
+                                                    p_pipe_info, p_reg_cache );
+            }
+            else
+#endif
+            {
+                /* Send the Constructed HCP packet to the lower layer */
+                status = phHciNfc_Send_HCP( psHciContext, pHwRef );
+            }
             p_pipe_info->prev_status = NFCSTATUS_PENDING;
         }
     }
@@ -1875,6 +2335,14 @@ phHciNfc_Notify_Event(
             case NFC_NOTIFY_TARGET_DISCOVERED:
             {
                 HCI_PRINT(" PICC Discovery ! Obtain PICC Info .... \n");
+#ifdef NXP_HCI_REG_CACHE
+                /* The Registry of the previous Target is no longer valid */
+                phHciNfc_RegCache_Invalidate_Target( psHciContext );
+#endif
+#ifdef NXP_HCI_FAST_RESELECT
+                /* A new discovery round starts with a different field */
+                phHciNfc_ReaderMgmt_Clear_Targets( psHciContext );
+#endif
                 /* psHciContext->hci_seq = PL_DURATION_SEQ; */
                 if ( hciState_Unknown == psHciContext->hci_state.next_state )
                 {
@@ -1916,6 +2384,18 @@ phHciNfc_Notify_Event(
                 phNfc_sCompletionInfo_t *psCompInfo = 
 		                (phNfc_sCompletionInfo_t *)pInfo;
 
+#ifdef NXP_HCI_REG_CACHE
+                if ( NFC_NOTIFY_TARGET_RELEASED == type )
+                {
+                    phHciNfc_RegCache_Invalidate_Target( psHciContext );
+                }
+#endif
+#ifdef NXP_HCI_FAST_RESELECT
+                if ( NFC_NOTIFY_TARGET_RELEASED == type )
+                {
+                    phHciNfc_ReaderMgmt_Clear_Targets( psHciContext );
+                }
+#endif
                 if (((TRUE == psHciContext->event_pending) || 
                     (NFCSTATUS_RF_TIMEOUT == psCompInfo->status))
                     && ( hciState_Transact == psHciContext->hci_state.next_state))
@@ -1932,6 +2412,9 @@ phHciNfc_Notify_Event(
             case NFC_NOTIFY_DEVICE_ACTIVATED:
             {
                 HCI_PRINT("  Device Activated! Obtaining Remote Reader Info .... \n");
+#ifdef NXP_HCI_REG_CACHE
+                phHciNfc_RegCache_Invalidate_Target( psHciContext );
+#endif
                 if ( hciState_Unknown == psHciContext->hci_state.next_state )
                 {
                     switch (psHciContext->host_rf_type)
@@ -1968,6 +2451,9 @@ phHciNfc_Notify_Event(
             case NFC_NOTIFY_DEVICE_DEACTIVATED:
             {
                 HCI_PRINT(" Device De-Activated! \n");
+#ifdef NXP_HCI_REG_CACHE
+                phHciNfc_RegCache_Invalidate_Target( psHciContext );
+#endif
                 if ( hciState_Unknown == psHciContext->hci_state.next_state )
                 {
                     status = phHciNfc_FSM_Update ( psHciContext, hciState_Initialise );
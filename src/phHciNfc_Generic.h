@@ -558,6 +558,75 @@ typedef struct phHciNfc_Pipe_Params{
 }phHciNfc_Pipe_Params_t;
 
 
+#ifdef NXP_HCI_REG_CACHE
+
+/* Bit in the Registry Cache Mask of a pipe enabling the caching
+ * of the Registry Index */
+#define PHHCINFC_REG_CACHE_BIT(index)   ((uint32_t)0x01U << (index))
+
+typedef struct phHciNfc_Reg_Cache{
+    /** \internal Indicates whether the cached Registry value is valid */
+    uint8_t     valid;
+    /** \internal Registry Index of the cached value */
+    uint8_t     reg_index;
+    /** \internal Length of the cached Registry value */
+    uint8_t     length;
+    /** \internal Cached Registry value */
+    uint8_t     value[PHHCINFC_MAX_PACKET_DATA - HCP_HEADER_LEN];
+}phHciNfc_Reg_Cache_t;
+
+#endif /* #ifdef NXP_HCI_REG_CACHE */
+
+#ifdef NXP_HCI_SEQ_PROFILE
+
+typedef struct phHciNfc_Seq_Stats{
+    /** \internal Number of times the Sequence Step completed */
+    uint32_t    count;
+    /** \internal Total duration of the Sequence Step in milliseconds */
+    uint32_t    total_time;
+    /** \internal Longest duration of the Sequence Step in milliseconds */
+    uint32_t    max_time;
+}phHciNfc_Seq_Stats_t;
+
+#endif /* #ifdef NXP_HCI_SEQ_PROFILE */
+
+#ifdef NXP_HCI_FAST_RESELECT
+
+typedef struct phHciNfc_Act_Cache{
+    /** \internal Indicates whether the cached Target Information is valid */
+    uint8_t                     valid;
+    /** \internal RF Reader Type which discovered the Target */
+    phHal_eRFDevType_t          rf_type;
+    /** \internal Activation Parameters of the Target */
+    phHal_uRemoteDevInfo_t      dev_info;
+}phHciNfc_Act_Cache_t;
+
+typedef struct phHciNfc_Reselect_Stats{
+    /** \internal Number of Targets reselected through Activate Next */
+    uint32_t    count;
+    /** \internal Number of Reselections served from the Activation Cache */
+    uint32_t    hits;
+    /** \internal Total duration of the Reselections in milliseconds */
+    uint32_t    total_time;
+    /** \internal Longest duration of a Reselection in milliseconds */
+    uint32_t    max_time;
+}phHciNfc_Reselect_Stats_t;
+
+#endif /* #ifdef NXP_HCI_FAST_RESELECT */
+
+#ifdef NXP_HCI_DISPATCH_STATS
+
+typedef struct phHciNfc_Dispatch_Stats{
+    /** \internal Number of Responses dispatched to the Gate of the pipe */
+    uint32_t    resp_count;
+    /** \internal Number of Events dispatched to the Gate of the pipe */
+    uint32_t    event_count;
+    /** \internal Number of Commands dispatched to the Gate of the pipe */
+    uint32_t    cmd_count;
+}phHciNfc_Dispatch_Stats_t;
+
+#endif /* #ifdef NXP_HCI_DISPATCH_STATS */
+
 typedef struct phHciNfc_Pipe_Info{
     /** \internal Structure containing the created dynamic pipe information */
     phHciNfc_Pipe_Params_t      pipe;
@@ -584,6 +653,15 @@ typedef struct phHciNfc_Pipe_Info{
     pphHciNfc_Pipe_Receive_t    recv_event; 
     /** \internal Pointer to a Pipe specific Receive Command function */
     pphHciNfc_Pipe_Receive_t    recv_cmd; 
+#ifdef NXP_HCI_REG_CACHE
+    /** \internal Mask of the Registry Indices which can be cached,
+     *  the bits are set by the Gate owning the pipe */
+    uint32_t                    reg_cache_mask;
+    /** \internal Index of the next Registry Cache entry to be replaced */
+    uint8_t                     reg_cache_next;
+    /** \internal Registry values read through this pipe */
+    phHciNfc_Reg_Cache_t        reg_cache[NXP_HCI_REG_CACHE_ENTRIES];
+#endif
 }phHciNfc_Pipe_Info_t;
 
 
@@ -732,6 +810,48 @@ typedef struct phHciNfc_sContext{
     /** \internal Pending Release of the detected Target */
     uint8_t                     target_release;
 
+#ifdef NXP_HCI_SEQ_PROFILE
+    /** \internal Sequence Step being timed */
+    phHciNfc_eSeq_t             prof_seq;
+    /** \internal Start time of the Sequence Step being timed */
+    uint32_t                    prof_start;
+    /** \internal Duration of the Sequence Steps */
+    phHciNfc_Seq_Stats_t        seq_stats[HCI_END_SEQ];
+#endif
+
+#ifdef NXP_HCI_REG_CACHE
+    /** \internal Response built from the Registry Cache */
+    uint8_t                     cache_resp[PHHCINFC_MAX_PACKET_DATA];
+    /** \internal Length of the Response built from the Registry Cache */
+    uint8_t                     cache_resp_len;
+    /** \internal Pipe on which the Cached Response is to be delivered */
+    uint8_t                     cache_resp_pipe;
+    /** \internal Number of Get Parameter served from the Registry Cache */
+    uint32_t                    reg_cache_hits;
+    /** \internal Number of Get Parameter sent to the Host Controller */
+    uint32_t                    reg_cache_misses;
+#endif
+
+#ifdef NXP_HCI_FAST_RESELECT
+    /** \internal Activation Parameters of the Targets in the field */
+    phHciNfc_Act_Cache_t        act_cache[NXP_HCI_ACT_CACHE_ENTRIES];
+    /** \internal Next Activation Cache entry to be replaced */
+    uint8_t                     act_cache_next;
+    /** \internal Reselection of a Target in progress */
+    uint8_t                     reselect_pending;
+    /** \internal Start time of the Reselection in progress */
+    uint32_t                    reselect_start;
+    /** \internal Statistics of the Reselections */
+    phHciNfc_Reselect_Stats_t   reselect_stats;
+#endif
+
+#ifdef NXP_HCI_DISPATCH_STATS
+    /** \internal HCP Messages dispatched to the Gate of each pipe */
+    phHciNfc_Dispatch_Stats_t   dispatch_stats[PHHCINFC_MAX_PIPE];
+    /** \internal HCP Messages received without a Gate handler */
+    uint32_t                    dispatch_unrouted;
+#endif
+
 }phHciNfc_sContext_t;
 
 /*
@@ -1225,6 +1345,107 @@ phHciNfc_Release_Lower(
                     void                        *pHwRef
                );
 
+#ifdef NXP_HCI_REG_CACHE
+
+/**
+ * \ingroup grp_hci_nfc
+ *
+ *  The phHciNfc_RegCache_Invalidate function invalidates the Registry
+ *  values cached for a pipe.
+ *
+ *  \param[in]  psHciContext            psHciContext is the context of
+ *                                      the HCI Layer.
+ *  \param[in]  pipe_id                 pipe_id of the pipe whose cache is
+ *                                      invalidated, HCI_UNKNOWN_PIPE_ID
+ *                                      invalidates the cache of all the pipes.
+ *
+ *  \retval NONE.
+ *
+ */
+
+extern
+void
+phHciNfc_RegCache_Invalidate(
+                    phHciNfc_sContext_t         *psHciContext,
+                    uint8_t                     pipe_id
+               );
+
+/**
+ * \ingroup grp_hci_nfc
+ *
+ *  The phHciNfc_RegCache_Invalidate_Target function invalidates the
+ *  Registry values cached for the pipes of the RF Reader and NFC-IP1
+ *  Gates, which describe the Target in the field.
+ *
+ *  \param[in]  psHciContext            psHciContext is the context of
+ *                                      the HCI Layer.
+ *
+ *  \retval NONE.
+ *
+ */
+
+extern
+void
+phHciNfc_RegCache_Invalidate_Target(
+                    phHciNfc_sContext_t         *psHciContext
+               );
+
+/**
+ * \ingroup grp_hci_nfc
+ *
+ *  The phHciNfc_RegCache_Get_Stats function retrieves the number of
+ *  Get Parameter commands served from the Registry Cache and the number
+ *  of those sent to the Host Controller.
+ *
+ *  \param[in]  psHciContext            psHciContext is the context of
+ *                                      the HCI Layer.
+ *  \param[out] p_hits                  Number of Registry Cache hits.
+ *  \param[out] p_misses                Number of Registry Cache misses.
+ *
+ *  \retval NONE.
+ *
+ */
+
+extern
+void
+phHciNfc_RegCache_Get_Stats(
+                    phHciNfc_sContext_t         *psHciContext,
+                    uint32_t                    *p_hits,
+                    uint32_t                    *p_misses
+               );
+
+#endif /* #ifdef NXP_HCI_REG_CACHE */
+
+#ifdef NXP_HCI_DISPATCH_STATS
+
+/**
+ * \ingroup grp_hci_nfc
+ *
+ *  The phHciNfc_Get_Dispatch_Stats function retrieves the number of
+ *  Responses, Events and Commands dispatched to the Gate handlers of
+ *  the pipe.
+ *
+ *  \param[in]  psHciContext            psHciContext is the context of
+ *                                      the HCI Layer.
+ *  \param[in]  pipe_id                 pipe_id of the pipe.
+ *  \param[out] p_stats                 Messages dispatched to the pipe.
+ *
+ *  \retval NFCSTATUS_SUCCESS           The Statistics are retrieved.
+ *  \retval NFCSTATUS_INVALID_PARAMETER One or more of the supplied parameters
+ *                                      could not be interpreted properly.
+ *
+ */
+
+extern
+NFCSTATUS
+phHciNfc_Get_Dispatch_Stats(
+                    phHciNfc_sContext_t         *psHciContext,
+                    uint8_t                     pipe_id,
+                    phHciNfc_Dispatch_Stats_t   *p_stats
+               );
+
+#endif /* #ifdef NXP_HCI_DISPATCH_STATS */
+
 
 
 #endif
@@ -195,6 +195,12 @@ phHciNfc_ISO15693_Update_PipeInfo(
         pPipeInfo->recv_resp = &phHciNfc_Recv_ISO15693_Response;
         /* Update the event Receive routine of the ISO15693 Gate */
         pPipeInfo->recv_event = &phHciNfc_Recv_ISO15693_Event;
+#ifdef NXP_HCI_REG_CACHE
+        /* Registry describing the activated Target */
+        pPipeInfo->reg_cache_mask =
+                        PHHCINFC_REG_CACHE_BIT(ISO_15693_INVENTORY_INDEX)
+                        | PHHCINFC_REG_CACHE_BIT(ISO_15693_AFI_INDEX);
+#endif
     }
     return status;
 }
@@ -122,6 +122,25 @@ phHciNfc_ReaderMgmt_Initiate_Discovery(
                                 uint8_t                 reader_pipe_id
                              );
 
+#ifdef NXP_HCI_FAST_RESELECT
+static
+NFCSTATUS
+phHciNfc_ReaderMgmt_Target_ID(
+                                phHal_eRFDevType_t      rf_type,
+                                phHal_uRemoteDevInfo_t  *p_dev_info,
+                                uint8_t                 **pp_id,
+                                uint8_t                 *p_id_length
+                             );
+
+static
+uint8_t
+phHciNfc_ReaderMgmt_Find_Target(
+                                phHciNfc_sContext_t     *psHciContext,
+                                phHal_eRFDevType_t      rf_type,
+                                phHal_uRemoteDevInfo_t  *p_dev_info
+                             );
+#endif /* #ifdef NXP_HCI_FAST_RESELECT */
+
 /*
 *************************** Function Definitions ***************************
 */
@@ -1546,16 +1565,283 @@ phHciNfc_ReaderMgmt_Activate_Next(
             && (reader_pipe_id != HCI_UNKNOWN_PIPE_ID )
           )
         {
+#ifdef NXP_HCI_REG_CACHE
+            /* The Next Target replaces the Target described in the Registry */
+            phHciNfc_RegCache_Invalidate( psHciContext, reader_pipe_id );
+#endif
             status = phHciNfc_Send_RFReader_Command (psHciContext, 
                 pHwRef, reader_pipe_id, NXP_WR_ACTIVATE_NEXT );
+#ifdef NXP_HCI_FAST_RESELECT
+            if( NFCSTATUS_PENDING == status )
+            {
+                /* Reselection completes when the Target Info is obtained */
+                psHciContext->reselect_pending = TRUE;
+                psHciContext->reselect_start = phOsalNfc_GetTime();
+            }
+#endif
+        }
+
+    }
+
+    return status;
+
+}
+
+#ifdef NXP_HCI_FAST_RESELECT
+
+/*!
+* \brief Retrieves the identifier of the Target used as the Activation
+* Cache key.
+*/
+
+static
+NFCSTATUS
+phHciNfc_ReaderMgmt_Target_ID(
+                                phHal_eRFDevType_t      rf_type,
+                                phHal_uRemoteDevInfo_t  *p_dev_info,
+                                uint8_t                 **pp_id,
+                                uint8_t                 *p_id_length
+                             )
+{
+    NFCSTATUS                   status = NFCSTATUS_SUCCESS;
+
+    switch( rf_type )
+    {
+        case phHal_eISO14443_A_PCD:
+        {
+            *pp_id = p_dev_info->Iso14443A_Info.Uid;
+            *p_id_length = p_dev_info->Iso14443A_Info.UidLength;
+            break;
+        }
+#ifdef TYPE_B
+        case phHal_eISO14443_B_PCD:
+        {
+            *pp_id = p_dev_info->Iso14443B_Info.AtqB.AtqResInfo.Pupi;
+            *p_id_length = PHHAL_PUPI_LENGTH;
+            break;
+        }
+#endif /* #ifdef TYPE_B */
+#ifdef TYPE_FELICA
+        case phHal_eFelica_PCD:
+        {
+            *pp_id = p_dev_info->Felica_Info.IDm;
+            *p_id_length = p_dev_info->Felica_Info.IDmLength;
+            break;
+        }
+#endif /* #ifdef TYPE_FELICA */
+        default:
+        {
+            status = PHNFCSTVAL(CID_NFC_HCI, NFCSTATUS_FEATURE_NOT_SUPPORTED);
+            break;
+        }
+    }
+    if( (NFCSTATUS_SUCCESS == status) && (0 == *p_id_length) )
+    {
+        status = PHNFCSTVAL(CID_NFC_HCI, NFCSTATUS_INVALID_PARAMETER);
+    }
+
+    return status;
+}
+
+
+/*!
+* \brief Finds the Activation Cache entry of the Target.
+*
+* This function returns NXP_HCI_ACT_CACHE_ENTRIES if the Target is not
+* cached.
+*/
+
+static
+uint8_t
+phHciNfc_ReaderMgmt_Find_Target(
+                                phHciNfc_sContext_t     *psHciContext,
+                                phHal_eRFDevType_t      rf_type,
+                                phHal_uRemoteDevInfo_t  *p_dev_info
+                             )
+{
+    phHciNfc_Act_Cache_t        *p_entry = NULL;
+    uint8_t                     *p_id = NULL;
+    uint8_t                     *p_entry_id = NULL;
+    uint8_t                     id_length = 0;
+    uint8_t                     entry_id_length = 0;
+    uint8_t                     i = 0;
+
+    if( NFCSTATUS_SUCCESS != phHciNfc_ReaderMgmt_Target_ID( rf_type,
+                                            p_dev_info, &p_id, &id_length ) )
+    {
+        i = NXP_HCI_ACT_CACHE_ENTRIES;
+    }
+    for( ; i < NXP_HCI_ACT_CACHE_ENTRIES; i++ )
+    {
+        p_entry = &psHciContext->act_cache[i];
+        if( (TRUE == p_entry->valid) && (rf_type == p_entry->rf_type)
+            && (NFCSTATUS_SUCCESS == phHciNfc_ReaderMgmt_Target_ID( rf_type,
+                        &p_entry->dev_info, &p_entry_id, &entry_id_length ))
+            && (id_length == entry_id_length)
+            && (0 == memcmp( p_id, p_entry_id, id_length ))
+          )
+        {
+            break;
         }
+    }
+
+    return i;
+}
+
+
+/*!
+* \brief Restores the Activation Parameters of the Target from the
+* Activation Cache.
+*
+* The identifier of the Target is the first information read by the RF
+* Reader Gate, the remaining Registry reads are skipped on a cache hit.
+*/
 
+NFCSTATUS
+phHciNfc_ReaderMgmt_Restore_Target(
+                                phHciNfc_sContext_t             *psHciContext,
+                                phHal_sRemoteDevInformation_t   *p_remote_info
+                    )
+{
+    NFCSTATUS                   status = NFCSTATUS_SUCCESS;
+    uint8_t                     index = 0;
+
+    if( (NULL == psHciContext) || (NULL == p_remote_info) )
+    {
+        status = PHNFCSTVAL(CID_NFC_HCI, NFCSTATUS_INVALID_PARAMETER);
+    }
+    else if( TRUE != psHciContext->reselect_pending )
+    {
+        /* Only the Targets reselected in the same field are restored */
+        status = PHNFCSTVAL(CID_NFC_HCI, NFCSTATUS_FAILED);
+    }
+    else
+    {
+        index = phHciNfc_ReaderMgmt_Find_Target( psHciContext,
+                    psHciContext->host_rf_type, &p_remote_info->RemoteDevInfo );
+        if( index < NXP_HCI_ACT_CACHE_ENTRIES )
+        {
+            (void)memcpy( &p_remote_info->RemoteDevInfo,
+                    &psHciContext->act_cache[index].dev_info,
+                    sizeof(phHal_uRemoteDevInfo_t) );
+            psHciContext->reselect_stats.hits++;
+            HCI_DEBUG("HCI : Target Info restored from Activation Cache %02X\n",
+                                                                    index);
+        }
+        else
+        {
+            status = PHNFCSTVAL(CID_NFC_HCI, NFCSTATUS_FAILED);
+        }
     }
 
     return status;
+}
+
+
+/*!
+* \brief Stores the Activation Parameters of the Target in the
+* Activation Cache.
+*
+* This function also completes the timing of the Reselection in progress.
+*/
+
+void
+phHciNfc_ReaderMgmt_Store_Target(
+                                phHciNfc_sContext_t             *psHciContext,
+                                phHal_sRemoteDevInformation_t   *p_remote_info
+                    )
+{
+    phHciNfc_Reselect_Stats_t   *p_stats = NULL;
+    uint32_t                    elapsed = 0;
+    uint8_t                     index = 0;
+
+    if( (NULL != psHciContext) && (NULL != p_remote_info) )
+    {
+        index = phHciNfc_ReaderMgmt_Find_Target( psHciContext,
+                    psHciContext->host_rf_type, &p_remote_info->RemoteDevInfo );
+        if( index >= NXP_HCI_ACT_CACHE_ENTRIES )
+        {
+            /* Replace the oldest entry */
+            index = psHciContext->act_cache_next;
+            psHciContext->act_cache_next = (uint8_t)
+                ((index + 1) % NXP_HCI_ACT_CACHE_ENTRIES);
+        }
+        psHciContext->act_cache[index].valid = TRUE;
+        psHciContext->act_cache[index].rf_type = psHciContext->host_rf_type;
+        (void)memcpy( &psHciContext->act_cache[index].dev_info,
+                    &p_remote_info->RemoteDevInfo,
+                    sizeof(phHal_uRemoteDevInfo_t) );
+
+        if( TRUE == psHciContext->reselect_pending )
+        {
+            p_stats = &psHciContext->reselect_stats;
+            elapsed = phOsalNfc_GetTime() - psHciContext->reselect_start;
+            psHciContext->reselect_pending = FALSE;
+            p_stats->count++;
+            p_stats->total_time += elapsed;
+            if( elapsed > p_stats->max_time )
+            {
+                p_stats->max_time = elapsed;
+            }
+        }
+    }
+
+    return;
+}
+
+
+/*!
+* \brief Invalidates the Activation Parameters of all the Targets cached.
+*/
+
+void
+phHciNfc_ReaderMgmt_Clear_Targets(
+                                phHciNfc_sContext_t             *psHciContext
+                    )
+{
+    uint8_t                     i = 0;
+
+    if( NULL != psHciContext )
+    {
+        for( i = 0; i < NXP_HCI_ACT_CACHE_ENTRIES; i++ )
+        {
+            psHciContext->act_cache[i].valid = FALSE;
+        }
+        psHciContext->act_cache_next = 0;
+        psHciContext->reselect_pending = FALSE;
+    }
+
+    return;
+}
+
 
+/*!
+* \brief Retrieves the statistics of the Reselections.
+*/
+
+NFCSTATUS
+phHciNfc_ReaderMgmt_Get_Reselect_Stats(
+                                phHciNfc_sContext_t             *psHciContext,
+                                phHciNfc_Reselect_Stats_t       *p_stats
+                    )
+{
+    NFCSTATUS                   status = NFCSTATUS_SUCCESS;
+
+    if( (NULL == psHciContext) || (NULL == p_stats) )
+    {
+        status = PHNFCSTVAL(CID_NFC_HCI, NFCSTATUS_INVALID_PARAMETER);
+    }
+    else
+    {
+        (void)memcpy( p_stats, &psHciContext->reselect_stats,
+                    sizeof(phHciNfc_Reselect_Stats_t) );
+    }
+
+    return status;
 }
 
+#endif /* #ifdef NXP_HCI_FAST_RESELECT */
+
 /*!
 * \brief Checks the presence of the Remote Target in the field.
 *
@@ -1837,6 +2123,10 @@ phHciNfc_ReaderMgmt_Deselect(
                 p_pipe_info->param_info = &rls_param;
                 p_pipe_info->param_length = sizeof(rls_param);
             }
+#ifdef NXP_HCI_REG_CACHE
+            /* The Target is released, its Registry is no longer valid */
+            phHciNfc_RegCache_Invalidate( psHciContext, reader_pipe_id );
+#endif
             status = phHciNfc_Send_RFReader_Event ( psHciContext, pHwRef, 
                         reader_pipe_id,(uint8_t) NXP_EVT_RELEASE_TARGET );
         }
@@ -554,5 +554,101 @@ NFCSTATUS
                                 uint8_t             event
                     );
 
+#ifdef NXP_HCI_FAST_RESELECT
+
+/**
+ * \ingroup grp_hci_nfc
+ *
+ *  The phHciNfc_ReaderMgmt_Restore_Target function restores the Activation
+ *  Parameters of the Target from the Activation Cache, using the identifier
+ *  of the Target already read from the RF Reader Gate.
+ *
+ *  \param[in]  psHciContext            psHciContext is the context of
+ *                                      the HCI Layer.
+ *  \param[in,out] p_remote_info        Information of the Target, updated
+ *                                      with the cached Activation Parameters.
+ *
+ *  \retval NFCSTATUS_SUCCESS           The Activation Parameters are restored.
+ *  \retval NFCSTATUS_INVALID_PARAMETER One or more of the supplied parameters
+ *                                      could not be interpreted properly.
+ *  \retval NFCSTATUS_FAILED            The Target is not in the Activation
+ *                                      Cache.
+ *
+ */
+
+extern
+NFCSTATUS
+phHciNfc_ReaderMgmt_Restore_Target(
+                                phHciNfc_sContext_t             *psHciContext,
+                                phHal_sRemoteDevInformation_t   *p_remote_info
+                    );
+
+/**
+ * \ingroup grp_hci_nfc
+ *
+ *  The phHciNfc_ReaderMgmt_Store_Target function stores the Activation
+ *  Parameters of the Target discovered in the Activation Cache and
+ *  completes the Reselection in progress.
+ *
+ *  \param[in]  psHciContext            psHciContext is the context of
+ *                                      the HCI Layer.
+ *  \param[in]  p_remote_info           Information of the Target discovered.
+ *
+ *  \retval NONE.
+ *
+ */
+
+extern
+void
+phHciNfc_ReaderMgmt_Store_Target(
+                                phHciNfc_sContext_t             *psHciContext,
+                                phHal_sRemoteDevInformation_t   *p_remote_info
+                    );
+
+/**
+ * \ingroup grp_hci_nfc
+ *
+ *  The phHciNfc_ReaderMgmt_Clear_Targets function invalidates the
+ *  Activation Parameters of all the Targets cached.
+ *
+ *  \param[in]  psHciContext            psHciContext is the context of
+ *                                      the HCI Layer.
+ *
+ *  \retval NONE.
+ *
+ */
+
+extern
+void
+phHciNfc_ReaderMgmt_Clear_Targets(
+                                phHciNfc_sContext_t             *psHciContext
+                    );
+
+/**
+ * \ingroup grp_hci_nfc
+ *
+ *  The phHciNfc_ReaderMgmt_Get_Reselect_Stats function retrieves the
+ *  number, the Activation Cache hits and the latency of the Reselections
+ *  done through Activate Next.
+ *
+ *  \param[in]  psHciContext            psHciContext is the context of
+ *                                      the HCI Layer.
+ *  \param[out] p_stats                 Statistics of the Reselections.
+ *
+ *  \retval NFCSTATUS_SUCCESS           The Statistics are retrieved.
+ *  \retval NFCSTATUS_INVALID_PARAMETER One or more of the supplied parameters
+ *                                      could not be interpreted properly.
+ *
+ */
+
+extern
+NFCSTATUS
+phHciNfc_ReaderMgmt_Get_Reselect_Stats(
+                                phHciNfc_sContext_t             *psHciContext,
+                                phHciNfc_Reselect_Stats_t       *p_stats
+                    );
+
+#endif /* #ifdef NXP_HCI_FAST_RESELECT */
+
 #endif /* PHHCINFC_RFREADER_H */
 
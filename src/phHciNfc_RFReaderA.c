@@ -229,6 +229,15 @@ phHciNfc_ReaderA_Update_PipeInfo(
             pPipeInfo->recv_resp = &phHciNfc_Recv_ReaderA_Response;
             /* Update the event Receive routine of the reader A Gate */
             pPipeInfo->recv_event = &phHciNfc_Recv_ReaderA_Event;
+#ifdef NXP_HCI_REG_CACHE
+            /* Registry describing the activated Target */
+            pPipeInfo->reg_cache_mask =
+                            PHHCINFC_REG_CACHE_BIT(RDR_A_UID_INDEX)
+                            | PHHCINFC_REG_CACHE_BIT(RDR_A_SAK_INDEX)
+                            | PHHCINFC_REG_CACHE_BIT(RDR_A_ATQA_INDEX)
+                            | PHHCINFC_REG_CACHE_BIT(RDR_A_APP_DATA_INDEX)
+                            | PHHCINFC_REG_CACHE_BIT(RDR_A_FWI_SFGT_INDEX);
+#endif
         }
     }
 
@@ -275,6 +284,15 @@ phHciNfc_ReaderA_Info_Sequence (
         else
         {
             HCI_DEBUG ("HCI : p_rdr_a_info->current_seq : %02X\n", p_rdr_a_info->current_seq);
+#ifdef NXP_HCI_FAST_RESELECT
+            /* Skip the Registry reads of a Target already activated */
+            if ((RDR_A_SAK == p_rdr_a_info->current_seq)
+                && (NFCSTATUS_SUCCESS == phHciNfc_ReaderMgmt_Restore_Target(
+                            psHciContext, &(p_rdr_a_info->reader_a_info))))
+            {
+                p_rdr_a_info->current_seq = RDR_A_END_SEQUENCE;
+            }
+#endif
             switch(p_rdr_a_info->current_seq)
             {
                 case RDR_A_UID:
@@ -341,6 +359,10 @@ phHciNfc_ReaderA_Info_Sequence (
                     p_rdr_a_info->current_seq = RDR_A_UID;
                     p_rdr_a_info->next_seq = RDR_A_UID;
                     status = NFCSTATUS_SUCCESS;
+#ifdef NXP_HCI_FAST_RESELECT
+                    phHciNfc_ReaderMgmt_Store_Target(psHciContext, 
+                                    &(p_rdr_a_info->reader_a_info));
+#endif
                     HCI_DEBUG ("HCI : p_rdr_a_info->reader_a_info.RemDevType : %02X\n", p_rdr_a_info->reader_a_info.RemDevType);
                     HCI_DEBUG ("HCI : status notified: %02X\n", CompInfo.status);
                     /* Notify to the upper layer */
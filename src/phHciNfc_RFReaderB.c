@@ -255,6 +255,14 @@ phHciNfc_ReaderB_Update_PipeInfo(
         pPipeInfo->recv_resp = &phHciNfc_Recv_ReaderB_Response;
         /* Update the event Receive routine of the reader B Gate */
         pPipeInfo->recv_event = &phHciNfc_Recv_ReaderB_Event;
+#ifdef NXP_HCI_REG_CACHE
+        /* Registry describing the activated Target */
+        pPipeInfo->reg_cache_mask =
+                        PHHCINFC_REG_CACHE_BIT(RDR_B_PUPI_INDEX)
+                        | PHHCINFC_REG_CACHE_BIT(RDR_B_APP_DATA_INDEX)
+                        | PHHCINFC_REG_CACHE_BIT(RDR_B_AFI_INDEX)
+                        | PHHCINFC_REG_CACHE_BIT(RDR_B_HIGHER_LAYER_RESP_INDEX);
+#endif
     }
 
     return status;
@@ -297,6 +305,15 @@ phHciNfc_ReaderB_Info_Sequence (
         }
         else
         {
+#ifdef NXP_HCI_FAST_RESELECT
+            /* Skip the Registry reads of a Target already activated */
+            if ((RDR_B_APP_DATA == p_rdr_b_info->current_seq)
+                && (NFCSTATUS_SUCCESS == phHciNfc_ReaderMgmt_Restore_Target(
+                            psHciContext, &(p_rdr_b_info->reader_b_info))))
+            {
+                p_rdr_b_info->current_seq = RDR_B_END_SEQUENCE;
+            }
+#endif
             switch(p_rdr_b_info->current_seq)
             {
                 case RDR_B_PUPI:
@@ -397,6 +414,10 @@ phHciNfc_ReaderB_Info_Sequence (
                     p_rdr_b_info->current_seq = RDR_B_PUPI;
                     p_rdr_b_info->next_seq = RDR_B_PUPI;
                     status = NFCSTATUS_SUCCESS;
+#ifdef NXP_HCI_FAST_RESELECT
+                    phHciNfc_ReaderMgmt_Store_Target(psHciContext, 
+                                    &(p_rdr_b_info->reader_b_info));
+#endif
                     /* Notify to the upper layer */
                     phHciNfc_Tag_Notify(psHciContext, 
                                         pHwRef, 
@@ -68,6 +68,14 @@
 /* Address Definitions for HAL Configuration */
 #define NFC_ADDRESS_HAL_CONF            0x9FD0U
 
+/* Status of a Sequence Step not applicable to the current Target or
+ * Configuration, the Sequence continues with the following Step */
+#define HCI_SEQ_STEP_SKIPPED            \
+                PHNFCSTVAL(CID_NFC_HCI, 0x79U)
+
+#define HCI_SEQ_TABLE_SIZE(table)       \
+                ((uint8_t)(sizeof(table) / sizeof(phHciNfc_sSeqStep_t)))
+
 
 /*
 ################################################################################
@@ -102,6 +110,29 @@ static phHciNfc_sFsm_t phHciNfc_Valid_Fsm[] = {
 
 #endif
 
+/* Function run by a Step of the HCI Sequence Engine */
+typedef NFCSTATUS (*pphHciNfc_Seq_Step_t)(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                            );
+
+typedef struct phHciNfc_sSeqStep
+{
+    /* Sequence Step described by the entry */
+    phHciNfc_eSeq_t         seq;
+    /* Gate operation performed in the Step */
+    pphHciNfc_Seq_Step_t    step;
+    /* Status of the Gate operation completing the Step */
+    NFCSTATUS               next_status;
+    /* Step following the completion of the Step, HCI_INVALID_SEQ for
+     * the last Step of the Sequence */
+    phHciNfc_eSeq_t         next_seq;
+    /* Prepares the Gate of the next Step, it may override the
+     * next_seq for the transitions depending on the HCI Mode */
+    pphHciNfc_Seq_Step_t    transition;
+}phHciNfc_sSeqStep_t;
+
+
 
 /*
 ################################################################################
@@ -205,401 +236,912 @@ phHciNfc_Pending_Sequence(
                                 void                    *pHwRef
                           );
 
+static
+NFCSTATUS
+phHciNfc_Run_Sequence(
+                                phHciNfc_sContext_t         *psHciContext,
+                                void                        *pHwRef,
+                                const phHciNfc_sSeqStep_t   *p_seq_table,
+                                uint8_t                     seq_count,
+                                NFCSTATUS                   complete_status
+                          );
 
-/*
-################################################################################
-***************************** Function Definitions *****************************
-################################################################################
-*/
+#ifdef ESTABLISH_SESSION
+static
+NFCSTATUS
+phHciNfc_Init_Admin_Transition(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
+#endif
 
-NFCSTATUS 
-phHciNfc_FSM_Validate( 
-                      phHciNfc_sContext_t *psHciContext,  
-                      phHciNfc_eState_t state,  
-                      uint8_t validate_type
-                    )
-{
-    NFCSTATUS           status = PHNFCSTVAL(CID_NFC_HCI, NFCSTATUS_INVALID_STATE);
-    phHciNfc_eState_t   cur_state = (phHciNfc_eState_t) 
-        psHciContext->hci_state.cur_state;
+static
+NFCSTATUS
+phHciNfc_Init_Dev_Transition(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
 
-    switch(validate_type)
-    {
-        case NFC_FSM_CURRENT:
-        {
-            if( cur_state == (uint8_t) state )
-            {
-                status = NFCSTATUS_SUCCESS;
-            }
-            break;
-        }
-        case NFC_FSM_NEXT:
-        {
-            phHciNfc_eState_t   next_state = state;
-            switch (cur_state)
-            {
-                case hciState_Reset:
-                {
-                    switch(next_state)
-                    {
-                        /* Specifies the Starting of the init Sequence */
-                        case hciState_Initialise:
-                        /* Initialise to Perform Test on 
-                           the Antenna/SWP Link */
-                        case hciState_Test:
-                        {
-                            status = NFCSTATUS_SUCCESS;
-                            break;
-                        }
-                        default:
-                            break;
-                    }
-                    break;
-                }
-                case hciState_Initialise:
-                {
-                    switch(next_state)
-                    {
-                        /* Discovery Resume after connect failure */
-                        case hciState_Initialise:
-                        /* Configuring the Discovery/Emulation */
-                        case hciState_Config:
-                        /* Configuring the Memory */
-                        case hciState_IO:
-                        /* Occurence of the Tag Discovered Event */
-                        case hciState_Select:
-                        /* Occurence of the Target Activated Event */
-                        case hciState_Listen:
-                        /* Specifies the Starting of the Release Sequence */
-                        case hciState_Release:
-                        {
-                            status = NFCSTATUS_SUCCESS;
-                            break;
-                        }
-                        default:
-                            break;
-                    }
-                    break;
-                }
-                case hciState_Test:
-                {
-                    if ((hciState_Test == next_state )
-                        || (hciState_IO == next_state)
-                        || (hciState_Release == next_state))
-                    {
-                        /*  Next Test/Reset Sequence */
-                        status = NFCSTATUS_SUCCESS;
-                    }
-                    break;
-                }
-                case hciState_Select:
-                {
-                    switch(next_state)
-                    {
-                        /* Restart the Wheel */
-                        case hciState_Initialise:
-                            /* Select the next Tag in the Field or 
-                             * already Selected Tag Again 
-                             */
-                        /* Configuring the Memory */
-                        case hciState_IO:
-                        case hciState_Select:
-                        /* Configuring the Discovery/Emulation */
-                        case hciState_Config:
-                            /* Re-Activate the Target or 
-                             * Discover the next target 
-                             */
-                        case hciState_Reactivate:
-                        /* Connect the Discovered Target */
-                        case hciState_Connect:
-                        /* Specifies the Starting of the Release Sequence */
-                        case hciState_Release:
-                        {
-                            status = NFCSTATUS_SUCCESS;
-                            break;
-                        }
-                        default:
-                            break;
-                    }
-                    break;
-                }
-                case hciState_Connect:
-                {
-                    switch(next_state)
-                    {
-                        /* Disabling the Tag Discovery */
-                        case hciState_Initialise:
-                            /* Configuring the Discovery/Emulation */
-                            /* This should not be allowed if the target
-                            * is connected.
-                            */
-                        /* Configuring the Memory */
-                        case hciState_IO:
-                        case hciState_Config:
-                            /* Re-Activate the Target or 
-                             * Discover the next target 
-                             */
-                        case hciState_Reactivate:
-                        /* Intermediate Transceive State */
-                        case hciState_Transact:
-                        /* Intermediate Presence Check State */
-                        case hciState_Presence:
-                        /* Disconnect the Target Connected */
-                        case hciState_Disconnect:
-                        /* Specifies the Starting of the Release Sequence */
-                        case hciState_Release:
-                        {
-                            status = NFCSTATUS_SUCCESS;
-                            break;
-                        }
-                        default:
-                            break;
-                    }
-                    break;
-                }
-                case hciState_Listen:
-                {
-                    switch(next_state)
-                    {
-                        /* Releasing from the Emulation/Target Mode */
-                        case hciState_Initialise:
-                        /* Occurence of the Tag Discovered Event 
-                        * after the Disconnect Operation
-                        */
-                        case hciState_Select:
-                        /* Configuring the Memory */
-                        case hciState_IO:
-                        /* Configuring the Discovery/Emulation */
-                        case hciState_Config:
-                        /* Intermediate Transceive State */
-                        case hciState_Transact:
-                        /* Specifies the Starting of the Release Sequence */
-                        case hciState_Release:
-                        {
-                            status = NFCSTATUS_SUCCESS;
-                            break;
-                        }
-                        default:
-                            break;
-                    }
-                    break;
-                }
-                case hciState_Reactivate:
-                {
-                    switch(next_state)
-                    {
-                        /* Restart/Discovery after the Target is removed
-                         * after Reactivation.
-                        */
-                        /* case hciState_Initialise: */
-                        /* Re-Connect the Re-Activated Target */
-                        case hciState_Connect:
-                        /* Configuring the Memory */
-                        case hciState_IO:
-                        /* Configuring the Discovery/Emulation */
-                        case hciState_Config:
-                        /* Specifies the Starting of the Release Sequence */
-                        case hciState_Release:
-                        {
-                            status = NFCSTATUS_SUCCESS;
-                            break;
-                        }
-                        default:
-                            break;
-                    }
-                    break;
-                }
-                case hciState_Disconnect:
-                {
-                    switch(next_state)
-                    {
-                        /* Discovery Resume after connect failure 
-                           after the disconnect */
-                        case hciState_Initialise:
-                        /* Configuring the Memory */
-                        case hciState_IO:
-                        /* Configuring the Discovery/Emulation */
-                        case hciState_Config:
-                        /* Occurence of the Tag Discovered Event 
-                        * after the Disconnect Operation
-                        */
-                        case hciState_Select:
-                        /* Occurence of the Target Activated Event */
-                        case hciState_Listen:
-                        /* Specifies the Starting of the Release Sequence */
-                        case hciState_Release:
-                        {
-                            status = NFCSTATUS_SUCCESS;
-                            break;
-                        }
-                        default:
-                        {
-                            break;
-                    }
-                    }
-                    break;
-                }
-#ifdef USE_M5
-                case hciState_Presence:
-                case hciState_Transact:
-                case hciState_Release:
-                {
-                    break;
-                }
-#endif
-                /* case phHciNfc_Unknown: */
-                default:
-                {
-                    /* status = PHNFCSTVAL(CID_NFC_HCI, NFCSTATUS_INVALID_STATE); */
-                    break;
-                }
-            } /* End of State Validation Switch */
-            if( NFC_FSM_IN_PROGRESS == psHciContext->hci_state.transition )
-            {
-                status = PHNFCSTVAL(CID_NFC_HCI, NFCSTATUS_BUSY);
-            }
-            break;
-        }
-        default:
-        {
-            HCI_DEBUG("State Validate Type:%x is Unknown/Incorrect \n",
-                                                            validate_type);
-            break;
-        }
-    }
-    return status;
-}
+static
+NFCSTATUS
+phHciNfc_Init_PollLoop_Transition(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
 
+static
 NFCSTATUS
-phHciNfc_FSM_Update(
-                    phHciNfc_sContext_t *psHciContext,
-                    phHciNfc_eState_t   next_state
-                    )
-{
-    NFCSTATUS       status = PHNFCSTVAL(CID_NFC_HCI, NFCSTATUS_INVALID_STATE);
+phHciNfc_Init_Reader_Transition(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
 
-    HCI_DEBUG(" HCI: Current State --> %02u \n", 
-                            psHciContext->hci_state.cur_state );
-    HCI_DEBUG(" HCI: Transition Before FSM Update --> %02u \n", 
-                    psHciContext->hci_state.transition );
-    HCI_DEBUG(" HCI: Next State Before FSM Update --> %02u \n", 
-                            psHciContext->hci_state.next_state );
+#ifdef ESTABLISH_SESSION
+#ifdef SW_AUTO_ACTIVATION
+static
+NFCSTATUS
+phHciNfc_Init_SwAuto_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
+#endif
 
-    status = phHciNfc_FSM_Validate(psHciContext, next_state, NFC_FSM_NEXT );
-    if(NFCSTATUS_SUCCESS == status)
-    {
-        psHciContext->hci_state.next_state = (uint8_t) next_state;
-        psHciContext->hci_state.transition = NFC_FSM_IN_PROGRESS;
-        psHciContext->response_pending = FALSE;
-        HCI_DEBUG(" HCI: Next State After FSM Update --> %02u \n", 
-                                psHciContext->hci_state.next_state );
-    }
-    else
-    {
-        HCI_DEBUG(" HCI: FSM - Invalid next state --> %02u \n", 
-                                next_state );
-    }
+static
+NFCSTATUS
+phHciNfc_Init_Identity_Transition(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
+#endif /* #ifdef ESTABLISH_SESSION */
 
-    return status;
-}
+#if ( NXP_HAL_MEM_INFO_SIZE > 0x00U )
+static
+NFCSTATUS
+phHciNfc_Init_HalInfo_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
+#endif
 
+static
+NFCSTATUS
+phHciNfc_Init_Complete(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
 
+static
 NFCSTATUS
-phHciNfc_FSM_Complete(
-                        phHciNfc_sContext_t *psHciContext
-                    )
-{
-    NFCSTATUS       status = PHNFCSTVAL(CID_NFC_HCI, NFCSTATUS_INVALID_STATE);
+phHciNfc_Rel_PollLoop_Transition(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
 
-    HCI_DEBUG("HCI: In Function: %s \n", __FUNCTION__);
+static
+NFCSTATUS
+phHciNfc_Rel_Emulation_Transition(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
 
-    HCI_DEBUG(" HCI: Transition Before FSM Complete --> %02u \n", 
-                    psHciContext->hci_state.transition );
- 
-    HCI_DEBUG(" HCI: Current State Before FSM Complete --> %02u \n", 
-                            psHciContext->hci_state.cur_state );
+static
+NFCSTATUS
+phHciNfc_Rel_Dev_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
 
-    HCI_DEBUG(" HCI: Next State Before FSM Complete  --> %02u \n", 
-                            psHciContext->hci_state.next_state );
+static
+NFCSTATUS
+phHciNfc_Rel_Admin_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
 
-    if( (NFC_FSM_IN_PROGRESS == psHciContext->hci_state.transition)
-      )
-    {
-        psHciContext->hci_state.cur_state = 
-                                    psHciContext->hci_state.next_state ;
-        psHciContext->hci_state.transition = NFC_FSM_COMPLETE ;
-        psHciContext->hci_state.next_state = (uint8_t) hciState_Unknown ;
-        /* Reset the HCI Sequence */
-        psHciContext->response_pending = FALSE;
-        psHciContext->hci_seq = HCI_INVALID_SEQ;
-        status = NFCSTATUS_SUCCESS;
-    }
+static
+NFCSTATUS
+phHciNfc_Rel_Complete(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
 
-    HCI_DEBUG(" HCI: Current State After FSM Complete --> %02u \n", 
-                            psHciContext->hci_state.cur_state );
+#ifdef ENABLE_P2P
+static
+NFCSTATUS
+phHciNfc_Cfg_ATRInfo_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
 
-    return status;
-}
+static
+NFCSTATUS
+phHciNfc_Cfg_P2P_Complete(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
+#endif /* #ifdef ENABLE_P2P */
 
-void
-phHciNfc_FSM_Rollback(
-                        phHciNfc_sContext_t *psHciContext
-                    )
-{
+static
+NFCSTATUS
+phHciNfc_Poll_Duration_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
 
-    HCI_DEBUG("HCI: %s: transition=%02u, cur_state=%02u, next_state=%02u\n",
-            __func__,
-            psHciContext->hci_state.transition,
-            psHciContext->hci_state.cur_state,
-            psHciContext->hci_state.next_state);
+#if defined (ENABLE_P2P) && defined (TARGET_SPEED)
+static
+NFCSTATUS
+phHciNfc_Poll_TargetSpeed_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
+#endif
 
+#if defined (ENABLE_P2P) && defined (INITIATOR_SPEED)
+static
+NFCSTATUS
+phHciNfc_Poll_InitiatorSpeed_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
+#endif
 
+#if defined (ENABLE_P2P) && defined (NFCIP_TGT_DISABLE_CFG)
+static
+NFCSTATUS
+phHciNfc_Poll_TgtDisable_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
+#endif
 
+static
+NFCSTATUS
+phHciNfc_Poll_RdPhases_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
 
+static
+NFCSTATUS
+phHciNfc_Poll_Phases_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
 
+static
+NFCSTATUS
+phHciNfc_Poll_Phases_Transition(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
 
-    if( (NFC_FSM_IN_PROGRESS  == psHciContext->hci_state.transition)
-      )
-    {
-        psHciContext->hci_state.transition = NFC_FSM_COMPLETE ;
-        psHciContext->hci_state.next_state = (uint8_t) hciState_Unknown ;
-        /* Reset the HCI Sequence */
-        psHciContext->hci_seq = HCI_INVALID_SEQ;
-        psHciContext->response_pending = FALSE;
-    }
-}
+static
+NFCSTATUS
+phHciNfc_Poll_Disable_Transition(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
 
-#ifdef HCI_FSM_RESET
 static
 void
-phHciNfc_FSM_Reset(
-                        phHciNfc_sContext_t *psHciContext
-                    )
-{
+phHciNfc_Poll_Notify(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef,
+                                NFCSTATUS               status
+                          );
 
-    if( (hciState_Reset  != psHciContext->hci_state.cur_state )
-      )
-    {
-        psHciContext->hci_state.cur_state = (uint8_t) hciState_Initialise ;
-        psHciContext->hci_state.transition = NFC_FSM_COMPLETE ;
-        psHciContext->hci_state.next_state = (uint8_t) hciState_Unknown ;
-        /* Reset the HCI Sequence */
-        psHciContext->hci_seq = HCI_INVALID_SEQ;
-    }
+static
+NFCSTATUS
+phHciNfc_Poll_Complete(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
 
-}
+#if defined(HOST_EMULATION)
+static
+NFCSTATUS
+phHciNfc_EmuCfg_Admin_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
 #endif
 
-
-
 static
 NFCSTATUS
-phHciNfc_Pending_Sequence(
+phHciNfc_EmuCfg_Config_Step(
                                 phHciNfc_sContext_t     *psHciContext,
                                 void                    *pHwRef
-                          )
-{
-    NFCSTATUS           status = NFCSTATUS_SUCCESS;
+                          );
+
+#ifdef UICC_SESSION_RESET
+static
+NFCSTATUS
+phHciNfc_EmuCfg_Config_Transition(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
+
+static
+NFCSTATUS
+phHciNfc_EmuCfg_Release_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
+
+static
+NFCSTATUS
+phHciNfc_EmuCfg_Release_Transition(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
+#endif /* UICC_SESSION_RESET */
+
+static
+NFCSTATUS
+phHciNfc_EmuCfg_Complete(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
+
+static
+NFCSTATUS
+phHciNfc_Smx_Mode_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
+
+static
+NFCSTATUS
+phHciNfc_Smx_Complete(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
+
+static
+NFCSTATUS
+phHciNfc_Connect_Select_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
+
+static
+NFCSTATUS
+phHciNfc_Connect_Reactivate_Complete(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
+
+static
+NFCSTATUS
+phHciNfc_Connect_Complete(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
+
+static
+NFCSTATUS
+phHciNfc_Disc_Dispatch_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
+
+static
+NFCSTATUS
+phHciNfc_Disc_Deselect_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
+
+static
+NFCSTATUS
+phHciNfc_Disc_Deselect_Transition(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
+
+static
+NFCSTATUS
+phHciNfc_Disc_Complete(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          );
+
+
+/*
+################################################################################
+************************ Sequence Table Definitions ****************************
+################################################################################
+*/
+
+#if ( NXP_HAL_MEM_INFO_SIZE > 0x00U )
+#define HCI_SESSION_INFO_SEQ            DEV_HAL_INFO_SEQ
+#else
+#define HCI_SESSION_INFO_SEQ            IDENTITY_INFO_SEQ
+#endif /* #if ( NXP_HAL_MEM_INFO_SIZE > 0x00U ) */
+
+#if defined( ESTABLISH_SESSION )
+#define HCI_EMULATION_INIT_NEXT_SEQ     ADMIN_SESSION_SEQ
+#elif ( NXP_HAL_MEM_INFO_SIZE > 0x00U )
+#define HCI_EMULATION_INIT_NEXT_SEQ     DEV_HAL_INFO_SEQ
+#else
+#define HCI_EMULATION_INIT_NEXT_SEQ     HCI_END_SEQ
+#endif
+
+#if defined( SW_AUTO_ACTIVATION )
+#define HCI_PL_STOP_NEXT_SEQ            READER_SW_AUTO_SEQ
+#else
+#define HCI_PL_STOP_NEXT_SEQ            HCI_SESSION_INFO_SEQ
+#endif
+
+/* Steps of the HCI Initialisation Sequence */
+static const phHciNfc_sSeqStep_t phHciNfc_Init_Seq_Table[] = {
+#ifdef ESTABLISH_SESSION
+    { ADMIN_INIT_SEQ,       phHciNfc_Admin_Initialise, NFCSTATUS_SUCCESS,
+                            LINK_MGMT_INIT_SEQ,     phHciNfc_Init_Admin_Transition },
+#else
+    { ADMIN_INIT_SEQ,       phHciNfc_Admin_Initialise, NFCSTATUS_SUCCESS,
+                            LINK_MGMT_INIT_SEQ,     NULL },
+#endif
+    { LINK_MGMT_INIT_SEQ,   phHciNfc_LinkMgmt_Initialise, NFCSTATUS_SUCCESS,
+                            IDENTITY_INIT_SEQ,      NULL },
+    { IDENTITY_INIT_SEQ,    phHciNfc_IDMgmt_Initialise, NFCSTATUS_SUCCESS,
+                            DEV_INIT_SEQ,           NULL },
+    { DEV_INIT_SEQ,         phHciNfc_DevMgmt_Initialise, NFCSTATUS_SUCCESS,
+                            PL_INIT_SEQ,            phHciNfc_Init_Dev_Transition },
+    { PL_INIT_SEQ,          phHciNfc_PollLoop_Initialise, NFCSTATUS_SUCCESS,
+                            READER_MGMT_INIT_SEQ,   phHciNfc_Init_PollLoop_Transition },
+    { READER_MGMT_INIT_SEQ, phHciNfc_ReaderMgmt_Initialise, NFCSTATUS_SUCCESS,
+                            EMULATION_INIT_SEQ,     phHciNfc_Init_Reader_Transition },
+    { EMULATION_INIT_SEQ,   phHciNfc_EmuMgmt_Initialise, NFCSTATUS_SUCCESS,
+                            HCI_EMULATION_INIT_NEXT_SEQ, NULL },
+#ifdef ESTABLISH_SESSION
+    { ADMIN_SESSION_SEQ,    phHciNfc_Admin_Initialise, NFCSTATUS_SUCCESS,
+                            HCI_SESSION_INFO_SEQ,   NULL },
+    { PL_STOP_SEQ,          phHciNfc_ReaderMgmt_Disable_Discovery, NFCSTATUS_SUCCESS,
+                            HCI_PL_STOP_NEXT_SEQ,   NULL },
+#ifdef SW_AUTO_ACTIVATION
+    { READER_SW_AUTO_SEQ,   phHciNfc_Init_SwAuto_Step, NFCSTATUS_SUCCESS,
+                            IDENTITY_INFO_SEQ,      NULL },
+#endif
+    { IDENTITY_INFO_SEQ,    phHciNfc_IDMgmt_Info_Sequence, NFCSTATUS_SUCCESS,
+                            HCI_END_SEQ,            phHciNfc_Init_Identity_Transition },
+    { EMULATION_SWP_SEQ,    phHciNfc_EmuMgmt_Initialise, NFCSTATUS_SUCCESS,
+                            HCI_END_SEQ,            NULL },
+#endif /* #ifdef ESTABLISH_SESSION */
+#if ( NXP_HAL_MEM_INFO_SIZE > 0x00U )
+    { DEV_HAL_INFO_SEQ,     phHciNfc_Init_HalInfo_Step, NFCSTATUS_SUCCESS,
+                            DEV_HAL_INFO_SEQ,       NULL },
+#endif
+    { HCI_END_SEQ,          phHciNfc_Init_Complete, NFCSTATUS_SUCCESS,
+                            HCI_INVALID_SEQ,        NULL },
+};
+
+/* Steps of the HCI Release Sequence */
+static const phHciNfc_sSeqStep_t phHciNfc_Release_Seq_Table[] = {
+    { PL_STOP_SEQ,          phHciNfc_ReaderMgmt_Disable_Discovery, NFCSTATUS_SUCCESS,
+                            EMULATION_REL_SEQ,      phHciNfc_Rel_PollLoop_Transition },
+    { EMULATION_REL_SEQ,    phHciNfc_EmuMgmt_Release, NFCSTATUS_SUCCESS,
+                            ADMIN_REL_SEQ,          phHciNfc_Rel_Emulation_Transition },
+    { DEV_REL_SEQ,          phHciNfc_Rel_Dev_Step, NFCSTATUS_SUCCESS,
+                            HCI_END_SEQ,            NULL },
+    { READER_MGMT_REL_SEQ,  phHciNfc_ReaderMgmt_Release, NFCSTATUS_SUCCESS,
+                            PL_REL_SEQ,             NULL },
+    { PL_REL_SEQ,           phHciNfc_PollLoop_Release, NFCSTATUS_SUCCESS,
+                            IDENTITY_REL_SEQ,       NULL },
+    { IDENTITY_REL_SEQ,     phHciNfc_IDMgmt_Release, NFCSTATUS_SUCCESS,
+                            LINK_MGMT_REL_SEQ,      NULL },
+    { LINK_MGMT_REL_SEQ,    phHciNfc_LinkMgmt_Release, NFCSTATUS_SUCCESS,
+                            ADMIN_REL_SEQ,          NULL },
+    { ADMIN_REL_SEQ,        phHciNfc_Rel_Admin_Step, NFCSTATUS_SUCCESS,
+                            DEV_REL_SEQ,            NULL },
+    { HCI_END_SEQ,          phHciNfc_Rel_Complete, NFCSTATUS_SUCCESS,
+                            HCI_INVALID_SEQ,        NULL },
+};
+
+#if defined (ENABLE_P2P) && defined (NFCIP_TGT_DISABLE_CFG)
+#define HCI_PL_SPEED_NEXT_SEQ           PL_TGT_DISABLE_SEQ
+#else
+#define HCI_PL_SPEED_NEXT_SEQ           PL_CONFIG_PHASE_SEQ
+#endif
+
+#if defined (ENABLE_P2P) && defined (INITIATOR_SPEED)
+#define HCI_PL_INITIATOR_NEXT_SEQ       INITIATOR_SPEED_SEQ
+#else
+#define HCI_PL_INITIATOR_NEXT_SEQ       HCI_PL_SPEED_NEXT_SEQ
+#endif
+
+#if defined (ENABLE_P2P) && defined (TARGET_SPEED)
+#define HCI_PL_DURATION_NEXT_SEQ        TARGET_SPEED_SEQ
+#else
+#define HCI_PL_DURATION_NEXT_SEQ        HCI_PL_INITIATOR_NEXT_SEQ
+#endif
+
+#ifdef ENABLE_P2P
+/* Steps of the NFC-IP(P2P) General Bytes Configuration Sequence */
+static const phHciNfc_sSeqStep_t phHciNfc_P2P_Cfg_Seq_Table[] = {
+    { TARGET_GENERAL_SEQ,   phHciNfc_Cfg_ATRInfo_Step, NFCSTATUS_PENDING,
+                            HCI_END_SEQ,            NULL },
+    { HCI_END_SEQ,          phHciNfc_Cfg_P2P_Complete, NFCSTATUS_SUCCESS,
+                            HCI_INVALID_SEQ,        NULL },
+};
+#endif /* #ifdef ENABLE_P2P */
+
+/* Steps of the HCI Discovery (Polling Loop) Configuration Sequence */
+static const phHciNfc_sSeqStep_t phHciNfc_PollLoop_Seq_Table[] = {
+    { PL_DURATION_SEQ,      phHciNfc_Poll_Duration_Step, NFCSTATUS_SUCCESS,
+                            HCI_PL_DURATION_NEXT_SEQ, NULL },
+#if defined (ENABLE_P2P) && defined (TARGET_SPEED)
+    { TARGET_SPEED_SEQ,     phHciNfc_Poll_TargetSpeed_Step, NFCSTATUS_PENDING,
+                            HCI_PL_INITIATOR_NEXT_SEQ, NULL },
+#endif
+#if defined (ENABLE_P2P) && defined (INITIATOR_SPEED)
+    { INITIATOR_SPEED_SEQ,  phHciNfc_Poll_InitiatorSpeed_Step, NFCSTATUS_PENDING,
+                            HCI_PL_SPEED_NEXT_SEQ,  NULL },
+#endif
+#if defined (ENABLE_P2P) && defined (NFCIP_TGT_DISABLE_CFG)
+    { PL_TGT_DISABLE_SEQ,   phHciNfc_Poll_TgtDisable_Step, NFCSTATUS_SUCCESS,
+                            PL_CONFIG_PHASE_SEQ,    NULL },
+#endif
+    { PL_CONFIG_PHASE_SEQ,  phHciNfc_Poll_Phases_Step, NFCSTATUS_SUCCESS,
+                            READER_ENABLE_SEQ,      phHciNfc_Poll_Phases_Transition },
+    { READER_ENABLE_SEQ,    phHciNfc_ReaderMgmt_Enable_Discovery, NFCSTATUS_SUCCESS,
+                            HCI_END_SEQ,            NULL },
+    { READER_DISABLE_SEQ,   phHciNfc_ReaderMgmt_Disable_Discovery, NFCSTATUS_SUCCESS,
+                            PL_DURATION_SEQ,        phHciNfc_Poll_Disable_Transition },
+    { HCI_END_SEQ,          phHciNfc_Poll_Complete, NFCSTATUS_SUCCESS,
+                            HCI_INVALID_SEQ,        NULL },
+};
+
+/* Steps of the HCI Emulation Configuration Sequence */
+static const phHciNfc_sSeqStep_t phHciNfc_EmuCfg_Seq_Table[] = {
+#if defined(HOST_EMULATION)
+    { ADMIN_CE_SEQ,         phHciNfc_EmuCfg_Admin_Step, NFCSTATUS_SUCCESS,
+                            EMULATION_CONFIG_SEQ,   NULL },
+#endif
+#ifdef UICC_SESSION_RESET
+    { EMULATION_CONFIG_SEQ, phHciNfc_EmuCfg_Config_Step, NFCSTATUS_SUCCESS,
+                            HCI_END_SEQ,            phHciNfc_EmuCfg_Config_Transition },
+    { ADMIN_REL_SEQ,        phHciNfc_EmuCfg_Release_Step, NFCSTATUS_SUCCESS,
+                            HCI_END_SEQ,            phHciNfc_EmuCfg_Release_Transition },
+#else
+    { EMULATION_CONFIG_SEQ, phHciNfc_EmuCfg_Config_Step, NFCSTATUS_SUCCESS,
+                            HCI_END_SEQ,            NULL },
+#endif /* UICC_SESSION_RESET */
+    { HCI_END_SEQ,          phHciNfc_EmuCfg_Complete, NFCSTATUS_SUCCESS,
+                            HCI_INVALID_SEQ,        NULL },
+};
+
+/* Steps of the SmartMX Mode Configuration Sequence */
+static const phHciNfc_sSeqStep_t phHciNfc_SmxMode_Seq_Table[] = {
+    { READER_DISABLE_SEQ,   phHciNfc_ReaderMgmt_Disable_Discovery, NFCSTATUS_SUCCESS,
+                            EMULATION_CONFIG_SEQ,   NULL },
+    { EMULATION_CONFIG_SEQ, phHciNfc_Smx_Mode_Step, NFCSTATUS_SUCCESS,
+                            PL_CONFIG_PHASE_SEQ,    NULL },
+    { PL_CONFIG_PHASE_SEQ,  phHciNfc_Poll_RdPhases_Step, NFCSTATUS_SUCCESS,
+                            READER_ENABLE_SEQ,      NULL },
+    { READER_ENABLE_SEQ,    phHciNfc_ReaderMgmt_Enable_Discovery, NFCSTATUS_SUCCESS,
+                            HCI_END_SEQ,            NULL },
+    { HCI_END_SEQ,          phHciNfc_Smx_Complete, NFCSTATUS_SUCCESS,
+                            HCI_INVALID_SEQ,        NULL },
+};
+
+/* Steps of the HCI Target Selection and Reactivation Sequence */
+static const phHciNfc_sSeqStep_t phHciNfc_Connect_Seq_Table[] = {
+    { READER_REACTIVATE_SEQ, phHciNfc_Connect_Reactivate_Complete, NFCSTATUS_SUCCESS,
+                            HCI_INVALID_SEQ,        NULL },
+    { READER_SELECT_SEQ,    phHciNfc_Connect_Select_Step, NFCSTATUS_SUCCESS,
+                            HCI_END_SEQ,            NULL },
+    { HCI_END_SEQ,          phHciNfc_Connect_Complete, NFCSTATUS_SUCCESS,
+                            HCI_INVALID_SEQ,        NULL },
+};
+
+/* Steps of the HCI Target De-Selection Sequence */
+static const phHciNfc_sSeqStep_t phHciNfc_Disconnect_Seq_Table[] = {
+    { READER_UICC_DISPATCH_SEQ, phHciNfc_Disc_Dispatch_Step, NFCSTATUS_PENDING,
+                            READER_DESELECT_SEQ,    NULL },
+    { READER_DESELECT_SEQ,  phHciNfc_Disc_Deselect_Step, NFCSTATUS_PENDING,
+                            HCI_END_SEQ,            phHciNfc_Disc_Deselect_Transition },
+    { HCI_END_SEQ,          phHciNfc_Disc_Complete, NFCSTATUS_SUCCESS,
+                            HCI_INVALID_SEQ,        NULL },
+};
+
+
+
+/*
+################################################################################
+***************************** Function Definitions *****************************
+################################################################################
+*/
+
+NFCSTATUS 
+phHciNfc_FSM_Validate( 
+                      phHciNfc_sContext_t *psHciContext,  
+                      phHciNfc_eState_t state,  
+                      uint8_t validate_type
+                    )
+{
+    NFCSTATUS           status = PHNFCSTVAL(CID_NFC_HCI, NFCSTATUS_INVALID_STATE);
+    phHciNfc_eState_t   cur_state = (phHciNfc_eState_t) 
+        psHciContext->hci_state.cur_state;
+
+    switch(validate_type)
+    {
+        case NFC_FSM_CURRENT:
+        {
+            if( cur_state == (uint8_t) state )
+            {
+                status = NFCSTATUS_SUCCESS;
+            }
+            break;
+        }
+        case NFC_FSM_NEXT:
+        {
+            phHciNfc_eState_t   next_state = state;
+            switch (cur_state)
+            {
+                case hciState_Reset:
+                {
+                    switch(next_state)
+                    {
+                        /* Specifies the Starting of the init Sequence */
+                        case hciState_Initialise:
+                        /* Initialise to Perform Test on 
+                           the Antenna/SWP Link */
+                        case hciState_Test:
+                        {
+                            status = NFCSTATUS_SUCCESS;
+                            break;
+                        }
+                        default:
+                            break;
+                    }
+                    break;
+                }
+                case hciState_Initialise:
+                {
+                    switch(next_state)
+                    {
+                        /* Discovery Resume after connect failure */
+                        case hciState_Initialise:
+                        /* Configuring the Discovery/Emulation */
+                        case hciState_Config:
+                        /* Configuring the Memory */
+                        case hciState_IO:
+                        /* Occurence of the Tag Discovered Event */
+                        case hciState_Select:
+                        /* Occurence of the Target Activated Event */
+                        case hciState_Listen:
+                        /* Specifies the Starting of the Release Sequence */
+                        case hciState_Release:
+                        {
+                            status = NFCSTATUS_SUCCESS;
+                            break;
+                        }
+                        default:
+                            break;
+                    }
+                    break;
+                }
+                case hciState_Test:
+                {
+                    if ((hciState_Test == next_state )
+                        || (hciState_IO == next_state)
+                        || (hciState_Release == next_state))
+                    {
+                        /*  Next Test/Reset Sequence */
+                        status = NFCSTATUS_SUCCESS;
+                    }
+                    break;
+                }
+                case hciState_Select:
+                {
+                    switch(next_state)
+                    {
+                        /* Restart the Wheel */
+                        case hciState_Initialise:
+                            /* Select the next Tag in the Field or 
+                             * already Selected Tag Again 
+                             */
+                        /* Configuring the Memory */
+                        case hciState_IO:
+                        case hciState_Select:
+                        /* Configuring the Discovery/Emulation */
+                        case hciState_Config:
+                            /* Re-Activate the Target or 
+                             * Discover the next target 
+                             */
+                        case hciState_Reactivate:
+                        /* Connect the Discovered Target */
+                        case hciState_Connect:
+                        /* Specifies the Starting of the Release Sequence */
+                        case hciState_Release:
+                        {
+                            status = NFCSTATUS_SUCCESS;
+                            break;
+                        }
+                        default:
+                            break;
+                    }
+                    break;
+                }
+                case hciState_Connect:
+                {
+                    switch(next_state)
+                    {
+                        /* Disabling the Tag Discovery */
+                        case hciState_Initialise:
+                            /* Configuring the Discovery/Emulation */
+                            /* This should not be allowed if the target
+                            * is connected.
+                            */
+                        /* Configuring the Memory */
+                        case hciState_IO:
+                        case hciState_Config:
+                            /* Re-Activate the Target or 
+                             * Discover the next target 
+                             */
+                        case hciState_Reactivate:
+                        /* Intermediate Transceive State */
+                        case hciState_Transact:
+                        /* Intermediate Presence Check State */
+                        case hciState_Presence:
+                        /* Disconnect the Target Connected */
+                        case hciState_Disconnect:
+                        /* Specifies the Starting of the Release Sequence */
+                        case hciState_Release:
+                        {
+                            status = NFCSTATUS_SUCCESS;
+                            break;
+                        }
+                        default:
+                            break;
+                    }
+                    break;
+                }
+                case hciState_Listen:
+                {
+                    switch(next_state)
+                    {
+                        /* Releasing from the Emulation/Target Mode */
+                        case hciState_Initialise:
+                        /* Occurence of the Tag Discovered Event 
+                        * after the Disconnect Operation
+                        */
+                        case hciState_Select:
+                        /* Configuring the Memory */
+                        case hciState_IO:
+                        /* Configuring the Discovery/Emulation */
+                        case hciState_Config:
+                        /* Intermediate Transceive State */
+                        case hciState_Transact:
+                        /* Specifies the Starting of the Release Sequence */
+                        case hciState_Release:
+                        {
+                            status = NFCSTATUS_SUCCESS;
+                            break;
+                        }
+                        default:
+                            break;
+                    }
+                    break;
+                }
+                case hciState_Reactivate:
+                {
+                    switch(next_state)
+                    {
+                        /* Restart/Discovery after the Target is removed
+                         * after Reactivation.
+                        */
+                        /* case hciState_Initialise: */
+                        /* Re-Connect the Re-Activated Target */
+                        case hciState_Connect:
+                        /* Configuring the Memory */
+                        case hciState_IO:
+                        /* Configuring the Discovery/Emulation */
+                        case hciState_Config:
+                        /* Specifies the Starting of the Release Sequence */
+                        case hciState_Release:
+                        {
+                            status = NFCSTATUS_SUCCESS;
+                            break;
+                        }
+                        default:
+                            break;
+                    }
+                    break;
+                }
+                case hciState_Disconnect:
+                {
+                    switch(next_state)
+                    {
+                        /* Discovery Resume after connect failure 
+                           after the disconnect */
+                        case hciState_Initialise:
+                        /* Configuring the Memory */
+                        case hciState_IO:
+                        /* Configuring the Discovery/Emulation */
+                        case hciState_Config:
+                        /* Occurence of the Tag Discovered Event 
+                        * after the Disconnect Operation
+                        */
+                        case hciState_Select:
+                        /* Occurence of the Target Activated Event */
+                        case hciState_Listen:
+                        /* Specifies the Starting of the Release Sequence */
+                        case hciState_Release:
+                        {
+                            status = NFCSTATUS_SUCCESS;
+                            break;
+                        }
+                        default:
+                        {
+                            break;
+                    }
+                    }
+                    break;
+                }
+#ifdef USE_M5
+                case hciState_Presence:
+                case hciState_Transact:
+                case hciState_Release:
+                {
+                    break;
+                }
+#endif
+                /* case phHciNfc_Unknown: */
+                default:
+                {
+                    /* status = PHNFCSTVAL(CID_NFC_HCI, NFCSTATUS_INVALID_STATE); */
+                    break;
+                }
+            } /* End of State Validation Switch */
+            if( NFC_FSM_IN_PROGRESS == psHciContext->hci_state.transition )
+            {
+                status = PHNFCSTVAL(CID_NFC_HCI, NFCSTATUS_BUSY);
+            }
+            break;
+        }
+        default:
+        {
+            HCI_DEBUG("State Validate Type:%x is Unknown/Incorrect \n",
+                                                            validate_type);
+            break;
+        }
+    }
+    return status;
+}
+
+NFCSTATUS
+phHciNfc_FSM_Update(
+                    phHciNfc_sContext_t *psHciContext,
+                    phHciNfc_eState_t   next_state
+                    )
+{
+    NFCSTATUS       status = PHNFCSTVAL(CID_NFC_HCI, NFCSTATUS_INVALID_STATE);
+
+    HCI_DEBUG(" HCI: Current State --> %02u \n", 
+                            psHciContext->hci_state.cur_state );
+    HCI_DEBUG(" HCI: Transition Before FSM Update --> %02u \n", 
+                    psHciContext->hci_state.transition );
+    HCI_DEBUG(" HCI: Next State Before FSM Update --> %02u \n", 
+                            psHciContext->hci_state.next_state );
+
+    status = phHciNfc_FSM_Validate(psHciContext, next_state, NFC_FSM_NEXT );
+    if(NFCSTATUS_SUCCESS == status)
+    {
+        psHciContext->hci_state.next_state = (uint8_t) next_state;
+        psHciContext->hci_state.transition = NFC_FSM_IN_PROGRESS;
+        psHciContext->response_pending = FALSE;
+        HCI_DEBUG(" HCI: Next State After FSM Update --> %02u \n", 
+                                psHciContext->hci_state.next_state );
+    }
+    else
+    {
+        HCI_DEBUG(" HCI: FSM - Invalid next state --> %02u \n", 
+                                next_state );
+    }
+
+    return status;
+}
+
+
+NFCSTATUS
+phHciNfc_FSM_Complete(
+                        phHciNfc_sContext_t *psHciContext
+                    )
+{
+    NFCSTATUS       status = PHNFCSTVAL(CID_NFC_HCI, NFCSTATUS_INVALID_STATE);
+
+    HCI_DEBUG("HCI: In Function: %s \n", __FUNCTION__);
+
+    HCI_DEBUG(" HCI: Transition Before FSM Complete --> %02u \n", 
+                    psHciContext->hci_state.transition );
+ 
+    HCI_DEBUG(" HCI: Current State Before FSM Complete --> %02u \n", 
+                            psHciContext->hci_state.cur_state );
+
+    HCI_DEBUG(" HCI: Next State Before FSM Complete  --> %02u \n", 
+                            psHciContext->hci_state.next_state );
+
+    if( (NFC_FSM_IN_PROGRESS == psHciContext->hci_state.transition)
+      )
+    {
+        psHciContext->hci_state.cur_state = 
+                                    psHciContext->hci_state.next_state ;
+        psHciContext->hci_state.transition = NFC_FSM_COMPLETE ;
+        psHciContext->hci_state.next_state = (uint8_t) hciState_Unknown ;
+        /* Reset the HCI Sequence */
+        psHciContext->response_pending = FALSE;
+        psHciContext->hci_seq = HCI_INVALID_SEQ;
+        status = NFCSTATUS_SUCCESS;
+    }
+
+    HCI_DEBUG(" HCI: Current State After FSM Complete --> %02u \n", 
+                            psHciContext->hci_state.cur_state );
+
+    return status;
+}
+
+void
+phHciNfc_FSM_Rollback(
+                        phHciNfc_sContext_t *psHciContext
+                    )
+{
+
+    HCI_DEBUG("HCI: %s: transition=%02u, cur_state=%02u, next_state=%02u\n",
+            __func__,
+            psHciContext->hci_state.transition,
+            psHciContext->hci_state.cur_state,
+            psHciContext->hci_state.next_state);
+
+
+
+
+
+
+    if( (NFC_FSM_IN_PROGRESS  == psHciContext->hci_state.transition)
+      )
+    {
+        psHciContext->hci_state.transition = NFC_FSM_COMPLETE ;
+        psHciContext->hci_state.next_state = (uint8_t) hciState_Unknown ;
+        /* Reset the HCI Sequence */
+        psHciContext->hci_seq = HCI_INVALID_SEQ;
+        psHciContext->response_pending = FALSE;
+    }
+}
+
+#ifdef HCI_FSM_RESET
+static
+void
+phHciNfc_FSM_Reset(
+                        phHciNfc_sContext_t *psHciContext
+                    )
+{
+
+    if( (hciState_Reset  != psHciContext->hci_state.cur_state )
+      )
+    {
+        psHciContext->hci_state.cur_state = (uint8_t) hciState_Initialise ;
+        psHciContext->hci_state.transition = NFC_FSM_COMPLETE ;
+        psHciContext->hci_state.next_state = (uint8_t) hciState_Unknown ;
+        /* Reset the HCI Sequence */
+        psHciContext->hci_seq = HCI_INVALID_SEQ;
+    }
+
+}
+#endif
+
+
+
+static
+NFCSTATUS
+phHciNfc_Pending_Sequence(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    NFCSTATUS           status = NFCSTATUS_SUCCESS;
 
     PHNFC_UNUSED_VARIABLE(status);
 
@@ -1046,463 +1588,517 @@ phHciNfc_Resume_Sequence(
 }
 
 
+/*!
+ * \brief Runs the current Step of a table driven HCI Sequence.
+ *
+ * This function looks up the Step matching the current hci_seq in the
+ * Sequence table and runs its Gate operation. When the Gate operation
+ * returns the next_status of the Step, the sequence moves to the next
+ * Step and the transition of the Step is performed. A Step returning
+ * HCI_SEQ_STEP_SKIPPED is passed over and the following Step is run in
+ * the same call. The duration of each Step, from its first run to the
+ * first run of the following Step, is recorded in the HCI Context.
+ */
+
+static
 NFCSTATUS
-phHciNfc_Initialise_Sequence(
-                                phHciNfc_sContext_t     *psHciContext,
-                                void                    *pHwRef
-                             )
+phHciNfc_Run_Sequence(
+                                phHciNfc_sContext_t         *psHciContext,
+                                void                        *pHwRef,
+                                const phHciNfc_sSeqStep_t   *p_seq_table,
+                                uint8_t                     seq_count,
+                                NFCSTATUS                   complete_status
+                          )
 {
     NFCSTATUS                   status = NFCSTATUS_SUCCESS;
-    static  uint8_t             config = 0;
+    const phHciNfc_sSeqStep_t   *p_seq_step = NULL;
+    uint8_t                     i = 0;
 
-    PHNFC_UNUSED_VARIABLE(config);
-
-    switch(psHciContext->hci_seq)
+    do
     {
-        case ADMIN_INIT_SEQ:
+        status = NFCSTATUS_SUCCESS;
+        p_seq_step = NULL;
+        for(i = 0; (i < seq_count) && (NULL == p_seq_step); i++)
         {
-            status = phHciNfc_Admin_Initialise( psHciContext,pHwRef );
-            if(NFCSTATUS_SUCCESS == status)
+            if( p_seq_table[i].seq == psHciContext->hci_seq )
             {
-#ifdef ESTABLISH_SESSION
-                if( hciMode_Session == psHciContext->hci_mode)
+                p_seq_step = &p_seq_table[i];
+            }
+        }
+
+        if( NULL != p_seq_step )
+        {
+#ifdef NXP_HCI_SEQ_PROFILE
+            if( p_seq_step->seq != psHciContext->prof_seq )
+            {
+                uint32_t    now = phOsalNfc_GetTime();
+
+                if( psHciContext->prof_seq < HCI_END_SEQ )
                 {
-                    /* TODO: Initialise Link Management 
-                            Gate Resources */
-                    NFCSTATUS info_status = NFCSTATUS_SUCCESS;
-                    PHNFC_UNUSED_VARIABLE(info_status);
-                    info_status = phHciNfc_IDMgmt_Update_Sequence( 
-                                                psHciContext, INFO_SEQ );
+                    phHciNfc_Seq_Stats_t *p_stats =
+                            &psHciContext->seq_stats[psHciContext->prof_seq];
+                    uint32_t    elapsed = now - psHciContext->prof_start;
 
-                    if(NFCSTATUS_SUCCESS == info_status)
-                    {
-                        psHciContext->hci_seq = PL_STOP_SEQ;
-                    }
-                    else
+                    p_stats->count++;
+                    p_stats->total_time += elapsed;
+                    if( elapsed > p_stats->max_time )
                     {
-                        psHciContext->hci_seq = HCI_END_SEQ;
-                        status = PHNFCSTVAL(CID_NFC_HCI,
-                                    NFCSTATUS_INVALID_HCI_SEQUENCE);
+                        p_stats->max_time = elapsed;
                     }
                 }
-                else
-#endif
-                {
-                    psHciContext->hci_seq = LINK_MGMT_INIT_SEQ;
-                }
+                /* The last Step may release the HCI Context, it is not timed */
+                psHciContext->prof_seq = 
+                        ( HCI_INVALID_SEQ != p_seq_step->next_seq )?
+                                        p_seq_step->seq : HCI_INVALID_SEQ;
+                psHciContext->prof_start = now;
             }
-            break;
-        }
-        case LINK_MGMT_INIT_SEQ:
-        {
-            status = phHciNfc_LinkMgmt_Initialise( psHciContext,pHwRef );
-            if(NFCSTATUS_SUCCESS == status)
+#endif /* #ifdef NXP_HCI_SEQ_PROFILE */
+
+            status = p_seq_step->step( psHciContext, pHwRef );
+
+            if( HCI_INVALID_SEQ == p_seq_step->next_seq )
             {
-                psHciContext->hci_seq = IDENTITY_INIT_SEQ;
+                /* The HCI Context is no longer accessed after the last Step */
             }
-            break;
-        }
-        case IDENTITY_INIT_SEQ:
-        {
-            status = phHciNfc_IDMgmt_Initialise( psHciContext,pHwRef );
-            if(NFCSTATUS_SUCCESS == status)
+            else if( HCI_SEQ_STEP_SKIPPED == status )
             {
-                psHciContext->hci_seq = DEV_INIT_SEQ;
+                psHciContext->hci_seq = p_seq_step->next_seq;
+#ifdef NXP_HCI_SEQ_PROFILE
+                /* The Step is passed over, it is not accounted */
+                psHciContext->prof_seq = HCI_INVALID_SEQ;
+#endif /* #ifdef NXP_HCI_SEQ_PROFILE */
             }
-            break;
-        }
-        case DEV_INIT_SEQ:
-        {
-            status = phHciNfc_DevMgmt_Initialise( psHciContext,pHwRef );
-            if(NFCSTATUS_SUCCESS == status)
+            else if( p_seq_step->next_status == status )
             {
-                if (HCI_SELF_TEST != psHciContext->init_mode)
+                psHciContext->hci_seq = p_seq_step->next_seq;
+                status = NFCSTATUS_SUCCESS;
+                if( NULL != p_seq_step->transition )
                 {
-                    psHciContext->hci_seq = PL_INIT_SEQ;
+                    status = p_seq_step->transition( psHciContext, pHwRef );
                 }
-                else
+                if( NFCSTATUS_SUCCESS == status )
                 {
-#if defined( ESTABLISH_SESSION )
-                    NFCSTATUS info_status = NFCSTATUS_SUCCESS;
-                    PHNFC_UNUSED_VARIABLE(info_status);
-                    info_status = phHciNfc_IDMgmt_Update_Sequence( 
-                                                psHciContext, INFO_SEQ );
-
-                    if(NFCSTATUS_SUCCESS == info_status)
-                    {
-#if ( NXP_HAL_MEM_INFO_SIZE > 0x00U )
-                        psHciContext->hci_seq = DEV_HAL_INFO_SEQ;
-#else
-                        psHciContext->hci_seq = IDENTITY_INFO_SEQ;
-#endif /* #if ( NXP_HAL_MEM_INFO_SIZE > 0x00U ) */
-                    }
-                    else
-                    {
-                        psHciContext->hci_seq = HCI_END_SEQ;
-                        status = PHNFCSTVAL(CID_NFC_HCI,
-                                    NFCSTATUS_INVALID_HCI_SEQUENCE);
-                    }
-#elif ( NXP_HAL_MEM_INFO_SIZE > 0x00U )
-                    psHciContext->hci_seq = DEV_HAL_INFO_SEQ;
-#else
-                    psHciContext->hci_seq = HCI_END_SEQ;
-#endif /* #ifdef ESTABLISH_SESSION */
+                    status = complete_status;
                 }
-
             }
-            break;
-        }
-        case PL_INIT_SEQ:
-        {
-            status = phHciNfc_PollLoop_Initialise( psHciContext,pHwRef );
-            if(NFCSTATUS_SUCCESS == status)
+            else
             {
-                NFCSTATUS reset_status = NFCSTATUS_SUCCESS;
-                PHNFC_UNUSED_VARIABLE(reset_status);
-                reset_status = phHciNfc_ReaderMgmt_Update_Sequence(
-                                                    psHciContext, RESET_SEQ );
-                psHciContext->hci_seq = READER_MGMT_INIT_SEQ;
+                /* Step in progress or failed, nothing to be updated */
             }
-            break;
-        }
-        case READER_MGMT_INIT_SEQ:
-        {
-            status = phHciNfc_ReaderMgmt_Initialise( psHciContext,pHwRef );
-            if(NFCSTATUS_SUCCESS == status)
+
+#ifdef NXP_HCI_SEQ_PROFILE
+            if( (HCI_INVALID_SEQ != p_seq_step->next_seq)
+                && (HCI_SEQ_STEP_SKIPPED != status)
+                && (NFCSTATUS_SUCCESS != status)
+                && (NFCSTATUS_PENDING != status)
+              )
             {
-                NFCSTATUS reset_status = NFCSTATUS_SUCCESS;
-                PHNFC_UNUSED_VARIABLE(reset_status);
-                reset_status =  phHciNfc_EmuMgmt_Update_Seq( 
-                                                psHciContext, RESET_SEQ );
-                psHciContext->hci_seq = EMULATION_INIT_SEQ;
+                /* The Sequence is aborted, the Step is not accounted */
+                psHciContext->prof_seq = HCI_INVALID_SEQ;
             }
-            break;
+#endif /* #ifdef NXP_HCI_SEQ_PROFILE */
+        }
+    }while( HCI_SEQ_STEP_SKIPPED == status );
+
+    return status;
+}
+
+
+#ifdef NXP_HCI_SEQ_PROFILE
+
+NFCSTATUS
+phHciNfc_Get_Seq_Stats(
+                                phHciNfc_sContext_t     *psHciContext,
+                                phHciNfc_eSeq_t         seq,
+                                phHciNfc_Seq_Stats_t    *p_seq_stats
+                          )
+{
+    NFCSTATUS           status = NFCSTATUS_SUCCESS;
+
+    if( (NULL == psHciContext) || (NULL == p_seq_stats)
+        || (seq >= HCI_END_SEQ)
+      )
+    {
+        status = PHNFCSTVAL(CID_NFC_HCI, NFCSTATUS_INVALID_PARAMETER);
+    }
+    else
+    {
+        (void)memcpy( p_seq_stats, &psHciContext->seq_stats[seq],
+                                        sizeof(phHciNfc_Seq_Stats_t) );
+    }
+    return status;
+}
+
+#endif /* #ifdef NXP_HCI_SEQ_PROFILE */
+
+
+#ifdef ESTABLISH_SESSION
+
+static
+NFCSTATUS
+phHciNfc_Init_Admin_Transition(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    NFCSTATUS           status = NFCSTATUS_SUCCESS;
+
+    if( hciMode_Session == psHciContext->hci_mode)
+    {
+        /* TODO: Initialise Link Management 
+                Gate Resources */
+        NFCSTATUS info_status = NFCSTATUS_SUCCESS;
+        PHNFC_UNUSED_VARIABLE(info_status);
+        info_status = phHciNfc_IDMgmt_Update_Sequence( 
+                                    psHciContext, INFO_SEQ );
+
+        if(NFCSTATUS_SUCCESS == info_status)
+        {
+            psHciContext->hci_seq = PL_STOP_SEQ;
         }
-        case EMULATION_INIT_SEQ:
+        else
         {
-            status = phHciNfc_EmuMgmt_Initialise( psHciContext,pHwRef );
-            if(NFCSTATUS_SUCCESS == status)
-            {
-#if defined( ESTABLISH_SESSION )
-                psHciContext->hci_seq = ADMIN_SESSION_SEQ;
-#elif ( NXP_HAL_MEM_INFO_SIZE > 0x00U )
-                psHciContext->hci_seq = DEV_HAL_INFO_SEQ;
-#else
-                psHciContext->hci_seq = HCI_END_SEQ;
-#endif
-            }
-            break;
+            psHciContext->hci_seq = HCI_END_SEQ;
+            status = PHNFCSTVAL(CID_NFC_HCI,
+                        NFCSTATUS_INVALID_HCI_SEQUENCE);
         }
-#ifdef ESTABLISH_SESSION
-        case ADMIN_SESSION_SEQ:
+    }
+    return status;
+}
+
+#endif /* #ifdef ESTABLISH_SESSION */
+
+
+static
+NFCSTATUS
+phHciNfc_Init_Dev_Transition(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    NFCSTATUS           status = NFCSTATUS_SUCCESS;
+
+    if (HCI_SELF_TEST == psHciContext->init_mode)
+    {
+#if defined( ESTABLISH_SESSION )
+        NFCSTATUS info_status = NFCSTATUS_SUCCESS;
+        PHNFC_UNUSED_VARIABLE(info_status);
+        info_status = phHciNfc_IDMgmt_Update_Sequence( 
+                                    psHciContext, INFO_SEQ );
+
+        if(NFCSTATUS_SUCCESS == info_status)
         {
-            status = phHciNfc_Admin_Initialise( psHciContext,pHwRef );
-            if(NFCSTATUS_SUCCESS == status)
-            {
-#if ( NXP_HAL_MEM_INFO_SIZE > 0x00U )
-                psHciContext->hci_seq = DEV_HAL_INFO_SEQ;
-#else
-                psHciContext->hci_seq = IDENTITY_INFO_SEQ;
-#endif /* #if ( NXP_HAL_MEM_INFO_SIZE > 0x00U ) */
-            }
-            break;
+            psHciContext->hci_seq = HCI_SESSION_INFO_SEQ;
         }
-        case PL_STOP_SEQ:
+        else
         {
-            status = phHciNfc_ReaderMgmt_Disable_Discovery( 
-                                                psHciContext, pHwRef );
-            if(NFCSTATUS_SUCCESS == status)
-            {
-#if defined( SW_AUTO_ACTIVATION )
-                psHciContext->hci_seq = READER_SW_AUTO_SEQ;
+            psHciContext->hci_seq = HCI_END_SEQ;
+            status = PHNFCSTVAL(CID_NFC_HCI,
+                        NFCSTATUS_INVALID_HCI_SEQUENCE);
+        }
 #elif ( NXP_HAL_MEM_INFO_SIZE > 0x00U )
-                psHciContext->hci_seq = DEV_HAL_INFO_SEQ;
+        psHciContext->hci_seq = DEV_HAL_INFO_SEQ;
 #else
-                psHciContext->hci_seq = IDENTITY_INFO_SEQ;
-#endif /* #if ( NXP_HAL_MEM_INFO_SIZE > 0x00U ) */
-            }
-            break;
-        }
+        psHciContext->hci_seq = HCI_END_SEQ;
+#endif /* #ifdef ESTABLISH_SESSION */
+    }
+    return status;
+}
+
+
+static
+NFCSTATUS
+phHciNfc_Init_PollLoop_Transition(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    NFCSTATUS reset_status = NFCSTATUS_SUCCESS;
+    PHNFC_UNUSED_VARIABLE(reset_status);
+    reset_status = phHciNfc_ReaderMgmt_Update_Sequence(
+                                        psHciContext, RESET_SEQ );
+    return NFCSTATUS_SUCCESS;
+}
+
+
+static
+NFCSTATUS
+phHciNfc_Init_Reader_Transition(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    NFCSTATUS reset_status = NFCSTATUS_SUCCESS;
+    PHNFC_UNUSED_VARIABLE(reset_status);
+    reset_status =  phHciNfc_EmuMgmt_Update_Seq( 
+                                    psHciContext, RESET_SEQ );
+    return NFCSTATUS_SUCCESS;
+}
+
+
+#ifdef ESTABLISH_SESSION
+
 #ifdef SW_AUTO_ACTIVATION
-        case READER_SW_AUTO_SEQ:
-        {
-            uint8_t     activate_enable = FALSE;
-            uint8_t     rdr_enable = TRUE;
 
-            status = phHciNfc_ReaderA_Update_Info( 
-                    psHciContext, HCI_READER_A_ENABLE, 
-                                            &rdr_enable);
-            if(status == NFCSTATUS_SUCCESS)
-            {
-                status = phHciNfc_ReaderA_Auto_Activate( psHciContext,
-                                                pHwRef, activate_enable );
-                if(status == NFCSTATUS_SUCCESS)
-                {
-                    psHciContext->hci_seq = IDENTITY_INFO_SEQ;
-                }
-            }
-            break;
-        }
-#endif
-        /* fall through */
-        case IDENTITY_INFO_SEQ:
-        {
-            status = phHciNfc_IDMgmt_Info_Sequence( psHciContext,pHwRef );
-            if(NFCSTATUS_SUCCESS == status)
-            {
-                if ((HCI_SELF_TEST != psHciContext->init_mode)
-                    /* && ( TRUE == ((phHal_sHwReference_t *)pHwRef)->se_detect ) */
-                    && (HCI_CUSTOM_INIT != psHciContext->init_mode)
-                    && (HCI_NFC_DEVICE_TEST != psHciContext->init_mode))
-                {
-                    NFCSTATUS info_status = NFCSTATUS_SUCCESS;
-                    PHNFC_UNUSED_VARIABLE(info_status);
-                    info_status = phHciNfc_EmuMgmt_Update_Seq( 
-                                                psHciContext, INFO_SEQ );
+static
+NFCSTATUS
+phHciNfc_Init_SwAuto_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    NFCSTATUS   status = NFCSTATUS_SUCCESS;
+    uint8_t     activate_enable = FALSE;
+    uint8_t     rdr_enable = TRUE;
+
+    status = phHciNfc_ReaderA_Update_Info( 
+            psHciContext, HCI_READER_A_ENABLE, 
+                                    &rdr_enable);
+    if(status == NFCSTATUS_SUCCESS)
+    {
+        status = phHciNfc_ReaderA_Auto_Activate( psHciContext,
+                                        pHwRef, activate_enable );
+    }
+    return status;
+}
+
+#endif /* #ifdef SW_AUTO_ACTIVATION */
+
+
+static
+NFCSTATUS
+phHciNfc_Init_Identity_Transition(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    if ((HCI_SELF_TEST != psHciContext->init_mode)
+        /* && ( TRUE == ((phHal_sHwReference_t *)pHwRef)->se_detect ) */
+        && (HCI_CUSTOM_INIT != psHciContext->init_mode)
+        && (HCI_NFC_DEVICE_TEST != psHciContext->init_mode))
+    {
+        NFCSTATUS info_status = NFCSTATUS_SUCCESS;
+        PHNFC_UNUSED_VARIABLE(info_status);
+        info_status = phHciNfc_EmuMgmt_Update_Seq( 
+                                    psHciContext, INFO_SEQ );
+
+        psHciContext->hci_seq = (NFCSTATUS_SUCCESS == info_status)?
+                                    EMULATION_SWP_SEQ : IDENTITY_INFO_SEQ;
+    }
+    return NFCSTATUS_SUCCESS;
+}
 
-                    if(NFCSTATUS_SUCCESS == info_status)
-                    {
-                        psHciContext->hci_seq = EMULATION_SWP_SEQ;
-                    }
-                }
-                else
-                {
-                    psHciContext->hci_seq = HCI_END_SEQ;
-                }
-            }
-            break;
-        }
-        case EMULATION_SWP_SEQ:
-        {
-            status = phHciNfc_EmuMgmt_Initialise( psHciContext,pHwRef );
-            if(NFCSTATUS_SUCCESS == status)
-            {
-                psHciContext->hci_seq = HCI_END_SEQ;
-            }
-            break;
-        }
 #endif /* #ifdef ESTABLISH_SESSION */
 
+
 #if ( NXP_HAL_MEM_INFO_SIZE > 0x00U )
-        case DEV_HAL_INFO_SEQ:
+
+static
+NFCSTATUS
+phHciNfc_Init_HalInfo_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    NFCSTATUS           status = NFCSTATUS_SUCCESS;
+    static uint8_t      mem_index = 0;
+
+    status = phHciNfc_DevMgmt_Get_Info(psHciContext, pHwRef,
+                (NFC_ADDRESS_HAL_CONF + mem_index),
+                    (psHciContext->hal_mem_info + mem_index));
+    if(NFCSTATUS_PENDING == status)
+    {
+        mem_index++;
+        if (NXP_HAL_MEM_INFO_SIZE <= mem_index )
         {
-            static uint8_t      mem_index = 0;
-            status = phHciNfc_DevMgmt_Get_Info(psHciContext, pHwRef,
-                        (NFC_ADDRESS_HAL_CONF + mem_index),
-                            (psHciContext->hal_mem_info + mem_index));
-            if(NFCSTATUS_PENDING == status)
-            {
-                mem_index++;
-                if (NXP_HAL_MEM_INFO_SIZE <= mem_index )
-                {
-                    NFCSTATUS info_status = NFCSTATUS_SUCCESS;
-                    PHNFC_UNUSED_VARIABLE(info_status);
-                    info_status = phHciNfc_IDMgmt_Update_Sequence(
-                                                psHciContext, INFO_SEQ );
-                    mem_index = 0;
-                    psHciContext->hci_seq = IDENTITY_INFO_SEQ;
-                    /* psHciContext->hci_seq =
-                            (HCI_SELF_TEST != psHciContext->init_mode)?
-                                    IDENTITY_INFO_SEQ : HCI_END_SEQ; */
-                }
-            }
-            break;
+            NFCSTATUS info_status = NFCSTATUS_SUCCESS;
+            PHNFC_UNUSED_VARIABLE(info_status);
+            info_status = phHciNfc_IDMgmt_Update_Sequence(
+                                        psHciContext, INFO_SEQ );
+            mem_index = 0;
+            psHciContext->hci_seq = IDENTITY_INFO_SEQ;
+            /* psHciContext->hci_seq =
+                    (HCI_SELF_TEST != psHciContext->init_mode)?
+                            IDENTITY_INFO_SEQ : HCI_END_SEQ; */
         }
+    }
+    return status;
+}
+
 #endif /* #if ( NXP_HAL_MEM_INFO_SIZE > 0x00U ) */
-        case HCI_END_SEQ:
-        {
-            phHal_sMemInfo_t    *p_mem_info =
-                    (phHal_sMemInfo_t *) ( psHciContext->hal_mem_info );
-            if (
-                (HCI_SELF_TEST == psHciContext->init_mode )
-                || (HCI_NFC_DEVICE_TEST == psHciContext->init_mode )
-                )
-            {
-                psHciContext->hci_state.next_state
-                    = (uint8_t) hciState_Test;
-            }
-            status = phHciNfc_FSM_Complete ( psHciContext );
+
+
+static
+NFCSTATUS
+phHciNfc_Init_Complete(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    NFCSTATUS           status = NFCSTATUS_SUCCESS;
+    phHal_sMemInfo_t    *p_mem_info =
+            (phHal_sMemInfo_t *) ( psHciContext->hal_mem_info );
+
+    if (
+        (HCI_SELF_TEST == psHciContext->init_mode )
+        || (HCI_NFC_DEVICE_TEST == psHciContext->init_mode )
+        )
+    {
+        psHciContext->hci_state.next_state
+            = (uint8_t) hciState_Test;
+    }
+    status = phHciNfc_FSM_Complete ( psHciContext );
 #ifdef UICC_CONNECTIVITY_PATCH
-            phHciNfc_Uicc_Connectivity( psHciContext, pHwRef );
+    phHciNfc_Uicc_Connectivity( psHciContext, pHwRef );
 #endif /* #ifdef UICC_CONNECTIVITY_PATCH */
 
 #if ( NXP_HAL_MEM_INFO_SIZE > 0x00U )
-            if(NXP_FW_UPLOAD_SUCCESS != p_mem_info->fw_magic )
-            {
-                status = PHNFCSTVAL( CID_NFC_HCI, NFCSTATUS_FAILED );
-            }
+    if(NXP_FW_UPLOAD_SUCCESS != p_mem_info->fw_magic )
+    {
+        status = PHNFCSTVAL( CID_NFC_HCI, NFCSTATUS_FAILED );
+    }
 #endif /* #if ( NXP_HAL_MEM_INFO_SIZE > 0x00U ) */
 
-            /* Initialisation Complete Notification to the Upper Layer */
-            if(NFCSTATUS_SUCCESS == status)
-            {
-                phNfc_sCompletionInfo_t     comp_info={FALSE,0, NULL};
+    /* Initialisation Complete Notification to the Upper Layer */
+    if(NFCSTATUS_SUCCESS == status)
+    {
+        phNfc_sCompletionInfo_t     comp_info={FALSE,0, NULL};
 
-                comp_info.status = status;
-                phHciNfc_Notify(psHciContext->p_upper_notify,
-                        psHciContext->p_upper_context, pHwRef,
-                                NFC_NOTIFY_INIT_COMPLETED, &comp_info);
-                HCI_PRINT("HCI Initialisation Completed \n");
-            }
-            else
-            {
-                pphNfcIF_Notification_CB_t  p_upper_notify = psHciContext->p_upper_notify;
-                void                        *pcontext = psHciContext->p_upper_context;
-                phNfc_sCompletionInfo_t     comp_info;
+        comp_info.status = status;
+        phHciNfc_Notify(psHciContext->p_upper_notify,
+                psHciContext->p_upper_context, pHwRef,
+                        NFC_NOTIFY_INIT_COMPLETED, &comp_info);
+        HCI_PRINT("HCI Initialisation Completed \n");
+    }
+    else
+    {
+        pphNfcIF_Notification_CB_t  p_upper_notify = psHciContext->p_upper_notify;
+        void                        *pcontext = psHciContext->p_upper_context;
+        phNfc_sCompletionInfo_t     comp_info;
 
 
-                phHciNfc_Release_Lower( psHciContext, pHwRef );
-                phHciNfc_Release_Resources( &psHciContext );
-                 /* Notify the Failure to the Upper Layer */
-                comp_info.status = status;
-                phHciNfc_Notify( p_upper_notify, pcontext, pHwRef,
-                                NFC_NOTIFY_INIT_FAILED, &comp_info);
-                HCI_PRINT("HCI FSM Initialisation Error \n");
-            }
-            break;
-        }
-        default:
-            break;
+        phHciNfc_Release_Lower( psHciContext, pHwRef );
+        phHciNfc_Release_Resources( &psHciContext );
+         /* Notify the Failure to the Upper Layer */
+        comp_info.status = status;
+        phHciNfc_Notify( p_upper_notify, pcontext, pHwRef,
+                        NFC_NOTIFY_INIT_FAILED, &comp_info);
+        HCI_PRINT("HCI FSM Initialisation Error \n");
     }
-
     return status;
 }
 
 
 NFCSTATUS
-phHciNfc_Release_Sequence(
-                            phHciNfc_sContext_t     *psHciContext,
-                            void                    *pHwRef
-                         )
+phHciNfc_Initialise_Sequence(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                             )
 {
-    NFCSTATUS           status = NFCSTATUS_SUCCESS;
+    return phHciNfc_Run_Sequence( psHciContext, pHwRef,
+                    phHciNfc_Init_Seq_Table,
+                    HCI_SEQ_TABLE_SIZE(phHciNfc_Init_Seq_Table),
+                    NFCSTATUS_SUCCESS );
+}
 
-    switch(psHciContext->hci_seq)
-    {
-        case PL_STOP_SEQ:
-        {
-            status = phHciNfc_ReaderMgmt_Disable_Discovery( 
-                                                psHciContext, pHwRef );
-            if(NFCSTATUS_SUCCESS == status)
-            {
-                (void)phHciNfc_EmuMgmt_Update_Seq( 
-                                    psHciContext, REL_SEQ );
-                psHciContext->hci_seq = EMULATION_REL_SEQ;
-                status = NFCSTATUS_PENDING;
-            }
-            break;
-        }
-        case EMULATION_REL_SEQ:
-        {
-            status = phHciNfc_EmuMgmt_Release( psHciContext,pHwRef );
-            if(NFCSTATUS_SUCCESS == status)
-            {
-                (void)phHciNfc_DevMgmt_Update_Sequence( 
+
+static
+NFCSTATUS
+phHciNfc_Rel_PollLoop_Transition(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    (void)phHciNfc_EmuMgmt_Update_Seq( 
+                        psHciContext, REL_SEQ );
+    return NFCSTATUS_SUCCESS;
+}
+
+
+static
+NFCSTATUS
+phHciNfc_Rel_Emulation_Transition(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    (void)phHciNfc_DevMgmt_Update_Sequence( 
+                        psHciContext, REL_SEQ );
+    return NFCSTATUS_SUCCESS;
+}
+
+
+static
+NFCSTATUS
+phHciNfc_Rel_Dev_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    NFCSTATUS info_status = NFCSTATUS_SUCCESS;
+    PHNFC_UNUSED_VARIABLE(info_status);
+    info_status = phHciNfc_DevMgmt_Update_Sequence(
                                     psHciContext, REL_SEQ );
-                psHciContext->hci_seq = ADMIN_REL_SEQ;
-                status = NFCSTATUS_PENDING;
-            }
-            break;
-        }
-        case DEV_REL_SEQ:
-        {
-            NFCSTATUS info_status = NFCSTATUS_SUCCESS;
-            PHNFC_UNUSED_VARIABLE(info_status);
-            info_status = phHciNfc_DevMgmt_Update_Sequence(
-                                            psHciContext, REL_SEQ );
-            status = phHciNfc_DevMgmt_Release( psHciContext, pHwRef );
-            if(NFCSTATUS_SUCCESS == status)
-            {
-                psHciContext->hci_seq = HCI_END_SEQ;
-                status = NFCSTATUS_PENDING;
-            }
-            break;
-        }
-        case READER_MGMT_REL_SEQ:
-        {
-            status = phHciNfc_ReaderMgmt_Release( psHciContext,pHwRef );
-            if(NFCSTATUS_SUCCESS == status)
-            {
-                psHciContext->hci_seq = PL_REL_SEQ;
-                status = NFCSTATUS_PENDING;
-            }
-            break;
-        }
-        case PL_REL_SEQ:
-        {
-            status = phHciNfc_PollLoop_Release( psHciContext,pHwRef );
-            if(NFCSTATUS_SUCCESS == status)
-            {
-                psHciContext->hci_seq = IDENTITY_REL_SEQ;
-                status = NFCSTATUS_PENDING;
-            }
-            break;
-        }
-        case IDENTITY_REL_SEQ:
-        {
-            status = phHciNfc_IDMgmt_Release( psHciContext,pHwRef );
-            if(NFCSTATUS_SUCCESS == status)
-            {
-                psHciContext->hci_seq = LINK_MGMT_REL_SEQ;
-                status = NFCSTATUS_PENDING;
-            }
-            break;
-        }
-        case LINK_MGMT_REL_SEQ:
-        {
-            status = phHciNfc_LinkMgmt_Release( psHciContext,pHwRef );
-            if(NFCSTATUS_SUCCESS == status)
-            {
-                psHciContext->hci_seq = ADMIN_REL_SEQ;
-                status = NFCSTATUS_PENDING;
-            }
-            break;
-        }
-        case ADMIN_REL_SEQ:
-        {
-            /*  Admin Management Release Sequence */
-            status = phHciNfc_Admin_Release( psHciContext,pHwRef, phHciNfc_TerminalHostID );
-            if(NFCSTATUS_SUCCESS == status)
-            {
-                psHciContext->hci_seq = DEV_REL_SEQ;
-                status = NFCSTATUS_PENDING;
-            }
-            break;
-        }
-        case HCI_END_SEQ:
-        {
-            pphNfcIF_Notification_CB_t  p_upper_notify = 
-                                            psHciContext->p_upper_notify;
-            phNfc_sLowerIF_t            *plower_if = 
-                                            &(psHciContext->lower_interface);
-            void                        *pcontext = 
-                                                psHciContext->p_upper_context;
-            phNfc_sCompletionInfo_t     comp_info;
+    return phHciNfc_DevMgmt_Release( psHciContext, pHwRef );
+}
+
+
+static
+NFCSTATUS
+phHciNfc_Rel_Admin_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    /*  Admin Management Release Sequence */
+    return phHciNfc_Admin_Release( psHciContext,pHwRef, phHciNfc_TerminalHostID );
+}
 
 
-            status = plower_if->release((void *)plower_if->pcontext,
-                                            (void *)pHwRef);
+static
+NFCSTATUS
+phHciNfc_Rel_Complete(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    NFCSTATUS                   status = NFCSTATUS_SUCCESS;
+    pphNfcIF_Notification_CB_t  p_upper_notify = 
+                                    psHciContext->p_upper_notify;
+    phNfc_sLowerIF_t            *plower_if = 
+                                    &(psHciContext->lower_interface);
+    void                        *pcontext = 
+                                        psHciContext->p_upper_context;
+    phNfc_sCompletionInfo_t     comp_info;
+
 
-            phHciNfc_Release_Resources( &psHciContext );
-            /* De-Initialisation Complete Notification to the Upper Layer */
-            comp_info.status = status;
-            phHciNfc_Notify(p_upper_notify, pcontext, pHwRef,
-                                    NFC_NOTIFY_DEINIT_COMPLETED, &comp_info);
+    status = plower_if->release((void *)plower_if->pcontext,
+                                    (void *)pHwRef);
 
-            HCI_PRINT("HCI Release Completed \n");
-            break;
-        }
-        default:
-        {
-            /* psHciContext->hci_seq = HCI_END_SEQ; */
-            break;
-        }
-    }
+    phHciNfc_Release_Resources( &psHciContext );
+    /* De-Initialisation Complete Notification to the Upper Layer */
+    comp_info.status = status;
+    phHciNfc_Notify(p_upper_notify, pcontext, pHwRef,
+                            NFC_NOTIFY_DEINIT_COMPLETED, &comp_info);
 
+    HCI_PRINT("HCI Release Completed \n");
     return status;
 }
 
 
+NFCSTATUS
+phHciNfc_Release_Sequence(
+                            phHciNfc_sContext_t     *psHciContext,
+                            void                    *pHwRef
+                         )
+{
+    return phHciNfc_Run_Sequence( psHciContext, pHwRef,
+                    phHciNfc_Release_Seq_Table,
+                    HCI_SEQ_TABLE_SIZE(phHciNfc_Release_Seq_Table),
+                    NFCSTATUS_PENDING );
+}
+
+
 static
 NFCSTATUS
 phHciNfc_Config_Sequence(
@@ -1528,37 +2124,10 @@ phHciNfc_Config_Sequence(
 #ifdef ENABLE_P2P
         case NFC_GENERAL_CFG:
         {
-            if(TARGET_GENERAL_SEQ == psHciContext->hci_seq)
-            {
-                status = phHciNfc_NfcIP_SetATRInfo( psHciContext,
-                                        pHwRef, NFCIP_TARGET, 
-                                        psHciContext->p_config_params);
-                    if( NFCSTATUS_PENDING != status )
-                    {
-                        /* Roll Back the State Machine to its Original State */
-                        phHciNfc_FSM_Rollback ( psHciContext );
-                    }
-                    else
-                    {
-                        psHciContext->hci_seq = HCI_END_SEQ;
-                    }
-            }
-            else
-            {
-                status = phHciNfc_Pending_Sequence(psHciContext, pHwRef );
-                if (NFCSTATUS_PENDING != status)
-                {
-                    /* Roll Back to its Current State as Configuration is Complete */
-                    phHciNfc_FSM_Rollback(psHciContext); 
-
-                    HCI_PRINT(" NFC-IP(P2P) Configuration Completed. \n");
-                    comp_info.status = status;
-                    psHciContext->error_status = NFCSTATUS_SUCCESS;
-                    phHciNfc_Notify(psHciContext->p_upper_notify,
-                                    psHciContext->p_upper_context, pHwRef,
-                                        NFC_NOTIFY_CONFIG_SUCCESS , &comp_info);
-                }
-            }
+            status = phHciNfc_Run_Sequence( psHciContext, pHwRef,
+                            phHciNfc_P2P_Cfg_Seq_Table,
+                            HCI_SEQ_TABLE_SIZE(phHciNfc_P2P_Cfg_Seq_Table),
+                            NFCSTATUS_PENDING );
             break;
         }
 #endif
@@ -1618,221 +2187,424 @@ phHciNfc_Config_Sequence(
             break;
         }
     }
-    
+    
+    return status;
+}
+
+
+#ifdef ENABLE_P2P
+
+static
+NFCSTATUS
+phHciNfc_Cfg_ATRInfo_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    NFCSTATUS           status = NFCSTATUS_SUCCESS;
+
+    status = phHciNfc_NfcIP_SetATRInfo( psHciContext,
+                            pHwRef, NFCIP_TARGET, 
+                            psHciContext->p_config_params);
+    if( NFCSTATUS_PENDING != status )
+    {
+        /* Roll Back the State Machine to its Original State */
+        phHciNfc_FSM_Rollback ( psHciContext );
+    }
+    return status;
+}
+
+
+static
+NFCSTATUS
+phHciNfc_Cfg_P2P_Complete(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    NFCSTATUS                   status = NFCSTATUS_SUCCESS;
+    phNfc_sCompletionInfo_t     comp_info = {FALSE,0,NULL};
+
+    status = phHciNfc_Pending_Sequence(psHciContext, pHwRef );
+    if (NFCSTATUS_PENDING != status)
+    {
+        /* Roll Back to its Current State as Configuration is Complete */
+        phHciNfc_FSM_Rollback(psHciContext); 
+
+        HCI_PRINT(" NFC-IP(P2P) Configuration Completed. \n");
+        comp_info.status = status;
+        psHciContext->error_status = NFCSTATUS_SUCCESS;
+        phHciNfc_Notify(psHciContext->p_upper_notify,
+                        psHciContext->p_upper_context, pHwRef,
+                            NFC_NOTIFY_CONFIG_SUCCESS , &comp_info);
+    }
+    return status;
+}
+
+#endif /* #ifdef ENABLE_P2P */
+
+
+static
+NFCSTATUS
+phHciNfc_Poll_Duration_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    return phHciNfc_PollLoop_Cfg( psHciContext, pHwRef,
+                        (uint8_t)PL_DURATION , NULL);
+}
+
+
+#if defined (ENABLE_P2P) && defined (TARGET_SPEED)
+
+static
+NFCSTATUS
+phHciNfc_Poll_TargetSpeed_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    phHal_sADD_Cfg_t    *p_poll_config = (phHal_sADD_Cfg_t * )
+                                        psHciContext->p_config_params;
+    uint8_t             mode = p_poll_config->NfcIP_Target_Mode;
+
+    HCI_DEBUG("Setting target mode to 0x%02X", mode);
+    return phHciNfc_NfcIP_SetMode( psHciContext, pHwRef, NFCIP_TARGET,
+                                                    (uint8_t) mode );
+}
+
+#endif /* #if defined (ENABLE_P2P) && defined (TARGET_SPEED) */
+
+
+#if defined (ENABLE_P2P) && defined (INITIATOR_SPEED)
+
+static
+NFCSTATUS
+phHciNfc_Poll_InitiatorSpeed_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    phHal_sADD_Cfg_t    *p_poll_config = (phHal_sADD_Cfg_t * )
+                                        psHciContext->p_config_params;
+    uint8_t             speed = p_poll_config->NfcIP_Mode;
+
+    HCI_DEBUG("Setting initiator mode to 0x%02X", speed);
+    return phHciNfc_NfcIP_SetMode( psHciContext, pHwRef, NFCIP_INITIATOR,
+                (uint8_t) (speed & DEFAULT_NFCIP_INITIATOR_MODE_SUPPORT));
+}
+
+#endif /* #if defined (ENABLE_P2P) && defined (INITIATOR_SPEED) */
+
+
+#if defined (ENABLE_P2P) && defined (NFCIP_TGT_DISABLE_CFG)
+
+static
+NFCSTATUS
+phHciNfc_Poll_TgtDisable_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    phHal_sADD_Cfg_t    *p_poll_config = (phHal_sADD_Cfg_t * )
+                                        psHciContext->p_config_params;
+
+    /* Configure the Polling Loop Target Disable Parameter */
+    return phHciNfc_PollLoop_Cfg( psHciContext, pHwRef,
+            (uint8_t)PL_DISABLE_TARGET, &p_poll_config->NfcIP_Tgt_Disable );
+}
+
+#endif /* #if defined (ENABLE_P2P) && defined (NFCIP_TGT_DISABLE_CFG) */
+
+
+static
+NFCSTATUS
+phHciNfc_Poll_RdPhases_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    /* Configure the Polling Loop Gate Parameters */
+    return phHciNfc_PollLoop_Cfg( psHciContext, pHwRef,
+                        (uint8_t)PL_RD_PHASES, NULL );
+}
+
+
+static
+NFCSTATUS
+phHciNfc_Poll_Phases_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    phHal_sADD_Cfg_t        *p_poll_config = (phHal_sADD_Cfg_t * )
+                                        psHciContext->p_config_params;
+    phHal_sPollDevInfo_t    *p_poll_info = 
+                                &(p_poll_config->PollDevInfo.PollCfgInfo);
+    uint8_t                 speed = p_poll_config->NfcIP_Mode;
+
+    p_poll_info->EnableIso14443A = 
+        ( (p_poll_info->EnableIso14443A)
+                        || ( speed & (uint8_t)phHal_ePassive106 ) 
+                        );
+    p_poll_info->EnableFelica212 = 
+                ( (p_poll_info->EnableFelica212)
+                        || ( speed & (uint8_t)phHal_ePassive212 ) 
+                        );
+    p_poll_info->EnableFelica424 = 
+                ( (p_poll_info->EnableFelica424)
+                        || ( speed & (uint8_t)phHal_ePassive424 ) 
+                        );
+    return phHciNfc_Poll_RdPhases_Step( psHciContext, pHwRef );
+}
+
+
+static
+NFCSTATUS
+phHciNfc_Poll_Phases_Transition(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    phHal_sADD_Cfg_t    *p_poll_config = (phHal_sADD_Cfg_t * )
+                                        psHciContext->p_config_params;
+
+    if(((~(PL_RD_PHASES_DISABLE)) & 
+            p_poll_config->PollDevInfo.PollEnabled) == 0)
+    {
+        /* psHciContext->hci_seq = READER_DISABLE_SEQ; */
+        psHciContext->hci_seq = HCI_END_SEQ;
+    }
+    return NFCSTATUS_SUCCESS;
+}
+
+
+static
+NFCSTATUS
+phHciNfc_Poll_Disable_Transition(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    phHal_sADD_Cfg_t    *p_poll_config = (phHal_sADD_Cfg_t * )
+                                        psHciContext->p_config_params;
+
+    if(((~(PL_RD_PHASES_DISABLE)) & 
+            p_poll_config->PollDevInfo.PollEnabled) == 0)
+    {
+        psHciContext->hci_seq = HCI_PL_INITIATOR_NEXT_SEQ;
+    }
+    return NFCSTATUS_SUCCESS;
+}
+
+
+static
+void
+phHciNfc_Poll_Notify(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef,
+                                NFCSTATUS               status
+                          )
+{
+    phHal_sADD_Cfg_t            *p_poll_config = (phHal_sADD_Cfg_t * )
+                                        psHciContext->p_config_params;
+    phNfc_sCompletionInfo_t     comp_info = {FALSE,0,NULL};
+
+    /* Poll Configuration Notification to the Upper Layer */
+    comp_info.status = status;
+    if((~(PL_RD_PHASES_DISABLE) & 
+            p_poll_config->PollDevInfo.PollEnabled)!= 0)
+    {
+        phHciNfc_Notify(psHciContext->p_upper_notify,
+            psHciContext->p_upper_context, pHwRef,
+            NFC_NOTIFY_POLL_ENABLED, &comp_info);
+    } 
+    else
+    {
+        phHciNfc_Notify(psHciContext->p_upper_notify,
+            psHciContext->p_upper_context, pHwRef,
+            NFC_NOTIFY_POLL_DISABLED, &comp_info);
+    }
+    HCI_PRINT("HCI Discovery Configuration Completed \n");
+}
+
+
+static
+NFCSTATUS
+phHciNfc_Poll_Complete(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    NFCSTATUS           status = NFCSTATUS_SUCCESS;
+
+    status = phHciNfc_Pending_Sequence(psHciContext, pHwRef );
+    if (NFCSTATUS_PENDING != status)
+    {
+        /* status = phHciNfc_FSM_Complete ( psHciContext );*/
+        phHciNfc_FSM_Rollback ( psHciContext );
+        phHciNfc_Poll_Notify( psHciContext, pHwRef, status );
+    }
+    return status;
+}
+
+
+NFCSTATUS
+phHciNfc_PollLoop_Sequence(
+                           phHciNfc_sContext_t      *psHciContext,
+                           void                 *pHwRef
+                           )
+{
+    NFCSTATUS           status = NFCSTATUS_SUCCESS;
+
+    if (NULL != psHciContext->p_config_params)
+    {
+        status = phHciNfc_Run_Sequence( psHciContext, pHwRef,
+                        phHciNfc_PollLoop_Seq_Table,
+                        HCI_SEQ_TABLE_SIZE(phHciNfc_PollLoop_Seq_Table),
+                        NFCSTATUS_PENDING );
+    }/* End of the Poll Config info Check */
+
+    return status;
+}
+
+
+#if defined(HOST_EMULATION)
+
+static
+NFCSTATUS
+phHciNfc_EmuCfg_Admin_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    NFCSTATUS               status = NFCSTATUS_SUCCESS;
+    phHciNfc_GateID_t       ce_gate = phHciNfc_UnknownGate;
+    phHal_sEmulationCfg_t   *p_emulation_cfg = (phHal_sEmulationCfg_t * )
+                                        psHciContext->p_config_params;
+
+    if((NFC_HOST_CE_A_EMULATION == p_emulation_cfg->emuType)
+        && (NULL == psHciContext->p_ce_a_info))
+    {
+        ce_gate = phHciNfc_CETypeAGate;
+    }
+    else if((NFC_HOST_CE_B_EMULATION == p_emulation_cfg->emuType)
+        && (NULL == psHciContext->p_ce_b_info))
+    {
+        ce_gate = phHciNfc_CETypeBGate;
+    }
+    else
+    {
+        ;
+    }
+
+    if(phHciNfc_UnknownGate != ce_gate)
+    {
+        status = phHciNfc_Admin_CE_Init(psHciContext, pHwRef, ce_gate);
+    }
+    else
+    {
+        status = PHNFCSTVAL(CID_NFC_HCI, NFCSTATUS_NOT_ALLOWED);
+    }
     return status;
 }
 
+#endif  /* #ifdef HOST_EMULATION */
+
 
+static
 NFCSTATUS
-phHciNfc_PollLoop_Sequence(
-                           phHciNfc_sContext_t      *psHciContext,
-                           void                 *pHwRef
-                           )
+phHciNfc_EmuCfg_Config_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
 {
-    NFCSTATUS           status = NFCSTATUS_SUCCESS;
-    phHal_sADD_Cfg_t    *p_poll_config = (phHal_sADD_Cfg_t * )
-        psHciContext->p_config_params;
-    if (NULL != p_poll_config)
-    {
-        uint8_t speed = 
-                p_poll_config->NfcIP_Mode;
-        uint8_t targetSpeed =
-                p_poll_config->NfcIP_Target_Mode;
-        switch(psHciContext->hci_seq)
-        {
-            case PL_DURATION_SEQ:
-            {
-                status = phHciNfc_PollLoop_Cfg( psHciContext, pHwRef,
-                    (uint8_t)PL_DURATION , NULL);
-                if(NFCSTATUS_SUCCESS == status)
-                {
-#if defined (ENABLE_P2P) && defined (TARGET_SPEED)
-                    psHciContext->hci_seq = TARGET_SPEED_SEQ;
-#elif defined (ENABLE_P2P) && defined (INITIATOR_SPEED)
-                    psHciContext->hci_seq = INITIATOR_SPEED_SEQ;
-#elif defined (ENABLE_P2P) &&  defined (NFCIP_TGT_DISABLE_CFG)
-                    psHciContext->hci_seq = PL_TGT_DISABLE_SEQ;
-#else
-                    psHciContext->hci_seq = PL_CONFIG_PHASE_SEQ;  
-#endif
+    return phHciNfc_Emulation_Cfg(psHciContext, pHwRef, 
+                                    psHciContext->config_type);
+}
 
-                    status = NFCSTATUS_PENDING;
-                }
-                break;
-            }
-#if defined (ENABLE_P2P) && defined (TARGET_SPEED)
-            case TARGET_SPEED_SEQ:
-            {
-#define NFCIP_ACTIVE_SHIFT	0x03U
-#define NFCIP_PASSIVE_MASK	0x07U
-                uint8_t mode = targetSpeed;
-                HCI_DEBUG("Setting target mode to 0x%02X", mode);
-                status = 
-                    phHciNfc_NfcIP_SetMode( psHciContext, pHwRef, NFCIP_TARGET,
-                     (uint8_t) mode );
-                if(NFCSTATUS_PENDING == status)
-                {
-#if defined (INITIATOR_SPEED)
-                    psHciContext->hci_seq = INITIATOR_SPEED_SEQ;
-#elif defined (NFCIP_TGT_DISABLE_CFG)
-                    psHciContext->hci_seq = PL_TGT_DISABLE_SEQ;
-#else
-                    psHciContext->hci_seq = PL_CONFIG_PHASE_SEQ;  
-#endif
-                    status = NFCSTATUS_PENDING;
-                }
-                break;
-            }
-#endif
-#if defined (ENABLE_P2P) && defined (INITIATOR_SPEED)
-            case INITIATOR_SPEED_SEQ:
-            {
-                HCI_DEBUG("Setting initiator mode to 0x%02X", speed);
-                status = 
-                    phHciNfc_NfcIP_SetMode( psHciContext, pHwRef, NFCIP_INITIATOR,
-                     (uint8_t) (speed & DEFAULT_NFCIP_INITIATOR_MODE_SUPPORT));
-                if(NFCSTATUS_PENDING == status)
-                {
-#if defined (NFCIP_TGT_DISABLE_CFG)
-                    psHciContext->hci_seq = PL_TGT_DISABLE_SEQ;
-#else
-                    psHciContext->hci_seq = PL_CONFIG_PHASE_SEQ;  
-#endif
-                    status = NFCSTATUS_PENDING;
-                }
-                break;
-            }
-#endif
-#if defined (ENABLE_P2P) && defined (NFCIP_TGT_DISABLE_CFG)
-            case PL_TGT_DISABLE_SEQ:
-            {
-                /* Configure the Polling Loop Target Disable Parameter */
-                status = phHciNfc_PollLoop_Cfg( psHciContext, pHwRef,
-                (uint8_t)PL_DISABLE_TARGET, &p_poll_config->NfcIP_Tgt_Disable );
-                if(NFCSTATUS_SUCCESS == status)
-                {
-                    psHciContext->hci_seq = PL_CONFIG_PHASE_SEQ;  
-                    status = NFCSTATUS_PENDING;
-                }
-                break;
-            }
-#endif
-            case PL_CONFIG_PHASE_SEQ:
-            {
-                phHal_sPollDevInfo_t *p_poll_info = 
-                                &(p_poll_config->PollDevInfo.PollCfgInfo);
 
-                p_poll_info->EnableIso14443A = 
-                    ( (p_poll_info->EnableIso14443A)
-                                    || ( speed & (uint8_t)phHal_ePassive106 ) 
-                                    );
-                p_poll_info->EnableFelica212 = 
-                            ( (p_poll_info->EnableFelica212)
-                                    || ( speed & (uint8_t)phHal_ePassive212 ) 
-                                    );
-                p_poll_info->EnableFelica424 = 
-                            ( (p_poll_info->EnableFelica424)
-                                    || ( speed & (uint8_t)phHal_ePassive424 ) 
-                                    );
-                /* Configure the Polling Loop Gate Parameters */
-                status = phHciNfc_PollLoop_Cfg( psHciContext, pHwRef,
-                    (uint8_t)PL_RD_PHASES, NULL );
-                if(NFCSTATUS_SUCCESS == status)
-                {
-                    if(((~(PL_RD_PHASES_DISABLE)) & 
-                            p_poll_config->PollDevInfo.PollEnabled)!= 0)
-                    {
-                        psHciContext->hci_seq = READER_ENABLE_SEQ;
-                    }
-                    else
-                    {
-                        /* psHciContext->hci_seq = READER_DISABLE_SEQ; */
-                        psHciContext->hci_seq = HCI_END_SEQ;
-                    }
-                    status = NFCSTATUS_PENDING;
-                }
-                break;
-            }
-            case READER_ENABLE_SEQ:
-            {
-                status = 
-                    phHciNfc_ReaderMgmt_Enable_Discovery( 
-                    psHciContext, pHwRef );
-                if(NFCSTATUS_SUCCESS == status)
-                {
-                    /* psHciContext->hci_seq = PL_CONFIG_PHASE_SEQ; */
-                    psHciContext->hci_seq = HCI_END_SEQ;  
-                    status = NFCSTATUS_PENDING;
-                }
-                break;
-            }
-            case READER_DISABLE_SEQ:
-            {
-                status = phHciNfc_ReaderMgmt_Disable_Discovery( 
-                    psHciContext, pHwRef );
+#ifdef UICC_SESSION_RESET
+
+static
+NFCSTATUS
+phHciNfc_EmuCfg_Config_Transition(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    if(UICC_SWP_CFG == psHciContext->config_type)
+    {
+        psHciContext->hci_seq = ADMIN_REL_SEQ;
+    }
+    return NFCSTATUS_SUCCESS;
+}
 
-                if(NFCSTATUS_SUCCESS == status)
-                {
-                    if((~(PL_RD_PHASES_DISABLE) & 
-                            p_poll_config->PollDevInfo.PollEnabled)!= 0)
-                    {
-                        psHciContext->hci_seq = PL_DURATION_SEQ;
-                    }
-                    else
-                    {
-#if defined (ENABLE_P2P) && defined (INITIATOR_SPEED)
-                        psHciContext->hci_seq = INITIATOR_SPEED_SEQ;
-#elif defined (ENABLE_P2P) &&  defined (NFCIP_TGT_DISABLE_CFG)
-                        psHciContext->hci_seq = PL_TGT_DISABLE_SEQ;
-#else
-                        psHciContext->hci_seq = PL_CONFIG_PHASE_SEQ;  
-#endif
-                        /* psHciContext->hci_seq = HCI_END_SEQ; */
-                    }
-                    status = NFCSTATUS_PENDING;
-                }
-                break;
-            }
-            case HCI_END_SEQ:
-            {
-                phNfc_sCompletionInfo_t     comp_info;
-                status = phHciNfc_Pending_Sequence(psHciContext, pHwRef );
-                if (NFCSTATUS_PENDING != status)
-                {
-                    /* status = phHciNfc_FSM_Complete ( psHciContext );*/
-                    phHciNfc_FSM_Rollback ( psHciContext );
-                    /* Poll Configuration Notification to the Upper Layer */
-                    if((~(PL_RD_PHASES_DISABLE) & 
-                            p_poll_config->PollDevInfo.PollEnabled)!= 0)
-                    {
-                        comp_info.status = status;
-                        phHciNfc_Notify(psHciContext->p_upper_notify,
-                            psHciContext->p_upper_context, pHwRef,
-                            NFC_NOTIFY_POLL_ENABLED, &comp_info);
-                    } 
-                    else
-                    {
-                        comp_info.status = status;
-                        phHciNfc_Notify(psHciContext->p_upper_notify,
-                            psHciContext->p_upper_context, pHwRef,
-                            NFC_NOTIFY_POLL_DISABLED, &comp_info);
-                    }
-                    HCI_PRINT("HCI Discovery Configuration Completed \n");
-                }
-                break;
-            }
-            default:
-            {
-                /* psHciContext->hci_seq = HCI_END_SEQ; */
-                break;
-            }
-        }/* End of the Poll Sequence Switch */
-    }/* End of the Poll Config info Check */
 
+static
+NFCSTATUS
+phHciNfc_EmuCfg_Release_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    NFCSTATUS               status = HCI_SEQ_STEP_SKIPPED;
+#if defined(HOST_EMULATION)
+    phHal_sEmulationCfg_t   *p_emulation_cfg = (phHal_sEmulationCfg_t * )
+                                        psHciContext->p_config_params;
+
+    if ((NFC_UICC_EMULATION == p_emulation_cfg->emuType)
+        &&(FALSE == p_emulation_cfg->config.uiccEmuCfg.enableUicc)
+        )
+    {
+        /*  Admin Management UICC Release Sequence */
+        status = phHciNfc_Admin_Release( psHciContext,pHwRef, phHciNfc_UICCHostID );
+    }
+#endif  /* #ifdef HOST_EMULATION */
     return status;
 }
 
 
+static
+NFCSTATUS
+phHciNfc_EmuCfg_Release_Transition(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    if (UICC_SWP_CFG == psHciContext->config_type)
+    {
+        (void)phHciNfc_SWP_Update_Sequence(psHciContext, 
+                                                    CONFIG_SEQ );
+    }
+    return NFCSTATUS_SUCCESS;
+}
+
+#endif /* UICC_SESSION_RESET */
+
+
+static
+NFCSTATUS
+phHciNfc_EmuCfg_Complete(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    static phNfc_sCompletionInfo_t      comp_info = {FALSE,0,NULL};
+
+    phHciNfc_FSM_Rollback(psHciContext); 
+
+    HCI_PRINT(" Emulation Configuration Completed. \n");
+
+    comp_info.status = NFCSTATUS_SUCCESS;
+    phHciNfc_Notify(psHciContext->p_upper_notify,
+                     psHciContext->p_upper_context, pHwRef,
+                       NFC_NOTIFY_CONFIG_SUCCESS, &comp_info);
+    return NFCSTATUS_SUCCESS;
+}
+
+
 NFCSTATUS
 phHciNfc_EmulationCfg_Sequence(
                             phHciNfc_sContext_t     *psHciContext,
@@ -1840,16 +2612,8 @@ phHciNfc_EmulationCfg_Sequence(
                          )
 {
     NFCSTATUS               status = NFCSTATUS_SUCCESS;
-    static phNfc_sCompletionInfo_t      comp_info = {FALSE,0,NULL};
-#if defined(HOST_EMULATION)
-    phHciNfc_GateID_t       ce_gate = phHciNfc_UnknownGate;
-#endif  /* #ifdef HOST_EMULATION */
     phHal_sEmulationCfg_t   *p_emulation_cfg = (phHal_sEmulationCfg_t * )
                                         psHciContext->p_config_params;
-#ifdef UICC_SESSION_RESET
-    uint8_t                 uicc_clear_pipes = FALSE;
-#endif
-
 
     if (NULL != p_emulation_cfg)
     {
@@ -1857,231 +2621,189 @@ phHciNfc_EmulationCfg_Sequence(
         if(NFC_HOST_CE_A_EMULATION == p_emulation_cfg->emuType)
         {
             psHciContext->config_type = NFC_CE_A_CFG;
-            if (NULL == psHciContext->p_ce_a_info)
-            {
-                ce_gate = phHciNfc_CETypeAGate;
-            }
         }
         else if (NFC_HOST_CE_B_EMULATION == p_emulation_cfg->emuType)
         {
             psHciContext->config_type = NFC_CE_B_CFG;
-            if (NULL == psHciContext->p_ce_b_info)
-            {
-                ce_gate = phHciNfc_CETypeBGate;
-            }
-        }
-#ifdef UICC_SESSION_RESET
-        else if ((NFC_UICC_EMULATION == p_emulation_cfg->emuType)
-            &&(FALSE == p_emulation_cfg->config.uiccEmuCfg.enableUicc)
-            )
-        {
-            uicc_clear_pipes = TRUE;
         }
-#endif
         else
         {
             ;
         }
 #endif  /* #ifdef HOST_EMULATION */
 
-        switch(psHciContext->hci_seq)
+        status = phHciNfc_Run_Sequence( psHciContext, pHwRef,
+                        phHciNfc_EmuCfg_Seq_Table,
+                        HCI_SEQ_TABLE_SIZE(phHciNfc_EmuCfg_Seq_Table),
+                        NFCSTATUS_PENDING );
+    }/* End of the Emulation Config info Check */
+    
+    return status;
+}
+
+
+static
+NFCSTATUS
+phHciNfc_Smx_Mode_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    return phHciNfc_WI_Configure_Mode( 
+                    psHciContext, pHwRef,psHciContext->smx_mode );
+}
+
+
+static
+NFCSTATUS
+phHciNfc_Smx_Complete(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    NFCSTATUS           status = NFCSTATUS_SUCCESS;
+
+    status = phHciNfc_Pending_Sequence(psHciContext, pHwRef );
+    if (NFCSTATUS_PENDING != status)
+    {
+        /* status = phHciNfc_FSM_Complete ( psHciContext );*/
+        phHciNfc_FSM_Rollback ( psHciContext );
+        if( hciState_Disconnect == psHciContext->hci_state.cur_state)
         {
-#if defined(HOST_EMULATION)
-            case ADMIN_CE_SEQ:
-            {
-                if(phHciNfc_UnknownGate != ce_gate)
-                {
-                    status = phHciNfc_Admin_CE_Init(psHciContext, pHwRef, ce_gate);
-                }
-                else
-                {
-                    status = PHNFCSTVAL(CID_NFC_HCI, NFCSTATUS_NOT_ALLOWED);
-                }
+            psHciContext->host_rf_type = phHal_eUnknown_DevType;
+            psHciContext->p_target_info = NULL;
+            psHciContext->p_xchg_info = NULL;
+        }
+        phHciNfc_Poll_Notify( psHciContext, pHwRef, status );
+    }
+    return status;
+}
+
+
+NFCSTATUS
+phHciNfc_SmartMx_Mode_Sequence(
+                           phHciNfc_sContext_t      *psHciContext,
+                           void                     *pHwRef
+                          )
+{
+    NFCSTATUS           status = NFCSTATUS_SUCCESS;
+
+    if (NULL != psHciContext->p_config_params)
+    {
+        status = phHciNfc_Run_Sequence( psHciContext, pHwRef,
+                        phHciNfc_SmxMode_Seq_Table,
+                        HCI_SEQ_TABLE_SIZE(phHciNfc_SmxMode_Seq_Table),
+                        NFCSTATUS_PENDING );
+    }/* End of the Poll Config info Check */
+
+    return status;
+}
 
-                if(NFCSTATUS_SUCCESS == status)
-                {
-                    psHciContext->hci_seq = EMULATION_CONFIG_SEQ;
-                    /* psHciContext->hci_seq = HCI_END_SEQ; */
-                    status = NFCSTATUS_PENDING;
-                }
-                break;
-            }
-#endif
-            case EMULATION_CONFIG_SEQ:
-            {
-                status = phHciNfc_Emulation_Cfg(psHciContext, pHwRef, 
-                                                psHciContext->config_type);
-                if(NFCSTATUS_SUCCESS == status)
-                {
-                    /* psHciContext->hci_seq = PL_CONFIG_PHASE_SEQ; */
-#ifdef UICC_SESSION_RESET
-                    if(UICC_SWP_CFG == psHciContext->config_type)
-                    {
-                        psHciContext->hci_seq = ADMIN_REL_SEQ;
-                    }
-                    else
-#endif /* UICC_SESSION_RESET */
-                    {
-                        psHciContext->hci_seq = HCI_END_SEQ;
-                    }
-                    status = NFCSTATUS_PENDING;
-                }
-                break;
-            }
-#ifdef UICC_SESSION_RESET
-            case ADMIN_REL_SEQ:
-            {
-                if (TRUE == uicc_clear_pipes)
-                {
-                    /*  Admin Management UICC Release Sequence */
-                    status = phHciNfc_Admin_Release( psHciContext,pHwRef, phHciNfc_UICCHostID );
-                    if(NFCSTATUS_SUCCESS == status)
-                    {
-                        psHciContext->hci_seq = HCI_END_SEQ;
-                        if (UICC_SWP_CFG == psHciContext->config_type)
-                        {
-                            (void)phHciNfc_SWP_Update_Sequence(psHciContext, 
-                                                                        CONFIG_SEQ );
-                        }
-                        status = NFCSTATUS_PENDING;
-                    }
-                    break;
-                }
-            }
-#endif /* UICC_SESSION_RESET */
-            /* fall through */
-            case HCI_END_SEQ:
-            {
-                phHciNfc_FSM_Rollback(psHciContext); 
 
-                HCI_PRINT(" Emulation Configuration Completed. \n");
+static
+NFCSTATUS
+phHciNfc_Connect_Select_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    NFCSTATUS               status = HCI_SEQ_STEP_SKIPPED;
+    phHal_eRemDevType_t     target_type = 
+                                psHciContext->p_target_info->RemDevType;
 
-                comp_info.status = status;
-                phHciNfc_Notify(psHciContext->p_upper_notify,
-                                 psHciContext->p_upper_context, pHwRef,
-                                   NFC_NOTIFY_CONFIG_SUCCESS, &comp_info);
-                break;
-            }
-            default:
-            {
-                /* psHciContext->hci_seq = HCI_END_SEQ; */
-                break;
-            }
-        }
-        /*
-            NFC_CE_A_CFG;
-            NFC_CE_B_CFG; */
+    /* If the Target is Mifare then the Selection is complete */
+    if(( phHal_eMifare_PICC != target_type ) 
+        &&(phHal_eISO14443_3A_PICC != target_type)
+#ifdef TYPE_B
+        &&  ( phHal_eISO14443_B_PICC != target_type )
+        &&  ( phHal_eISO14443_4B_PICC != target_type )
+#endif
+#ifdef TYPE_FELICA
+        &&  ( phHal_eFelica_PICC != target_type )
+#endif
+#ifdef TYPE_JEWEL
+        &&  ( phHal_eJewel_PICC != target_type )
+#endif /* #ifdef TYPE_JEWEL */
+#ifdef TYPE_ISO15693
+        &&  ( phHal_eISO15693_PICC != target_type )
+#endif /* #ifdef TYPE_ISO15693 */
 
-    }/* End of the Emulation Config info Check */
-    
+        )
+    {
+        status = phHciNfc_ReaderMgmt_Info_Sequence( psHciContext, pHwRef );
+    }
     return status;
 }
 
 
+static
 NFCSTATUS
-phHciNfc_SmartMx_Mode_Sequence(
-                           phHciNfc_sContext_t      *psHciContext,
-                           void                     *pHwRef
+phHciNfc_Connect_Reactivate_Complete(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
                           )
 {
-    NFCSTATUS           status = NFCSTATUS_SUCCESS;
-    phHal_sADD_Cfg_t    *p_poll_config = (phHal_sADD_Cfg_t * )
-        psHciContext->p_config_params;
-    phNfc_sCompletionInfo_t     comp_info = {FALSE,0,NULL};
-    if (NULL != p_poll_config)
+    NFCSTATUS                           status = NFCSTATUS_SUCCESS;
+    static phNfc_sCompletionInfo_t      comp_info = {FALSE,0,NULL};
+
+    /* Complete the Reactivate Sequence and notify the HAL */
+    status = phHciNfc_FSM_Complete ( psHciContext );
+    /* Reactivate Complete Notification to the Upper Layer */
+    if(NFCSTATUS_SUCCESS == status)
     {
-        switch(psHciContext->hci_seq)
-        {
-            case READER_DISABLE_SEQ:
-            {
-                status = phHciNfc_ReaderMgmt_Disable_Discovery( 
-                    psHciContext, pHwRef );
-                if(NFCSTATUS_SUCCESS == status)
-                {
-                    psHciContext->hci_seq = EMULATION_CONFIG_SEQ;
-                    /* psHciContext->hci_seq = HCI_END_SEQ; */
-                    status = NFCSTATUS_PENDING;
-                }
-                break;
-            }
-            case EMULATION_CONFIG_SEQ:
-            {
-                status = phHciNfc_WI_Configure_Mode( 
-                    psHciContext, pHwRef,psHciContext->smx_mode );
-                if(NFCSTATUS_SUCCESS == status)
-                {
-                    psHciContext->hci_seq = PL_CONFIG_PHASE_SEQ;
-                    /* psHciContext->hci_seq = HCI_END_SEQ; */
-                    status = NFCSTATUS_PENDING;
-                }
-                break;
-            }
-            case PL_CONFIG_PHASE_SEQ:
-            {
-                /* Configure the Polling Loop Gate Parameters */
-                status = phHciNfc_PollLoop_Cfg( psHciContext, pHwRef,
-                    (uint8_t)PL_RD_PHASES, NULL );
-                if(NFCSTATUS_SUCCESS == status)
-                {
-                    psHciContext->hci_seq = READER_ENABLE_SEQ;
-                    status = NFCSTATUS_PENDING;
-                }
-                break;
-            }
-            case READER_ENABLE_SEQ:
-            {
-                status = 
-                    phHciNfc_ReaderMgmt_Enable_Discovery( 
-                    psHciContext, pHwRef );
-                if(NFCSTATUS_SUCCESS == status)
-                {
-                    /* psHciContext->hci_seq = PL_CONFIG_PHASE_SEQ; */
-                    psHciContext->hci_seq = HCI_END_SEQ;  
-                    status = NFCSTATUS_PENDING;
-                }
-                break;
-            }
-            case HCI_END_SEQ:
-            {
-                status = phHciNfc_Pending_Sequence(psHciContext, pHwRef );
-                if (NFCSTATUS_PENDING != status)
-                {
-                    /* status = phHciNfc_FSM_Complete ( psHciContext );*/
-                    phHciNfc_FSM_Rollback ( psHciContext );
-                    if( hciState_Disconnect == psHciContext->hci_state.cur_state)
-                    {
-                        psHciContext->host_rf_type = phHal_eUnknown_DevType;
-                        psHciContext->p_target_info = NULL;
-                        psHciContext->p_xchg_info = NULL;
-                    }
-                    /* Poll Configuration Notification to the Upper Layer */
-                    if((~(PL_RD_PHASES_DISABLE) & 
-                            p_poll_config->PollDevInfo.PollEnabled)!= 0)
-                    {
-                        comp_info.status = status;
-                        phHciNfc_Notify(psHciContext->p_upper_notify,
-                            psHciContext->p_upper_context, pHwRef,
-                            NFC_NOTIFY_POLL_ENABLED, &comp_info);
-                    } 
-                    else
-                    {
-                        comp_info.status = status;
-                        phHciNfc_Notify(psHciContext->p_upper_notify,
-                            psHciContext->p_upper_context, pHwRef,
-                            NFC_NOTIFY_POLL_DISABLED, &comp_info);
-                    }
-                    HCI_PRINT("HCI Discovery Configuration Completed \n");
-                }
-                break;
-            }
-            default:
-            {
-                /* psHciContext->hci_seq = HCI_END_SEQ; */
-                break;
-            }
-        }/* End of the Poll Sequence Switch */
-    }/* End of the Poll Config info Check */
+        comp_info.status = status;
+        phHciNfc_Notify(psHciContext->p_upper_notify,
+                        psHciContext->p_upper_context, pHwRef,
+                        NFC_NOTIFY_TARGET_REACTIVATED , &comp_info);
+        HCI_PRINT(" HCI Remote Target Reactivated. \n");
+    }
+    else
+    {
+        comp_info.status = status;
+        phHciNfc_FSM_Rollback ( psHciContext );
+        phHciNfc_Notify(psHciContext->p_upper_notify,
+            psHciContext->p_upper_context, pHwRef,
+            NFC_NOTIFY_ERROR , &comp_info);
+        HCI_PRINT("HCI FSM Invalid Selection State \n");
+        HCI_PRINT("HCI Remote Target Reactivation Failed \n");
+    }
+    return status;
+}
+
+
+static
+NFCSTATUS
+phHciNfc_Connect_Complete(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    NFCSTATUS                           status = NFCSTATUS_SUCCESS;
+    static phNfc_sCompletionInfo_t      comp_info = {FALSE,0,NULL};
 
+    /* Complete the Connect Sequence and notify the HAL */
+    status = phHciNfc_FSM_Complete ( psHciContext );
+    /* Connection Complete Notification to the Upper Layer */
+    if(NFCSTATUS_SUCCESS == status)
+    {
+        /* Invalidate the previously polled RF Reader Type */
+        /* psHciContext->host_rf_type = phHal_eInvalidRFType;*/
+        comp_info.status = status;
+        phHciNfc_Notify(psHciContext->p_upper_notify,
+                        psHciContext->p_upper_context, pHwRef,
+                        NFC_NOTIFY_TARGET_CONNECTED , &comp_info);
+        HCI_PRINT(" HCI Remote Target Selected for Transaction. \n");
+    }
+    else
+    {
+        comp_info.status = status;
+        /* phHciNfc_FSM_Rollback ( psHciContext ); */
+        phHciNfc_Notify(psHciContext->p_upper_notify,
+            psHciContext->p_upper_context, pHwRef,
+            NFC_NOTIFY_ERROR , &comp_info);
+        HCI_PRINT("HCI FSM Invalid Selection State \n");
+        HCI_PRINT("HCI Remote Target Selection Failed \n");
+    }
     return status;
 }
 
@@ -2093,107 +2815,98 @@ phHciNfc_Connect_Sequence(
                          )
 {
     NFCSTATUS           status = NFCSTATUS_SUCCESS;
-    static phNfc_sCompletionInfo_t      comp_info = {FALSE,0,NULL};
-    phHal_eRemDevType_t         target_type = phHal_eUnknown_DevType;
 
     if( NULL != psHciContext->p_target_info )
     {
+        status = phHciNfc_Run_Sequence( psHciContext, pHwRef,
+                        phHciNfc_Connect_Seq_Table,
+                        HCI_SEQ_TABLE_SIZE(phHciNfc_Connect_Seq_Table),
+                        NFCSTATUS_PENDING );
+    }
 
-        target_type = psHciContext->p_target_info->RemDevType;
-        switch(psHciContext->hci_seq)
-        {
-            case READER_REACTIVATE_SEQ:
-            {
-                /* Complete the Reactivate Sequence and notify the HAL */
-                status = phHciNfc_FSM_Complete ( psHciContext );
-                /* Reactivate Complete Notification to the Upper Layer */
-                if(NFCSTATUS_SUCCESS == status)
-                {
-                    comp_info.status = status;
-                    phHciNfc_Notify(psHciContext->p_upper_notify,
-                                    psHciContext->p_upper_context, pHwRef,
-                                    NFC_NOTIFY_TARGET_REACTIVATED , &comp_info);
-                    HCI_PRINT(" HCI Remote Target Reactivated. \n");
-                }
-                else
-                {
-                    comp_info.status = status;
-                    phHciNfc_FSM_Rollback ( psHciContext );
-                    phHciNfc_Notify(psHciContext->p_upper_notify,
-                        psHciContext->p_upper_context, pHwRef,
-                        NFC_NOTIFY_ERROR , &comp_info);
-                    HCI_PRINT("HCI FSM Invalid Selection State \n");
-                    HCI_PRINT("HCI Remote Target Reactivation Failed \n");
-                }
-                break;
-            }
-            case READER_SELECT_SEQ:
-            {
-                /* If the Target is Mifare then it should fall through */
-                if(( phHal_eMifare_PICC != target_type ) 
-                    &&(phHal_eISO14443_3A_PICC != target_type)
-#ifdef TYPE_B
-                    &&  ( phHal_eISO14443_B_PICC != target_type )
-                    &&  ( phHal_eISO14443_4B_PICC != target_type )
-#endif
-#ifdef TYPE_FELICA
-                    &&  ( phHal_eFelica_PICC != target_type )
-#endif
-#ifdef TYPE_JEWEL
-                    &&  ( phHal_eJewel_PICC != target_type )
-#endif /* #ifdef TYPE_JEWEL */
-#ifdef TYPE_ISO15693
-                    &&  ( phHal_eISO15693_PICC != target_type )
-#endif /* #ifdef TYPE_ISO15693 */
+    return status;
+}
 
-                    )
-                {
-                    status = phHciNfc_ReaderMgmt_Info_Sequence( psHciContext, pHwRef );
-                    if(NFCSTATUS_SUCCESS == status)
-                    {
-                        psHciContext->hci_seq = HCI_END_SEQ;
-                        status = NFCSTATUS_PENDING;
-                    }
-                    break;
-                }
-            }
-            /* fall through */
-            case HCI_END_SEQ:
-            {
-                /* Complete the Connect Sequence and notify the HAL */
-                status = phHciNfc_FSM_Complete ( psHciContext );
-                /* Connection Complete Notification to the Upper Layer */
-                if(NFCSTATUS_SUCCESS == status)
-                {
-                    /* Invalidate the previously polled RF Reader Type */
-                    /* psHciContext->host_rf_type = phHal_eInvalidRFType;*/
-                    comp_info.status = status;
-                    phHciNfc_Notify(psHciContext->p_upper_notify,
-                                    psHciContext->p_upper_context, pHwRef,
-                                    NFC_NOTIFY_TARGET_CONNECTED , &comp_info);
-                    HCI_PRINT(" HCI Remote Target Selected for Transaction. \n");
-                }
-                else
-                {
-                    comp_info.status = status;
-                    /* phHciNfc_FSM_Rollback ( psHciContext ); */
-                    phHciNfc_Notify(psHciContext->p_upper_notify,
+
+static
+NFCSTATUS
+phHciNfc_Disc_Dispatch_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    NFCSTATUS           status = NFCSTATUS_SUCCESS;
+
+    status = phHciNfc_ReaderMgmt_UICC_Dispatch( psHciContext, pHwRef,
+                                psHciContext->p_target_info->RemDevType );
+    /* The Target is De-Selected right away if nothing is dispatched */
+    return (NFCSTATUS_PENDING == status)? status : HCI_SEQ_STEP_SKIPPED;
+}
+
+
+static
+NFCSTATUS
+phHciNfc_Disc_Deselect_Step(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    uint8_t             re_poll = 0;
+
+    re_poll = (uint8_t) ( NULL != psHciContext->p_config_params )?
+                    *((uint8_t *)psHciContext->p_config_params):FALSE;
+    return phHciNfc_ReaderMgmt_Deselect( psHciContext, pHwRef,
+                    psHciContext->p_target_info->RemDevType, re_poll);
+}
+
+
+static
+NFCSTATUS
+phHciNfc_Disc_Deselect_Transition(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    psHciContext->p_config_params = NULL;
+    return NFCSTATUS_SUCCESS;
+}
+
+
+static
+NFCSTATUS
+phHciNfc_Disc_Complete(
+                                phHciNfc_sContext_t     *psHciContext,
+                                void                    *pHwRef
+                          )
+{
+    NFCSTATUS                           status = NFCSTATUS_SUCCESS;
+    static phNfc_sCompletionInfo_t      comp_info = {FALSE, 0 , NULL};
+
+    /* Complete the Disconnect Sequence and notify the HAL */
+    status = phHciNfc_FSM_Complete ( psHciContext );
+    /* Disconnect Notification to the Upper Layer */
+    if(NFCSTATUS_SUCCESS == status)
+    {
+        /* Invalidate the previously polled RF Reader Type */
+        psHciContext->host_rf_type = phHal_eUnknown_DevType;
+        psHciContext->p_target_info = NULL;
+        psHciContext->p_xchg_info = NULL;
+        comp_info.status = status;
+        phHciNfc_Notify(psHciContext->p_upper_notify,
                         psHciContext->p_upper_context, pHwRef,
-                        NFC_NOTIFY_ERROR , &comp_info);
-                    HCI_PRINT("HCI FSM Invalid Selection State \n");
-                    HCI_PRINT("HCI Remote Target Selection Failed \n");
-                }
-                break;
-            }
-            default:
-            {
-                HCI_PRINT("\t Invalid HCI Connect Sequence \n");
-                /* psHciContext->hci_seq = HCI_END_SEQ; */
-                break;
-            }
-        }/* End of the Connect Sequence Switch */
+                        NFC_NOTIFY_TARGET_DISCONNECTED , &comp_info);
+        HCI_PRINT(" HCI Remote Target De-Selected. \n");
+    }
+    else
+    {
+        comp_info.status = status;
+        /* phHciNfc_FSM_Rollback ( psHciContext ); */
+        phHciNfc_Notify(psHciContext->p_upper_notify,
+            psHciContext->p_upper_context, pHwRef,
+            NFC_NOTIFY_ERROR , &comp_info);
+        HCI_PRINT("HCI FSM Invalid De-Selection State \n");
+        HCI_PRINT("HCI Remote Target De-Selection Failed \n");
     }
-
     return status;
 }
 
@@ -2205,77 +2918,13 @@ phHciNfc_Disconnect_Sequence(
                          )
 {
     NFCSTATUS           status = NFCSTATUS_SUCCESS;
-    static phNfc_sCompletionInfo_t      comp_info = {FALSE, 0 , NULL};
-    phHal_eRemDevType_t         target_type = phHal_eUnknown_DevType;
-    uint8_t             re_poll = 0;
 
     if( NULL != psHciContext->p_target_info )
     {
-
-        target_type = psHciContext->p_target_info->RemDevType;
-        switch(psHciContext->hci_seq)
-        {
-            case READER_UICC_DISPATCH_SEQ:
-            {
-                status = phHciNfc_ReaderMgmt_UICC_Dispatch( 
-                                psHciContext, pHwRef, target_type );
-                psHciContext->hci_seq = READER_DESELECT_SEQ;
-                if(NFCSTATUS_PENDING == status)
-                {
-                    break;
-                }
-            }
-            /* fall through */
-            case READER_DESELECT_SEQ:
-            {
-                re_poll = (uint8_t) ( NULL != psHciContext->p_config_params )?
-                                *((uint8_t *)psHciContext->p_config_params):FALSE;
-                status = phHciNfc_ReaderMgmt_Deselect( 
-                                psHciContext, pHwRef, target_type, re_poll);
-                if(NFCSTATUS_PENDING == status)
-                {
-                    psHciContext->hci_seq = HCI_END_SEQ;
-                    psHciContext->p_config_params = NULL;
-                }
-                break;
-            }
-            case HCI_END_SEQ:
-            {
-                /* Complete the Disconnect Sequence and notify the HAL */
-                status = phHciNfc_FSM_Complete ( psHciContext );
-                /* Disconnect Notification to the Upper Layer */
-                if(NFCSTATUS_SUCCESS == status)
-                {
-                    /* Invalidate the previously polled RF Reader Type */
-                    psHciContext->host_rf_type = phHal_eUnknown_DevType;
-                    psHciContext->p_target_info = NULL;
-                    psHciContext->p_xchg_info = NULL;
-                    comp_info.status = status;
-                    phHciNfc_Notify(psHciContext->p_upper_notify,
-                                    psHciContext->p_upper_context, pHwRef,
-                                    NFC_NOTIFY_TARGET_DISCONNECTED , &comp_info);
-                    HCI_PRINT(" HCI Remote Target De-Selected. \n");
-                }
-                else
-                {
-                    comp_info.status = status;
-                    /* phHciNfc_FSM_Rollback ( psHciContext ); */
-                    phHciNfc_Notify(psHciContext->p_upper_notify,
-                        psHciContext->p_upper_context, pHwRef,
-                        NFC_NOTIFY_ERROR , &comp_info);
-                    HCI_PRINT("HCI FSM Invalid De-Selection State \n");
-                    HCI_PRINT("HCI Remote Target De-Selection Failed \n");
-                }
-
-                break;
-            }
-            default:
-            {
-                HCI_PRINT("\t Invalid HCI Connect Sequence \n");
-                /* psHciContext->hci_seq = HCI_END_SEQ; */
-                break;
-            }
-        }/* End of the Connect Sequence Switch */
+        status = phHciNfc_Run_Sequence( psHciContext, pHwRef,
+                        phHciNfc_Disconnect_Seq_Table,
+                        HCI_SEQ_TABLE_SIZE(phHciNfc_Disconnect_Seq_Table),
+                        NFCSTATUS_PENDING );
     }
 
     return status;
@@ -410,6 +410,38 @@ phHciNfc_Release_Sequence(
                             void                    *pHwRef
                          );
 
+#ifdef NXP_HCI_SEQ_PROFILE
+
+/**
+ * \ingroup grp_hci_nfc
+ *
+ *  The phHciNfc_Get_Seq_Stats function retrieves the number of times a
+ *  Step of the table driven HCI Sequences completed, with its total and
+ *  longest duration.
+ *
+ *  \param[in]  psHciContext            psHciContext is the context of
+ *                                      the HCI Layer.
+ *  \param[in]  seq                     seq is the Sequence Step whose
+ *                                      statistics are retrieved.
+ *  \param[out] p_seq_stats             p_seq_stats receives the statistics
+ *                                      of the Sequence Step.
+ *
+ *  \retval NFCSTATUS_SUCCESS           Statistics retrieved successfully.
+ *  \retval NFCSTATUS_INVALID_PARAMETER One or more of the supplied parameters
+ *                                      could not be interpreted properly.
+ *
+ */
+
+extern
+NFCSTATUS
+phHciNfc_Get_Seq_Stats(
+                            phHciNfc_sContext_t     *psHciContext,
+                            phHciNfc_eSeq_t         seq,
+                            phHciNfc_Seq_Stats_t    *p_seq_stats
+                         );
+
+#endif /* #ifdef NXP_HCI_SEQ_PROFILE */
+
 
 /*
 ################################################################################
@@ -549,6 +549,9 @@ NFCSTATUS phLibNfc_Mgt_Reset(void  *pContext)
         (void) memset(&(gpphLibContext->Discov_handle),0,
                         MAX_REMOTE_DEVICES);
 
+        /*Free memory allocated for LLCP transport tables*/
+        phFriNfc_LlcpTransport_Release(&gpphLibContext->llcp_cntx.sLlcpTransportContext);
+
         /*Free memory allocated for NDEF records*/
         if(NULL != gpphLibContext->psBufferedAuth)
         {
@@ -620,11 +623,7 @@ NFCSTATUS phLibNfc_Mgt_Reset(void  *pContext)
             phOsalNfc_FreeMemory(NdefInfo.pNdefRecord);
             NdefInfo.pNdefRecord = NULL;
         }          
-        if(NULL != gpphLibContext->phLib_NdefRecCntx.NdefCb)
-        {
-            phOsalNfc_FreeMemory(gpphLibContext->phLib_NdefRecCntx.NdefCb);
-            gpphLibContext->phLib_NdefRecCntx.NdefCb = NULL;
-        }
+        gpphLibContext->phLib_NdefRecCntx.NdefCb = NULL;
         if(NULL != gpphLibContext->phLib_NdefRecCntx.ndef_message.buffer)
         {
             phOsalNfc_FreeMemory(gpphLibContext->phLib_NdefRecCntx.ndef_message.buffer);
@@ -372,6 +372,54 @@ typedef struct phLibNfc_ChkNdef_Info
     uint32_t  MaxNdefMsgLength;                 /**< Indicates Maximum Ndef Message length that Tag can hold*/ 
 } phLibNfc_ChkNdef_Info_t;
 
+/**
+* \ingroup grp_lib_nfc
+*
+*\brief NDEF Read Cache statistics.
+*/
+typedef struct phLibNfc_Ndef_sCacheStats
+{
+    uint32_t  nLookups;                 /**< NDEF reads issued from the beginning of the message */
+    uint32_t  nHits;                    /**< NDEF reads served from the cache */
+    uint32_t  nMisses;                  /**< NDEF reads forwarded to the Tag */
+    uint32_t  nInvalidations;           /**< Cached messages dropped on a write, a format, a read only
+                                             conversion, a change of the Check NDEF information
+                                             or a corrupted cached copy (CRC mismatch) */
+    uint32_t  nBytesServed;             /**< Bytes of NDEF message served from the cache */
+    uint32_t  nTransceivesSaved;        /**< Transceives the served reads needed when read from the Tag */
+} phLibNfc_Ndef_sCacheStats_t;
+
+/**
+* \ingroup grp_lib_nfc
+*
+*\brief NDEF write statistics, counted in blocks of MIFARE Ultralight Tags.
+*/
+typedef struct phLibNfc_Ndef_sWriteStats
+{
+    uint32_t  nBlocksWritten;           /**< Blocks written by the last NDEF write */
+    uint32_t  nBlocksSkipped;           /**< Unchanged blocks not written by the last NDEF write */
+    uint32_t  nTotalBlocksWritten;      /**< Blocks written by all the NDEF writes */
+    uint32_t  nTotalBlocksSkipped;      /**< Unchanged blocks not written by all the NDEF writes */
+} phLibNfc_Ndef_sWriteStats_t;
+
+/**
+* \ingroup grp_lib_nfc
+*
+*\brief NDEF read statistics of \ref phLibNfc_Ndef_Read.
+*/
+typedef struct phLibNfc_Ndef_sReadStats
+{
+    uint32_t  nTransceives;             /**< Transceives needed by the last NDEF read */
+    uint32_t  nBytesRead;               /**< Bytes returned by the last NDEF read */
+    uint32_t  nTotalReads;              /**< NDEF reads completed successfully */
+    uint32_t  nTotalTransceives;        /**< Transceives needed by all the NDEF reads */
+    uint32_t  nAuths;                   /**< MIFARE Standard sector authentications sent by the last NDEF read */
+    uint32_t  nAuthsSkipped;            /**< Authentications the last NDEF read did not send, the sector
+                                             being already authenticated with the same key */
+    uint32_t  nTotalAuths;              /**< Sector authentications sent by all the NDEF reads */
+    uint32_t  nTotalAuthsSkipped;       /**< Authentications not sent by all the NDEF reads */
+} phLibNfc_Ndef_sReadStats_t;
+
 /**
 *\ingroup grp_lib_nfc
 *
@@ -386,6 +434,16 @@ typedef phFriNfc_LlcpTransport_eSocketType_t phLibNfc_Llcp_eSocketType_t;
 
 typedef phFriNfc_LlcpTransport_sSocketOptions_t phLibNfc_Llcp_sSocketOptions_t;
 
+typedef phFriNfc_LlcpTransport_eSocketPriority_t phLibNfc_Llcp_eSocketPriority_t;
+
+typedef phFriNfc_LlcpTransport_sSocketSchedStats_t phLibNfc_Llcp_sSocketSchedStats_t;
+
+typedef phFriNfc_LlcpTransport_sConfig_t phLibNfc_Llcp_sTransportConfig_t;
+
+typedef phFriNfc_LlcpTransport_sSocketMemory_t phLibNfc_Llcp_sSocketMemory_t;
+
+typedef phFriNfc_LlcpTransport_sSocketRecvStats_t phLibNfc_Llcp_sSocketRecvStats_t;
+
 /**
 * \ingroup grp_lib_nfc
 *
@@ -1824,6 +1882,63 @@ NFCSTATUS phLibNfc_Ndef_Read(phLibNfc_Handle                   hRemoteDevice,
                             pphLibNfc_RspCb_t                  pNdefRead_RspCb,
                             void*                              pContext
                             );
+
+/**
+* \ingroup grp_lib_nfc
+* \brief <b>Read a range of the NDEF message</b>.
+*
+* This function reads \a psRd->length bytes of the NDEF message of an already
+* connected Tag, starting at byte \a Offset of the message. The ranges may be
+* requested in any order, so that the client can parse the first record before
+* deciding whether it needs the rest of the message.
+*
+* The message is read from the Tag in order into a window kept by LibNfc, with
+* \ref NXP_NDEF_READ_PREFETCH_LEN bytes read ahead of each range, rounded up to
+* the block size of the Tag. A range already in the window is returned at once
+* with NFCSTATUS_SUCCESS. The window is dropped on a new Check NDEF, on a read
+* with \ref phLibNfc_Ndef_Read and on any change of the NDEF message.
+*
+*\param[in]     hRemoteDevice       Handle of the remote device.
+*\param[in]     Offset              Offset of the range in the NDEF message.
+*\param[in,out] psRd                Buffer receiving the range. Its length gives the
+*                                   size of the range and is updated with the number
+*                                   of bytes read, which is smaller at the end of the
+*                                   message.
+*\param[in]     pNdefRead_RspCb     Response callback defined by the caller.
+*\param[in]     pContext            Client context which will be included in
+*                                   callback when the request is completed.
+*
+* \retval NFCSTATUS_SUCCESS             The range is read, from the window.
+* \retval NFCSTATUS_PENDING             Request accepted and started.
+* \retval NFCSTATUS_SHUTDOWN            Shutdown in progress.
+* \retval NFCSTATUS_INVALID_HANDLE      Target handle is invalid.
+* \retval NFCSTATUS_NOT_INITIALISED     Indicates stack is not yet initialized.
+* \retval NFCSTATUS_INVALID_PARAMETER   One or more of the supplied parameters could not
+*                                       be properly interpreted.
+* \retval NFCSTATUS_TARGET_NOT_CONNECTED The Remote Device is not connected.
+* \retval NFCSTATUS_INSUFFICIENT_RESOURCES No memory is available for the window.
+* \retval NFCSTATUS_BUSY                A presence check is in progress.
+* \retval NFCSTATUS_FAILED              Read operation failed.
+* \retval NFCSTATUS_NON_NDEF_COMPLIANT  Tag is not Ndef Compliant.
+* \retval NFCSTATUS_REJECTED            Previous request pending, or Ndef check has not
+*                                       been performed.
+*
+*\note Response callback parameters details for this interface are as listed below.
+*
+* \param[in] pContext   LibNfc client context   passed in the corresponding request before.
+* \param[in] status     Status of the response  callback.
+*
+*                  \param NFCSTATUS_SUCCESS             NDEF read operation successful.
+*                  \param NFCSTATUS_SHUTDOWN            Shutdown in progress.
+*                  \param NFCSTATUS_ABORTED             Aborted due to disconnect operation in between.
+*                  \param NFCSTATUS_FAILED              Request failed.
+*/
+NFCSTATUS phLibNfc_Ndef_ReadRange(phLibNfc_Handle                   hRemoteDevice,
+                                  uint32_t                          Offset,
+                                  phNfc_sData_t*                    psRd,
+                                  pphLibNfc_RspCb_t                 pNdefRead_RspCb,
+                                  void*                             pContext
+                                  );
 /**
 **  \ingroup grp_lib_nfc
 *
@@ -2119,6 +2234,98 @@ NFCSTATUS phLibNfc_Ndef_SearchNdefContent(
                                 void *                          pContext   
                                 );
 
+/**
+* \ingroup grp_lib_nfc
+* \brief <b>Get the NDEF Read Cache statistics</b>.
+*
+* When the NDEF Read Cache is enabled, a complete NDEF message read from the
+* beginning is kept per Tag UID. \ref phLibNfc_Ndef_Read serves it again without
+* any exchange with the Tag while the Check NDEF of the Tag returns the same
+* container size, message length, card state and last response data. A CRC of
+* the kept copy, computed when it is stored, guards against its corruption in
+* memory only: a message changed on the Tag is detected through the Check NDEF
+* data alone. A read served from the cache completes through its response
+* callback as a read from the Tag. The cached message of a Tag is
+* dropped on any NDEF write, format or read only conversion of that Tag.
+*
+* \param[out] psStats               A pointer to be filled with the cache statistics.
+*
+* \retval NFCSTATUS_SUCCESS                  Operation successful.
+* \retval NFCSTATUS_INVALID_PARAMETER        One or more of the supplied parameters
+*                                            could not be properly interpreted.
+* \retval NFCSTATUS_NOT_INITIALISED          Indicates stack is not yet initialized.
+* \retval NFCSTATUS_SHUTDOWN                 Shutdown in progress.
+* \retval NFCSTATUS_FEATURE_NOT_SUPPORTED    The NDEF Read Cache is disabled.
+*/
+extern NFCSTATUS phLibNfc_Ndef_GetCacheStats(phLibNfc_Ndef_sCacheStats_t    *psStats);
+
+/**
+* \ingroup grp_lib_nfc
+* \brief <b>Write NDEF to a tag, writing only the changed blocks</b>.
+*
+* This function behaves as \ref phLibNfc_Ndef_Write, but compares the new message
+* with the message read from the Tag on the current connection, kept by the NDEF
+* read cache or by a complete \ref phLibNfc_Ndef_ReadRange window. A message served
+* by the NDEF read cache from a previous connection is not used. The data
+* blocks holding the same content are not written again. As for a full write, the
+* length of the NDEF TLV is set to zero before the data blocks are written and is
+* updated last, so that an interrupted write never leaves a corrupted message.
+*
+* Only MIFARE Ultralight Tags holding the NDEF TLV in their first sector are
+* written this way. Any other Tag, or a Tag whose message was not read on the
+* current connection, gets a full write. \ref phLibNfc_Ndef_GetWriteStats returns the blocks written and
+* the blocks skipped.
+*
+*\param[in]  hRemoteDevice          Handle of the remote device.
+*\param[in]  psWr                   Ndef Buffer to write.
+*\param[in]  pNdefWrite_RspCb       Response callback defined by the caller.
+*\param[in]  pContext               Client context which will be included in
+*                                   callback when the request is completed.
+*
+* The return values and the response callback are the ones of \ref phLibNfc_Ndef_Write.
+*/
+extern NFCSTATUS phLibNfc_Ndef_DiffWrite(phLibNfc_Handle          hRemoteDevice,
+                                         phNfc_sData_t*           psWr,
+                                         pphLibNfc_RspCb_t        pNdefWrite_RspCb,
+                                         void*                    pContext
+                                         );
+
+/**
+* \ingroup grp_lib_nfc
+* \brief <b>Get the NDEF write statistics</b>.
+*
+* This function returns the blocks written and the unchanged blocks skipped by
+* the last NDEF write and by all the NDEF writes to MIFARE Ultralight Tags.
+*
+* \param[out] psStats               A pointer to be filled with the write statistics.
+*
+* \retval NFCSTATUS_SUCCESS                  Operation successful.
+* \retval NFCSTATUS_INVALID_PARAMETER        One or more of the supplied parameters
+*                                            could not be properly interpreted.
+* \retval NFCSTATUS_NOT_INITIALISED          Indicates stack is not yet initialized.
+* \retval NFCSTATUS_SHUTDOWN                 Shutdown in progress.
+*/
+extern NFCSTATUS phLibNfc_Ndef_GetWriteStats(phLibNfc_Ndef_sWriteStats_t    *psStats);
+
+/**
+* \ingroup grp_lib_nfc
+* \brief <b>Get the NDEF read statistics</b>.
+*
+* This function returns the transceives and the bytes of the last NDEF read
+* completed by \ref phLibNfc_Ndef_Read, and the totals of all of them. A read
+* served from the NDEF read cache needs no transceive. For MIFARE Standard 1K
+* and 4K Tags, the sector authentications sent and skipped are counted too.
+*
+* \param[out] psStats               A pointer to be filled with the read statistics.
+*
+* \retval NFCSTATUS_SUCCESS                  Operation successful.
+* \retval NFCSTATUS_INVALID_PARAMETER        One or more of the supplied parameters
+*                                            could not be properly interpreted.
+* \retval NFCSTATUS_NOT_INITIALISED          Indicates stack is not yet initialized.
+* \retval NFCSTATUS_SHUTDOWN                 Shutdown in progress.
+*/
+extern NFCSTATUS phLibNfc_Ndef_GetReadStats(phLibNfc_Ndef_sReadStats_t    *psStats);
+
 
 
 
@@ -2422,6 +2629,9 @@ extern NFCSTATUS phLibNfc_Mgt_GetstackCapabilities(phLibNfc_StackCapabilities_t*
 * This function configures the parameters of the local LLCP peer. This function must be called
 * before any other LLCP-related function from this API.
 *
+* When symm_delay_max is not 0, the SYMM answers on an idle link are delayed from
+* symm_delay_min up to symm_delay_max milliseconds, doubling on each idle exchange.
+*
 * \param[in] pConfigInfo   Contains local LLCP link parameters to be applied
 * \param[in] pConfigRspCb  This callback has to be called once LibNfc
 *                          completes the Configuration.
@@ -2445,6 +2655,25 @@ extern NFCSTATUS phLibNfc_Mgt_SetLlcp_ConfigParams( phLibNfc_Llcp_sLinkParameter
                                                    );
 
 
+/**
+* \ingroup grp_lib_nfcHW_
+* \brief <b>Interface to size the tables of the local LLCP transport</b>.
+*
+* This function sets the number of sockets and of SDP cached service names allocated by
+* the LLCP transport. A size of 0 selects the default. The configuration is applied by the
+* next call to \ref phLibNfc_Mgt_SetLlcp_ConfigParams.
+*
+* \param[in] pConfigInfo   Contains the sizes of the LLCP transport tables
+*
+* \retval NFCSTATUS_SUCCESS               Operation successful.
+* \retval NFCSTATUS_INVALID_PARAMETER     One or more of the supplied parameters
+*                                         could not be properly interpreted.
+* \retval NFCSTATUS_NOT_INITIALISED       Indicates stack is not yet initialized.
+* \retval NFCSTATUS_SHUTDOWN              Shutdown in progress.
+*/
+extern NFCSTATUS phLibNfc_Mgt_SetLlcp_TransportConfig( phLibNfc_Llcp_sTransportConfig_t* pConfigInfo );
+
+
 /**
 * \ingroup grp_lib_nfc
 * \brief <b>Checks if a remote peer is LLCP compliant</b>.
@@ -2629,6 +2858,11 @@ extern NFCSTATUS phLibNfc_Llcp_Socket( phLibNfc_Llcp_eSocketType_t      eType,
 * gathered. As mentionned in LLCP specification, a SAP of 0 means that the service name
 * as not been found.
 *
+* The SAPs found are remembered for the peer NFCID3 during the nRemoteSapTtl of the
+* transport configuration. Only the well-known SAPs are kept across link sessions. Services
+* already known are not queried again, and the callback is called right away when all of
+* them are known.
+*
 * This feature is available only since LLCP v1.1, both devices must be at least v1.1 in
 * order to be able to use this function.
 *
@@ -2729,6 +2963,118 @@ extern NFCSTATUS phLibNfc_Llcp_SocketGetRemoteOptions( phLibNfc_Handle
                                                        );
 
 
+/**
+* \ingroup grp_lib_nfc
+* \brief <b>Set the scheduling priority of a socket</b>.
+*
+* This function sets the priority used to grant send turns to the socket when several
+* sockets have data ready. The ready sockets of each priority are served in turn, up to
+* the weight of the priority, before the ready sockets of the lower priorities.
+* Sockets are created with the normal priority.
+*
+* \param[in]  hSocket               Socket handle obtained during socket creation.
+* \param[in]  ePriority             The scheduling priority of the socket.
+*
+* \retval NFCSTATUS_SUCCESS                  Operation successful.
+* \retval NFCSTATUS_INVALID_PARAMETER        One or more of the supplied parameters
+*                                            could not be properly interpreted.
+* \retval NFCSTATUS_NOT_INITIALISED          Indicates stack is not yet initialized.
+* \retval NFCSTATUS_SHUTDOWN                 Shutdown in progress.
+*/
+extern NFCSTATUS phLibNfc_Llcp_SetSocketPriority( phLibNfc_Handle                   hSocket,
+                                                  phLibNfc_Llcp_eSocketPriority_t   ePriority
+                                                  );
+
+
+/**
+* \ingroup grp_lib_nfc
+* \brief <b>Get the scheduling statistics of a socket</b>.
+*
+* This function returns the number of send turns granted to the socket and the time its
+* pending operations spent waiting in the ready queue.
+*
+* \param[in]  hSocket               Socket handle obtained during socket creation.
+* \param[out] psStats               A pointer to be filled with the scheduling statistics.
+*
+* \retval NFCSTATUS_SUCCESS                  Operation successful.
+* \retval NFCSTATUS_INVALID_PARAMETER        One or more of the supplied parameters
+*                                            could not be properly interpreted.
+* \retval NFCSTATUS_NOT_INITIALISED          Indicates stack is not yet initialized.
+* \retval NFCSTATUS_SHUTDOWN                 Shutdown in progress.
+*/
+extern NFCSTATUS phLibNfc_Llcp_GetSocketSchedStats( phLibNfc_Handle                      hSocket,
+                                                    phLibNfc_Llcp_sSocketSchedStats_t*   psStats
+                                                    );
+
+
+/**
+* \ingroup grp_lib_nfc
+* \brief <b>Get the memory used by a socket</b>.
+*
+* This function returns the size of the socket descriptor, of the receive window buffer
+* table allocated for the socket, and of the working buffer used by the socket.
+*
+* \param[in]  hSocket               Socket handle obtained during socket creation.
+* \param[out] psMemory              A pointer to be filled with the memory used by the socket.
+*
+* \retval NFCSTATUS_SUCCESS                  Operation successful.
+* \retval NFCSTATUS_INVALID_PARAMETER        One or more of the supplied parameters
+*                                            could not be properly interpreted.
+* \retval NFCSTATUS_NOT_INITIALISED          Indicates stack is not yet initialized.
+* \retval NFCSTATUS_SHUTDOWN                 Shutdown in progress.
+*/
+extern NFCSTATUS phLibNfc_Llcp_GetSocketMemory( phLibNfc_Handle                  hSocket,
+                                                phLibNfc_Llcp_sSocketMemory_t*   psMemory
+                                                );
+
+
+/**
+* \ingroup grp_lib_nfc
+* \brief <b>Get the receive statistics of a socket</b>.
+*
+* This function returns the number of I frames stored straight into the receive
+* buffer of the application or into the linear buffer, staged in the receive
+* window buffers, and dropped for lack of room.
+*
+* \param[in]  hSocket               Socket handle obtained during socket creation.
+* \param[out] psStats               A pointer to be filled with the receive statistics.
+*
+* \retval NFCSTATUS_SUCCESS                  Operation successful.
+* \retval NFCSTATUS_INVALID_PARAMETER        One or more of the supplied parameters
+*                                            could not be properly interpreted.
+* \retval NFCSTATUS_NOT_INITIALISED          Indicates stack is not yet initialized.
+* \retval NFCSTATUS_SHUTDOWN                 Shutdown in progress.
+*/
+extern NFCSTATUS phLibNfc_Llcp_GetSocketRecvStats( phLibNfc_Handle                     hSocket,
+                                                   phLibNfc_Llcp_sSocketRecvStats_t*   psStats
+                                                   );
+
+
+/**
+* \ingroup grp_lib_nfc
+* \brief <b>Get the socket options of a bulk transfer</b>.
+*
+* This function gives the largest MIU, up to the local link MIU, and RW, up to
+* PHFRINFC_LLCP_RW_MAX, that a connection-oriented socket can use with a working
+* buffer of the given length. The local link MIU is set with
+* phLibNfc_Mgt_SetLlcp_ConfigParams, up to PHFRINFC_LLCP_MIU_MAX.
+* The socket must be given (rw + 1) * miu bytes of the working buffer.
+*
+* \param[in]  nWorkingBufferLength  The length of the working buffer of the socket.
+* \param[out] psOptions             A pointer to be filled with the socket options.
+*
+* \retval NFCSTATUS_SUCCESS                  Operation successful.
+* \retval NFCSTATUS_INVALID_PARAMETER        One or more of the supplied parameters
+*                                            could not be properly interpreted.
+* \retval NFCSTATUS_BUFFER_TOO_SMALL         The working buffer is too small.
+* \retval NFCSTATUS_NOT_INITIALISED          Indicates stack is not yet initialized.
+* \retval NFCSTATUS_SHUTDOWN                 Shutdown in progress.
+*/
+extern NFCSTATUS phLibNfc_Llcp_GetBulkSocketOptions( uint32_t                         nWorkingBufferLength,
+                                                     phLibNfc_Llcp_sSocketOptions_t*  psOptions
+                                                     );
+
+
 /**
 * \ingroup grp_lib_nfc
 * \brief <b>Bind a socket to a local SAP</b>.
@@ -140,6 +140,29 @@ typedef struct phLibNfc_Hal_CB_Info
 
 }phLibNfc_Hal_CB_Info_t;
 
+#ifdef NXP_NDEF_READ_CACHE
+/* NDEF message of a Tag, valid while its Check NDEF information is unchanged */
+typedef struct phLibNfc_NdefCacheEntry
+{
+    uint8_t                      Uid[PHHAL_MAX_UID_LENGTH];
+    uint8_t                      UidLength;
+    phHal_eRemDevType_t          RemDevType;
+    uint8_t                      CardState;
+    uint32_t                     NdefLength,
+                                 NdefActualSize;
+    /* Last response of the Check NDEF preceding the read of the message */
+    uint8_t                      ChkPrint[NXP_NDEF_READ_CACHE_PRINT_LEN];
+    uint8_t                      ChkPrintLength;
+    uint8_t                      *pNdefMessage;
+    /* CRC of the cached copy, checked before each use against its corruption
+       in memory; it can not tell that the message on the Tag changed */
+    uint16_t                     MessageCrc;
+    /* Transceives used to read the message from the Tag */
+    uint32_t                     TransceiveCount;
+    uint32_t                     LastUse;
+}phLibNfc_NdefCacheEntry_t;
+#endif /* #ifdef NXP_NDEF_READ_CACHE */
+
 typedef struct phLibNfc_NdefInfo
 {
     bool_t                       NdefContinueRead;
@@ -162,6 +185,43 @@ typedef struct phLibNfc_NdefInfo
     void                        *pClientNdefFmtCntx;
     phLibNfc_Ndef_SrchType_t    *pNdef_NtfSrch_Type;
 
+    /* Prefetch window of the ranged reads, holding the first
+       RangeWindowLength bytes of the NDEF message */
+    uint8_t                      *pRangeWindow;
+    uint32_t                     RangeWindowLength;
+    /* Bytes asked to the NDEF map by the pending ranged read */
+    uint32_t                     RangeReadLength;
+    uint32_t                     RangeOffset;
+    phNfc_sData_t                *psRangeRd;
+
+    /* Content of the NDEF TLV on the Tag given to the map by a
+       differential write */
+    uint8_t                      *pDiffImage;
+    phLibNfc_Ndef_sWriteStats_t  sWriteStats;
+
+    /* Transceive and MIFARE Standard authentication counts of the
+       lower layers when the NDEF read started */
+    uint32_t                     RdTrcvStart;
+    uint32_t                     RdAuthStart;
+    uint32_t                     RdAuthSkipStart;
+    phLibNfc_Ndef_sReadStats_t   sReadStats;
+
+#ifdef NXP_NDEF_READ_CACHE
+    phLibNfc_NdefCacheEntry_t    sCache[NXP_NDEF_READ_CACHE_ENTRIES];
+    /* Entry of the connected Tag, validated by its last Check NDEF */
+    phLibNfc_NdefCacheEntry_t    *psCacheEntry;
+    /* Read from the beginning in progress, its message may be cached */
+    uint8_t                      CacheFill;
+    /* Previous read served from the cache */
+    uint8_t                      CacheServed;
+    /* Message of psCacheEntry read from the Tag on the current connection */
+    uint8_t                      CacheFromTag;
+    /* Last response of the Check NDEF of the connected Tag */
+    uint8_t                      ChkPrint[NXP_NDEF_READ_CACHE_PRINT_LEN];
+    uint8_t                      ChkPrintLength;
+    uint32_t                     CacheTick;
+    phLibNfc_Ndef_sCacheStats_t  sCacheStats;
+#endif /* #ifdef NXP_NDEF_READ_CACHE */
 }phLibNfc_NdefInfo_t;
 
 typedef struct phLibNfc_NdefRecInfo
@@ -176,6 +236,7 @@ typedef struct phLibNfc_NdefRecInfo
     uint32_t                    NumberOfRawRecords;
     uint8_t                     *RawRecords[MAX_NO_OF_RECORDS];
     phFriNfc_NdefReg_Cb_t       *NdefCb;
+    phFriNfc_NdefReg_Cb_t       NdefCbNode;
     phNfc_sData_t               ndef_message;
 }phLibNfc_NdefRecInfo_t;
 
@@ -189,6 +250,11 @@ typedef struct phLibNfc_LlcpInfo
    /* LLCP compliance flag */
    bool_t bIsLlcp;
 
+   /* Sizes of the transport tables, given upon config
+    * and used upon transport reset.
+    */
+   phLibNfc_Llcp_sTransportConfig_t sTransportConfig;
+
    /* Monitor structure for LLCP Transport */
    phFriNfc_LlcpTransport_t sLlcpTransportContext;
 
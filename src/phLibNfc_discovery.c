@@ -264,6 +264,8 @@ NFCSTATUS phLibNfc_RemoteDev_CheckPresence( phLibNfc_Handle     hTargetDev,
     {
         ps_rem_dev_info = (phHal_sRemoteDevInformation_t *)
                                     gpphLibContext->Connected_handle;
+        /* The presence check authenticates or reactivates the Tag */
+        phLibNfc_Ndef_ResetAuth();
         if((phHal_eMifare_PICC == ps_rem_dev_info->RemDevType)
             &&(0 != ps_rem_dev_info->RemoteDevInfo.Iso14443A_Info.Sak)
             &&(TRUE == gpphLibContext->LastTrancvSuccess))
@@ -537,6 +537,7 @@ phLibNfc_RemoteDev_ReConnect (
     else
     {
         psRemoteDevInfo = (phLibNfc_sRemoteDevInformation_t *)hRemoteDevice;
+        phLibNfc_Ndef_ResetAuth();
        
         /* Call the HAL connect*/
         ret_val = phHal4Nfc_Connect (gpphLibContext->psHwReference,
@@ -626,6 +627,7 @@ NFCSTATUS phLibNfc_RemoteDev_Connect(
     else
     {
         psRemoteDevInfo = (phLibNfc_sRemoteDevInformation_t*)hRemoteDevice;
+        phLibNfc_Ndef_ResetAuth();
        
         /* Call the HAL connect*/
         RetVal = phHal4Nfc_Connect(gpphLibContext->psHwReference,
@@ -846,6 +848,7 @@ NFCSTATUS phLibNfc_RemoteDev_Disconnect( phLibNfc_Handle                 hRemote
         {           
             gpphLibContext->ReleaseType = ReleaseType;
             psRemoteDevInfo = (phLibNfc_sRemoteDevInformation_t*)hRemoteDevice;
+            phLibNfc_Ndef_ResetAuth();
             RetVal = phHal4Nfc_Disconnect(gpphLibContext->psHwReference,
                                 (phHal_sRemoteDevInformation_t*)psRemoteDevInfo,
                                 gpphLibContext->ReleaseType,
@@ -1083,6 +1086,8 @@ phLibNfc_RemoteDev_Transceive(phLibNfc_Handle                   hRemoteDevice,
                       phOsalNfc_GetMemory(
                         gpphLibContext->psTransInfo->sRecvData.length);             
             }
+            /* A raw command may change the sector authenticated on the Tag */
+            phLibNfc_Ndef_ResetAuth();
             /*Call the lower layer Transceive function */
             RetVal = phHal4Nfc_Transceive( gpphLibContext->psHwReference,
                                         (phHal_sTransceiveInfo_t*)gpphLibContext->psTransInfo,
@@ -128,6 +128,11 @@ NFCSTATUS phLibNfc_Mgt_SetLlcp_ConfigParams( phLibNfc_Llcp_sLinkParameters_t* pC
    {
       return NFCSTATUS_INVALID_PARAMETER;
    }
+   if ((pConfigInfo->symm_delay_max != 0) &&
+       (pConfigInfo->symm_delay_min > pConfigInfo->symm_delay_max))
+   {
+      return NFCSTATUS_INVALID_PARAMETER;
+   }
 
    /* Save the config for later use */
    memcpy( &gpphLibContext->llcp_cntx.sLocalParams,
@@ -174,7 +179,8 @@ NFCSTATUS phLibNfc_Mgt_SetLlcp_ConfigParams( phLibNfc_Llcp_sLinkParameters_t* pC
 
    /* Resets the LLCP Transport component */
    result = phFriNfc_LlcpTransport_Reset( &gpphLibContext->llcp_cntx.sLlcpTransportContext,
-                                          &gpphLibContext->llcp_cntx.sLlcpContext );
+                                          &gpphLibContext->llcp_cntx.sLlcpContext,
+                                          &gpphLibContext->llcp_cntx.sTransportConfig );
    if (result != NFCSTATUS_SUCCESS)
    {
       return PHNFCSTATUS(result);
@@ -183,6 +189,31 @@ NFCSTATUS phLibNfc_Mgt_SetLlcp_ConfigParams( phLibNfc_Llcp_sLinkParameters_t* pC
    return NFCSTATUS_PENDING;
 }
 
+NFCSTATUS phLibNfc_Mgt_SetLlcp_TransportConfig( phLibNfc_Llcp_sTransportConfig_t* pConfigInfo )
+{
+   NFCSTATUS      result;
+
+   /* State checking */
+   result = static_CheckState();
+   if (result != NFCSTATUS_SUCCESS)
+   {
+      return result;
+   }
+
+   /* Parameters checking */
+   if (pConfigInfo == NULL)
+   {
+      return NFCSTATUS_INVALID_PARAMETER;
+   }
+
+   /* Save the config for the next transport reset */
+   memcpy( &gpphLibContext->llcp_cntx.sTransportConfig,
+           pConfigInfo,
+           sizeof(phLibNfc_Llcp_sTransportConfig_t) );
+
+   return NFCSTATUS_SUCCESS;
+}
+
 NFCSTATUS phLibNfc_Llcp_CheckLlcp( phLibNfc_Handle              hRemoteDevice,
                                    pphLibNfc_ChkLlcpRspCb_t     pCheckLlcp_RspCb,
                                    pphLibNfc_LlcpLinkStatusCb_t pLink_Cb,
@@ -676,6 +707,142 @@ NFCSTATUS phLibNfc_Llcp_SocketGetRemoteOptions( phLibNfc_Handle
    return PHNFCSTATUS(result);
 }
 
+NFCSTATUS phLibNfc_Llcp_SetSocketPriority( phLibNfc_Handle                   hSocket,
+                                           phLibNfc_Llcp_eSocketPriority_t   ePriority
+                                           )
+{
+   NFCSTATUS                        result;
+   phFriNfc_LlcpTransport_Socket_t  *psSocket = (phFriNfc_LlcpTransport_Socket_t*)hSocket;
+
+   LLCP_PRINT("phLibNfc_Llcp_SetSocketPriority");
+
+   /* State checking */
+   result = static_CheckState();
+   if (result != NFCSTATUS_SUCCESS)
+   {
+      return result;
+   }
+
+   /* Parameters checking */
+   if (hSocket == 0)
+   {
+      return NFCSTATUS_INVALID_PARAMETER;
+   }
+
+   /* Set priority */
+   result = phFriNfc_LlcpTransport_SetSocketPriority(psSocket, ePriority);
+
+   return PHNFCSTATUS(result);
+}
+
+NFCSTATUS phLibNfc_Llcp_GetSocketSchedStats( phLibNfc_Handle                      hSocket,
+                                             phLibNfc_Llcp_sSocketSchedStats_t*   psStats
+                                             )
+{
+   NFCSTATUS                        result;
+   phFriNfc_LlcpTransport_Socket_t  *psSocket = (phFriNfc_LlcpTransport_Socket_t*)hSocket;
+
+   /* State checking */
+   result = static_CheckState();
+   if (result != NFCSTATUS_SUCCESS)
+   {
+      return result;
+   }
+
+   /* Parameters checking */
+   if ((hSocket == 0) ||
+       (psStats == NULL))
+   {
+      return NFCSTATUS_INVALID_PARAMETER;
+   }
+
+   /* Get scheduling statistics */
+   result = phFriNfc_LlcpTransport_GetSocketSchedStats(psSocket, psStats);
+
+   return PHNFCSTATUS(result);
+}
+
+NFCSTATUS phLibNfc_Llcp_GetSocketMemory( phLibNfc_Handle                  hSocket,
+                                         phLibNfc_Llcp_sSocketMemory_t*   psMemory
+                                         )
+{
+   NFCSTATUS                        result;
+   phFriNfc_LlcpTransport_Socket_t  *psSocket = (phFriNfc_LlcpTransport_Socket_t*)hSocket;
+
+   /* State checking */
+   result = static_CheckState();
+   if (result != NFCSTATUS_SUCCESS)
+   {
+      return result;
+   }
+
+   /* Parameters checking */
+   if ((hSocket == 0) ||
+       (psMemory == NULL))
+   {
+      return NFCSTATUS_INVALID_PARAMETER;
+   }
+
+   /* Get memory usage */
+   result = phFriNfc_LlcpTransport_GetSocketMemory(psSocket, psMemory);
+
+   return PHNFCSTATUS(result);
+}
+
+NFCSTATUS phLibNfc_Llcp_GetSocketRecvStats( phLibNfc_Handle                     hSocket,
+                                            phLibNfc_Llcp_sSocketRecvStats_t*   psStats
+                                            )
+{
+   NFCSTATUS                        result;
+   phFriNfc_LlcpTransport_Socket_t  *psSocket = (phFriNfc_LlcpTransport_Socket_t*)hSocket;
+
+   /* State checking */
+   result = static_CheckState();
+   if (result != NFCSTATUS_SUCCESS)
+   {
+      return result;
+   }
+
+   /* Parameters checking */
+   if ((hSocket == 0) ||
+       (psStats == NULL))
+   {
+      return NFCSTATUS_INVALID_PARAMETER;
+   }
+
+   /* Get receive statistics */
+   result = phFriNfc_LlcpTransport_GetSocketRecvStats(psSocket, psStats);
+
+   return PHNFCSTATUS(result);
+}
+
+NFCSTATUS phLibNfc_Llcp_GetBulkSocketOptions( uint32_t                         nWorkingBufferLength,
+                                              phLibNfc_Llcp_sSocketOptions_t*  psOptions
+                                              )
+{
+   NFCSTATUS      result;
+
+   /* State checking */
+   result = static_CheckState();
+   if (result != NFCSTATUS_SUCCESS)
+   {
+      return result;
+   }
+
+   /* Parameters checking */
+   if (psOptions == NULL)
+   {
+      return NFCSTATUS_INVALID_PARAMETER;
+   }
+
+   /* Get the bulk transfer options */
+   result = phFriNfc_LlcpTransport_GetBulkSocketOptions(&gpphLibContext->llcp_cntx.sLlcpTransportContext,
+                                                        nWorkingBufferLength,
+                                                        psOptions);
+
+   return PHNFCSTATUS(result);
+}
+
 NFCSTATUS phLibNfc_Llcp_Bind( phLibNfc_Handle hSocket,
                               uint8_t         nSap,
                               phNfc_sData_t * psServiceName
@@ -56,6 +56,17 @@
 #define     TOPAZ_LEN_BITMASK              0x02U
 #define     TOPAZ_DYNAMIC_LEN               460U
 #define     TOPAZ_STATIC_CARD_LEN           128U
+
+/* Block sizes the ranged reads round their window to */
+#define     NDEF_RANGE_MIFARE_BLOCK_LEN      16U
+#define     NDEF_RANGE_FELICA_BLOCK_LEN      16U
+#define     NDEF_RANGE_JEWEL_BLOCK_LEN        8U
+#define     NDEF_RANGE_ISO15693_BLOCK_LEN     4U
+
+/* NDEF TLV header, as found in the image given to a differential write */
+#define     NDEF_TLV_T                      0x03U
+#define     NDEF_TLV_LONG_L                 0xFFU
+#define     NDEF_TLV_MAX_HEADER_LEN           4U
 #define     MIFARE_STD_BLOCK_SIZE          0x10U
 /*
 *************************** Global Variables **********************************
@@ -105,6 +116,95 @@ STATIC void CheckNdef_timer_cb(uint32_t timer_id, void *pContext);
 STATIC void phLibNfc_Ndef_ChkNdef_Pchk_Cb(void   *pContext,
                                 NFCSTATUS  status
                                 );
+
+/*Callback for the activation of a Tag left idle by the Chk Ndef*/
+STATIC void phLibNfc_Ndef_ChkNdef_Reconnect_Cb(void                           *pContext,
+                                phHal_sRemoteDevInformation_t  *psRemoteDevInfo,
+                                NFCSTATUS                      status
+                                );
+
+/* Response callback for Ndef Read Range */
+STATIC
+void phLibNfc_Ndef_ReadRange_Cb(void* Context,NFCSTATUS status);
+
+/* Buffer the authentication of the MIFARE Standard block read next, for the
+   presence check and the reconnection of the Tag during an NDEF read */
+STATIC
+void phLibNfc_Ndef_ReadAuthSetup(phHal_sRemoteDevInformation_t *psRemoteDevInfo);
+
+/* Update the buffered authentication with the block read next */
+STATIC
+void phLibNfc_Ndef_ReadAuthUpdate(void);
+
+/* Handle a Tag lost during an NDEF read, a MIFARE Standard Tag is
+   reconnected */
+STATIC
+NFCSTATUS phLibNfc_Ndef_ReadLost(void);
+
+/* Block size the window of the ranged reads is rounded to */
+STATIC
+uint32_t phLibNfc_Ndef_RangeBlockSize(phHal_sRemoteDevInformation_t *psRemoteDevInfo);
+
+/* Copy the requested range from the given start of the NDEF message */
+STATIC
+void phLibNfc_Ndef_RangeCopy(uint8_t    *pMessage,
+                             uint32_t   MessageLength);
+
+/* Drop the window of the ranged reads */
+STATIC
+void phLibNfc_Ndef_RangeReset(void);
+
+/* Account the blocks of a completed write and release its image */
+STATIC
+void phLibNfc_Ndef_WriteDone(NFCSTATUS status);
+
+#ifdef NXP_NDEF_READ_CACHE
+/* Get the UID of a Tag, 0 if it is not known for this type of Tag */
+STATIC
+uint8_t phLibNfc_Ndef_CacheGetUid(phHal_sRemoteDevInformation_t *psRemoteDevInfo,
+                                  uint8_t                       **ppUid);
+
+/* Find the cache entry of a Tag */
+STATIC
+phLibNfc_NdefCacheEntry_t *phLibNfc_Ndef_CacheFind(
+                                phHal_sRemoteDevInformation_t *psRemoteDevInfo);
+
+/* Release the message of a cache entry and clear it */
+STATIC
+void phLibNfc_Ndef_CacheDrop(phLibNfc_NdefCacheEntry_t *psEntry);
+
+/* Drop the cached message of the connected Tag */
+STATIC
+void phLibNfc_Ndef_CacheInvalidate(void);
+
+/* Validate the cached message of the connected Tag after a Check NDEF */
+STATIC
+void phLibNfc_Ndef_CacheProbe(void);
+
+/* CRC of the cached copy of a message */
+STATIC
+uint16_t phLibNfc_Ndef_CacheCrc(uint8_t     *pData,
+                                uint32_t    Length);
+
+/* Check the cached copy for corruption in memory, drops the entry on a mismatch.
+   The Tag itself is not read: its changes are caught by the Check NDEF print */
+STATIC
+uint8_t phLibNfc_Ndef_CacheCheck(phLibNfc_NdefCacheEntry_t *psEntry);
+
+/* Completes an NDEF read served from the cache */
+STATIC
+void phLibNfc_Ndef_CacheRead_timer_cb(uint32_t timer_id, void *pContext);
+
+/* Serve an NDEF read from the cache, returns TRUE if it was served */
+STATIC
+uint8_t phLibNfc_Ndef_CacheRead(phNfc_sData_t           *psRd,
+                                phLibNfc_Ndef_EOffset_t Offset,
+                                NFCSTATUS               *pStatus);
+
+/* Keep the message of a completed NDEF read */
+STATIC
+void phLibNfc_Ndef_CacheStore(void);
+#endif /* #ifdef NXP_NDEF_READ_CACHE */
 /*
 *************************** Function Definitions ******************************
 */
@@ -168,6 +268,20 @@ NFCSTATUS phLibNfc_Ndef_Read( phLibNfc_Handle                   hRemoteDevice,
         psRd->length = 0;
         RetVal = NFCSTATUS_SUCCESS;
     }
+#ifdef NXP_NDEF_READ_CACHE
+    else if(TRUE == phLibNfc_Ndef_CacheRead(psRd, Offset, &RetVal))
+    {
+        /* Message served from the NDEF Read Cache, the read completes
+           through the response callback as a read from the Tag */
+        if(NFCSTATUS_PENDING == RetVal)
+        {
+            gpphLibContext->CBInfo.pClientRdNdefCb = pNdefRead_RspCb;
+            gpphLibContext->CBInfo.pClientRdNdefCntx = pContext;
+            gpphLibContext->status.GenCb_pending_status=TRUE;
+            gpphLibContext->LibNfcState.next_state = eLibNfcHalStateTransaction;
+        }
+    }
+#endif /* #ifdef NXP_NDEF_READ_CACHE */
 #ifdef LLCP_TRANSACT_CHANGES
     else if ((LLCP_STATE_RESET_INIT != gpphLibContext->llcp_cntx.sLlcpContext.state)
             && (LLCP_STATE_CHECKED != gpphLibContext->llcp_cntx.sLlcpContext.state))
@@ -179,43 +293,7 @@ NFCSTATUS phLibNfc_Ndef_Read( phLibNfc_Handle                   hRemoteDevice,
     {
         gpphLibContext->psRemoteDevList->psRemoteDevInfo->SessionOpened = SESSION_OPEN;
         gpphLibContext->ndef_cntx.eLast_Call = NdefRd;
-        if((((phHal_sRemoteDevInformation_t*)hRemoteDevice)->RemDevType == 
-            phHal_eMifare_PICC) && (((phHal_sRemoteDevInformation_t*)
-            hRemoteDevice)->RemoteDevInfo.Iso14443A_Info.Sak != 0)&&
-            ((NULL == gpphLibContext->psBufferedAuth)
-            ||(phHal_eMifareAuthentA == gpphLibContext->psBufferedAuth->cmd.MfCmd))
-            )
-        {
-            if(NULL != gpphLibContext->psBufferedAuth)
-            {
-                if(NULL != gpphLibContext->psBufferedAuth->sRecvData.buffer)
-                {
-                    phOsalNfc_FreeMemory(
-                        gpphLibContext->psBufferedAuth->sRecvData.buffer);
-                }
-                if(NULL != gpphLibContext->psBufferedAuth->sSendData.buffer)
-                {
-                    phOsalNfc_FreeMemory(
-                        gpphLibContext->psBufferedAuth->sSendData.buffer);
-                }
-                phOsalNfc_FreeMemory(gpphLibContext->psBufferedAuth);
-            }
-            gpphLibContext->psBufferedAuth
-                =(phLibNfc_sTransceiveInfo_t *) 
-                phOsalNfc_GetMemory(sizeof(phLibNfc_sTransceiveInfo_t));            
-            gpphLibContext->psBufferedAuth->addr = 
-             (uint8_t)gpphLibContext->ndef_cntx.psNdefMap
-             ->StdMifareContainer.currentBlock;
-            gpphLibContext->psBufferedAuth->cmd.MfCmd = phHal_eMifareRead16;
-            gpphLibContext->psBufferedAuth->sSendData.length
-                = 0;            
-            gpphLibContext->psBufferedAuth->sRecvData.length
-                = MIFARE_STD_BLOCK_SIZE;                      
-            gpphLibContext->psBufferedAuth->sRecvData.buffer
-                = (uint8_t *)phOsalNfc_GetMemory(MIFARE_STD_BLOCK_SIZE);
-            gpphLibContext->psBufferedAuth->sSendData.buffer
-             = (uint8_t *)phOsalNfc_GetMemory(MIFARE_STD_BLOCK_SIZE);
-        }
+        phLibNfc_Ndef_ReadAuthSetup((phHal_sRemoteDevInformation_t*)hRemoteDevice);
         if(eLibNfcHalStatePresenceChk !=
                 gpphLibContext->LibNfcState.next_state)
         {
@@ -233,6 +311,20 @@ NFCSTATUS phLibNfc_Ndef_Read( phLibNfc_Handle                   hRemoteDevice,
             gpphLibContext->ndef_cntx.NdefContinueRead =(uint8_t) ((phLibNfc_Ndef_EBegin==Offset) ?
                                                     PH_FRINFC_NDEFMAP_SEEK_BEGIN :
                                                     PH_FRINFC_NDEFMAP_SEEK_CUR);
+            /* The read position of the map is no more the end of the window */
+            phLibNfc_Ndef_RangeReset();
+            gpphLibContext->ndef_cntx.RdTrcvStart =
+                                    gpphLibContext->psOverHalCtxt->TransceiveCount;
+#ifndef PH_FRINFC_MAP_MIFARESTD_DISABLED
+            gpphLibContext->ndef_cntx.RdAuthStart = gpphLibContext->ndef_cntx.
+                                    psNdefMap->StdMifareContainer.AuthCount;
+            gpphLibContext->ndef_cntx.RdAuthSkipStart = gpphLibContext->ndef_cntx.
+                                    psNdefMap->StdMifareContainer.AuthSkipped;
+#endif  /* PH_FRINFC_MAP_MIFARESTD_DISABLED */
+#ifdef NXP_NDEF_READ_CACHE
+            gpphLibContext->ndef_cntx.CacheFill = (uint8_t)
+                                    (phLibNfc_Ndef_EBegin == Offset);
+#endif /* #ifdef NXP_NDEF_READ_CACHE */
             /* call below layer Ndef Read*/
             RetVal = phFriNfc_NdefMap_RdNdef(gpphLibContext->ndef_cntx.psNdefMap,
                             gpphLibContext->ndef_cntx.psUpperNdefMsg->buffer,
@@ -279,7 +371,6 @@ void phLibNfc_Ndef_Read_Cb(void* Context,NFCSTATUS status)
     pphLibNfc_RspCb_t       pClientCb=NULL;
     phLibNfc_LibContext_t   *pLibNfc_Ctxt = (phLibNfc_LibContext_t *)Context;
     void                    *pUpperLayerContext=NULL;
-    phHal_sRemoteDevInformation_t   *ps_rem_dev_info = NULL;
 
     if(pLibNfc_Ctxt != gpphLibContext)
     {
@@ -301,38 +392,40 @@ void phLibNfc_Ndef_Read_Cb(void* Context,NFCSTATUS status)
         else
         {
             gpphLibContext->status.GenCb_pending_status = FALSE;
-            if (gpphLibContext->psBufferedAuth != NULL && gpphLibContext->ndef_cntx.psNdefMap != NULL) {
-                   gpphLibContext->psBufferedAuth->addr = (uint8_t)
-                   gpphLibContext->ndef_cntx.psNdefMap->StdMifareContainer.currentBlock;
-            }
+            phLibNfc_Ndef_ReadAuthUpdate();
 
             if(NFCSTATUS_FAILED == status )
             {
                 /*During Ndef read operation tag was not present in RF
                 field of reader*/
-                RetStatus = NFCSTATUS_FAILED; 
                 gpphLibContext->LastTrancvSuccess = FALSE;
-                gpphLibContext->ndef_cntx.is_ndef = FALSE;
-                ps_rem_dev_info = (phHal_sRemoteDevInformation_t *)
-                                    gpphLibContext->Connected_handle;
-                if ((phHal_eMifare_PICC == ps_rem_dev_info->RemDevType) && 
-                    (0x08 == (ps_rem_dev_info->RemoteDevInfo.Iso14443A_Info.Sak & 0x08)) ||
-                    (0x01 == ps_rem_dev_info->RemoteDevInfo.Iso14443A_Info.Sak))
-                {
-
-                    /* card type is mifare 1k/4k, then reconnect */
-                    RetStatus = phHal4Nfc_Connect(gpphLibContext->psHwReference,  
-                                ps_rem_dev_info,
-                                (pphHal4Nfc_ConnectCallback_t)
-                                phLibNfc_Reconnect_Mifare_Cb,
-                                (void *)gpphLibContext);
-                }
-
+                RetStatus = phLibNfc_Ndef_ReadLost();
             }  
             else if(status == NFCSTATUS_SUCCESS)
             {
+                phLibNfc_Ndef_sReadStats_t  *ps_stats = 
+                                        &gpphLibContext->ndef_cntx.sReadStats;
+
                 gpphLibContext->LastTrancvSuccess = TRUE;
                 RetStatus = NFCSTATUS_SUCCESS;
+                ps_stats->nTransceives = (gpphLibContext->psOverHalCtxt->TransceiveCount
+                                        - gpphLibContext->ndef_cntx.RdTrcvStart);
+                ps_stats->nBytesRead = gpphLibContext->ndef_cntx.psUpperNdefMsg->length;
+                ps_stats->nTotalReads++;
+                ps_stats->nTotalTransceives += ps_stats->nTransceives;
+#ifndef PH_FRINFC_MAP_MIFARESTD_DISABLED
+                ps_stats->nAuths = (gpphLibContext->ndef_cntx.psNdefMap->
+                                        StdMifareContainer.AuthCount
+                                        - gpphLibContext->ndef_cntx.RdAuthStart);
+                ps_stats->nAuthsSkipped = (gpphLibContext->ndef_cntx.psNdefMap->
+                                        StdMifareContainer.AuthSkipped
+                                        - gpphLibContext->ndef_cntx.RdAuthSkipStart);
+                ps_stats->nTotalAuths += ps_stats->nAuths;
+                ps_stats->nTotalAuthsSkipped += ps_stats->nAuthsSkipped;
+#endif  /* PH_FRINFC_MAP_MIFARESTD_DISABLED */
+#ifdef NXP_NDEF_READ_CACHE
+                phLibNfc_Ndef_CacheStore();
+#endif /* #ifdef NXP_NDEF_READ_CACHE */
             }
 		    else
 		    {
@@ -357,7 +450,434 @@ void phLibNfc_Ndef_Read_Cb(void* Context,NFCSTATUS status)
             }
         }
     }
-    return;
+    return;
+}
+
+/**
+* Get the NDEF read statistics
+*/
+NFCSTATUS phLibNfc_Ndef_GetReadStats(phLibNfc_Ndef_sReadStats_t    *psStats)
+{
+    NFCSTATUS RetVal = NFCSTATUS_SUCCESS;
+
+    if((NULL == gpphLibContext)||
+        (gpphLibContext->LibNfcState.cur_state == eLibNfcHalStateShutdown))
+    {
+        RetVal = NFCSTATUS_NOT_INITIALISED;
+    }
+    else if(NULL == psStats)
+    {
+        RetVal = NFCSTATUS_INVALID_PARAMETER;
+    }
+    else if(gpphLibContext->LibNfcState.next_state == eLibNfcHalStateShutdown)
+    {
+        RetVal = NFCSTATUS_SHUTDOWN;
+    }
+    else
+    {
+        (void)memcpy(psStats, &gpphLibContext->ndef_cntx.sReadStats,
+                    sizeof(phLibNfc_Ndef_sReadStats_t));
+    }
+    return RetVal;
+}
+
+/**
+* This function reads a range of the NDEF message of an already connected
+* tag. The message is read in order into a window, ahead of the requested
+* range, and the ranges within the window are served from it.
+*/
+NFCSTATUS phLibNfc_Ndef_ReadRange( phLibNfc_Handle              hRemoteDevice,
+                                   uint32_t                     Offset,
+                                   phNfc_sData_t                *psRd,
+                                   pphLibNfc_RspCb_t            pNdefRead_RspCb,
+                                   void*                        pContext
+                                   )
+{
+    NFCSTATUS RetVal = NFCSTATUS_FAILED;
+
+    if((NULL == gpphLibContext)|| 
+        (gpphLibContext->LibNfcState.cur_state == eLibNfcHalStateShutdown))
+    {
+        RetVal = NFCSTATUS_NOT_INITIALISED;
+    }
+    else if((NULL == psRd) || (NULL == pNdefRead_RspCb)
+        || (NULL == psRd->buffer)
+        || (0 == psRd->length)
+        || (NULL == pContext)
+        || (0 == hRemoteDevice))
+    {
+        RetVal= NFCSTATUS_INVALID_PARAMETER;
+    }    
+    else if(gpphLibContext->LibNfcState.next_state == eLibNfcHalStateShutdown)
+    {
+        RetVal = NFCSTATUS_SHUTDOWN;
+    }
+    else if(0 == gpphLibContext->Connected_handle)
+    {   /*presently no target or tag is connected*/ 
+        RetVal=NFCSTATUS_TARGET_NOT_CONNECTED;        
+    }
+    else if(hRemoteDevice != gpphLibContext->Connected_handle)
+    {   /*This handle of the device sent by application is not connected */ 
+        RetVal=NFCSTATUS_INVALID_HANDLE;        
+    }
+    else if((TRUE == gpphLibContext->status.GenCb_pending_status)       
+            ||(NULL!=gpphLibContext->CBInfo.pClientRdNdefCb)
+            ||(CHK_NDEF_NOT_DONE == gpphLibContext->ndef_cntx.is_ndef))
+    {
+        /*Previous callback is pending*/
+        RetVal = NFCSTATUS_REJECTED;
+    }
+    else if(gpphLibContext->ndef_cntx.is_ndef == FALSE)
+    {
+        /*no Ndef Support in tag*/
+         RetVal = NFCSTATUS_NON_NDEF_COMPLIANT;
+    }
+    else if(Offset >= gpphLibContext->ndef_cntx.NdefActualSize)
+    {
+        /*Range after the end of the message- So Returning length as zero*/
+        psRd->length = 0;
+        RetVal = NFCSTATUS_SUCCESS;
+    }
+#ifdef LLCP_TRANSACT_CHANGES
+    else if ((LLCP_STATE_RESET_INIT != gpphLibContext->llcp_cntx.sLlcpContext.state)
+            && (LLCP_STATE_CHECKED != gpphLibContext->llcp_cntx.sLlcpContext.state))
+    {
+        RetVal= NFCSTATUS_BUSY;
+    }
+#endif /* #ifdef LLCP_TRANSACT_CHANGES */
+    else if(eLibNfcHalStatePresenceChk ==
+                gpphLibContext->LibNfcState.next_state)
+    {
+        RetVal= NFCSTATUS_BUSY;
+    }
+    else
+    {
+        phLibNfc_NdefInfo_t     *ps_ndef = &gpphLibContext->ndef_cntx;
+        uint32_t                range_end = 0;
+        uint32_t                window_end = 0;
+        uint32_t                block_len = 0;
+        uint8_t                 cr_index = 0;
+
+        ps_ndef->RangeOffset = Offset;
+        ps_ndef->psRangeRd = psRd;
+        range_end = ps_ndef->NdefActualSize;
+        if(psRd->length < (range_end - Offset))
+        {
+            range_end = Offset + psRd->length;
+        }
+#ifdef NXP_NDEF_READ_CACHE
+        if((NULL != ps_ndef->psCacheEntry)
+            && (TRUE == phLibNfc_Ndef_CacheCheck(ps_ndef->psCacheEntry)))
+        {
+            phLibNfc_Ndef_RangeCopy(ps_ndef->psCacheEntry->pNdefMessage,
+                                    ps_ndef->psCacheEntry->NdefActualSize);
+            ps_ndef->sCacheStats.nBytesServed += psRd->length;
+            RetVal = NFCSTATUS_SUCCESS;
+        }
+        else
+#endif /* #ifdef NXP_NDEF_READ_CACHE */
+        if(range_end <= ps_ndef->RangeWindowLength)
+        {
+            phLibNfc_Ndef_RangeCopy(ps_ndef->pRangeWindow,
+                                    ps_ndef->RangeWindowLength);
+            RetVal = NFCSTATUS_SUCCESS;
+        }
+        else
+        {
+            if(NULL == ps_ndef->pRangeWindow)
+            {
+                ps_ndef->pRangeWindow = (uint8_t *)
+                            phOsalNfc_GetMemory(ps_ndef->NdefActualSize);
+                ps_ndef->RangeWindowLength = 0;
+            }
+            if(NULL == ps_ndef->pRangeWindow)
+            {
+                RetVal = NFCSTATUS_INSUFFICIENT_RESOURCES;
+            }
+            else
+            {
+                /* Read ahead of the range, up to a block boundary */
+                block_len = phLibNfc_Ndef_RangeBlockSize(
+                                (phHal_sRemoteDevInformation_t *)hRemoteDevice);
+                window_end = ps_ndef->RangeWindowLength + NXP_NDEF_READ_PREFETCH_LEN;
+                if(window_end < range_end)
+                {
+                    window_end = range_end;
+                }
+                window_end = (((window_end + block_len - 1) / block_len) * block_len);
+                if(window_end > ps_ndef->NdefActualSize)
+                {
+                    window_end = ps_ndef->NdefActualSize;
+                }
+                ps_ndef->RangeReadLength = (window_end - ps_ndef->RangeWindowLength);
+
+                gpphLibContext->psRemoteDevList->psRemoteDevInfo->SessionOpened = SESSION_OPEN;
+                ps_ndef->eLast_Call = NdefRd;
+                phLibNfc_Ndef_ReadAuthSetup(
+                                (phHal_sRemoteDevInformation_t *)hRemoteDevice);
+                for (cr_index = 0; cr_index < PH_FRINFC_NDEFMAP_CR; cr_index++)
+                {
+                    RetVal= phFriNfc_NdefMap_SetCompletionRoutine(
+                                        ps_ndef->psNdefMap,
+                                        cr_index,
+                                        phLibNfc_Ndef_ReadRange_Cb,
+                                        (void *)gpphLibContext);
+                }
+                /* The window is filled in order, continue after its end */
+                RetVal = phFriNfc_NdefMap_RdNdef(ps_ndef->psNdefMap,
+                                (ps_ndef->pRangeWindow + ps_ndef->RangeWindowLength),
+                                &(ps_ndef->RangeReadLength),
+                                ((0 == ps_ndef->RangeWindowLength)?
+                                PH_FRINFC_NDEFMAP_SEEK_BEGIN :
+                                PH_FRINFC_NDEFMAP_SEEK_CUR));
+                RetVal = PHNFCSTATUS(RetVal);
+                if(NFCSTATUS_PENDING == RetVal)
+                {
+                    gpphLibContext->CBInfo.pClientRdNdefCb = pNdefRead_RspCb;
+                    gpphLibContext->CBInfo.pClientRdNdefCntx = pContext;
+                    gpphLibContext->status.GenCb_pending_status=TRUE;
+                    gpphLibContext->LibNfcState.next_state = eLibNfcHalStateTransaction;
+                }
+                else if(NFCSTATUS_SUCCESS == RetVal)
+                {
+                    ps_ndef->RangeWindowLength += ps_ndef->RangeReadLength;
+                    phLibNfc_Ndef_RangeCopy(ps_ndef->pRangeWindow,
+                                            ps_ndef->RangeWindowLength);
+                }
+                else
+                {
+                    /*Ndef read failed*/
+                    phLibNfc_Ndef_RangeReset();
+                    RetVal = NFCSTATUS_FAILED;
+                }
+            }
+        }
+    }
+    return RetVal;
+}
+
+/* Response callback for phLibNfc_Ndef_ReadRange */
+STATIC
+void phLibNfc_Ndef_ReadRange_Cb(void* Context,NFCSTATUS status)
+{
+    NFCSTATUS               RetStatus = NFCSTATUS_SUCCESS;
+    pphLibNfc_RspCb_t       pClientCb=NULL;
+    phLibNfc_LibContext_t   *pLibNfc_Ctxt = (phLibNfc_LibContext_t *)Context;
+    void                    *pUpperLayerContext=NULL;
+
+    if(pLibNfc_Ctxt != gpphLibContext)
+    {
+        /*wrong context returned*/
+        phOsalNfc_RaiseException(phOsalNfc_e_InternalErr,1);
+    }
+    else
+    {
+        if(eLibNfcHalStateShutdown == gpphLibContext->LibNfcState.next_state)
+        {   /*shutdown called before completion of Ndef read allow
+              shutdown to happen */
+            phLibNfc_Pending_Shutdown();
+            RetStatus = NFCSTATUS_SHUTDOWN;    
+        }
+        else if(eLibNfcHalStateRelease == gpphLibContext->LibNfcState.next_state)
+        {
+            RetStatus = NFCSTATUS_ABORTED;
+        }
+        else
+        {
+            gpphLibContext->status.GenCb_pending_status = FALSE;
+            phLibNfc_Ndef_ReadAuthUpdate();
+
+            if(status == NFCSTATUS_SUCCESS)
+            {
+                gpphLibContext->LastTrancvSuccess = TRUE;
+                gpphLibContext->ndef_cntx.RangeWindowLength +=
+                                gpphLibContext->ndef_cntx.RangeReadLength;
+                phLibNfc_Ndef_RangeCopy(gpphLibContext->ndef_cntx.pRangeWindow,
+                                gpphLibContext->ndef_cntx.RangeWindowLength);
+                RetStatus = NFCSTATUS_SUCCESS;
+            }
+            else
+            {
+                gpphLibContext->LastTrancvSuccess = FALSE;
+                phLibNfc_Ndef_RangeReset();
+                RetStatus = NFCSTATUS_FAILED;
+                if(NFCSTATUS_FAILED == status)
+                {
+                    /*During Ndef read operation tag was not present in RF
+                    field of reader*/
+                    RetStatus = phLibNfc_Ndef_ReadLost();
+                }
+            }
+        }
+        /*update the current state as connected*/
+        phLibNfc_UpdateCurState(status,gpphLibContext);
+
+        pClientCb = gpphLibContext->CBInfo.pClientRdNdefCb;
+        pUpperLayerContext = gpphLibContext->CBInfo.pClientRdNdefCntx;
+
+        if(NFCSTATUS_PENDING != RetStatus)
+        {
+            gpphLibContext->CBInfo.pClientRdNdefCb = NULL;
+            gpphLibContext->CBInfo.pClientRdNdefCntx = NULL;
+            if (NULL != pClientCb)
+            {
+                /*Notify to upper layer status and read bytes*/
+                pClientCb(pUpperLayerContext,RetStatus);            
+            }
+        }
+    }
+    return;
+}
+
+STATIC
+void phLibNfc_Ndef_ReadAuthSetup(phHal_sRemoteDevInformation_t *psRemoteDevInfo)
+{
+#ifndef PH_FRINFC_MAP_MIFARESTD_DISABLED
+    if((psRemoteDevInfo->RemDevType == phHal_eMifare_PICC)
+        && (psRemoteDevInfo->RemoteDevInfo.Iso14443A_Info.Sak != 0)
+        && ((NULL == gpphLibContext->psBufferedAuth)
+        ||(phHal_eMifareAuthentA == gpphLibContext->psBufferedAuth->cmd.MfCmd)))
+    {
+        if(NULL != gpphLibContext->psBufferedAuth)
+        {
+            if(NULL != gpphLibContext->psBufferedAuth->sRecvData.buffer)
+            {
+                phOsalNfc_FreeMemory(
+                    gpphLibContext->psBufferedAuth->sRecvData.buffer);
+            }
+            if(NULL != gpphLibContext->psBufferedAuth->sSendData.buffer)
+            {
+                phOsalNfc_FreeMemory(
+                    gpphLibContext->psBufferedAuth->sSendData.buffer);
+            }
+            phOsalNfc_FreeMemory(gpphLibContext->psBufferedAuth);
+        }
+        gpphLibContext->psBufferedAuth
+            =(phLibNfc_sTransceiveInfo_t *)
+            phOsalNfc_GetMemory(sizeof(phLibNfc_sTransceiveInfo_t));
+        if(NULL != gpphLibContext->psBufferedAuth)
+        {
+            gpphLibContext->psBufferedAuth->addr =
+             (uint8_t)gpphLibContext->ndef_cntx.psNdefMap
+             ->StdMifareContainer.currentBlock;
+            gpphLibContext->psBufferedAuth->cmd.MfCmd = phHal_eMifareRead16;
+            gpphLibContext->psBufferedAuth->sSendData.length
+                = 0;
+            gpphLibContext->psBufferedAuth->sRecvData.length
+                = MIFARE_STD_BLOCK_SIZE;
+            gpphLibContext->psBufferedAuth->sRecvData.buffer
+                = (uint8_t *)phOsalNfc_GetMemory(MIFARE_STD_BLOCK_SIZE);
+            gpphLibContext->psBufferedAuth->sSendData.buffer
+             = (uint8_t *)phOsalNfc_GetMemory(MIFARE_STD_BLOCK_SIZE);
+        }
+    }
+#else
+    PHNFC_UNUSED_VARIABLE(psRemoteDevInfo);
+#endif  /* PH_FRINFC_MAP_MIFARESTD_DISABLED */
+}
+
+STATIC
+void phLibNfc_Ndef_ReadAuthUpdate(void)
+{
+#ifndef PH_FRINFC_MAP_MIFARESTD_DISABLED
+    if((NULL != gpphLibContext->psBufferedAuth)
+        && (NULL != gpphLibContext->ndef_cntx.psNdefMap))
+    {
+        gpphLibContext->psBufferedAuth->addr = (uint8_t)
+            gpphLibContext->ndef_cntx.psNdefMap->StdMifareContainer.currentBlock;
+    }
+#endif  /* PH_FRINFC_MAP_MIFARESTD_DISABLED */
+}
+
+STATIC
+NFCSTATUS phLibNfc_Ndef_ReadLost(void)
+{
+    NFCSTATUS                       RetStatus = NFCSTATUS_FAILED;
+    phHal_sRemoteDevInformation_t   *ps_rem_dev_info = NULL;
+
+    gpphLibContext->ndef_cntx.is_ndef = FALSE;
+    ps_rem_dev_info = (phHal_sRemoteDevInformation_t *)
+                        gpphLibContext->Connected_handle;
+    if((phHal_eMifare_PICC == ps_rem_dev_info->RemDevType)
+        && ((0x08 == (ps_rem_dev_info->RemoteDevInfo.Iso14443A_Info.Sak & 0x08))
+        || (0x01 == ps_rem_dev_info->RemoteDevInfo.Iso14443A_Info.Sak)))
+    {
+        /* card type is mifare 1k/4k, then reconnect */
+        RetStatus = phHal4Nfc_Connect(gpphLibContext->psHwReference,
+                    ps_rem_dev_info,
+                    (pphHal4Nfc_ConnectCallback_t)
+                    phLibNfc_Reconnect_Mifare_Cb,
+                    (void *)gpphLibContext);
+    }
+    return RetStatus;
+}
+
+STATIC
+uint32_t phLibNfc_Ndef_RangeBlockSize(phHal_sRemoteDevInformation_t *psRemoteDevInfo)
+{
+    uint32_t    block_len = 1;
+
+    switch(psRemoteDevInfo->RemDevType)
+    {
+        case phHal_eMifare_PICC:
+        {
+            /* A MIFARE UL read returns 4 pages, a MIFARE Std read 1 block */
+            block_len = NDEF_RANGE_MIFARE_BLOCK_LEN;
+            break;
+        }
+        case phHal_eFelica_PICC:
+        {
+            block_len = NDEF_RANGE_FELICA_BLOCK_LEN;
+            break;
+        }
+        case phHal_eJewel_PICC:
+        {
+            block_len = NDEF_RANGE_JEWEL_BLOCK_LEN;
+            break;
+        }
+        case phHal_eISO15693_PICC:
+        {
+            block_len = NDEF_RANGE_ISO15693_BLOCK_LEN;
+            break;
+        }
+        default:
+        {
+            /* ISO 14443-4 tags read any length */
+            break;
+        }
+    }
+    return block_len;
+}
+
+STATIC
+void phLibNfc_Ndef_RangeCopy(uint8_t    *pMessage,
+                             uint32_t   MessageLength)
+{
+    phLibNfc_NdefInfo_t     *ps_ndef = &gpphLibContext->ndef_cntx;
+    uint32_t                length = 0;
+
+    if(ps_ndef->RangeOffset < MessageLength)
+    {
+        length = (MessageLength - ps_ndef->RangeOffset);
+        if(length > ps_ndef->psRangeRd->length)
+        {
+            length = ps_ndef->psRangeRd->length;
+        }
+        (void)memcpy(ps_ndef->psRangeRd->buffer,
+                    (pMessage + ps_ndef->RangeOffset), length);
+    }
+    ps_ndef->psRangeRd->length = length;
+}
+
+STATIC
+void phLibNfc_Ndef_RangeReset(void)
+{
+    if(NULL != gpphLibContext->ndef_cntx.pRangeWindow)
+    {
+        phOsalNfc_FreeMemory(gpphLibContext->ndef_cntx.pRangeWindow);
+        gpphLibContext->ndef_cntx.pRangeWindow = NULL;
+    }
+    gpphLibContext->ndef_cntx.RangeWindowLength = 0;
 }
 
 /**
@@ -432,6 +952,10 @@ NFCSTATUS phLibNfc_Ndef_Write(
         gpphLibContext->ndef_cntx.psUpperNdefMsg = psWr;
         gpphLibContext->ndef_cntx.AppWrLength= psWr->length;
         gpphLibContext->ndef_cntx.eLast_Call = NdefWr;
+        phLibNfc_Ndef_RangeReset();
+#ifdef NXP_NDEF_READ_CACHE
+        phLibNfc_Ndef_CacheInvalidate();
+#endif /* #ifdef NXP_NDEF_READ_CACHE */
         gpphLibContext->psRemoteDevList->psRemoteDevInfo->SessionOpened 
             = SESSION_OPEN;
         if((((phHal_sRemoteDevInformation_t*)hRemoteDevice)->RemDevType == 
@@ -493,10 +1017,14 @@ NFCSTATUS phLibNfc_Ndef_Write(
             if(0 == psWr->length)
             {
                  /* Length of bytes to be written Zero- Erase the Tag  */
+                gpphLibContext->ndef_cntx.psNdefMap->DiffImage = NULL;
                 RetVal = phFriNfc_NdefMap_EraseNdef(gpphLibContext->ndef_cntx.psNdefMap);
             }
             else
             {
+                /* Blocks found unchanged in the image are not written */
+                gpphLibContext->ndef_cntx.psNdefMap->DiffImage =
+                                gpphLibContext->ndef_cntx.pDiffImage;
                 /*Write from beginning or current location*/
                 NdefWriteType = PH_FRINFC_NDEFMAP_SEEK_BEGIN; 
                 /*Call FRI Ndef Write*/
@@ -521,6 +1049,143 @@ NFCSTATUS phLibNfc_Ndef_Write(
     return RetVal;
 }
 
+/**
+* Write NDEF to a tag, writing again only the blocks whose content
+* changed since the message was read.
+*/
+NFCSTATUS phLibNfc_Ndef_DiffWrite(
+                            phLibNfc_Handle          hRemoteDevice,
+                            phNfc_sData_t           *psWr,                              
+                            pphLibNfc_RspCb_t        pNdefWrite_RspCb,
+                            void*                    pContext
+                            )
+{
+    NFCSTATUS           RetVal = NFCSTATUS_FAILED;
+    uint8_t             *p_message = NULL;
+    uint32_t            length = 0;
+    uint8_t             index = 0;
+
+    if((NULL != gpphLibContext)
+        && (NULL != psWr)
+        && (0 != psWr->length)
+        && (0 != hRemoteDevice)
+        && (hRemoteDevice == gpphLibContext->Connected_handle)
+        && (TRUE == gpphLibContext->ndef_cntx.is_ndef)
+        && (FALSE == gpphLibContext->status.GenCb_pending_status)
+        && (NULL == gpphLibContext->ndef_cntx.pDiffImage)
+        && (PH_FRINFC_NDEFMAP_MIFARE_UL_CARD == 
+            gpphLibContext->ndef_cntx.psNdefMap->CardType))
+    {
+        /* Message read from the Tag on the current connection, a message
+           cached on a previous connection may have been changed since by
+           another device with the same length and leading bytes */
+        length = gpphLibContext->ndef_cntx.NdefActualSize;
+#ifdef NXP_NDEF_READ_CACHE
+        if((NULL != gpphLibContext->ndef_cntx.psCacheEntry)
+            && (TRUE == gpphLibContext->ndef_cntx.CacheFromTag)
+            && (TRUE == phLibNfc_Ndef_CacheCheck(
+                            gpphLibContext->ndef_cntx.psCacheEntry)))
+        {
+            p_message = gpphLibContext->ndef_cntx.psCacheEntry->pNdefMessage;
+        }
+        else
+#endif /* #ifdef NXP_NDEF_READ_CACHE */
+        if((0 != length)
+            && (length == gpphLibContext->ndef_cntx.RangeWindowLength))
+        {
+            p_message = gpphLibContext->ndef_cntx.pRangeWindow;
+        }
+        if((NULL != p_message) && (0 != length))
+        {
+            /* The image starts with the T and L bytes of the NDEF TLV */
+            gpphLibContext->ndef_cntx.pDiffImage = (uint8_t *)
+                            phOsalNfc_GetMemory(length + NDEF_TLV_MAX_HEADER_LEN);
+        }
+        if(NULL != gpphLibContext->ndef_cntx.pDiffImage)
+        {
+            gpphLibContext->ndef_cntx.pDiffImage[index++] = NDEF_TLV_T;
+            if(length < NDEF_TLV_LONG_L)
+            {
+                gpphLibContext->ndef_cntx.pDiffImage[index++] = (uint8_t)length;
+            }
+            else
+            {
+                gpphLibContext->ndef_cntx.pDiffImage[index++] = NDEF_TLV_LONG_L;
+                gpphLibContext->ndef_cntx.pDiffImage[index++] = (uint8_t)(length >> 8);
+                gpphLibContext->ndef_cntx.pDiffImage[index++] = (uint8_t)length;
+            }
+            (void)memcpy(&gpphLibContext->ndef_cntx.pDiffImage[index],
+                        p_message, length);
+            gpphLibContext->ndef_cntx.psNdefMap->DiffImageLength = (index + length);
+        }
+    }
+
+    RetVal = phLibNfc_Ndef_Write(hRemoteDevice, psWr, pNdefWrite_RspCb, pContext);
+
+    if((NFCSTATUS_PENDING != RetVal)
+        && (NULL != gpphLibContext)
+        && (NULL != gpphLibContext->ndef_cntx.pDiffImage))
+    {
+        phOsalNfc_FreeMemory(gpphLibContext->ndef_cntx.pDiffImage);
+        gpphLibContext->ndef_cntx.pDiffImage = NULL;
+        gpphLibContext->ndef_cntx.psNdefMap->DiffImage = NULL;
+    }
+    return RetVal;
+}
+
+/**
+* Get the NDEF write statistics
+*/
+NFCSTATUS phLibNfc_Ndef_GetWriteStats(phLibNfc_Ndef_sWriteStats_t    *psStats)
+{
+    NFCSTATUS RetVal = NFCSTATUS_SUCCESS;
+
+    if((NULL == gpphLibContext)||
+        (gpphLibContext->LibNfcState.cur_state == eLibNfcHalStateShutdown))
+    {
+        RetVal = NFCSTATUS_NOT_INITIALISED;
+    }
+    else if(NULL == psStats)
+    {
+        RetVal = NFCSTATUS_INVALID_PARAMETER;
+    }
+    else if(gpphLibContext->LibNfcState.next_state == eLibNfcHalStateShutdown)
+    {
+        RetVal = NFCSTATUS_SHUTDOWN;
+    }
+    else
+    {
+        (void)memcpy(psStats, &gpphLibContext->ndef_cntx.sWriteStats,
+                    sizeof(phLibNfc_Ndef_sWriteStats_t));
+    }
+    return RetVal;
+}
+
+STATIC
+void phLibNfc_Ndef_WriteDone(NFCSTATUS status)
+{
+    phLibNfc_NdefInfo_t     *ps_ndef = &gpphLibContext->ndef_cntx;
+
+    if(NULL != ps_ndef->psNdefMap)
+    {
+        if((NFCSTATUS_SUCCESS == status)
+            && (0 != ps_ndef->AppWrLength)
+            && (PH_FRINFC_NDEFMAP_MIFARE_UL_CARD == ps_ndef->psNdefMap->CardType))
+        {
+            ps_ndef->sWriteStats.nBlocksWritten = ps_ndef->psNdefMap->WrBlocksWritten;
+            ps_ndef->sWriteStats.nBlocksSkipped = ps_ndef->psNdefMap->WrBlocksSkipped;
+            ps_ndef->sWriteStats.nTotalBlocksWritten += ps_ndef->psNdefMap->WrBlocksWritten;
+            ps_ndef->sWriteStats.nTotalBlocksSkipped += ps_ndef->psNdefMap->WrBlocksSkipped;
+        }
+        ps_ndef->psNdefMap->DiffImage = NULL;
+    }
+    if(NULL != ps_ndef->pDiffImage)
+    {
+        phOsalNfc_FreeMemory(ps_ndef->pDiffImage);
+        ps_ndef->pDiffImage = NULL;
+    }
+}
+
 /* Response callback for phLibNfc_Ndef_Write */
 STATIC
 void phLibNfc_Ndef_Write_Cb(void* Context,NFCSTATUS status)
@@ -596,6 +1261,7 @@ void phLibNfc_Ndef_Write_Cb(void* Context,NFCSTATUS status)
 				status = NFCSTATUS_FAILED;;
 			}
         }
+        phLibNfc_Ndef_WriteDone(status);
         phLibNfc_UpdateCurState(status,gpphLibContext);
 
         pClientCb = gpphLibContext->CBInfo.pClientWrNdefCb;
@@ -701,6 +1367,19 @@ void phLibNfc_Ndef_Init(void)
     return;
 }
 /**
+* Make the NDEF map forget the MIFARE Standard sector authenticated on the
+* Tag, before the Tag is accessed or reactivated outside of the map
+*/
+void phLibNfc_Ndef_ResetAuth(void)
+{
+#ifndef PH_FRINFC_MAP_MIFARESTD_DISABLED
+    if(NULL != gpphLibContext)
+    {
+        phFriNfc_MifareStdMap_ResetAuth(gpphLibContext->ndef_cntx.psNdefMap);
+    }
+#endif  /* PH_FRINFC_MAP_MIFARESTD_DISABLED */
+}
+/**
 * Free the allocated memory used for Ndef operations 
 */
 void phLibNfc_Ndef_DeInit(void)
@@ -738,6 +1417,21 @@ void phLibNfc_Ndef_DeInit(void)
         phOsalNfc_FreeMemory(gpphLibContext->psTransInfo);
         gpphLibContext->psTransInfo= NULL;
     }
+    phLibNfc_Ndef_RangeReset();
+    if(NULL != gpphLibContext->ndef_cntx.pDiffImage)
+    {
+        phOsalNfc_FreeMemory(gpphLibContext->ndef_cntx.pDiffImage);
+        gpphLibContext->ndef_cntx.pDiffImage = NULL;
+    }
+#ifdef NXP_NDEF_READ_CACHE
+    {
+        uint8_t     index = 0;
+        for (index = 0; index < NXP_NDEF_READ_CACHE_ENTRIES; index++)
+        {
+            phLibNfc_Ndef_CacheDrop(&gpphLibContext->ndef_cntx.sCache[index]);
+        }
+    }
+#endif /* #ifdef NXP_NDEF_READ_CACHE */
 }
 
 
@@ -791,6 +1485,13 @@ NFCSTATUS phLibNfc_Ndef_CheckNdef(phLibNfc_Handle       hRemoteDevice,
         /* Allocate memory for the ndef related structure */       
         gpphLibContext->ndef_cntx.NdefSendRecvLen=300;
         gpphLibContext->ndef_cntx.eLast_Call = ChkNdef;
+        phLibNfc_Ndef_RangeReset();
+#ifdef NXP_NDEF_READ_CACHE
+        gpphLibContext->ndef_cntx.psCacheEntry = NULL;
+        gpphLibContext->ndef_cntx.CacheServed = FALSE;
+        gpphLibContext->ndef_cntx.CacheFromTag = FALSE;
+        gpphLibContext->ndef_cntx.ChkPrintLength = 0;
+#endif /* #ifdef NXP_NDEF_READ_CACHE */
         
         /* Resets the component instance */
         RetVal = phFriNfc_NdefMap_Reset( gpphLibContext->ndef_cntx.psNdefMap,
@@ -893,7 +1594,19 @@ void phLibNfc_Ndef_CheckNdef_Cb(void *pContext,NFCSTATUS status)
         }
         else
         {
-            if(status == NFCSTATUS_SUCCESS)
+            if((status == NFCSTATUS_SUCCESS)
+                && (TRUE == pLibNfc_Ctxt->ndef_cntx.psNdefMap->ReActivate))
+            {
+                /* The map identified the Tag with a command it does not
+                   support, activate it again before completing the check */
+                pLibNfc_Ctxt->ndef_cntx.psNdefMap->ReActivate = FALSE;
+                RetStatus = phHal4Nfc_Connect(gpphLibContext->psHwReference,  
+                                ps_rem_dev_info,
+                                (pphHal4Nfc_ConnectCallback_t)
+                                phLibNfc_Ndef_ChkNdef_Reconnect_Cb,
+                                (void *)gpphLibContext);
+            }
+            else if(status == NFCSTATUS_SUCCESS)
             {
                 /*Tag is Ndef tag*/
                 gpphLibContext->ndef_cntx.is_ndef = TRUE;
@@ -911,6 +1624,7 @@ void phLibNfc_Ndef_CheckNdef_Cb(void *pContext,NFCSTATUS status)
             {
                 /*Ndef check Failed.Issue a PresenceChk to ascertain if tag is
                   still in the field*/
+                phLibNfc_Ndef_ResetAuth();
                 RetStatus = phHal4Nfc_PresenceCheck(
                                     gpphLibContext->psHwReference,
                                     phLibNfc_Ndef_ChkNdef_Pchk_Cb,
@@ -958,6 +1672,23 @@ void phLibNfc_Ndef_CheckNdef_Cb(void *pContext,NFCSTATUS status)
                 }                         
             }
             gpphLibContext->LibNfcState.cur_state=eLibNfcHalStateConnect;
+#ifdef NXP_NDEF_READ_CACHE
+            if((NFCSTATUS_SUCCESS == RetStatus)
+                && (TRUE == gpphLibContext->ndef_cntx.is_ndef))
+            {
+                /* The last response of the Check NDEF holds the NDEF length
+                   and, for most of the Tags, the first bytes of the message */
+                pLibNfc_Ctxt->ndef_cntx.ChkPrintLength = (uint8_t)
+                    ((pLibNfc_Ctxt->ndef_cntx.NdefSendRecvLen
+                    < NXP_NDEF_READ_CACHE_PRINT_LEN)?
+                    pLibNfc_Ctxt->ndef_cntx.NdefSendRecvLen:
+                    NXP_NDEF_READ_CACHE_PRINT_LEN);
+                (void)memcpy(pLibNfc_Ctxt->ndef_cntx.ChkPrint,
+                            pLibNfc_Ctxt->ndef_cntx.psNdefMap->SendRecvBuf,
+                            pLibNfc_Ctxt->ndef_cntx.ChkPrintLength);
+                phLibNfc_Ndef_CacheProbe();
+            }
+#endif /* #ifdef NXP_NDEF_READ_CACHE */
         }
         gpphLibContext->status.GenCb_pending_status = FALSE;
         /* Update the current state */
@@ -1125,6 +1856,18 @@ STATIC void phLibNfc_Ndef_ChkNdef_Pchk_Cb(void   *pContext,
     }
     return;
 }
+/*Callback for the activation of a Tag left idle by the Chk Ndef*/
+STATIC void phLibNfc_Ndef_ChkNdef_Reconnect_Cb(void                           *pContext,
+                                phHal_sRemoteDevInformation_t  *psRemoteDevInfo,
+                                NFCSTATUS                      status
+                                )
+{
+    PHNFC_UNUSED_VARIABLE(psRemoteDevInfo);
+    /* Complete the check: a failed activation is handled as a failed
+       check, with a presence check of the Tag */
+    phLibNfc_Ndef_CheckNdef_Cb(pContext, status);
+}
+
 /* Check Ndef Timer Callback*/
 STATIC void CheckNdef_timer_cb(uint32_t timer_id, void *pContext)
 {
@@ -1144,6 +1887,8 @@ void phLibNfc_Reconnect_Mifare_Cb (
     phLibNfc_LibContext_t       *pLibNfc_Ctxt = 
                                 (phLibNfc_LibContext_t *)pContext;
     void                        *pUpperLayerContext = NULL;
+
+    phLibNfc_Ndef_ResetAuth();
     switch(gpphLibContext->ndef_cntx.eLast_Call)
     {
         case ChkNdef:
@@ -1300,6 +2045,10 @@ NFCSTATUS phLibNfc_RemoteDev_FormatNdef(phLibNfc_Handle         hRemoteDevice,
     {
         uint8_t   fun_id;       
         gpphLibContext->ndef_cntx.eLast_Call = NdefFmt;        
+        phLibNfc_Ndef_RangeReset();
+#ifdef NXP_NDEF_READ_CACHE
+        phLibNfc_Ndef_CacheInvalidate();
+#endif /* #ifdef NXP_NDEF_READ_CACHE */
         gpphLibContext->ndef_cntx.NdefSendRecvLen = NDEF_SENDRCV_BUF_LEN;
     
         /* Call ndef format reset, this will initialize the ndef
@@ -1323,6 +2072,8 @@ NFCSTATUS phLibNfc_RemoteDev_FormatNdef(phLibNfc_Handle         hRemoteDevice,
         {
             mif_std_key[Index] = *(pScrtKey->buffer++);
         }
+        /* The formatting authenticates the sectors on its own */
+        phLibNfc_Ndef_ResetAuth();
         /* Start smart card formatting function   */
         RetVal = phFriNfc_NdefSmtCrd_Format(gpphLibContext->ndef_cntx.ndef_fmt,
                                         mif_std_key);
@@ -1393,6 +2144,10 @@ phLibNfc_ConvertToReadOnlyNdef (
     else
     {
         gpphLibContext->ndef_cntx.eLast_Call = NdefReadOnly;
+        phLibNfc_Ndef_RangeReset();
+#ifdef NXP_NDEF_READ_CACHE
+        phLibNfc_Ndef_CacheInvalidate();
+#endif /* #ifdef NXP_NDEF_READ_CACHE */
 
         if(eLibNfcHalStatePresenceChk != gpphLibContext->LibNfcState.next_state)
         {
@@ -1941,12 +2696,8 @@ NFCSTATUS phLibNfc_Ndef_SearchNdefContent(
                             gpphLibContext->phLib_NdefRecCntx.ChunkedRecordsarray,  
                             gpphLibContext->phLib_NdefRecCntx.NumberOfRecords);
 
-            gpphLibContext->phLib_NdefRecCntx.NdefCb = phOsalNfc_GetMemory(sizeof(phFriNfc_NdefReg_Cb_t));
-            if(gpphLibContext->phLib_NdefRecCntx.NdefCb==NULL)
-            {
-                /*exception: Not enough memory*/
-                phOsalNfc_RaiseException(phOsalNfc_e_NoMemory,1);
-            }
+            /*The registry was reset above, the single search node can be reused*/
+            gpphLibContext->phLib_NdefRecCntx.NdefCb = &(gpphLibContext->phLib_NdefRecCntx.NdefCbNode);
             gpphLibContext->phLib_NdefRecCntx.NdefCb->NdefCallback = phLibNfc_Ndef_Rtd_Cb;
             /*Copy the TNF types to search in global structure*/    
             gpphLibContext->phLib_NdefRecCntx.NdefCb->NumberOfRTDs = uNoSrchRecords;
@@ -1978,6 +2729,7 @@ NFCSTATUS phLibNfc_Ndef_SearchNdefContent(
 
         }
         gpphLibContext->ndef_cntx.NdefContinueRead = PH_FRINFC_NDEFMAP_SEEK_BEGIN;
+        phLibNfc_Ndef_RangeReset();
         /* call below layer Ndef Read*/
         RetVal = phFriNfc_NdefMap_RdNdef(gpphLibContext->ndef_cntx.psNdefMap,
                         gpphLibContext->phLib_NdefRecCntx.ndef_message.buffer,
@@ -2005,3 +2757,399 @@ NFCSTATUS phLibNfc_Ndef_SearchNdefContent(
 
 }
 
+/**
+* Get the NDEF Read Cache statistics
+*/
+NFCSTATUS phLibNfc_Ndef_GetCacheStats(phLibNfc_Ndef_sCacheStats_t    *psStats)
+{
+    NFCSTATUS RetVal = NFCSTATUS_SUCCESS;
+
+    if((NULL == gpphLibContext)||
+        (gpphLibContext->LibNfcState.cur_state == eLibNfcHalStateShutdown))
+    {
+        RetVal = NFCSTATUS_NOT_INITIALISED;
+    }
+    else if(NULL == psStats)
+    {
+        RetVal = NFCSTATUS_INVALID_PARAMETER;
+    }
+    else if(gpphLibContext->LibNfcState.next_state == eLibNfcHalStateShutdown)
+    {
+        RetVal = NFCSTATUS_SHUTDOWN;
+    }
+    else
+    {
+#ifdef NXP_NDEF_READ_CACHE
+        (void)memcpy(psStats, &gpphLibContext->ndef_cntx.sCacheStats,
+                    sizeof(phLibNfc_Ndef_sCacheStats_t));
+#else
+        RetVal = NFCSTATUS_FEATURE_NOT_SUPPORTED;
+#endif /* #ifdef NXP_NDEF_READ_CACHE */
+    }
+    return RetVal;
+}
+
+#ifdef NXP_NDEF_READ_CACHE
+
+STATIC
+uint8_t phLibNfc_Ndef_CacheGetUid(phHal_sRemoteDevInformation_t *psRemoteDevInfo,
+                                  uint8_t                       **ppUid)
+{
+    uint8_t     uid_len = 0;
+
+    switch(psRemoteDevInfo->RemDevType)
+    {
+        case phHal_eISO14443_A_PICC:
+        case phHal_eISO14443_4A_PICC:
+        case phHal_eISO14443_3A_PICC:
+        case phHal_eMifare_PICC:
+        {
+            *ppUid = psRemoteDevInfo->RemoteDevInfo.Iso14443A_Info.Uid;
+            uid_len = psRemoteDevInfo->RemoteDevInfo.Iso14443A_Info.UidLength;
+            break;
+        }
+        case phHal_eISO14443_B_PICC:
+        case phHal_eISO14443_4B_PICC:
+        {
+            *ppUid = psRemoteDevInfo->RemoteDevInfo.Iso14443B_Info.AtqB.AtqResInfo.Pupi;
+            uid_len = PHHAL_PUPI_LENGTH;
+            break;
+        }
+        case phHal_eFelica_PICC:
+        {
+            *ppUid = psRemoteDevInfo->RemoteDevInfo.Felica_Info.IDm;
+            uid_len = psRemoteDevInfo->RemoteDevInfo.Felica_Info.IDmLength;
+            break;
+        }
+        case phHal_eJewel_PICC:
+        {
+            *ppUid = psRemoteDevInfo->RemoteDevInfo.Jewel_Info.Uid;
+            uid_len = psRemoteDevInfo->RemoteDevInfo.Jewel_Info.UidLength;
+            break;
+        }
+        case phHal_eISO15693_PICC:
+        {
+            *ppUid = psRemoteDevInfo->RemoteDevInfo.Iso15693_Info.Uid;
+            uid_len = psRemoteDevInfo->RemoteDevInfo.Iso15693_Info.UidLength;
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+    if(uid_len > PHHAL_MAX_UID_LENGTH)
+    {
+        uid_len = 0;
+    }
+    return uid_len;
+}
+
+STATIC
+phLibNfc_NdefCacheEntry_t *phLibNfc_Ndef_CacheFind(
+                                phHal_sRemoteDevInformation_t *psRemoteDevInfo)
+{
+    phLibNfc_NdefCacheEntry_t   *ps_entry = NULL;
+    uint8_t                     *p_uid = NULL;
+    uint8_t                     uid_len = 0;
+    uint8_t                     index = 0;
+
+    uid_len = phLibNfc_Ndef_CacheGetUid(psRemoteDevInfo, &p_uid);
+    for (index = 0; (0 != uid_len) && (NULL == ps_entry)
+        && (index < NXP_NDEF_READ_CACHE_ENTRIES); index++)
+    {
+        phLibNfc_NdefCacheEntry_t *ps_cur =
+                                &gpphLibContext->ndef_cntx.sCache[index];
+
+        if((uid_len == ps_cur->UidLength)
+            && (psRemoteDevInfo->RemDevType == ps_cur->RemDevType)
+            && (0 == memcmp(p_uid, ps_cur->Uid, uid_len)))
+        {
+            ps_entry = ps_cur;
+        }
+    }
+    return ps_entry;
+}
+
+STATIC
+void phLibNfc_Ndef_CacheDrop(phLibNfc_NdefCacheEntry_t *psEntry)
+{
+    if(NULL != psEntry->pNdefMessage)
+    {
+        phOsalNfc_FreeMemory(psEntry->pNdefMessage);
+    }
+    if(psEntry == gpphLibContext->ndef_cntx.psCacheEntry)
+    {
+        gpphLibContext->ndef_cntx.psCacheEntry = NULL;
+        gpphLibContext->ndef_cntx.CacheFromTag = FALSE;
+    }
+    (void)memset(psEntry, 0, sizeof(phLibNfc_NdefCacheEntry_t));
+}
+
+STATIC
+void phLibNfc_Ndef_CacheInvalidate(void)
+{
+    phLibNfc_NdefCacheEntry_t   *ps_entry = NULL;
+
+    ps_entry = phLibNfc_Ndef_CacheFind((phHal_sRemoteDevInformation_t *)
+                                    gpphLibContext->Connected_handle);
+    if(NULL != ps_entry)
+    {
+        gpphLibContext->ndef_cntx.sCacheStats.nInvalidations++;
+        phLibNfc_Ndef_CacheDrop(ps_entry);
+    }
+    gpphLibContext->ndef_cntx.psCacheEntry = NULL;
+    gpphLibContext->ndef_cntx.CacheServed = FALSE;
+    gpphLibContext->ndef_cntx.CacheFromTag = FALSE;
+}
+
+STATIC
+void phLibNfc_Ndef_CacheProbe(void)
+{
+    phLibNfc_NdefInfo_t         *ps_ndef = &gpphLibContext->ndef_cntx;
+    phLibNfc_NdefCacheEntry_t   *ps_entry = NULL;
+
+    ps_ndef->psCacheEntry = NULL;
+    ps_ndef->CacheServed = FALSE;
+    ps_ndef->CacheFromTag = FALSE;
+    ps_entry = phLibNfc_Ndef_CacheFind((phHal_sRemoteDevInformation_t *)
+                                    gpphLibContext->Connected_handle);
+    if(NULL != ps_entry)
+    {
+        /* The Check NDEF reads the capability container, the NDEF
+           length and the block holding the start of the message, any
+           change of them means that the message was modified outside
+           this device */
+        if((ps_entry->NdefLength == ps_ndef->NdefLength)
+            && (ps_entry->NdefActualSize == ps_ndef->NdefActualSize)
+            && (ps_entry->CardState == ps_ndef->psNdefMap->CardState)
+            && (ps_entry->ChkPrintLength == ps_ndef->ChkPrintLength)
+            && (0 == memcmp(ps_entry->ChkPrint, ps_ndef->ChkPrint,
+                            ps_ndef->ChkPrintLength)))
+        {
+            ps_ndef->psCacheEntry = ps_entry;
+        }
+        else
+        {
+            ps_ndef->sCacheStats.nInvalidations++;
+            phLibNfc_Ndef_CacheDrop(ps_entry);
+        }
+    }
+}
+
+STATIC
+uint8_t phLibNfc_Ndef_CacheRead(phNfc_sData_t           *psRd,
+                                phLibNfc_Ndef_EOffset_t Offset,
+                                NFCSTATUS               *pStatus)
+{
+    phLibNfc_NdefInfo_t         *ps_ndef = &gpphLibContext->ndef_cntx;
+    phLibNfc_NdefCacheEntry_t   *ps_entry = ps_ndef->psCacheEntry;
+    uint8_t                     served = FALSE;
+
+    if(phLibNfc_Ndef_EBegin == Offset)
+    {
+        ps_ndef->sCacheStats.nLookups++;
+        if((NULL != ps_entry)
+            && (psRd->length >= ps_entry->NdefActualSize)
+            && (TRUE == phLibNfc_Ndef_CacheCheck(ps_entry)))
+        {
+            if((0x00 == ps_ndef->NdefReadTimerId)
+                || (PH_OSALNFC_INVALID_TIMER_ID == ps_ndef->NdefReadTimerId))
+            {
+                ps_ndef->NdefReadTimerId = phOsalNfc_Timer_Create();
+            }
+            if((0x00 == ps_ndef->NdefReadTimerId)
+                || (PH_OSALNFC_INVALID_TIMER_ID == ps_ndef->NdefReadTimerId))
+            {
+                /* Read the message from the Tag */
+                ps_entry = NULL;
+            }
+        }
+        else
+        {
+            ps_entry = NULL;
+        }
+        if(NULL != ps_entry)
+        {
+            (void)memcpy(psRd->buffer, ps_entry->pNdefMessage,
+                        ps_entry->NdefActualSize);
+            psRd->length = ps_entry->NdefActualSize;
+            ps_entry->LastUse = ++ps_ndef->CacheTick;
+
+            ps_ndef->sCacheStats.nHits++;
+            ps_ndef->sCacheStats.nBytesServed += ps_entry->NdefActualSize;
+            ps_ndef->sCacheStats.nTransceivesSaved += ps_entry->TransceiveCount;
+            ps_ndef->sReadStats.nTransceives = 0;
+            ps_ndef->sReadStats.nAuths = 0;
+            ps_ndef->sReadStats.nAuthsSkipped = 0;
+            ps_ndef->sReadStats.nBytesRead = ps_entry->NdefActualSize;
+            ps_ndef->sReadStats.nTotalReads++;
+            phOsalNfc_Timer_Start(ps_ndef->NdefReadTimerId, 0,
+                            phLibNfc_Ndef_CacheRead_timer_cb, NULL);
+            *pStatus = NFCSTATUS_PENDING;
+            served = TRUE;
+        }
+        else
+        {
+            ps_ndef->sCacheStats.nMisses++;
+        }
+    }
+    else if(TRUE == ps_ndef->CacheServed)
+    {
+        /* The whole message was given by the previous read, the end of
+           the container is reached as for a read from the Tag */
+        *pStatus = NFCSTATUS_FAILED;
+        served = TRUE;
+    }
+    else
+    {
+        /* Continue the read from the Tag */
+    }
+    ps_ndef->CacheServed = served;
+    return served;
+}
+
+STATIC
+void phLibNfc_Ndef_CacheStore(void)
+{
+    phLibNfc_NdefInfo_t             *ps_ndef = &gpphLibContext->ndef_cntx;
+    phHal_sRemoteDevInformation_t   *ps_rem_dev_info = NULL;
+    phLibNfc_NdefCacheEntry_t       *ps_entry = NULL;
+    uint8_t                         *p_uid = NULL;
+    uint8_t                         uid_len = 0;
+    uint8_t                         index = 0;
+
+    ps_rem_dev_info = (phHal_sRemoteDevInformation_t *)
+                                    gpphLibContext->Connected_handle;
+    /* Only a complete message read from the beginning is kept */
+    if((TRUE == ps_ndef->CacheFill)
+        && (0 != ps_ndef->ChkPrintLength)
+        && (0 != ps_ndef->NdefActualSize)
+        && (ps_ndef->NdefActualSize <= NXP_NDEF_READ_CACHE_MAX_LEN)
+        && (ps_ndef->psUpperNdefMsg->length == ps_ndef->NdefActualSize))
+    {
+        uid_len = phLibNfc_Ndef_CacheGetUid(ps_rem_dev_info, &p_uid);
+    }
+    if(0 != uid_len)
+    {
+        ps_entry = phLibNfc_Ndef_CacheFind(ps_rem_dev_info);
+        if(NULL == ps_entry)
+        {
+            /* Take a free entry, or the least recently used one */
+            ps_entry = &ps_ndef->sCache[0];
+            for (index = 1; index < NXP_NDEF_READ_CACHE_ENTRIES; index++)
+            {
+                if(ps_ndef->sCache[index].LastUse < ps_entry->LastUse)
+                {
+                    ps_entry = &ps_ndef->sCache[index];
+                }
+            }
+        }
+        phLibNfc_Ndef_CacheDrop(ps_entry);
+        ps_entry->pNdefMessage = (uint8_t *)
+                        phOsalNfc_GetMemory(ps_ndef->NdefActualSize);
+        if(NULL != ps_entry->pNdefMessage)
+        {
+            (void)memcpy(ps_entry->pNdefMessage,
+                        ps_ndef->psUpperNdefMsg->buffer,
+                        ps_ndef->NdefActualSize);
+            (void)memcpy(ps_entry->Uid, p_uid, uid_len);
+            ps_entry->UidLength = uid_len;
+            ps_entry->RemDevType = ps_rem_dev_info->RemDevType;
+            ps_entry->CardState = ps_ndef->psNdefMap->CardState;
+            ps_entry->NdefLength = ps_ndef->NdefLength;
+            ps_entry->NdefActualSize = ps_ndef->NdefActualSize;
+            (void)memcpy(ps_entry->ChkPrint, ps_ndef->ChkPrint,
+                        ps_ndef->ChkPrintLength);
+            ps_entry->ChkPrintLength = ps_ndef->ChkPrintLength;
+            ps_entry->MessageCrc = phLibNfc_Ndef_CacheCrc(ps_entry->pNdefMessage,
+                                                    ps_entry->NdefActualSize);
+            ps_entry->TransceiveCount = (gpphLibContext->psOverHalCtxt->TransceiveCount
+                                            - ps_ndef->RdTrcvStart);
+            ps_entry->LastUse = ++ps_ndef->CacheTick;
+            ps_ndef->psCacheEntry = ps_entry;
+            ps_ndef->CacheFromTag = TRUE;
+        }
+    }
+    ps_ndef->CacheFill = FALSE;
+}
+
+STATIC
+uint16_t phLibNfc_Ndef_CacheCrc(uint8_t     *pData,
+                                uint32_t    Length)
+{
+    /* CRC-16/CCITT, initial value 0xFFFF */
+    uint16_t    crc = 0xFFFFU;
+    uint32_t    index = 0;
+    uint8_t     bit = 0;
+
+    for (index = 0; index < Length; index++)
+    {
+        crc = (uint16_t)(crc ^ ((uint16_t)pData[index] << 8));
+        for (bit = 0; bit < 8; bit++)
+        {
+            crc = (uint16_t)((0 != (crc & 0x8000U))?
+                            (uint16_t)((crc << 1) ^ 0x1021U) :
+                            (uint16_t)(crc << 1));
+        }
+    }
+    return crc;
+}
+
+STATIC
+uint8_t phLibNfc_Ndef_CacheCheck(phLibNfc_NdefCacheEntry_t *psEntry)
+{
+    uint8_t     valid = TRUE;
+
+    if(psEntry->MessageCrc != phLibNfc_Ndef_CacheCrc(psEntry->pNdefMessage,
+                                                psEntry->NdefActualSize))
+    {
+        gpphLibContext->ndef_cntx.sCacheStats.nInvalidations++;
+        phLibNfc_Ndef_CacheDrop(psEntry);
+        valid = FALSE;
+    }
+    return valid;
+}
+
+STATIC
+void phLibNfc_Ndef_CacheRead_timer_cb(uint32_t timer_id, void *pContext)
+{
+    NFCSTATUS               RetStatus = NFCSTATUS_SUCCESS;
+    pphLibNfc_RspCb_t       pClientCb = NULL;
+    void                    *pUpperLayerContext = NULL;
+
+    PHNFC_UNUSED_VARIABLE(pContext);
+    phOsalNfc_Timer_Stop(timer_id);
+    phOsalNfc_Timer_Delete(gpphLibContext->ndef_cntx.NdefReadTimerId);
+    gpphLibContext->ndef_cntx.NdefReadTimerId = 0x00;
+
+    if(eLibNfcHalStateShutdown == gpphLibContext->LibNfcState.next_state)
+    {   /*shutdown called before completion of Ndef read allow
+          shutdown to happen */
+        phLibNfc_Pending_Shutdown();
+        RetStatus = NFCSTATUS_SHUTDOWN;
+    }
+    else if(eLibNfcHalStateRelease == gpphLibContext->LibNfcState.next_state)
+    {
+        RetStatus = NFCSTATUS_ABORTED;
+    }
+    else
+    {
+        gpphLibContext->status.GenCb_pending_status = FALSE;
+        gpphLibContext->LastTrancvSuccess = TRUE;
+    }
+    /*update the current state as connected*/
+    phLibNfc_UpdateCurState(NFCSTATUS_SUCCESS,gpphLibContext);
+
+    pClientCb = gpphLibContext->CBInfo.pClientRdNdefCb;
+    pUpperLayerContext = gpphLibContext->CBInfo.pClientRdNdefCntx;
+    gpphLibContext->CBInfo.pClientRdNdefCb = NULL;
+    gpphLibContext->CBInfo.pClientRdNdefCntx = NULL;
+    if (NULL != pClientCb)
+    {
+        /*Notify to upper layer status and read bytes*/
+        pClientCb(pUpperLayerContext,RetStatus);
+    }
+}
+
+#endif /* #ifdef NXP_NDEF_READ_CACHE */
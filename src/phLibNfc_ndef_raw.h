@@ -69,6 +69,7 @@ typedef enum phLibNfc_Last_Call{
 
 extern void phLibNfc_Ndef_Init(void);
 extern void phLibNfc_Ndef_DeInit(void);
+extern void phLibNfc_Ndef_ResetAuth(void);
 extern phLibNfc_Ndef_Info_t NdefInfo;
 extern phFriNfc_NdefRecord_t *pNdefRecord;
 
@@ -207,5 +207,16 @@ void   phOsalNfc_FreeMemory(void * pMem);
  */
 int phOsalNfc_MemCompare(void *src, void *dest, unsigned int n);
 
+/*!
+ * \ingroup grp_osal_nfc
+ * \brief Provides a monotonic time reference, used to measure the
+ * duration of the operations in the stack.
+ *
+ * \retval Time elapsed in milliseconds since an arbitrary origin,
+ *         the value wraps around on overflow.
+ *
+ */
+uint32_t phOsalNfc_GetTime(void);
+
 #endif
 #endif /*  PHOSALNFC_H  */
@@ -0,0 +1,164 @@
+LOCAL_PATH:= $(call my-dir)
+
+#
+# nfc_ndef_benchmark: timings of the NDEF record encoding and decoding,
+# written to the standard output as JSON lines
+#
+
+include $(CLEAR_VARS)
+
+LOCAL_SRC_FILES := ndef/phFriNfc_NdefRecord_Bench.c
+
+LOCAL_CFLAGS += -I$(LOCAL_PATH)/../inc
+LOCAL_CFLAGS += -I$(LOCAL_PATH)/../src
+
+LOCAL_STATIC_LIBRARIES := libnfc_ndef
+LOCAL_LDLIBS += -lrt
+
+LOCAL_MODULE:= nfc_ndef_benchmark
+LOCAL_MODULE_TAGS := optional
+
+include $(BUILD_HOST_EXECUTABLE)
+
+#
+# nfc_ndef_fuzzer: libFuzzer target of the NDEF record decoding, run with
+# tests/ndef/corpus as seed corpus
+#
+
+include $(CLEAR_VARS)
+
+# The record code is built into the target so that it is instrumented too
+LOCAL_SRC_FILES := ndef/phFriNfc_NdefRecord_Fuzzer.c
+LOCAL_SRC_FILES += ../src/phFriNfc_NdefRecord.c
+
+LOCAL_CFLAGS += -I$(LOCAL_PATH)/../inc
+LOCAL_CFLAGS += -I$(LOCAL_PATH)/../src
+
+LOCAL_SANITIZE := address undefined
+
+LOCAL_MODULE:= nfc_ndef_fuzzer
+LOCAL_MODULE_TAGS := optional
+
+include $(BUILD_HOST_FUZZ_TEST)
+
+#
+# nfc_llcp_fifo_test: randomised test of the LLCP cyclic FIFO, with timings
+# of 1 KB and 2 KB transfers (-b) written as JSON lines
+#
+
+include $(CLEAR_VARS)
+
+LOCAL_SRC_FILES := llcp/phFriNfc_LlcpUtils_FifoTest.c
+LOCAL_SRC_FILES += ../src/phFriNfc_LlcpUtils.c
+
+LOCAL_CFLAGS += -I$(LOCAL_PATH)/../inc
+LOCAL_CFLAGS += -I$(LOCAL_PATH)/../src
+LOCAL_CFLAGS += -I$(LOCAL_PATH)/../Linux_x86
+LOCAL_CFLAGS += -DNXP_MESSAGING -DANDROID
+
+LOCAL_LDLIBS += -lrt
+
+LOCAL_MODULE:= nfc_llcp_fifo_test
+LOCAL_MODULE_TAGS := optional
+
+include $(BUILD_HOST_EXECUTABLE)
+
+#
+# nfc_llcp_loopback_benchmark: two LLCP stacks linked by the loopback MAC
+# on a simulated clock; link activation, service discovery, connection and
+# throughput figures written as JSON lines
+#
+
+include $(CLEAR_VARS)
+
+LOCAL_SRC_FILES := llcp/phFriNfc_LlcpLoopback_Bench.c
+LOCAL_SRC_FILES += llcp/phOsalNfc_Sim.c
+LOCAL_SRC_FILES += ../src/phFriNfc_Llcp.c
+LOCAL_SRC_FILES += ../src/phFriNfc_LlcpUtils.c
+LOCAL_SRC_FILES += ../src/phFriNfc_LlcpMac.c
+LOCAL_SRC_FILES += ../src/phFriNfc_LlcpMacLoopback.c
+LOCAL_SRC_FILES += ../src/phFriNfc_LlcpTransport.c
+LOCAL_SRC_FILES += ../src/phFriNfc_LlcpTransport_Connectionless.c
+LOCAL_SRC_FILES += ../src/phFriNfc_LlcpTransport_Connection.c
+
+LOCAL_CFLAGS += -I$(LOCAL_PATH)/../inc
+LOCAL_CFLAGS += -I$(LOCAL_PATH)/../src
+LOCAL_CFLAGS += -I$(LOCAL_PATH)/../Linux_x86
+LOCAL_CFLAGS += -DNXP_MESSAGING -DANDROID
+# Uncomment to measure the PDU aggregation of NXP_LLCP_AGF_SEND
+#LOCAL_CFLAGS += -DNXP_LLCP_AGF_SEND
+
+LOCAL_LDLIBS += -lrt -lpthread
+
+LOCAL_MODULE:= nfc_llcp_loopback_benchmark
+LOCAL_MODULE_TAGS := optional
+
+include $(BUILD_HOST_EXECUTABLE)
+
+#
+# nfc_hci_dispatch_test: routing of the received HCP Messages to the Gate
+# handlers of every pipe, with timings of the dispatch (-b) written as JSON
+# lines
+#
+
+include $(CLEAR_VARS)
+
+LOCAL_SRC_FILES := hci/phHciNfc_Dispatch_Test.c
+LOCAL_SRC_FILES += llcp/phOsalNfc_Sim.c
+LOCAL_SRC_FILES += ../src/phHciNfc.c
+LOCAL_SRC_FILES += ../src/phHciNfc_AdminMgmt.c
+LOCAL_SRC_FILES += ../src/phHciNfc_CE_A.c
+LOCAL_SRC_FILES += ../src/phHciNfc_CE_B.c
+LOCAL_SRC_FILES += ../src/phHciNfc_DevMgmt.c
+LOCAL_SRC_FILES += ../src/phHciNfc_Emulation.c
+LOCAL_SRC_FILES += ../src/phHciNfc_Felica.c
+LOCAL_SRC_FILES += ../src/phHciNfc_Generic.c
+LOCAL_SRC_FILES += ../src/phHciNfc_IDMgmt.c
+LOCAL_SRC_FILES += ../src/phHciNfc_ISO15693.c
+LOCAL_SRC_FILES += ../src/phHciNfc_Jewel.c
+LOCAL_SRC_FILES += ../src/phHciNfc_LinkMgmt.c
+LOCAL_SRC_FILES += ../src/phHciNfc_NfcIPMgmt.c
+LOCAL_SRC_FILES += ../src/phHciNfc_Pipe.c
+LOCAL_SRC_FILES += ../src/phHciNfc_PollingLoop.c
+LOCAL_SRC_FILES += ../src/phHciNfc_RFReader.c
+LOCAL_SRC_FILES += ../src/phHciNfc_RFReaderA.c
+LOCAL_SRC_FILES += ../src/phHciNfc_RFReaderB.c
+LOCAL_SRC_FILES += ../src/phHciNfc_SWP.c
+LOCAL_SRC_FILES += ../src/phHciNfc_Sequence.c
+LOCAL_SRC_FILES += ../src/phHciNfc_WI.c
+
+LOCAL_CFLAGS += -I$(LOCAL_PATH)/../inc
+LOCAL_CFLAGS += -I$(LOCAL_PATH)/../src
+LOCAL_CFLAGS += -I$(LOCAL_PATH)/../Linux_x86
+LOCAL_CFLAGS += -DNXP_MESSAGING -DANDROID
+
+LOCAL_LDLIBS += -lrt
+
+LOCAL_MODULE:= nfc_hci_dispatch_test
+LOCAL_MODULE_TAGS := optional
+
+include $(BUILD_HOST_EXECUTABLE)
+
+#
+# nfc_hal_poll_profile_test: polling loop durations and reader technologies
+# written to the HCI by each polling profile, and by the adaptive one on
+# every discovery resume
+#
+
+include $(CLEAR_VARS)
+
+LOCAL_SRC_FILES := hal/phHal4Nfc_PollProfile_Test.c
+LOCAL_SRC_FILES += llcp/phOsalNfc_Sim.c
+LOCAL_SRC_FILES += ../src/phHal4Nfc_ADD.c
+
+LOCAL_CFLAGS += -I$(LOCAL_PATH)/../inc
+LOCAL_CFLAGS += -I$(LOCAL_PATH)/../src
+LOCAL_CFLAGS += -I$(LOCAL_PATH)/../Linux_x86
+LOCAL_CFLAGS += -DNXP_MESSAGING -DANDROID
+
+LOCAL_LDLIBS += -lrt
+
+LOCAL_MODULE:= nfc_hal_poll_profile_test
+LOCAL_MODULE_TAGS := optional
+
+include $(BUILD_HOST_EXECUTABLE)
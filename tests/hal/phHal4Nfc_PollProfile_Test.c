@@ -0,0 +1,373 @@
+/*
+ * Copyright (C) 2010 NXP Semiconductors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*!
+ * \file  phHal4Nfc_PollProfile_Test.c
+ * \brief Host test of the polling profiles of the HAL4 discovery.
+ *
+ * phHal4Nfc_ADD.c runs over the simulated OSAL of phOsalNfc_Sim.h, with the
+ * HCI calls replaced by probes which record the ADD configuration written
+ * (phHciNfc_Config_Discovery) and the restarts of the discovery wheel
+ * (phHciNfc_Restart_Discovery), and complete them at once.
+ *
+ * For each profile, the test checks the polling loop duration and the reader
+ * technologies written on NFC_DISCOVERY_CONFIG. For the adaptive profile, it
+ * then checks on each NFC_DISCOVERY_RESUME that the duration follows the
+ * detections: the short loop is written after a detection, the wheel is only
+ * restarted while the duration is unchanged, and the long loop is written
+ * back once the idle time has elapsed without a detection.
+ *
+ * Usage: nfc_hal_poll_profile_test
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <phNfcTypes.h>
+#include <phNfcConfig.h>
+#include <phNfcInterface.h>
+#include <phNfcHalTypes.h>
+#include <phHal4Nfc.h>
+#include <phHal4Nfc_Internal.h>
+#include <phOsalNfc.h>
+#include <phOsalNfc_Timer.h>
+
+#include "../llcp/phOsalNfc_Sim.h"
+
+#define POLL_TEST_CUSTOM_DURATION   120000U
+
+typedef struct poll_test_hci
+{
+    uint32_t                        nConfigs;
+    uint32_t                        nRestarts;
+    phHal_sADD_Cfg_t                sLastConfig;
+
+}poll_test_hci_t;
+
+phHal_sHwReference_t                *gpphHal4Nfc_Hwref;
+
+static poll_test_hci_t              gHci;
+static phHal4Nfc_Hal4Ctxt_t         gHal4Ctxt;
+static phHal_sHwReference_t         gHwRef;
+static uint32_t                     gConfigDone;
+static int                          gFailures;
+
+#define POLL_TEST_CHECK(cond)                                               \
+    do                                                                      \
+    {                                                                       \
+        if(!(cond))                                                         \
+        {                                                                   \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            gFailures++;                                                    \
+        }                                                                   \
+    }while(0)
+
+/* HCI and HAL4 entry points used by phHal4Nfc_ADD.c */
+NFCSTATUS
+phHciNfc_Config_Discovery(
+                void                    *psHciHandle,
+                void                    *pHwRef,
+                phHal_sADD_Cfg_t        *pPollConfig
+                         )
+{
+    PHNFC_UNUSED_VARIABLE(psHciHandle);
+    PHNFC_UNUSED_VARIABLE(pHwRef);
+    gHci.nConfigs++;
+    (void)memcpy(&gHci.sLastConfig, pPollConfig, sizeof(gHci.sLastConfig));
+    return NFCSTATUS_PENDING;
+}
+
+NFCSTATUS
+phHciNfc_Restart_Discovery(
+                void                    *psHciHandle,
+                void                    *pHwRef,
+                uint8_t                 repoll
+                          )
+{
+    PHNFC_UNUSED_VARIABLE(psHciHandle);
+    PHNFC_UNUSED_VARIABLE(pHwRef);
+    PHNFC_UNUSED_VARIABLE(repoll);
+    gHci.nRestarts++;
+    return NFCSTATUS_PENDING;
+}
+
+NFCSTATUS
+phHciNfc_Configure(
+                void                    *psHciHandle,
+                void                    *pHwRef,
+                phHal_eConfigType_t     config_type,
+                phHal_uConfig_t         *pConfig
+                  )
+{
+    PHNFC_UNUSED_VARIABLE(psHciHandle);
+    PHNFC_UNUSED_VARIABLE(pHwRef);
+    PHNFC_UNUSED_VARIABLE(config_type);
+    PHNFC_UNUSED_VARIABLE(pConfig);
+    return NFCSTATUS_FAILED;
+}
+
+NFCSTATUS
+phHciNfc_Select_Next_Target(
+                void                    *psHciHandle,
+                void                    *pHwRef
+                           )
+{
+    PHNFC_UNUSED_VARIABLE(psHciHandle);
+    PHNFC_UNUSED_VARIABLE(pHwRef);
+    return NFCSTATUS_FAILED;
+}
+
+void
+phHal4Nfc_DisconnectComplete(
+                phHal4Nfc_Hal4Ctxt_t    *Hal4Ctxt,
+                void                    *pInfo
+                            )
+{
+    PHNFC_UNUSED_VARIABLE(Hal4Ctxt);
+    PHNFC_UNUSED_VARIABLE(pInfo);
+}
+
+void
+phOsalNfc_RaiseException(
+                phOsalNfc_ExceptionType_t   eExceptionType,
+                uint16_t                    reason
+                        )
+{
+    PHNFC_UNUSED_VARIABLE(eExceptionType);
+    PHNFC_UNUSED_VARIABLE(reason);
+}
+
+static
+void
+poll_test_config_cb(
+                void                    *pContext,
+                NFCSTATUS               status
+                   )
+{
+    PHNFC_UNUSED_VARIABLE(pContext);
+    PHNFC_UNUSED_VARIABLE(status);
+    gConfigDone++;
+}
+
+static
+void
+poll_test_timer_cb(
+                uint32_t                TimerId,
+                void                    *pContext
+                  )
+{
+    PHNFC_UNUSED_VARIABLE(TimerId);
+    PHNFC_UNUSED_VARIABLE(pContext);
+}
+
+/* Lets the simulated clock run for nTime ms */
+static
+void
+poll_test_wait(
+                uint32_t                nTime
+              )
+{
+    uint32_t            id = phOsalNfc_Timer_Create();
+
+    phOsalNfc_Timer_Start(id, nTime, poll_test_timer_cb, NULL);
+    (void)phOsalNfc_Sim_Step();
+    phOsalNfc_Timer_Delete(id);
+}
+
+static
+void
+poll_test_reset(void)
+{
+    phOsalNfc_Sim_Reset();
+    if(NULL != gHal4Ctxt.psADDCtxtInfo)
+    {
+        phOsalNfc_FreeMemory(gHal4Ctxt.psADDCtxtInfo);
+    }
+    (void)memset(&gHal4Ctxt, 0, sizeof(gHal4Ctxt));
+    (void)memset(&gHwRef, 0, sizeof(gHwRef));
+    (void)memset(&gHci, 0, sizeof(gHci));
+    gHal4Ctxt.Hal4CurrentState = eHal4StateOpenAndReady;
+    gHal4Ctxt.Hal4NextState = eHal4StateInvalid;
+    gHwRef.hal_context = &gHal4Ctxt;
+    gpphHal4Nfc_Hwref = &gHwRef;
+}
+
+/* Issues a discovery request and completes it as the HCI would */
+static
+NFCSTATUS
+poll_test_discovery(
+                phHal_eDiscoveryConfigMode_t eMode,
+                phHal_sADD_Cfg_t            *psADDCfg
+                   )
+{
+    phNfc_sCompletionInfo_t     sInfo;
+    uint32_t                    nDone = gConfigDone;
+    NFCSTATUS                   status = NFCSTATUS_SUCCESS;
+
+    status = phHal4Nfc_ConfigureDiscovery(&gHwRef, eMode, psADDCfg,
+                                          poll_test_config_cb, NULL);
+    if(NFCSTATUS_PENDING != status)
+    {
+        return status;
+    }
+    (void)memset(&sInfo, 0, sizeof(sInfo));
+    sInfo.status = NFCSTATUS_SUCCESS;
+    phHal4Nfc_ConfigureComplete(&gHal4Ctxt, &sInfo,
+                                (NFC_DISCOVERY_CONFIG == eMode)?
+                                NFC_NOTIFY_POLL_ENABLED:
+                                NFC_NOTIFY_POLL_RESTARTED);
+    return ((nDone + 1) == gConfigDone)? NFCSTATUS_SUCCESS: NFCSTATUS_FAILED;
+}
+
+static
+void
+poll_test_all_readers(
+                phHal_sADD_Cfg_t        *psADDCfg
+                     )
+{
+    (void)memset(psADDCfg, 0, sizeof(*psADDCfg));
+    psADDCfg->PollDevInfo.PollCfgInfo.EnableIso14443A = TRUE;
+    psADDCfg->PollDevInfo.PollCfgInfo.EnableIso14443B = TRUE;
+    psADDCfg->PollDevInfo.PollCfgInfo.EnableFelica212 = TRUE;
+    psADDCfg->PollDevInfo.PollCfgInfo.EnableFelica424 = TRUE;
+    psADDCfg->PollDevInfo.PollCfgInfo.EnableIso15693 = TRUE;
+    psADDCfg->Duration = POLL_TEST_CUSTOM_DURATION;
+}
+
+static
+void
+poll_test_fixed_profiles(void)
+{
+    phHal_sADD_Cfg_t    sADDCfg;
+
+    /* Fast tap: short loop, ISO 14443 only */
+    poll_test_reset();
+    POLL_TEST_CHECK(NFCSTATUS_SUCCESS
+            == phHal4Nfc_SetPollProfile(&gHwRef, eHal4PollProfileFastTap));
+    poll_test_all_readers(&sADDCfg);
+    POLL_TEST_CHECK(NFCSTATUS_SUCCESS
+            == poll_test_discovery(NFC_DISCOVERY_CONFIG, &sADDCfg));
+    POLL_TEST_CHECK(NXP_POLL_FAST_TAP_DURATION == gHci.sLastConfig.Duration);
+    POLL_TEST_CHECK(gHci.sLastConfig.PollDevInfo.PollCfgInfo.EnableIso14443A);
+    POLL_TEST_CHECK(!gHci.sLastConfig.PollDevInfo.PollCfgInfo.EnableFelica212);
+    POLL_TEST_CHECK(!gHci.sLastConfig.PollDevInfo.PollCfgInfo.EnableIso15693);
+    POLL_TEST_CHECK(!gHal4Ctxt.psADDCtxtInfo->sCurrentPollConfig.EnableFelica424);
+    /* The duration of a fixed profile never changes on resume */
+    phHal4Nfc_PollProfileStop(gHal4Ctxt.psADDCtxtInfo, TRUE);
+    POLL_TEST_CHECK(NFCSTATUS_SUCCESS
+            == poll_test_discovery(NFC_DISCOVERY_RESUME, &sADDCfg));
+    POLL_TEST_CHECK((1 == gHci.nConfigs) && (1 == gHci.nRestarts));
+
+    /* Full sweep: every reader technology */
+    poll_test_reset();
+    POLL_TEST_CHECK(NFCSTATUS_SUCCESS
+            == phHal4Nfc_SetPollProfile(&gHwRef, eHal4PollProfileFullSweep));
+    poll_test_all_readers(&sADDCfg);
+    sADDCfg.PollDevInfo.PollCfgInfo.EnableIso15693 = FALSE;
+    POLL_TEST_CHECK(NFCSTATUS_SUCCESS
+            == poll_test_discovery(NFC_DISCOVERY_CONFIG, &sADDCfg));
+    POLL_TEST_CHECK(NXP_POLL_FULL_SWEEP_DURATION == gHci.sLastConfig.Duration);
+    POLL_TEST_CHECK(gHci.sLastConfig.PollDevInfo.PollCfgInfo.EnableIso15693);
+
+    /* Low power: long loop, readers as requested */
+    poll_test_reset();
+    POLL_TEST_CHECK(NFCSTATUS_SUCCESS
+            == phHal4Nfc_SetPollProfile(&gHwRef, eHal4PollProfileLowPower));
+    poll_test_all_readers(&sADDCfg);
+    sADDCfg.PollDevInfo.PollCfgInfo.EnableFelica212 = FALSE;
+    POLL_TEST_CHECK(NFCSTATUS_SUCCESS
+            == poll_test_discovery(NFC_DISCOVERY_CONFIG, &sADDCfg));
+    POLL_TEST_CHECK(NXP_POLL_LOW_POWER_DURATION == gHci.sLastConfig.Duration);
+    POLL_TEST_CHECK(!gHci.sLastConfig.PollDevInfo.PollCfgInfo.EnableFelica212);
+
+    /* Custom: the configuration of the upper layer as is */
+    poll_test_reset();
+    poll_test_all_readers(&sADDCfg);
+    POLL_TEST_CHECK(NFCSTATUS_SUCCESS
+            == poll_test_discovery(NFC_DISCOVERY_CONFIG, &sADDCfg));
+    POLL_TEST_CHECK(POLL_TEST_CUSTOM_DURATION == gHci.sLastConfig.Duration);
+    POLL_TEST_CHECK(gHci.sLastConfig.PollDevInfo.PollCfgInfo.EnableFelica424);
+}
+
+static
+void
+poll_test_adaptive_profile(void)
+{
+    phHal4Nfc_PollProfileStats_t    sStats;
+    phHal_sADD_Cfg_t                sADDCfg;
+
+    poll_test_reset();
+    POLL_TEST_CHECK(NFCSTATUS_SUCCESS
+            == phHal4Nfc_SetPollProfile(&gHwRef, eHal4PollProfileAdaptive));
+    poll_test_all_readers(&sADDCfg);
+
+    /* Nothing detected yet: long loop */
+    poll_test_wait(1000);
+    POLL_TEST_CHECK(NFCSTATUS_SUCCESS
+            == poll_test_discovery(NFC_DISCOVERY_CONFIG, &sADDCfg));
+    POLL_TEST_CHECK(1 == gHci.nConfigs);
+    POLL_TEST_CHECK(NXP_POLL_LOW_POWER_DURATION == gHci.sLastConfig.Duration);
+
+    /* A detection tightens the loop, written on the resume */
+    poll_test_wait(2000);
+    phHal4Nfc_PollProfileStop(gHal4Ctxt.psADDCtxtInfo, TRUE);
+    POLL_TEST_CHECK(NXP_POLL_FAST_TAP_DURATION
+            == gHal4Ctxt.psADDCtxtInfo->sADDCfg.Duration);
+    POLL_TEST_CHECK(NFCSTATUS_SUCCESS
+            == poll_test_discovery(NFC_DISCOVERY_RESUME, &sADDCfg));
+    POLL_TEST_CHECK((2 == gHci.nConfigs) && (0 == gHci.nRestarts));
+    POLL_TEST_CHECK(NXP_POLL_FAST_TAP_DURATION == gHci.sLastConfig.Duration);
+
+    /* Detections within the idle time: the wheel is only restarted */
+    poll_test_wait(NXP_POLL_ADAPTIVE_IDLE_TIME / 2);
+    phHal4Nfc_PollProfileStop(gHal4Ctxt.psADDCtxtInfo, TRUE);
+    POLL_TEST_CHECK(NFCSTATUS_SUCCESS
+            == poll_test_discovery(NFC_DISCOVERY_RESUME, &sADDCfg));
+    POLL_TEST_CHECK((2 == gHci.nConfigs) && (1 == gHci.nRestarts));
+
+    /* Idle for longer: back to the long loop */
+    poll_test_wait(NXP_POLL_ADAPTIVE_IDLE_TIME);
+    phHal4Nfc_PollProfileStop(gHal4Ctxt.psADDCtxtInfo, FALSE);
+    POLL_TEST_CHECK(NFCSTATUS_SUCCESS
+            == poll_test_discovery(NFC_DISCOVERY_RESUME, &sADDCfg));
+    POLL_TEST_CHECK((3 == gHci.nConfigs) && (1 == gHci.nRestarts));
+    POLL_TEST_CHECK(NXP_POLL_LOW_POWER_DURATION == gHci.sLastConfig.Duration);
+    /* The readers requested are kept by the reconfiguration */
+    POLL_TEST_CHECK(gHci.sLastConfig.PollDevInfo.PollCfgInfo.EnableFelica424);
+
+    POLL_TEST_CHECK(NFCSTATUS_SUCCESS
+            == phHal4Nfc_GetPollProfileStats(&gHwRef, eHal4PollProfileAdaptive,
+                                             &sStats));
+    POLL_TEST_CHECK(2 == sStats.DetectCount);
+    POLL_TEST_CHECK(NXP_POLL_LOW_POWER_DURATION == sStats.Duration);
+}
+
+int
+main(void)
+{
+    poll_test_fixed_profiles();
+    poll_test_adaptive_profile();
+    poll_test_reset();
+
+    if(0 != gFailures)
+    {
+        printf("%d checks failed\n", gFailures);
+        return 1;
+    }
+    printf("poll profiles: all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,597 @@
+/*
+ * Copyright (C) 2010 NXP Semiconductors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*!
+ * \file  phHciNfc_Dispatch_Test.c
+ * \brief Host test and benchmark of the routing of the received HCP Messages.
+ *
+ * The pipe of every Gate is created through phHciNfc_Update_PipeInfo and
+ * stored in the pipe list, as on ADM_NOTIFY_PIPE_CREATED. For each Gate, the
+ * test checks that the Gate lookup (*_Get_PipeID) gives the pipe, and that a
+ * Response, an Event and a Command received on the pipe through
+ * phHciNfc_Receive_Complete reach the handler the Gate registered for the
+ * pipe, and only that one. A Message on a pipe that has no handler for it,
+ * or on a pipe never created, must reach no handler and be counted as
+ * unrouted.
+ *
+ * The handlers registered by the Gates are swapped for probes once checked,
+ * so that the Messages do not run the Gate sequences.
+ *
+ * With -b, the dispatch of an Event through phHciNfc_Receive_Complete
+ * (Dispatch), the lookup of its pipe in the pipe list (PipeLookup) and the
+ * lookup asking the Get_PipeID of each Gate in turn (GateLookup), the chain
+ * the pipe list replaces, are then timed, one JSON object per line:
+ *
+ *  {"bench":"Dispatch","gates":13,"iterations":..,"ns_per_msg":..}
+ *
+ * Usage: nfc_hci_dispatch_test [-b]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <phNfcTypes.h>
+#include <phNfcConfig.h>
+#include <phNfcHalTypes.h>
+#include <phHciNfc_Generic.h>
+#include <phHciNfc_Pipe.h>
+#include <phHciNfc_IDMgmt.h>
+#include <phHciNfc_DevMgmt.h>
+#include <phHciNfc_PollingLoop.h>
+#include <phHciNfc_RFReaderA.h>
+#include <phHciNfc_RFReaderB.h>
+#include <phHciNfc_Felica.h>
+#include <phHciNfc_Jewel.h>
+#include <phHciNfc_ISO15693.h>
+#include <phHciNfc_NfcIPMgmt.h>
+#include <phHciNfc_WI.h>
+#include <phHciNfc_SWP.h>
+#include <phHciNfc_Emulation.h>
+
+#define DISPATCH_RESP               0x01U
+#define DISPATCH_EVENT              0x02U
+#define DISPATCH_CMD                0x04U
+
+/* A pipe on which no pipe is ever created */
+#define DISPATCH_UNKNOWN_PIPE       0x50U
+
+#define DISPATCH_BENCH_TIME_NS      200000000ULL
+
+typedef NFCSTATUS (*pphHciNfc_Gate_Init_t) (
+                                phHciNfc_sContext_t     *psHciContext
+                                );
+
+typedef NFCSTATUS (*pphHciNfc_Gate_Get_PipeID_t) (
+                                phHciNfc_sContext_t     *psHciContext,
+                                uint8_t                 *ppipe_id
+                                );
+
+typedef struct phHciNfc_Dispatch_Gate
+{
+    const char                      *name;
+    phHciNfc_GateID_t               gate_id;
+    /* Handlers the Gate registers on its pipe */
+    uint8_t                         handlers;
+    pphHciNfc_Gate_Init_t           init;
+    pphHciNfc_Gate_Get_PipeID_t     get_pipe_id;
+    uint8_t                         pipe_id;
+    phHciNfc_Pipe_Info_t            *p_pipe_info;
+
+}phHciNfc_Dispatch_Gate_t;
+
+/* Gates in the order of the pipe creation sequence */
+static phHciNfc_Dispatch_Gate_t gGates[] = {
+    { "IDMgmt",     phHciNfc_IdentityMgmtGate,   DISPATCH_RESP,
+      &phHciNfc_IDMgmt_Init_Resources,      &phHciNfc_IDMgmt_Get_PipeID },
+    { "DevMgmt",    phHciNfc_PN544MgmtGate,      DISPATCH_RESP | DISPATCH_EVENT,
+      &phHciNfc_DevMgmt_Init_Resources,     &phHciNfc_DevMgmt_Get_PipeID },
+    { "PollLoop",   phHciNfc_PollingLoopGate,    DISPATCH_RESP | DISPATCH_EVENT,
+      &phHciNfc_PollLoop_Init_Resources,    &phHciNfc_PollLoop_Get_PipeID },
+    { "ReaderA",    phHciNfc_RFReaderAGate,      DISPATCH_RESP | DISPATCH_EVENT,
+      &phHciNfc_ReaderA_Init_Resources,     &phHciNfc_ReaderA_Get_PipeID },
+#ifdef TYPE_B
+    { "ReaderB",    phHciNfc_RFReaderBGate,      DISPATCH_RESP | DISPATCH_EVENT,
+      &phHciNfc_ReaderB_Init_Resources,     &phHciNfc_ReaderB_Get_PipeID },
+#endif
+#ifdef TYPE_FELICA
+    { "Felica",     phHciNfc_RFReaderFGate,      DISPATCH_RESP | DISPATCH_EVENT,
+      &phHciNfc_Felica_Init_Resources,      &phHciNfc_Felica_Get_PipeID },
+#endif
+#ifdef TYPE_JEWEL
+    { "Jewel",      phHciNfc_JewelReaderGate,    DISPATCH_RESP | DISPATCH_EVENT,
+      &phHciNfc_Jewel_Init_Resources,       &phHciNfc_Jewel_Get_PipeID },
+#endif
+#ifdef TYPE_ISO15693
+    { "ISO15693",   phHciNfc_ISO15693Gate,       DISPATCH_RESP | DISPATCH_EVENT,
+      &phHciNfc_ISO15693_Init_Resources,    &phHciNfc_ISO15693_Get_PipeID },
+#endif
+#ifdef ENABLE_P2P
+    { "Initiator",  phHciNfc_NFCIP1InitRFGate,   DISPATCH_RESP | DISPATCH_EVENT,
+      &phHciNfc_Initiator_Init_Resources,   &phHciNfc_Initiator_Get_PipeID },
+    { "Target",     phHciNfc_NFCIP1TargetRFGate, DISPATCH_RESP | DISPATCH_EVENT,
+      &phHciNfc_Target_Init_Resources,      &phHciNfc_Target_Get_PipeID },
+#endif
+    { "WI",         phHciNfc_NfcWIMgmtGate,      DISPATCH_RESP | DISPATCH_EVENT,
+      &phHciNfc_WI_Init_Resources,          &phHciNfc_WI_Get_PipeID },
+    { "SWP",        phHciNfc_SwpMgmtGate,        DISPATCH_RESP | DISPATCH_EVENT,
+      &phHciNfc_SWP_Init_Resources,         &phHciNfc_SWP_Get_PipeID },
+    /* The Connectivity pipe is created by the UICC, on a fixed pipe */
+    { "Uicc",       phHciNfc_ConnectivityGate,   DISPATCH_CMD | DISPATCH_EVENT,
+      NULL,                                 &phHciNfc_Uicc_Get_PipeID },
+};
+
+#define DISPATCH_GATES              (sizeof(gGates) / sizeof(gGates[0]))
+
+static phHciNfc_sContext_t      *gpHciContext;
+static phHal_sHwReference_t     gHwRef;
+
+/* Last Message handed to a probe */
+static uint32_t                 gProbeCalls;
+static uint8_t                  gProbeType;
+static uint8_t                  gProbePipe;
+
+static
+void
+dispatch_probe_record(
+                uint8_t                 msg_type,
+                uint8_t                 *pdata
+                     )
+{
+    gProbeCalls++;
+    gProbeType = msg_type;
+    gProbePipe = (uint8_t)GET_BITS8(pdata[0], HCP_PIPEID_OFFSET,
+                                    HCP_PIPEID_LEN);
+}
+
+/* The probes complete later, so that no sequence is resumed */
+static
+NFCSTATUS
+dispatch_probe_resp(
+                void                    *pContext,
+                void                    *pHwRef,
+                uint8_t                 *pdata,
+#ifdef ONE_BYTE_LEN
+                uint8_t                 length
+#else
+                uint16_t                length
+#endif
+                   )
+{
+    dispatch_probe_record(HCP_MSG_TYPE_RESPONSE, pdata);
+    return NFCSTATUS_PENDING;
+}
+
+static
+NFCSTATUS
+dispatch_probe_event(
+                void                    *pContext,
+                void                    *pHwRef,
+                uint8_t                 *pdata,
+#ifdef ONE_BYTE_LEN
+                uint8_t                 length
+#else
+                uint16_t                length
+#endif
+                    )
+{
+    dispatch_probe_record(HCP_MSG_TYPE_EVENT, pdata);
+    return NFCSTATUS_PENDING;
+}
+
+static
+NFCSTATUS
+dispatch_probe_cmd(
+                void                    *pContext,
+                void                    *pHwRef,
+                uint8_t                 *pdata,
+#ifdef ONE_BYTE_LEN
+                uint8_t                 length
+#else
+                uint16_t                length
+#endif
+                  )
+{
+    dispatch_probe_record(HCP_MSG_TYPE_COMMAND, pdata);
+    return NFCSTATUS_PENDING;
+}
+
+/* Creates the pipes of all the Gates, returns 0 on success */
+static
+int
+dispatch_create_pipes(void)
+{
+    phHciNfc_PipeMgmt_Seq_t     pipe_seq = PIPE_IDMGMT_CREATE;
+    phHciNfc_Dispatch_Gate_t    *psGate = NULL;
+    NFCSTATUS                   status = NFCSTATUS_SUCCESS;
+    uint8_t                     pipe_id = 0;
+    uint32_t                    i = 0;
+
+    gpHciContext = (phHciNfc_sContext_t *)calloc(1, sizeof(phHciNfc_sContext_t));
+    if(NULL == gpHciContext)
+    {
+        return -1;
+    }
+    gHwRef.uicc_connected = TRUE;
+
+    for(i = 0; i < DISPATCH_GATES; i++)
+    {
+        if((NULL != gGates[i].init)
+            && (NFCSTATUS_SUCCESS != gGates[i].init(gpHciContext)))
+        {
+            printf("%s: resources not allocated\n", gGates[i].name);
+            return -1;
+        }
+    }
+    /* Allocates the Emulation information, then stops as the NFCIP-1 Target
+     * pipe is not open */
+    (void)phHciNfc_EmuMgmt_Initialise(gpHciContext, &gHwRef);
+
+    for(i = 0; i < DISPATCH_GATES; i++)
+    {
+        psGate = &gGates[i];
+        psGate->pipe_id = (phHciNfc_ConnectivityGate == psGate->gate_id)?
+                            (uint8_t)NXP_PIPE_CONNECTIVITY:
+                            (uint8_t)(HCI_DYNAMIC_PIPE_ID + i);
+        psGate->p_pipe_info = (phHciNfc_Pipe_Info_t *)
+                            calloc(1, sizeof(phHciNfc_Pipe_Info_t));
+        if(NULL == psGate->p_pipe_info)
+        {
+            return -1;
+        }
+        psGate->p_pipe_info->pipe.dest.gate_id = (uint8_t)psGate->gate_id;
+        psGate->p_pipe_info->pipe.pipe_id = psGate->pipe_id;
+
+        status = phHciNfc_Update_PipeInfo(gpHciContext, &pipe_seq,
+                                          psGate->pipe_id, psGate->p_pipe_info);
+        if(NFCSTATUS_SUCCESS != status)
+        {
+            printf("%s: pipe not updated, status %04X\n", psGate->name,
+                   status);
+            return -1;
+        }
+        gpHciContext->p_pipe_list[psGate->pipe_id] = psGate->p_pipe_info;
+
+        /* The Gate lookup and the pipe list must agree */
+        pipe_id = (uint8_t)HCI_UNKNOWN_PIPE_ID;
+        status = psGate->get_pipe_id(gpHciContext, &pipe_id);
+        if((NFCSTATUS_SUCCESS != status) || (pipe_id != psGate->pipe_id))
+        {
+            printf("%s: Get_PipeID gives pipe %02X instead of %02X\n",
+                   psGate->name, pipe_id, psGate->pipe_id);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* Checks the handlers of each pipe and swaps them for the probes */
+static
+int
+dispatch_check_handlers(void)
+{
+    phHciNfc_Pipe_Info_t        *psPipe = NULL;
+    uint8_t                     handlers = 0;
+    uint32_t                    i = 0;
+    uint32_t                    j = 0;
+
+    for(i = 0; i < DISPATCH_GATES; i++)
+    {
+        psPipe = gGates[i].p_pipe_info;
+        handlers = (uint8_t)(((NULL != psPipe->recv_resp)? DISPATCH_RESP: 0)
+                        | ((NULL != psPipe->recv_event)? DISPATCH_EVENT: 0)
+                        | ((NULL != psPipe->recv_cmd)? DISPATCH_CMD: 0));
+        if(handlers != gGates[i].handlers)
+        {
+            printf("%s: handlers %02X registered instead of %02X\n",
+                   gGates[i].name, handlers, gGates[i].handlers);
+            return -1;
+        }
+
+        /* Each Gate has its own handlers */
+        for(j = 0; j < i; j++)
+        {
+            if(((NULL != psPipe->recv_resp)
+                && (psPipe->recv_resp == gGates[j].p_pipe_info->recv_resp))
+                || ((NULL != psPipe->recv_event)
+                && (psPipe->recv_event == gGates[j].p_pipe_info->recv_event))
+                || ((NULL != psPipe->recv_cmd)
+                && (psPipe->recv_cmd == gGates[j].p_pipe_info->recv_cmd)))
+            {
+                printf("%s: handler shared with %s\n", gGates[i].name,
+                       gGates[j].name);
+                return -1;
+            }
+        }
+    }
+
+    for(i = 0; i < DISPATCH_GATES; i++)
+    {
+        psPipe = gGates[i].p_pipe_info;
+        psPipe->recv_resp = (NULL != psPipe->recv_resp)?
+                            &dispatch_probe_resp: NULL;
+        psPipe->recv_event = (NULL != psPipe->recv_event)?
+                            &dispatch_probe_event: NULL;
+        psPipe->recv_cmd = (NULL != psPipe->recv_cmd)?
+                            &dispatch_probe_cmd: NULL;
+    }
+    return 0;
+}
+
+static
+void
+dispatch_receive(
+                uint8_t                 pipe_id,
+                uint8_t                 msg_type
+                )
+{
+    phNfc_sTransactionInfo_t    info;
+    uint8_t                     frame[HCP_HEADER_LEN + 1];
+
+    frame[0] = (uint8_t)SET_BITS8(0, HCP_CHAINBIT_OFFSET, HCP_CHAINBIT_LEN,
+                                  HCP_CHAINBIT_DEFAULT);
+    frame[0] = (uint8_t)SET_BITS8(frame[0], HCP_PIPEID_OFFSET, HCP_PIPEID_LEN,
+                                  pipe_id);
+    frame[1] = (uint8_t)SET_BITS8(0, HCP_MSG_TYPE_OFFSET, HCP_MSG_TYPE_LEN,
+                                  msg_type);
+    /* ANY_OK for a Response, an instruction the Gates do not know otherwise */
+    frame[1] = (uint8_t)SET_BITS8(frame[1], HCP_MSG_INSTRUCTION_OFFSET,
+                                  HCP_MSG_INSTRUCTION_LEN,
+                                  (HCP_MSG_TYPE_RESPONSE == msg_type)?
+                                    ANY_OK: 0x3EU);
+    frame[2] = 0x00;
+
+    if((HCP_MSG_TYPE_RESPONSE == msg_type)
+        && (NULL != gpHciContext->p_pipe_list[pipe_id]))
+    {
+        /* A Response is only handled after a Command */
+        gpHciContext->p_pipe_list[pipe_id]->sent_msg_type =
+                                                    HCP_MSG_TYPE_COMMAND;
+    }
+
+    (void)memset(&info, 0, sizeof(info));
+    info.status = NFCSTATUS_SUCCESS;
+    info.buffer = frame;
+    info.length = sizeof(frame);
+    phHciNfc_Receive_Complete(gpHciContext, &gHwRef, &info);
+}
+
+static
+uint32_t
+dispatch_count(
+                phHciNfc_Dispatch_Stats_t *psStats,
+                uint8_t                 msg_type
+              )
+{
+    return (HCP_MSG_TYPE_RESPONSE == msg_type)? psStats->resp_count:
+           (HCP_MSG_TYPE_EVENT == msg_type)? psStats->event_count:
+                                            psStats->cmd_count;
+}
+
+/* Sends a Message on pipe_id and checks where it is routed */
+static
+int
+dispatch_check_route(
+                const char              *pName,
+                uint8_t                 pipe_id,
+                uint8_t                 msg_type,
+                uint8_t                 bRouted
+                    )
+{
+    phHciNfc_Dispatch_Stats_t   before;
+    phHciNfc_Dispatch_Stats_t   after;
+    uint32_t                    unrouted = gpHciContext->dispatch_unrouted;
+    uint32_t                    calls = gProbeCalls;
+
+    (void)memset(&before, 0, sizeof(before));
+    (void)memset(&after, 0, sizeof(after));
+    (void)phHciNfc_Get_Dispatch_Stats(gpHciContext, pipe_id, &before);
+    dispatch_receive(pipe_id, msg_type);
+    (void)phHciNfc_Get_Dispatch_Stats(gpHciContext, pipe_id, &after);
+
+    if(TRUE == bRouted)
+    {
+        if((gProbeCalls != (calls + 1)) || (gProbeType != msg_type)
+            || (gProbePipe != pipe_id)
+            || (dispatch_count(&after, msg_type)
+                                != (dispatch_count(&before, msg_type) + 1))
+            || (gpHciContext->dispatch_unrouted != unrouted))
+        {
+            printf("%s: message type %u on pipe %02X not routed to its "
+                   "handler\n", pName, msg_type, pipe_id);
+            return -1;
+        }
+    }
+    else if((gProbeCalls != calls)
+        || (0 != memcmp(&before, &after, sizeof(before)))
+        || (gpHciContext->dispatch_unrouted != (unrouted + 1)))
+    {
+        printf("%s: message type %u on pipe %02X routed without a handler\n",
+               pName, msg_type, pipe_id);
+        return -1;
+    }
+    return 0;
+}
+
+static
+int
+dispatch_test(void)
+{
+    static const uint8_t types[] = { HCP_MSG_TYPE_RESPONSE, HCP_MSG_TYPE_EVENT,
+                                     HCP_MSG_TYPE_COMMAND };
+    static const uint8_t masks[] = { DISPATCH_RESP, DISPATCH_EVENT,
+                                     DISPATCH_CMD };
+    uint32_t            i = 0;
+    uint32_t            t = 0;
+
+    if((0 != dispatch_create_pipes()) || (0 != dispatch_check_handlers()))
+    {
+        return -1;
+    }
+
+    for(i = 0; i < DISPATCH_GATES; i++)
+    {
+        for(t = 0; t < (sizeof(types) / sizeof(types[0])); t++)
+        {
+            if(0 != dispatch_check_route(gGates[i].name, gGates[i].pipe_id,
+                            types[t],
+                            (0 != (gGates[i].handlers & masks[t]))))
+            {
+                return -1;
+            }
+        }
+    }
+
+    /* Events and Commands on a pipe that was never created */
+    if((0 != dispatch_check_route("Unknown", DISPATCH_UNKNOWN_PIPE,
+                                  HCP_MSG_TYPE_EVENT, FALSE))
+        || (0 != dispatch_check_route("Unknown", DISPATCH_UNKNOWN_PIPE,
+                                  HCP_MSG_TYPE_COMMAND, FALSE)))
+    {
+        return -1;
+    }
+    return 0;
+}
+
+static
+uint64_t
+dispatch_now_ns(void)
+{
+    struct timespec     now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+static
+void
+dispatch_bench_print(
+                const char              *pName,
+                uint64_t                nIterations,
+                uint64_t                nElapsed
+                    )
+{
+    printf("{\"bench\":\"%s\",\"gates\":%u,\"iterations\":%llu,"
+           "\"ns_per_msg\":%.1f}\n", pName, (unsigned)DISPATCH_GATES,
+           (unsigned long long)nIterations,
+           (double)nElapsed / (double)nIterations);
+}
+
+/* Times the routing of Events spread over the pipes of all the Gates */
+static
+void
+dispatch_bench(void)
+{
+    volatile uint8_t    found = 0;
+    uint64_t            start = 0;
+    uint64_t            elapsed = 0;
+    uint64_t            iterations = 0;
+    uint8_t             pipe_id = 0;
+    uint32_t            i = 0;
+    uint32_t            g = 0;
+
+    start = dispatch_now_ns();
+    do
+    {
+        for(i = 0; i < 1024; i++)
+        {
+            dispatch_receive(gGates[i % DISPATCH_GATES].pipe_id,
+                                   HCP_MSG_TYPE_EVENT);
+        }
+        iterations += 1024;
+        elapsed = dispatch_now_ns() - start;
+    }while(elapsed < DISPATCH_BENCH_TIME_NS);
+    dispatch_bench_print("Dispatch", iterations, elapsed);
+
+    /* Lookup of the Gate owning the pipe, asking each Gate in turn */
+    iterations = 0;
+    start = dispatch_now_ns();
+    do
+    {
+        for(i = 0; i < 1024; i++)
+        {
+            for(g = 0; g < DISPATCH_GATES; g++)
+            {
+                (void)gGates[g].get_pipe_id(gpHciContext, &pipe_id);
+                if(pipe_id == gGates[i % DISPATCH_GATES].pipe_id)
+                {
+                    found = (uint8_t)g;
+                    break;
+                }
+            }
+        }
+        iterations += 1024;
+        elapsed = dispatch_now_ns() - start;
+    }while(elapsed < DISPATCH_BENCH_TIME_NS);
+    dispatch_bench_print("GateLookup", iterations, elapsed);
+
+    /* Lookup of the pipe in the pipe list, as done by the dispatch */
+    iterations = 0;
+    start = dispatch_now_ns();
+    do
+    {
+        for(i = 0; i < 1024; i++)
+        {
+            pipe_id = gGates[i % DISPATCH_GATES].pipe_id;
+            if(NULL != gpHciContext->p_pipe_list[pipe_id]->recv_event)
+            {
+                found = pipe_id;
+            }
+        }
+        iterations += 1024;
+        elapsed = dispatch_now_ns() - start;
+    }while(elapsed < DISPATCH_BENCH_TIME_NS);
+    dispatch_bench_print("PipeLookup", iterations, elapsed);
+    (void)found;
+}
+
+int
+main(
+                int                     argc,
+                char                    **argv
+    )
+{
+    uint8_t             bench = FALSE;
+    int                 arg = 0;
+
+    for(arg = 1; arg < argc; arg++)
+    {
+        if(0 == strcmp(argv[arg], "-b"))
+        {
+            bench = TRUE;
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [-b]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if(0 != dispatch_test())
+    {
+        printf("FAILED\n");
+        return 1;
+    }
+    fprintf(stderr, "HCI dispatch: %u gates routed\n",
+            (unsigned)DISPATCH_GATES);
+
+    if(TRUE == bench)
+    {
+        dispatch_bench();
+    }
+    return 0;
+}
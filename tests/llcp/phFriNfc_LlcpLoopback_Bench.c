@@ -0,0 +1,1252 @@
+/*
+ * Copyright (C) 2010 NXP Semiconductors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*!
+ * \file  phFriNfc_LlcpLoopback_Bench.c
+ * \brief Two stack LLCP benchmark over the loopback MAC.
+ *
+ * Two complete LLC and transport instances, an initiator and a target, are
+ * linked in this process by phFriNfc_LlcpMac_Loopback. The OSAL is the
+ * simulated one of phOsalNfc_Sim.h: the link latency and bitrate are applied
+ * on a virtual clock, so that the times in milliseconds are the ones of the
+ * modelled link, while the host time spent gives the CPU cost of the stacks.
+ *
+ * Each benchmark activates a new link and prints one JSON object per line:
+ *
+ *  - LinkActivation: from the MAC activation to both links up. The link
+ *    parameters come with the ATR, so that this is the LLC cost only.
+ *  - Discovery: SNL round trip resolving 1 and 4 service names.
+ *  - Connect: CONNECT to CC of a connection-oriented socket.
+ *  - ConnectRetry: CONNECT by service name to the remembered SAP of a
+ *    service moved since, from the DM to the CC of the CONNECT sent again
+ *    with the service name.
+ *  - ClThroughput: UI PDUs of the remote link MIU, from initiator to target.
+ *  - CoThroughput, CoBulkThroughput: I PDUs from initiator to target, with
+ *    the default socket options (MIU 128, RW 1), then with the options of
+ *    phFriNfc_LlcpTransport_GetBulkSocketOptions.
+ *  - CoMultiThroughput: the default options over several sockets at once.
+ *
+ * The received data is checked byte by byte. The throughput benchmarks give
+ * the PDUs per send turn and the AGF frames (NXP_LLCP_AGF_SEND), the I frames
+ * received straight into the socket buffer or staged in the receive window,
+ * and per PDU sent by either side the OSAL allocations and the host time.
+ *
+ * LLCP does not retransmit: with a loss rate, a lost frame ends the link at
+ * the LTO and the benchmark is reported as failed with the link down.
+ *
+ * Usage: nfc_llcp_loopback_benchmark [-l <latency ms>] [-r <bitrate>]
+ *                [-p <loss per mille>] [-s <seed>] [-m <link MIU>]
+ *                [-n <bytes>] [-k <sockets>]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <phNfcTypes.h>
+#include <phNfcStatus.h>
+#include <phLibNfc.h>
+#include <phNfcLlcpTypes.h>
+#include <phFriNfc_Llcp.h>
+#include <phFriNfc_LlcpMac.h>
+#include <phFriNfc_LlcpMacNfcip.h>
+#include <phFriNfc_LlcpMacLoopback.h>
+#include <phFriNfc_LlcpTransport.h>
+
+#include "phOsalNfc_Sim.h"
+
+#define BENCH_LLC_BUFFER_SIZE       PHFRINFC_LLCP_PACKET_MAX_SIZE
+#define BENCH_WORKING_BUFFER_SIZE   40960U
+#define BENCH_LINEAR_BUFFER_SIZE    4096U
+#define BENCH_CHUNK_SIZE            PHFRINFC_LLCP_MIU_MAX
+#define BENCH_MAX_STREAMS           8U
+#define BENCH_LINK_LTO              50U
+#define BENCH_TIMEOUT_MS            600000U
+
+#define BENCH_SERVICE_NAME          "urn:nfc:sn:bench"
+
+/* One of the two LLCP stacks */
+typedef struct bench_end
+{
+    phFriNfc_Llcp_t                 sLlcp;
+    phFriNfc_LlcpTransport_t        sTransport;
+    phFriNfc_LlcpMac_sLoopback_t    sLoopback;
+    phHal_sRemoteDevInformation_t   sRemoteDevInfo;
+    uint8_t                         aRxBuffer[BENCH_LLC_BUFFER_SIZE];
+    uint8_t                         aTxBuffer[BENCH_LLC_BUFFER_SIZE];
+    uint8_t                         bChecked;
+    uint8_t                         bLinkUp;
+
+}bench_end_t;
+
+/* Data sent by a socket of the initiator to a socket of the target */
+typedef struct bench_stream
+{
+    phFriNfc_LlcpTransport_eSocketType_t    eType;
+    phFriNfc_LlcpTransport_Socket_t         *psSender;
+    phFriNfc_LlcpTransport_Socket_t         *psReceiver;
+    phFriNfc_LlcpTransport_Socket_t         *psIncoming;
+    uint8_t                                 nDestSap;
+    uint16_t                                nChunk;
+    uint32_t                                nTotal;
+    uint32_t                                nSent;
+    uint32_t                                nReceived;
+    uint8_t                                 bConnected;
+    uint8_t                                 bAccepted;
+    uint8_t                                 bSendPending;
+    uint8_t                                 bRecvPending;
+    uint8_t                                 bError;
+    phNfc_sData_t                           sSendBuffer;
+    phNfc_sData_t                           sRecvBuffer;
+    phNfc_sData_t                           sSenderWorkingBuffer;
+    phNfc_sData_t                           sReceiverWorkingBuffer;
+    uint8_t                                 aSend[BENCH_CHUNK_SIZE];
+    uint8_t                                 aRecv[BENCH_LINEAR_BUFFER_SIZE];
+    uint8_t                                 aSenderWorking[BENCH_WORKING_BUFFER_SIZE];
+    uint8_t                                 aReceiverWorking[BENCH_WORKING_BUFFER_SIZE];
+
+}bench_stream_t;
+
+typedef struct bench_link
+{
+    bench_end_t                     sInitiator;
+    bench_end_t                     sTarget;
+    bench_stream_t                  sStreams[BENCH_MAX_STREAMS];
+    uint8_t                         nStreams;
+    phFriNfc_LlcpTransport_Socket_t *psListen;
+    phFriNfc_LlcpTransport_sSocketOptions_t sOptions;
+    uint8_t                         bDiscovered;
+    uint32_t                        nActivationTime;
+
+}bench_link_t;
+
+typedef uint8_t (*bench_done_t)(bench_link_t *psLink);
+
+static phFriNfc_LlcpMac_sLoopbackConfig_t   gConfig = { 1, 424000, 0, 1 };
+static uint16_t                             gLinkMiu = PHFRINFC_LLCP_MIU_MAX;
+static uint32_t                             gBytes = 65536;
+static uint8_t                              gSockets = 4;
+static bench_link_t                         gLink;
+
+static uint8_t gMagic[] = { 0x46, 0x66, 0x6D };
+
+/* The stacks only use the loopback mapping */
+NFCSTATUS
+phFriNfc_LlcpMac_Nfcip_Register(phFriNfc_LlcpMac_t *LlcpMac)
+{
+    PHNFC_UNUSED_VARIABLE(LlcpMac);
+    return PHNFCSTVAL(CID_FRI_NFC_LLCP_MAC, NFCSTATUS_FAILED);
+}
+
+static
+uint64_t
+bench_host_ns(void)
+{
+    struct timespec     now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+static
+void
+bench_check_cb(
+                void                    *pContext,
+                NFCSTATUS               status
+              )
+{
+    bench_end_t         *psEnd = (bench_end_t *)pContext;
+
+    psEnd->bChecked = (NFCSTATUS_SUCCESS == status) ? TRUE : FALSE;
+}
+
+static
+void
+bench_link_cb(
+                void                        *pContext,
+                phFriNfc_Llcp_eLinkStatus_t eLinkStatus
+             )
+{
+    bench_end_t         *psEnd = (bench_end_t *)pContext;
+
+    if(phFriNfc_LlcpMac_eLinkActivated == eLinkStatus)
+    {
+        psEnd->bLinkUp = TRUE;
+    }
+    else
+    {
+        psEnd->bLinkUp = FALSE;
+        (void)phFriNfc_LlcpTransport_CloseAll(&psEnd->sTransport);
+    }
+}
+
+static
+void
+bench_socket_err_cb(
+                void                    *pContext,
+                uint8_t                 nErrCode
+                   )
+{
+    bench_stream_t      *psStream = (bench_stream_t *)pContext;
+
+    PHNFC_UNUSED_VARIABLE(nErrCode);
+    psStream->bError = TRUE;
+}
+
+static
+void
+bench_connect_cb(
+                void                    *pContext,
+                uint8_t                 nErrCode,
+                NFCSTATUS               status
+                )
+{
+    bench_stream_t      *psStream = (bench_stream_t *)pContext;
+
+    PHNFC_UNUSED_VARIABLE(nErrCode);
+    if(NFCSTATUS_SUCCESS == status)
+    {
+        psStream->bConnected = TRUE;
+    }
+    else
+    {
+        psStream->bError = TRUE;
+    }
+}
+
+static
+void
+bench_accept_cb(
+                void                    *pContext,
+                NFCSTATUS               status
+               )
+{
+    bench_stream_t      *psStream = (bench_stream_t *)pContext;
+
+    if(NFCSTATUS_SUCCESS != status)
+    {
+        psStream->bError = TRUE;
+    }
+}
+
+static
+void
+bench_listen_cb(
+                void                            *pContext,
+                phFriNfc_LlcpTransport_Socket_t *IncomingSocket
+               )
+{
+    bench_link_t        *psLink = (bench_link_t *)pContext;
+    uint8_t             i = 0;
+
+    /* Accepted from the pump, out of the transport callback */
+    for(i = 0; i < psLink->nStreams; i++)
+    {
+        if((NULL == psLink->sStreams[i].psIncoming)
+            && (FALSE == psLink->sStreams[i].bAccepted))
+        {
+            psLink->sStreams[i].psIncoming = IncomingSocket;
+            break;
+        }
+    }
+}
+
+static
+void
+bench_send_cb(
+                void                    *pContext,
+                NFCSTATUS               status
+             )
+{
+    bench_stream_t      *psStream = (bench_stream_t *)pContext;
+
+    psStream->bSendPending = FALSE;
+    if(NFCSTATUS_SUCCESS != status)
+    {
+        psStream->bError = TRUE;
+    }
+}
+
+static
+void
+bench_received(
+                bench_stream_t          *psStream,
+                NFCSTATUS               status
+              )
+{
+    uint32_t            i = 0;
+
+    psStream->bRecvPending = FALSE;
+    if(NFCSTATUS_SUCCESS != status)
+    {
+        psStream->bError = TRUE;
+        return;
+    }
+    /* Every byte carries its position in the stream */
+    for(i = 0; i < psStream->sRecvBuffer.length; i++)
+    {
+        if(psStream->aRecv[i] != (uint8_t)(psStream->nReceived + i))
+        {
+            printf("stream byte %u received out of order\n",
+                   psStream->nReceived + i);
+            psStream->bError = TRUE;
+            return;
+        }
+    }
+    psStream->nReceived += psStream->sRecvBuffer.length;
+}
+
+static
+void
+bench_recv_cb(
+                void                    *pContext,
+                NFCSTATUS               status
+             )
+{
+    bench_received((bench_stream_t *)pContext, status);
+}
+
+static
+void
+bench_recv_from_cb(
+                void                    *pContext,
+                uint8_t                 ssap,
+                NFCSTATUS               status
+                  )
+{
+    PHNFC_UNUSED_VARIABLE(ssap);
+    bench_received((bench_stream_t *)pContext, status);
+}
+
+static
+void
+bench_discover_cb(
+                void                    *pContext,
+                NFCSTATUS               status
+                 )
+{
+    bench_link_t        *psLink = (bench_link_t *)pContext;
+
+    psLink->bDiscovered = (NFCSTATUS_SUCCESS == status) ? TRUE : FALSE;
+}
+
+/* Issues the accepts, sends and receives the streams are ready for */
+static
+void
+bench_pump(
+                bench_link_t            *psLink
+          )
+{
+    bench_stream_t      *psStream = NULL;
+    NFCSTATUS           status = NFCSTATUS_SUCCESS;
+    uint32_t            length = 0;
+    uint32_t            i = 0;
+    uint8_t             s = 0;
+
+    for(s = 0; s < psLink->nStreams; s++)
+    {
+        psStream = &psLink->sStreams[s];
+        if(TRUE == psStream->bError)
+        {
+            continue;
+        }
+
+        if(NULL != psStream->psIncoming)
+        {
+            psStream->psReceiver = psStream->psIncoming;
+            psStream->psIncoming = NULL;
+            psStream->bAccepted = TRUE;
+            status = phFriNfc_LlcpTransport_Accept(psStream->psReceiver,
+                                    &psLink->sOptions,
+                                    &psStream->sReceiverWorkingBuffer,
+                                    bench_socket_err_cb, bench_accept_cb,
+                                    psStream);
+            if((NFCSTATUS_SUCCESS != status) && (NFCSTATUS_PENDING != status))
+            {
+                psStream->bError = TRUE;
+                continue;
+            }
+        }
+
+        /* Receive until nothing more is stored */
+        while((NULL != psStream->psReceiver) && (FALSE == psStream->bRecvPending)
+            && (FALSE == psStream->bError)
+            && ((phFriNfc_LlcpTransport_eConnectionLess == psStream->eType)
+                || (TRUE == psStream->bConnected)))
+        {
+            psStream->sRecvBuffer.buffer = psStream->aRecv;
+            psStream->sRecvBuffer.length = sizeof(psStream->aRecv);
+            psStream->bRecvPending = TRUE;
+            if(phFriNfc_LlcpTransport_eConnectionLess == psStream->eType)
+            {
+                status = phFriNfc_LlcpTransport_RecvFrom(psStream->psReceiver,
+                                    &psStream->sRecvBuffer, bench_recv_from_cb,
+                                    psStream);
+            }
+            else
+            {
+                status = phFriNfc_LlcpTransport_Recv(psStream->psReceiver,
+                                    &psStream->sRecvBuffer, bench_recv_cb,
+                                    psStream);
+            }
+            if(NFCSTATUS_PENDING == status)
+            {
+                break;
+            }
+            if(NFCSTATUS_SUCCESS != status)
+            {
+                psStream->bRecvPending = FALSE;
+                break;
+            }
+        }
+
+        if((NULL != psStream->psSender) && (FALSE == psStream->bSendPending)
+            && (psStream->nSent < psStream->nTotal)
+            && ((phFriNfc_LlcpTransport_eConnectionLess == psStream->eType)
+                || (TRUE == psStream->bConnected)))
+        {
+            length = psStream->nTotal - psStream->nSent;
+            if(length > psStream->nChunk)
+            {
+                length = psStream->nChunk;
+            }
+            for(i = 0; i < length; i++)
+            {
+                psStream->aSend[i] = (uint8_t)(psStream->nSent + i);
+            }
+            psStream->sSendBuffer.buffer = psStream->aSend;
+            psStream->sSendBuffer.length = length;
+            psStream->bSendPending = TRUE;
+            if(phFriNfc_LlcpTransport_eConnectionLess == psStream->eType)
+            {
+                status = phFriNfc_LlcpTransport_SendTo(psStream->psSender,
+                                    psStream->nDestSap, &psStream->sSendBuffer,
+                                    bench_send_cb, psStream);
+            }
+            else
+            {
+                status = phFriNfc_LlcpTransport_Send(psStream->psSender,
+                                    &psStream->sSendBuffer, bench_send_cb,
+                                    psStream);
+            }
+            if((NFCSTATUS_SUCCESS == status) || (NFCSTATUS_PENDING == status))
+            {
+                psStream->nSent += length;
+            }
+            else
+            {
+                /* Busy, retried on the next event */
+                psStream->bSendPending = FALSE;
+            }
+        }
+    }
+}
+
+/* Fires the timers until the condition holds, the link dies or the timeout */
+static
+uint8_t
+bench_run(
+                bench_link_t            *psLink,
+                bench_done_t            pfDone
+         )
+{
+    uint32_t            start = phOsalNfc_Sim_GetTime();
+
+    for(;;)
+    {
+        bench_pump(psLink);
+        if(TRUE == pfDone(psLink))
+        {
+            return TRUE;
+        }
+        if(((phOsalNfc_Sim_GetTime() - start) > BENCH_TIMEOUT_MS)
+            || (FALSE == phOsalNfc_Sim_Step()))
+        {
+            return FALSE;
+        }
+    }
+}
+
+static
+uint8_t
+bench_link_is_up(
+                bench_link_t            *psLink
+                )
+{
+    return ((TRUE == psLink->sInitiator.bLinkUp)
+            && (TRUE == psLink->sTarget.bLinkUp)) ? TRUE : FALSE;
+}
+
+static
+uint8_t
+bench_link_is_down(
+                bench_link_t            *psLink
+                  )
+{
+    return ((FALSE == psLink->sInitiator.bLinkUp)
+            && (FALSE == psLink->sTarget.bLinkUp)) ? TRUE : FALSE;
+}
+
+static
+uint8_t
+bench_streams_connected(
+                bench_link_t            *psLink
+                       )
+{
+    uint8_t             s = 0;
+
+    for(s = 0; s < psLink->nStreams; s++)
+    {
+        if((TRUE == psLink->sStreams[s].bError)
+            || (FALSE == bench_link_is_up(psLink)))
+        {
+            return TRUE;
+        }
+        if((FALSE == psLink->sStreams[s].bConnected)
+            || (FALSE == psLink->sStreams[s].bAccepted))
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+static
+uint8_t
+bench_streams_received(
+                bench_link_t            *psLink
+                      )
+{
+    uint8_t             s = 0;
+
+    for(s = 0; s < psLink->nStreams; s++)
+    {
+        if((TRUE == psLink->sStreams[s].bError)
+            || (FALSE == bench_link_is_up(psLink)))
+        {
+            return TRUE;
+        }
+        if(psLink->sStreams[s].nReceived < psLink->sStreams[s].nTotal)
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+static
+uint8_t
+bench_discovered(
+                bench_link_t            *psLink
+                )
+{
+    return ((TRUE == psLink->bDiscovered)
+            || (FALSE == bench_link_is_up(psLink))) ? TRUE : FALSE;
+}
+
+static
+NFCSTATUS
+bench_end_reset(
+                bench_end_t             *psEnd,
+                bench_end_t             *psPeer,
+                phHal_eRemDevType_t     ePeerType
+               )
+{
+    phFriNfc_Llcp_sLinkParameters_t sParams;
+    phNfc_sData_t                   sGeneralBytes;
+    NFCSTATUS                       status = NFCSTATUS_SUCCESS;
+
+    (void)memset(&sParams, 0, sizeof(sParams));
+    sParams.miu = gLinkMiu;
+    sParams.lto = BENCH_LINK_LTO;
+    sParams.wks = 0x0011;
+    sParams.option = PHFRINFC_LLCP_OPTION_DEFAULT;
+
+    status = phFriNfc_Llcp_Reset(&psEnd->sLlcp, &psEnd->sLoopback, &sParams,
+                                 psEnd->aRxBuffer, sizeof(psEnd->aRxBuffer),
+                                 psEnd->aTxBuffer, sizeof(psEnd->aTxBuffer),
+                                 bench_link_cb, psEnd);
+    if(NFCSTATUS_SUCCESS == status)
+    {
+        status = phFriNfc_LlcpMac_Loopback_Register(&psEnd->sLlcp.MAC);
+    }
+    if(NFCSTATUS_SUCCESS == status)
+    {
+        status = phFriNfc_LlcpTransport_Reset(&psEnd->sTransport,
+                                              &psEnd->sLlcp, NULL);
+    }
+    if(NFCSTATUS_SUCCESS != status)
+    {
+        return status;
+    }
+
+    /* The peer seen as discovered: its role and its link parameters, as
+       they would come in the ATR general bytes */
+    psPeer->sRemoteDevInfo.RemDevType = ePeerType;
+    (void)memset(psPeer->sRemoteDevInfo.RemoteDevInfo.NfcIP_Info.NFCID,
+                 (phHal_eNfcIP1_Initiator == ePeerType) ? 0x1A : 0x7A,
+                 PHHAL_MAX_UID_LENGTH);
+    psPeer->sRemoteDevInfo.RemoteDevInfo.NfcIP_Info.NFCID_Length =
+                                                        PHHAL_MAX_UID_LENGTH;
+    (void)memcpy(psPeer->sRemoteDevInfo.RemoteDevInfo.NfcIP_Info.ATRInfo,
+                 gMagic, sizeof(gMagic));
+    sGeneralBytes.buffer =
+        &psPeer->sRemoteDevInfo.RemoteDevInfo.NfcIP_Info.ATRInfo[sizeof(gMagic)];
+    sGeneralBytes.length = PHHAL_MAX_ATR_LENGTH - sizeof(gMagic);
+    status = phFriNfc_Llcp_EncodeLinkParams(&sGeneralBytes, &sParams,
+                                            PHFRINFC_LLCP_VERSION);
+    psPeer->sRemoteDevInfo.RemoteDevInfo.NfcIP_Info.ATRInfo_Length =
+                        (uint8_t)(sizeof(gMagic) + sGeneralBytes.length);
+    return status;
+}
+
+/* Activates a new link, returns the activation time on the link in ms */
+static
+NFCSTATUS
+bench_link_up(
+                bench_link_t            *psLink
+             )
+{
+    NFCSTATUS           status = NFCSTATUS_SUCCESS;
+    uint32_t            start = 0;
+
+    (void)memset(psLink, 0, sizeof(*psLink));
+    phOsalNfc_Sim_Reset();
+
+    status = phFriNfc_LlcpMac_Loopback_Init(&psLink->sInitiator.sLoopback,
+                                            &psLink->sTarget.sLoopback,
+                                            &gConfig);
+    if(NFCSTATUS_SUCCESS == status)
+    {
+        status = bench_end_reset(&psLink->sInitiator, &psLink->sTarget,
+                                 phHal_eNfcIP1_Initiator);
+    }
+    if(NFCSTATUS_SUCCESS == status)
+    {
+        status = bench_end_reset(&psLink->sTarget, &psLink->sInitiator,
+                                 phHal_eNfcIP1_Target);
+    }
+    if(NFCSTATUS_SUCCESS != status)
+    {
+        return status;
+    }
+
+    /* Each side discovered the other one */
+    (void)phFriNfc_Llcp_ChkLlcp(&psLink->sInitiator.sLlcp,
+                                &psLink->sInitiator.sRemoteDevInfo,
+                                bench_check_cb, &psLink->sInitiator);
+    (void)phFriNfc_Llcp_ChkLlcp(&psLink->sTarget.sLlcp,
+                                &psLink->sTarget.sRemoteDevInfo,
+                                bench_check_cb, &psLink->sTarget);
+    if((FALSE == psLink->sInitiator.bChecked)
+        || (FALSE == psLink->sTarget.bChecked))
+    {
+        return NFCSTATUS_FAILED;
+    }
+
+    start = phOsalNfc_Sim_GetTime();
+    (void)phFriNfc_Llcp_Activate(&psLink->sInitiator.sLlcp);
+    (void)phFriNfc_Llcp_Activate(&psLink->sTarget.sLlcp);
+    if(FALSE == bench_run(psLink, bench_link_is_up))
+    {
+        return NFCSTATUS_FAILED;
+    }
+    psLink->nActivationTime = phOsalNfc_Sim_GetTime() - start;
+    return NFCSTATUS_SUCCESS;
+}
+
+static
+void
+bench_link_down(
+                bench_link_t            *psLink
+               )
+{
+    /* The field is lost: no DISC, both MACs are deactivated at once */
+    if(FALSE == bench_link_is_down(psLink))
+    {
+        (void)phFriNfc_LlcpMac_Deactivate(&psLink->sInitiator.sLlcp.MAC);
+    }
+    phFriNfc_LlcpTransport_Release(&psLink->sInitiator.sTransport);
+    phFriNfc_LlcpTransport_Release(&psLink->sTarget.sTransport);
+    (void)phFriNfc_LlcpMac_Loopback_Release(&psLink->sInitiator.sLoopback);
+}
+
+/* Opens nStreams sockets from the initiator to the target */
+static
+NFCSTATUS
+bench_streams_open(
+                bench_link_t                        *psLink,
+                phFriNfc_LlcpTransport_eSocketType_t eType,
+                uint8_t                             nStreams,
+                uint8_t                             bBulk
+                  )
+{
+    phFriNfc_LlcpTransport_sSocketOptions_t *psOptions = NULL;
+    phNfc_sData_t       sServiceName;
+    bench_stream_t      *psStream = NULL;
+    NFCSTATUS           status = NFCSTATUS_SUCCESS;
+    uint8_t             s = 0;
+
+    psLink->nStreams = nStreams;
+    psLink->sOptions.miu = PHFRINFC_LLCP_MIU_DEFAULT;
+    psLink->sOptions.rw = PHFRINFC_LLCP_RW_DEFAULT;
+    if(TRUE == bBulk)
+    {
+        status = phFriNfc_LlcpTransport_GetBulkSocketOptions(
+                        &psLink->sTarget.sTransport,
+                        BENCH_WORKING_BUFFER_SIZE - BENCH_LINEAR_BUFFER_SIZE,
+                        &psLink->sOptions);
+        if(NFCSTATUS_SUCCESS != status)
+        {
+            return status;
+        }
+    }
+    if(phFriNfc_LlcpTransport_eConnectionOriented == eType)
+    {
+        psOptions = &psLink->sOptions;
+    }
+
+    for(s = 0; (s < nStreams) && (NFCSTATUS_SUCCESS == status); s++)
+    {
+        psStream = &psLink->sStreams[s];
+        psStream->eType = eType;
+        psStream->nTotal = gBytes;
+        psStream->sSenderWorkingBuffer.buffer = psStream->aSenderWorking;
+        psStream->sSenderWorkingBuffer.length = sizeof(psStream->aSenderWorking);
+        psStream->sReceiverWorkingBuffer.buffer = psStream->aReceiverWorking;
+        psStream->sReceiverWorkingBuffer.length =
+                                        sizeof(psStream->aReceiverWorking);
+
+        status = phFriNfc_LlcpTransport_Socket(&psLink->sInitiator.sTransport,
+                                    eType, psOptions,
+                                    &psStream->sSenderWorkingBuffer,
+                                    &psStream->psSender, bench_socket_err_cb,
+                                    psStream);
+        if((NFCSTATUS_SUCCESS == status)
+            && (phFriNfc_LlcpTransport_eConnectionLess == eType))
+        {
+            /* Both ends bound, the receiver buffers a receive window */
+            status = phFriNfc_LlcpTransport_Bind(psStream->psSender, 0, NULL);
+            if(NFCSTATUS_SUCCESS == status)
+            {
+                status = phFriNfc_LlcpTransport_Socket(
+                                    &psLink->sTarget.sTransport, eType, NULL,
+                                    &psStream->sReceiverWorkingBuffer,
+                                    &psStream->psReceiver, bench_socket_err_cb,
+                                    psStream);
+            }
+            if(NFCSTATUS_SUCCESS == status)
+            {
+                status = phFriNfc_LlcpTransport_Bind(psStream->psReceiver, 0,
+                                                     NULL);
+            }
+            psStream->nDestSap = psStream->psReceiver->socket_sSap;
+            psStream->nChunk = psLink->sInitiator.sLlcp.sRemoteParams.miu;
+        }
+    }
+    if((NFCSTATUS_SUCCESS != status)
+        || (phFriNfc_LlcpTransport_eConnectionLess == eType))
+    {
+        return status;
+    }
+
+    /* One listening socket accepting all the connections */
+    sServiceName.buffer = (uint8_t *)BENCH_SERVICE_NAME;
+    sServiceName.length = (uint32_t)strlen(BENCH_SERVICE_NAME);
+    status = phFriNfc_LlcpTransport_Socket(&psLink->sTarget.sTransport, eType,
+                                    &psLink->sOptions,
+                                    &psLink->sStreams[0].sReceiverWorkingBuffer,
+                                    &psLink->psListen, bench_socket_err_cb,
+                                    &psLink->sStreams[0]);
+    if(NFCSTATUS_SUCCESS == status)
+    {
+        status = phFriNfc_LlcpTransport_Bind(psLink->psListen, 0,
+                                             &sServiceName);
+    }
+    if(NFCSTATUS_SUCCESS == status)
+    {
+        status = phFriNfc_LlcpTransport_Listen(psLink->psListen,
+                                               bench_listen_cb, psLink);
+    }
+    for(s = 0; (s < nStreams) && (NFCSTATUS_SUCCESS == status); s++)
+    {
+        status = phFriNfc_LlcpTransport_Connect(psLink->sStreams[s].psSender,
+                                    psLink->psListen->socket_sSap,
+                                    bench_connect_cb, &psLink->sStreams[s]);
+        if(NFCSTATUS_PENDING == status)
+        {
+            status = NFCSTATUS_SUCCESS;
+        }
+    }
+    if(NFCSTATUS_SUCCESS != status)
+    {
+        return status;
+    }
+    if((FALSE == bench_run(psLink, bench_streams_connected))
+        || (FALSE == bench_link_is_up(psLink)))
+    {
+        return NFCSTATUS_FAILED;
+    }
+    for(s = 0; s < nStreams; s++)
+    {
+        if(TRUE == psLink->sStreams[s].bError)
+        {
+            return NFCSTATUS_FAILED;
+        }
+        /* I PDUs of the MIU the receiver announced */
+        psLink->sStreams[s].nChunk = psLink->sStreams[s].psSender->remoteMIU;
+    }
+    return NFCSTATUS_SUCCESS;
+}
+
+static
+void
+bench_print_failure(
+                const char              *pName,
+                bench_link_t            *psLink
+                   )
+{
+    printf("{\"bench\":\"%s\",\"failed\":true,\"link_up\":%s,\"sim_ms\":%u}\n",
+           pName, (TRUE == bench_link_is_up(psLink)) ? "true" : "false",
+           (unsigned)phOsalNfc_Sim_GetTime());
+}
+
+static
+int
+bench_activation(void)
+{
+    uint64_t            start = bench_host_ns();
+    uint64_t            elapsed = 0;
+
+    if(NFCSTATUS_SUCCESS != bench_link_up(&gLink))
+    {
+        bench_print_failure("LinkActivation", &gLink);
+        bench_link_down(&gLink);
+        return 1;
+    }
+    elapsed = bench_host_ns() - start;
+    printf("{\"bench\":\"LinkActivation\",\"sim_ms\":%u,\"host_us\":%.1f}\n",
+           (unsigned)gLink.nActivationTime, (double)elapsed / 1000.0);
+    bench_link_down(&gLink);
+    return 0;
+}
+
+static
+int
+bench_discovery(
+                uint8_t                 nServices
+               )
+{
+    static char         names[4][32];
+    phNfc_sData_t       sNames[4];
+    uint8_t             saps[4];
+    phFriNfc_LlcpTransport_Socket_t *psSocket = NULL;
+    NFCSTATUS           status = NFCSTATUS_SUCCESS;
+    uint32_t            start = 0;
+    uint8_t             i = 0;
+
+    if(NFCSTATUS_SUCCESS != bench_link_up(&gLink))
+    {
+        bench_print_failure("Discovery", &gLink);
+        bench_link_down(&gLink);
+        return 1;
+    }
+
+    /* Services registered on the target */
+    gLink.nStreams = 0;
+    for(i = 0; (i < nServices) && (NFCSTATUS_SUCCESS == status); i++)
+    {
+        (void)snprintf(names[i], sizeof(names[i]), "urn:nfc:sn:bench%u",
+                       (unsigned)i);
+        sNames[i].buffer = (uint8_t *)names[i];
+        sNames[i].length = (uint32_t)strlen(names[i]);
+        saps[i] = 0;
+        status = phFriNfc_LlcpTransport_Socket(&gLink.sTarget.sTransport,
+                                    phFriNfc_LlcpTransport_eConnectionLess,
+                                    NULL, NULL, &psSocket, bench_socket_err_cb,
+                                    &gLink.sStreams[i]);
+        if(NFCSTATUS_SUCCESS == status)
+        {
+            status = phFriNfc_LlcpTransport_Bind(psSocket, 0, &sNames[i]);
+        }
+    }
+
+    start = phOsalNfc_Sim_GetTime();
+    if(NFCSTATUS_SUCCESS == status)
+    {
+        status = phFriNfc_LlcpTransport_DiscoverServices(
+                                    &gLink.sInitiator.sTransport, sNames, saps,
+                                    nServices, bench_discover_cb, &gLink);
+    }
+    if(((NFCSTATUS_SUCCESS != status) && (NFCSTATUS_PENDING != status))
+        || (FALSE == bench_run(&gLink, bench_discovered))
+        || (FALSE == gLink.bDiscovered))
+    {
+        bench_print_failure("Discovery", &gLink);
+        bench_link_down(&gLink);
+        return 1;
+    }
+    for(i = 0; i < nServices; i++)
+    {
+        if(saps[i] < PHFRINFC_LLCP_SAP_SDP_ADVERTISED_FIRST)
+        {
+            printf("service %u not resolved\n", (unsigned)i);
+            bench_link_down(&gLink);
+            return 1;
+        }
+    }
+    printf("{\"bench\":\"Discovery\",\"services\":%u,\"sim_ms\":%u}\n",
+           (unsigned)nServices, (unsigned)(phOsalNfc_Sim_GetTime() - start));
+    bench_link_down(&gLink);
+    return 0;
+}
+
+static
+int
+bench_connect(void)
+{
+    uint32_t            start = 0;
+
+    if(NFCSTATUS_SUCCESS != bench_link_up(&gLink))
+    {
+        bench_print_failure("Connect", &gLink);
+        bench_link_down(&gLink);
+        return 1;
+    }
+    start = phOsalNfc_Sim_GetTime();
+    if(NFCSTATUS_SUCCESS != bench_streams_open(&gLink,
+                        phFriNfc_LlcpTransport_eConnectionOriented, 1, FALSE))
+    {
+        bench_print_failure("Connect", &gLink);
+        bench_link_down(&gLink);
+        return 1;
+    }
+    printf("{\"bench\":\"Connect\",\"sim_ms\":%u}\n",
+           (unsigned)(phOsalNfc_Sim_GetTime() - start));
+    bench_link_down(&gLink);
+    return 0;
+}
+
+/* Connects stream s of the initiator by service name */
+static
+NFCSTATUS
+bench_stream_connect_by_name(
+                bench_link_t            *psLink,
+                uint8_t                 s
+                            )
+{
+    bench_stream_t      *psStream = &psLink->sStreams[s];
+    phNfc_sData_t       sServiceName;
+    NFCSTATUS           status = NFCSTATUS_SUCCESS;
+
+    psStream->eType = phFriNfc_LlcpTransport_eConnectionOriented;
+    psStream->sSenderWorkingBuffer.buffer = psStream->aSenderWorking;
+    psStream->sSenderWorkingBuffer.length = sizeof(psStream->aSenderWorking);
+    psStream->sReceiverWorkingBuffer.buffer = psStream->aReceiverWorking;
+    psStream->sReceiverWorkingBuffer.length =
+                                        sizeof(psStream->aReceiverWorking);
+    psLink->nStreams = s + 1;
+
+    sServiceName.buffer = (uint8_t *)BENCH_SERVICE_NAME;
+    sServiceName.length = (uint32_t)strlen(BENCH_SERVICE_NAME);
+    status = phFriNfc_LlcpTransport_Socket(&psLink->sInitiator.sTransport,
+                                    psStream->eType, &psLink->sOptions,
+                                    &psStream->sSenderWorkingBuffer,
+                                    &psStream->psSender, bench_socket_err_cb,
+                                    psStream);
+    if(NFCSTATUS_SUCCESS == status)
+    {
+        status = phFriNfc_LlcpTransport_ConnectByUri(psStream->psSender,
+                                    &sServiceName, bench_connect_cb, psStream);
+    }
+    if(NFCSTATUS_PENDING != status)
+    {
+        return NFCSTATUS_FAILED;
+    }
+    if((FALSE == bench_run(psLink, bench_streams_connected))
+        || (FALSE == bench_link_is_up(psLink))
+        || (TRUE == psStream->bError))
+    {
+        return NFCSTATUS_FAILED;
+    }
+    return NFCSTATUS_SUCCESS;
+}
+
+static
+int
+bench_connect_retry(void)
+{
+    phNfc_sData_t       sServiceName;
+    NFCSTATUS           status = NFCSTATUS_SUCCESS;
+    uint32_t            start = 0;
+    uint8_t             nOldSap = 0;
+
+    if(NFCSTATUS_SUCCESS != bench_link_up(&gLink))
+    {
+        bench_print_failure("ConnectRetry", &gLink);
+        bench_link_down(&gLink);
+        return 1;
+    }
+
+    /* The initiator learns the SAP of the service from the CC */
+    status = bench_streams_open(&gLink,
+                        phFriNfc_LlcpTransport_eConnectionOriented, 1, FALSE);
+    if(NFCSTATUS_SUCCESS == status)
+    {
+        status = bench_stream_connect_by_name(&gLink, 1);
+    }
+    if(NFCSTATUS_SUCCESS == status)
+    {
+        nOldSap = gLink.psListen->socket_sSap;
+        if(gLink.sStreams[1].psSender->socket_dSap != nOldSap)
+        {
+            status = NFCSTATUS_FAILED;
+        }
+    }
+
+    /* The target listens again, on another SAP: the one of the service is
+       still taken by the connections accepted */
+    if(NFCSTATUS_SUCCESS == status)
+    {
+        status = phFriNfc_LlcpTransport_Close(gLink.psListen);
+    }
+    if(NFCSTATUS_SUCCESS == status)
+    {
+        sServiceName.buffer = (uint8_t *)BENCH_SERVICE_NAME;
+        sServiceName.length = (uint32_t)strlen(BENCH_SERVICE_NAME);
+        status = phFriNfc_LlcpTransport_Socket(&gLink.sTarget.sTransport,
+                                    phFriNfc_LlcpTransport_eConnectionOriented,
+                                    &gLink.sOptions,
+                                    &gLink.sStreams[0].sReceiverWorkingBuffer,
+                                    &gLink.psListen, bench_socket_err_cb,
+                                    &gLink.sStreams[0]);
+    }
+    if(NFCSTATUS_SUCCESS == status)
+    {
+        status = phFriNfc_LlcpTransport_Bind(gLink.psListen, 0,
+                                             &sServiceName);
+    }
+    if(NFCSTATUS_SUCCESS == status)
+    {
+        status = phFriNfc_LlcpTransport_Listen(gLink.psListen,
+                                               bench_listen_cb, &gLink);
+    }
+    if((NFCSTATUS_SUCCESS == status)
+        && (gLink.psListen->socket_sSap == nOldSap))
+    {
+        status = NFCSTATUS_FAILED;
+    }
+
+    /* Refused on the remembered SAP, then connected by name */
+    start = phOsalNfc_Sim_GetTime();
+    if(NFCSTATUS_SUCCESS == status)
+    {
+        status = bench_stream_connect_by_name(&gLink, 2);
+    }
+    if((NFCSTATUS_SUCCESS != status)
+        || (gLink.sStreams[2].psSender->socket_dSap
+                                    != gLink.psListen->socket_sSap))
+    {
+        bench_print_failure("ConnectRetry", &gLink);
+        bench_link_down(&gLink);
+        return 1;
+    }
+    printf("{\"bench\":\"ConnectRetry\",\"sim_ms\":%u}\n",
+           (unsigned)(phOsalNfc_Sim_GetTime() - start));
+    bench_link_down(&gLink);
+    return 0;
+}
+
+static
+int
+bench_throughput(
+                const char                          *pName,
+                phFriNfc_LlcpTransport_eSocketType_t eType,
+                uint8_t                             nStreams,
+                uint8_t                             bBulk
+                )
+{
+    phFriNfc_Llcp_sSendStats_t                  sInitiatorStats;
+    phFriNfc_Llcp_sSendStats_t                  sTargetStats;
+    phFriNfc_LlcpTransport_sSocketRecvStats_t   sRecvStats;
+    uint32_t            direct = 0;
+    uint32_t            staged = 0;
+    uint32_t            received = 0;
+    uint32_t            start = 0;
+    uint32_t            elapsed = 0;
+    uint32_t            allocations = 0;
+    uint32_t            pdus = 0;
+    uint32_t            turns = 0;
+    uint64_t            host_start = 0;
+    uint64_t            host_elapsed = 0;
+    uint8_t             s = 0;
+
+    if((NFCSTATUS_SUCCESS != bench_link_up(&gLink))
+        || (NFCSTATUS_SUCCESS != bench_streams_open(&gLink, eType, nStreams,
+                                                    bBulk)))
+    {
+        bench_print_failure(pName, &gLink);
+        bench_link_down(&gLink);
+        return 1;
+    }
+
+    /* Count the transfer only */
+    (void)memset(&sInitiatorStats, 0, sizeof(sInitiatorStats));
+    (void)memset(&sTargetStats, 0, sizeof(sTargetStats));
+    (void)phFriNfc_Llcp_GetSendStats(&gLink.sInitiator.sLlcp, &sInitiatorStats);
+    (void)phFriNfc_Llcp_GetSendStats(&gLink.sTarget.sLlcp, &sTargetStats);
+    pdus = sInitiatorStats.nSentPdus + sTargetStats.nSentPdus;
+    turns = sInitiatorStats.nSendTurns + sTargetStats.nSendTurns;
+    allocations = phOsalNfc_Sim_GetAllocations();
+    start = phOsalNfc_Sim_GetTime();
+    host_start = bench_host_ns();
+
+    if(FALSE == bench_run(&gLink, bench_streams_received))
+    {
+        bench_print_failure(pName, &gLink);
+        bench_link_down(&gLink);
+        return 1;
+    }
+
+    host_elapsed = bench_host_ns() - host_start;
+    elapsed = phOsalNfc_Sim_GetTime() - start;
+    allocations = phOsalNfc_Sim_GetAllocations() - allocations;
+    (void)phFriNfc_Llcp_GetSendStats(&gLink.sInitiator.sLlcp, &sInitiatorStats);
+    (void)phFriNfc_Llcp_GetSendStats(&gLink.sTarget.sLlcp, &sTargetStats);
+    pdus = (sInitiatorStats.nSentPdus + sTargetStats.nSentPdus) - pdus;
+    turns = (sInitiatorStats.nSendTurns + sTargetStats.nSendTurns) - turns;
+    for(s = 0; s < nStreams; s++)
+    {
+        if((TRUE == gLink.sStreams[s].bError)
+            || (gLink.sStreams[s].nReceived != gLink.sStreams[s].nTotal))
+        {
+            bench_print_failure(pName, &gLink);
+            bench_link_down(&gLink);
+            return 1;
+        }
+        received += gLink.sStreams[s].nReceived;
+        if(phFriNfc_LlcpTransport_eConnectionOriented == eType)
+        {
+            (void)phFriNfc_LlcpTransport_GetSocketRecvStats(
+                                    gLink.sStreams[s].psReceiver, &sRecvStats);
+            direct += sRecvStats.nDirectFrames;
+            staged += sRecvStats.nStagedFrames;
+        }
+    }
+    if((0 == elapsed) || (0 == pdus) || (0 == turns))
+    {
+        bench_print_failure(pName, &gLink);
+        bench_link_down(&gLink);
+        return 1;
+    }
+
+    printf("{\"bench\":\"%s\",\"sockets\":%u,\"miu\":%u,\"rw\":%u,"
+           "\"bytes\":%u,\"sim_ms\":%u,\"kbit_per_s\":%.1f,\"pdus\":%u,"
+           "\"pdus_per_turn\":%.2f,\"max_pdus_per_turn\":%u,"
+           "\"agf_frames\":%u,\"direct_frames\":%u,\"staged_frames\":%u,"
+           "\"allocs_per_pdu\":%.3f,\"host_ns_per_pdu\":%.0f}\n",
+           pName, (unsigned)nStreams, (unsigned)gLink.sStreams[0].nChunk,
+           (phFriNfc_LlcpTransport_eConnectionOriented == eType) ?
+                            (unsigned)gLink.sOptions.rw : 0U,
+           (unsigned)received, (unsigned)elapsed,
+           ((double)received * 8.0) / (double)elapsed, (unsigned)pdus,
+           (double)pdus / (double)turns,
+           (unsigned)((sInitiatorStats.nMaxPdusPerTurn >
+                        sTargetStats.nMaxPdusPerTurn) ?
+                            sInitiatorStats.nMaxPdusPerTurn :
+                            sTargetStats.nMaxPdusPerTurn),
+           (unsigned)(sInitiatorStats.nAggregatedFrames
+                        + sTargetStats.nAggregatedFrames),
+           (unsigned)direct, (unsigned)staged,
+           (double)allocations / (double)pdus,
+           (double)host_elapsed / (double)pdus);
+    bench_link_down(&gLink);
+    return 0;
+}
+
+int
+main(
+                int                     argc,
+                char                    **argv
+    )
+{
+    int                 failures = 0;
+    int                 arg = 0;
+
+    for(arg = 1; arg < argc; arg++)
+    {
+        if((0 == strcmp(argv[arg], "-l")) && ((arg + 1) < argc))
+        {
+            gConfig.nLatency = (uint32_t)strtoul(argv[++arg], NULL, 0);
+        }
+        else if((0 == strcmp(argv[arg], "-r")) && ((arg + 1) < argc))
+        {
+            gConfig.nBitrate = (uint32_t)strtoul(argv[++arg], NULL, 0);
+        }
+        else if((0 == strcmp(argv[arg], "-p")) && ((arg + 1) < argc))
+        {
+            gConfig.nLossRate = (uint16_t)strtoul(argv[++arg], NULL, 0);
+        }
+        else if((0 == strcmp(argv[arg], "-s")) && ((arg + 1) < argc))
+        {
+            gConfig.nSeed = (uint32_t)strtoul(argv[++arg], NULL, 0);
+        }
+        else if((0 == strcmp(argv[arg], "-m")) && ((arg + 1) < argc))
+        {
+            gLinkMiu = (uint16_t)strtoul(argv[++arg], NULL, 0);
+        }
+        else if((0 == strcmp(argv[arg], "-n")) && ((arg + 1) < argc))
+        {
+            gBytes = (uint32_t)strtoul(argv[++arg], NULL, 0);
+        }
+        else if((0 == strcmp(argv[arg], "-k")) && ((arg + 1) < argc))
+        {
+            gSockets = (uint8_t)strtoul(argv[++arg], NULL, 0);
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [-l <latency ms>] [-r <bitrate>] "
+                    "[-p <loss per mille>] [-s <seed>] [-m <link MIU>] "
+                    "[-n <bytes>] [-k <sockets>]\n", argv[0]);
+            return 2;
+        }
+    }
+    if((gLinkMiu < PHFRINFC_LLCP_MIU_DEFAULT)
+        || (gLinkMiu > PHFRINFC_LLCP_MIU_MAX)
+        || (0 == gSockets) || (gSockets > BENCH_MAX_STREAMS))
+    {
+        fprintf(stderr, "link MIU or socket count out of range\n");
+        return 2;
+    }
+
+    failures += bench_activation();
+    failures += bench_discovery(1);
+    failures += bench_discovery(4);
+    failures += bench_connect();
+    failures += bench_connect_retry();
+    failures += bench_throughput("ClThroughput",
+                        phFriNfc_LlcpTransport_eConnectionLess, 1, FALSE);
+    failures += bench_throughput("CoThroughput",
+                        phFriNfc_LlcpTransport_eConnectionOriented, 1, FALSE);
+    failures += bench_throughput("CoBulkThroughput",
+                        phFriNfc_LlcpTransport_eConnectionOriented, 1, TRUE);
+    failures += bench_throughput("CoMultiThroughput",
+                        phFriNfc_LlcpTransport_eConnectionOriented, gSockets,
+                        FALSE);
+
+    return (0 == failures) ? 0 : 1;
+}
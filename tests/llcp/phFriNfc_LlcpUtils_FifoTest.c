@@ -0,0 +1,317 @@
+/*
+ * Copyright (C) 2010 NXP Semiconductors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*!
+ * \file  phFriNfc_LlcpUtils_FifoTest.c
+ * \brief Host test and benchmark of the LLCP cyclic FIFO.
+ *
+ * The test drives phFriNfc_Llcp_CyclicFifoWrite, FifoRead, Peek/Commit and Clear
+ * with random lengths over FIFOs of several sizes. Every byte written carries its
+ * position in the stream, so that each byte read back is checked for order and
+ * loss. The usage and the room left are checked after every operation.
+ *
+ * With -b, the write/read and peek/commit of 1 KB and 2 KB blocks through a
+ * FIFO whose indexes wrap are then timed, one JSON object per line:
+ *
+ *  {"bench":"WriteRead","block":1024,"iterations":..,"ns_per_op":..,"mb_per_s":..}
+ *
+ * Usage: nfc_llcp_fifo_test [-s <seed>] [-n <operations>] [-b]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <phNfcTypes.h>
+#include <phFriNfc_LlcpUtils.h>
+
+#define FIFO_TEST_MAX_SIZE          2048U
+#define FIFO_TEST_DEFAULT_OPS       200000U
+#define FIFO_BENCH_SIZE             4096U
+#define FIFO_BENCH_TIME_NS          200000000ULL
+
+static uint32_t gSeed = 1;
+
+static
+uint32_t
+fifo_rand(void)
+{
+    gSeed = (gSeed * 1103515245U) + 12345U;
+    return gSeed >> 8;
+}
+
+/* Runs nOps random operations on a FIFO of nSize bytes, returns 0 on success */
+static
+int
+fifo_test_size(
+                uint32_t                nSize,
+                uint32_t                nOps
+              )
+{
+    static uint8_t      fifo_buffer[FIFO_TEST_MAX_SIZE];
+    static uint8_t      data[FIFO_TEST_MAX_SIZE + 1];
+    UTIL_FIFO_BUFFER    fifo;
+    uint32_t            written = 0;
+    uint32_t            read = 0;
+    uint32_t            op = 0;
+    uint32_t            length = 0;
+    uint32_t            done = 0;
+    uint32_t            span = 0;
+    uint32_t            i = 0;
+    uint8_t             *pSpan = NULL;
+
+    phFriNfc_Llcp_CyclicFifoInit(&fifo, fifo_buffer, nSize);
+
+    for(op = 0; op < nOps; op++)
+    {
+        /* Lengths up to one byte above the FIFO size */
+        length = fifo_rand() % (nSize + 2);
+
+        switch(fifo_rand() % 8)
+        {
+            case 0:
+            case 1:
+            case 2:
+            {
+                for(i = 0; i < length; i++)
+                {
+                    data[i] = (uint8_t)(written + i);
+                }
+                done = phFriNfc_Llcp_CyclicFifoWrite(&fifo, data, length);
+                if(done > length)
+                {
+                    printf("size %u op %u: wrote %u of %u\n", nSize, op, done,
+                           length);
+                    return -1;
+                }
+                written += done;
+                break;
+            }
+            case 3:
+            case 4:
+            {
+                done = phFriNfc_Llcp_CyclicFifoFifoRead(&fifo, data, length);
+                for(i = 0; i < done; i++)
+                {
+                    if(data[i] != (uint8_t)(read + i))
+                    {
+                        printf("size %u op %u: byte %u read out of order\n",
+                               nSize, op, read + i);
+                        return -1;
+                    }
+                }
+                read += done;
+                break;
+            }
+            case 5:
+            case 6:
+            {
+                /* Consume through the contiguous spans */
+                span = phFriNfc_Llcp_CyclicFifoPeek(&fifo, &pSpan);
+                if(span > (written - read))
+                {
+                    printf("size %u op %u: span of %u with %u stored\n", nSize,
+                           op, span, written - read);
+                    return -1;
+                }
+                if(length > span)
+                {
+                    length = span;
+                }
+                for(i = 0; i < length; i++)
+                {
+                    if(pSpan[i] != (uint8_t)(read + i))
+                    {
+                        printf("size %u op %u: byte %u peeked out of order\n",
+                               nSize, op, read + i);
+                        return -1;
+                    }
+                }
+                done = phFriNfc_Llcp_CyclicFifoCommit(&fifo, length);
+                if(done != length)
+                {
+                    printf("size %u op %u: committed %u of %u\n", nSize, op,
+                           done, length);
+                    return -1;
+                }
+                read += done;
+                break;
+            }
+            default:
+            {
+                if(0 == (fifo_rand() % 16))
+                {
+                    phFriNfc_Llcp_CyclicFifoClear(&fifo);
+                    read = written;
+                }
+                break;
+            }
+        }
+
+        if((phFriNfc_Llcp_CyclicFifoUsage(&fifo) != (written - read))
+            || (phFriNfc_Llcp_CyclicFifoAvailable(&fifo)
+                                        != (nSize - (written - read))))
+        {
+            printf("size %u op %u: usage %u available %u, %u stored\n", nSize,
+                   op, phFriNfc_Llcp_CyclicFifoUsage(&fifo),
+                   phFriNfc_Llcp_CyclicFifoAvailable(&fifo), written - read);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static
+uint64_t
+fifo_now_ns(void)
+{
+    struct timespec     now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+static
+void
+fifo_bench_print(
+                const char              *pName,
+                uint32_t                nBlock,
+                uint64_t                nIterations,
+                uint64_t                nElapsed
+                )
+{
+    double              ns_per_op = (double)nElapsed / (double)nIterations;
+
+    printf("{\"bench\":\"%s\",\"block\":%u,\"iterations\":%llu,"
+           "\"ns_per_op\":%.1f,\"mb_per_s\":%.1f}\n", pName, (unsigned)nBlock,
+           (unsigned long long)nIterations, ns_per_op,
+           ((double)nBlock * 1000.0) / ns_per_op);
+}
+
+/* Times the transfer of nBlock bytes in and out of a FIFO whose indexes wrap */
+static
+void
+fifo_bench(
+                uint32_t                nBlock
+          )
+{
+    static uint8_t      fifo_buffer[FIFO_BENCH_SIZE];
+    static uint8_t      in[FIFO_BENCH_SIZE];
+    static uint8_t      out[FIFO_BENCH_SIZE];
+    UTIL_FIFO_BUFFER    fifo;
+    uint64_t            start = 0;
+    uint64_t            elapsed = 0;
+    uint64_t            iterations = 0;
+    uint32_t            span = 0;
+    uint32_t            done = 0;
+    uint32_t            i = 0;
+    uint8_t             *pSpan = NULL;
+
+    (void)memset(in, 0x5A, sizeof(in));
+    phFriNfc_Llcp_CyclicFifoInit(&fifo, fifo_buffer, FIFO_BENCH_SIZE);
+    /* Offset the indexes so that the blocks wrap around the buffer end */
+    (void)phFriNfc_Llcp_CyclicFifoWrite(&fifo, in, FIFO_BENCH_SIZE - 100);
+    (void)phFriNfc_Llcp_CyclicFifoFifoRead(&fifo, out, FIFO_BENCH_SIZE - 100);
+
+    start = fifo_now_ns();
+    do
+    {
+        for(i = 0; i < 1024; i++)
+        {
+            (void)phFriNfc_Llcp_CyclicFifoWrite(&fifo, in, nBlock);
+            (void)phFriNfc_Llcp_CyclicFifoFifoRead(&fifo, out, nBlock);
+        }
+        iterations += 1024;
+        elapsed = fifo_now_ns() - start;
+    }while(elapsed < FIFO_BENCH_TIME_NS);
+    fifo_bench_print("WriteRead", nBlock, iterations, elapsed);
+
+    iterations = 0;
+    start = fifo_now_ns();
+    do
+    {
+        for(i = 0; i < 1024; i++)
+        {
+            (void)phFriNfc_Llcp_CyclicFifoWrite(&fifo, in, nBlock);
+            done = 0;
+            while(done < nBlock)
+            {
+                span = phFriNfc_Llcp_CyclicFifoPeek(&fifo, &pSpan);
+                out[0] ^= pSpan[0];
+                done += phFriNfc_Llcp_CyclicFifoCommit(&fifo, span);
+            }
+        }
+        iterations += 1024;
+        elapsed = fifo_now_ns() - start;
+    }while(elapsed < FIFO_BENCH_TIME_NS);
+    fifo_bench_print("WritePeekCommit", nBlock, iterations, elapsed);
+}
+
+int
+main(
+                int                     argc,
+                char                    **argv
+    )
+{
+    static const uint32_t sizes[] = { 1, 2, 7, 128, 1024, FIFO_TEST_MAX_SIZE };
+    uint32_t            ops = FIFO_TEST_DEFAULT_OPS;
+    uint8_t             bench = FALSE;
+    uint32_t            seed = 0;
+    uint32_t            i = 0;
+    int                 arg = 0;
+
+    for(arg = 1; arg < argc; arg++)
+    {
+        if((0 == strcmp(argv[arg], "-s")) && ((arg + 1) < argc))
+        {
+            gSeed = (uint32_t)strtoul(argv[++arg], NULL, 0);
+        }
+        else if((0 == strcmp(argv[arg], "-n")) && ((arg + 1) < argc))
+        {
+            ops = (uint32_t)strtoul(argv[++arg], NULL, 0);
+        }
+        else if(0 == strcmp(argv[arg], "-b"))
+        {
+            bench = TRUE;
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [-s <seed>] [-n <operations>] [-b]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+
+    seed = gSeed;
+    for(i = 0; i < (sizeof(sizes) / sizeof(sizes[0])); i++)
+    {
+        if(0 != fifo_test_size(sizes[i], ops))
+        {
+            printf("FAILED (seed %u)\n", seed);
+            return 1;
+        }
+    }
+    fprintf(stderr, "cyclic FIFO: %u operations on %u sizes passed\n", ops,
+            (unsigned)(sizeof(sizes) / sizeof(sizes[0])));
+
+    if(TRUE == bench)
+    {
+        fifo_bench(1024);
+        fifo_bench(2048);
+    }
+    return 0;
+}
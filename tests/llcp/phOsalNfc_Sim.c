@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2010 NXP Semiconductors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*!
+ * \file  phOsalNfc_Sim.c
+ * \brief Simulated OSAL for the host LLCP, HCI and HAL tests, see phOsalNfc_Sim.h.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <phNfcTypes.h>
+#include <phOsalNfc.h>
+#include <phOsalNfc_Timer.h>
+
+#include "phOsalNfc_Sim.h"
+
+#define SIM_TIMER_MAX               16U
+
+typedef struct phOsalNfc_SimTimer
+{
+    uint8_t             bCreated;
+    uint8_t             bRunning;
+    uint32_t            nExpiry;
+    /* Start order, timers expiring together fire in that order */
+    uint32_t            nOrder;
+    ppCallBck_t         pfCallback;
+    void                *pContext;
+
+}phOsalNfc_SimTimer_t;
+
+static phOsalNfc_SimTimer_t gSimTimers[SIM_TIMER_MAX];
+static uint32_t             gSimNow;
+static uint32_t             gSimOrder;
+static uint32_t             gSimAllocations;
+
+void
+phOsalNfc_Sim_Reset(void)
+{
+    uint32_t            i = 0;
+
+    for(i = 0; i < SIM_TIMER_MAX; i++)
+    {
+        gSimTimers[i].bRunning = FALSE;
+    }
+    gSimNow = 0;
+}
+
+uint8_t
+phOsalNfc_Sim_Step(void)
+{
+    phOsalNfc_SimTimer_t    *psNext = NULL;
+    uint32_t                i = 0;
+    uint32_t                id = 0;
+
+    for(i = 0; i < SIM_TIMER_MAX; i++)
+    {
+        if((TRUE == gSimTimers[i].bRunning)
+            && ((NULL == psNext)
+                || (gSimTimers[i].nExpiry < psNext->nExpiry)
+                || ((gSimTimers[i].nExpiry == psNext->nExpiry)
+                    && (gSimTimers[i].nOrder < psNext->nOrder))))
+        {
+            psNext = &gSimTimers[i];
+            id = i;
+        }
+    }
+    if(NULL == psNext)
+    {
+        return FALSE;
+    }
+
+    /* The callback may start its timer again */
+    gSimNow = psNext->nExpiry;
+    psNext->bRunning = FALSE;
+    psNext->pfCallback(id, psNext->pContext);
+    return TRUE;
+}
+
+uint32_t
+phOsalNfc_Sim_GetTime(void)
+{
+    return gSimNow;
+}
+
+uint32_t
+phOsalNfc_Sim_GetAllocations(void)
+{
+    return gSimAllocations;
+}
+
+uint32_t
+phOsalNfc_GetTime(void)
+{
+    return gSimNow;
+}
+
+void *
+phOsalNfc_GetMemory(uint32_t Size)
+{
+    gSimAllocations++;
+    return malloc(Size);
+}
+
+void
+phOsalNfc_FreeMemory(void *pMem)
+{
+    free(pMem);
+}
+
+int
+phOsalNfc_MemCompare(void *src, void *dest, unsigned int n)
+{
+    return memcmp(src, dest, n);
+}
+
+uint32_t
+phOsalNfc_Timer_Create(void)
+{
+    uint32_t            i = 0;
+
+    for(i = 0; i < SIM_TIMER_MAX; i++)
+    {
+        if(FALSE == gSimTimers[i].bCreated)
+        {
+            (void)memset(&gSimTimers[i], 0, sizeof(gSimTimers[i]));
+            gSimTimers[i].bCreated = TRUE;
+            return i;
+        }
+    }
+    return PH_OSALNFC_INVALID_TIMER_ID;
+}
+
+void
+phOsalNfc_Timer_Start(
+                uint32_t                TimerId,
+                uint32_t                RegTimeCnt,
+                ppCallBck_t             Application_callback,
+                void                    *pContext
+                     )
+{
+    if((TimerId < SIM_TIMER_MAX) && (TRUE == gSimTimers[TimerId].bCreated))
+    {
+        gSimTimers[TimerId].bRunning = TRUE;
+        gSimTimers[TimerId].nExpiry = gSimNow + RegTimeCnt;
+        gSimTimers[TimerId].nOrder = gSimOrder++;
+        gSimTimers[TimerId].pfCallback = Application_callback;
+        gSimTimers[TimerId].pContext = pContext;
+    }
+}
+
+void
+phOsalNfc_Timer_Stop(uint32_t TimerId)
+{
+    if(TimerId < SIM_TIMER_MAX)
+    {
+        gSimTimers[TimerId].bRunning = FALSE;
+    }
+}
+
+void
+phOsalNfc_Timer_Delete(uint32_t TimerId)
+{
+    if(TimerId < SIM_TIMER_MAX)
+    {
+        gSimTimers[TimerId].bRunning = FALSE;
+        gSimTimers[TimerId].bCreated = FALSE;
+    }
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2010 NXP Semiconductors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*!
+ * \file  phOsalNfc_Sim.h
+ * \brief Simulated OSAL for the host LLCP, HCI and HAL tests.
+ *
+ * The timers and the time of phOsalNfc_Timer.h and phOsalNfc.h run on a
+ * virtual clock, in milliseconds. Nothing runs by itself: the test calls
+ * phOsalNfc_Sim_Step, which moves the clock to the next timer to expire and
+ * calls its callback from the calling thread. A run is therefore independent
+ * of the host load, and the host time spent in a run is the CPU time of the
+ * stack.
+ *
+ * The memory allocations made through phOsalNfc_GetMemory are counted.
+ */
+
+#ifndef PHOSALNFC_SIM_H
+#define PHOSALNFC_SIM_H
+
+#include <phNfcTypes.h>
+
+/*!
+ * \brief Reset the virtual clock to 0 and stop all the timers.
+ */
+void phOsalNfc_Sim_Reset(void);
+
+/*!
+ * \brief Fire the next timer to expire.
+ *
+ * \retval TRUE     A timer callback was called.
+ * \retval FALSE    No timer is running.
+ */
+uint8_t phOsalNfc_Sim_Step(void);
+
+/*!
+ * \brief Current time of the virtual clock, in milliseconds.
+ */
+uint32_t phOsalNfc_Sim_GetTime(void);
+
+/*!
+ * \brief Number of phOsalNfc_GetMemory calls since the start of the process.
+ */
+uint32_t phOsalNfc_Sim_GetAllocations(void);
+
+#endif /* PHOSALNFC_SIM_H */
@@ -0,0 +1,597 @@
+/*
+ * Copyright (C) 2010 NXP Semiconductors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*!
+ * \file  phFriNfc_NdefRecord_Bench.c
+ * \brief Host benchmark of the NDEF record encoding and decoding.
+ *
+ * Times GetRecords, Parse, the record iterator, Reassemble, GenerateMessage and
+ * GenerateMessageVector over a fixed set of messages (URI, Text, Smart Poster,
+ * Handover Select, MIME, chunked, a 16 and a 100 record message). Each message is
+ * first checked to decode to the records it was generated from. The timings are written to the
+ * standard output as one JSON object per line:
+ *
+ *  {"bench":"GetRecords","message":"uri","bytes":20,"records":1,"iterations":..,
+ *   "ns_per_op":..,"mb_per_s":..}
+ *
+ * Usage: nfc_ndef_benchmark [-t <milliseconds per case>] [-c <corpus directory>]
+ *
+ * With -c the messages are also written to the given directory, one file per
+ * message, as the seed corpus of the NDEF fuzzer (tests/ndef/corpus).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <phNfcTypes.h>
+#include <phNfcStatus.h>
+#include <phFriNfc_NdefRecord.h>
+
+#define BENCH_MAX_RECORDS           100U
+#define BENCH_MULTI_RECORDS         16U
+#define BENCH_MAX_MESSAGE           8192U
+#define BENCH_MAX_SEGMENTS          (2U * BENCH_MAX_RECORDS)
+#define BENCH_DEFAULT_TIME_MS       200U
+
+typedef struct bench_message
+{
+    const char             *name;
+    phFriNfc_NdefRecord_t   records[BENCH_MAX_RECORDS];
+    uint32_t                count;
+    uint8_t                 buffer[BENCH_MAX_MESSAGE];
+    uint32_t                length;
+} bench_message_t;
+
+typedef NFCSTATUS (*bench_op_t)(bench_message_t *pMessage);
+
+/* Payloads shared by the messages */
+static uint8_t  gUriPayload[] = "\x04" "www.example.com/nfc/product?id=1234";
+static uint8_t  gTextPayload[] = "\x02" "en" "Tap to pair with the speaker";
+static uint8_t  gActPayload[] = { 0x00 };
+static uint8_t  gSmartPoster[256];
+static uint8_t  gHandoverAc[] = { 0x01, 0x01, '0', 0x00 };
+static uint8_t  gHandover[64];
+static uint8_t  gBtOob[] = {
+    0x20, 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x0D, 0x09, 'S', 'p',
+    'e', 'a', 'k', 'e', 'r', ' ', 'N', 'F', 'C', 0x04, 0x0D, 0x14, 0x04,
+    0x24, 0x03, 0x03, 0x0B, 0x11
+};
+static uint8_t  gLarge[1024];
+
+static uint8_t  gTypeU[] = "U";
+static uint8_t  gTypeT[] = "T";
+static uint8_t  gTypeAct[] = "act";
+static uint8_t  gTypeSp[] = "Sp";
+static uint8_t  gTypeHs[] = "Hs";
+static uint8_t  gTypeAc[] = "ac";
+static uint8_t  gTypeBt[] = "application/vnd.bluetooth.ep.oob";
+static uint8_t  gTypeVcard[] = "text/vcard";
+static uint8_t  gTypeOctet[] = "application/octet-stream";
+static uint8_t  gId0[] = "0";
+
+static bench_message_t  gMessages[8];
+static uint32_t         gNumberOfMessages = 0;
+
+/* Sink of the decoded values, keeps the operations from being optimised out */
+static volatile uint32_t gSink;
+
+static
+void
+bench_record(
+                phFriNfc_NdefRecord_t   *pRecord,
+                uint8_t                 Flags,
+                uint8_t                 Tnf,
+                uint8_t                 *pType,
+                uint8_t                 *pId,
+                uint8_t                 *pPayload,
+                uint32_t                PayloadLength
+            )
+{
+    (void)memset(pRecord, 0, sizeof(*pRecord));
+    pRecord->Flags = Flags;
+    pRecord->Tnf = Tnf;
+    pRecord->Type = pType;
+    pRecord->TypeLength = (uint8_t)((NULL != pType)? strlen((char *)pType) : 0);
+    pRecord->Id = pId;
+    pRecord->IdLength = (uint8_t)((NULL != pId)? strlen((char *)pId) : 0);
+    pRecord->PayloadData = pPayload;
+    pRecord->PayloadLength = PayloadLength;
+}
+
+/* Serialises the records of the message, returns 0 on success */
+static
+int
+bench_generate(
+                bench_message_t         *pMessage
+              )
+{
+    phNfc_sData_t       message;
+
+    message.buffer = pMessage->buffer;
+    message.length = sizeof(pMessage->buffer);
+    if(NFCSTATUS_SUCCESS != phFriNfc_NdefRecord_GenerateMessage(
+                    pMessage->records, pMessage->count, &message))
+    {
+        return -1;
+    }
+    pMessage->length = message.length;
+    return 0;
+}
+
+/* Serialises a nested message (Smart Poster, Handover) into pBuffer */
+static
+uint32_t
+bench_nested(
+                phFriNfc_NdefRecord_t   *pRecords,
+                uint32_t                NumberOfRecords,
+                uint8_t                 *pBuffer,
+                uint32_t                Length
+            )
+{
+    phNfc_sData_t       message;
+
+    message.buffer = pBuffer;
+    message.length = Length;
+    if(NFCSTATUS_SUCCESS != phFriNfc_NdefRecord_GenerateMessage(
+                    pRecords, NumberOfRecords, &message))
+    {
+        return 0;
+    }
+    return message.length;
+}
+
+static
+int
+bench_build_corpus(void)
+{
+    phFriNfc_NdefRecord_t   nested[3];
+    bench_message_t         *pMessage = NULL;
+    uint32_t                length = 0;
+    uint32_t                i = 0;
+
+    for(i = 0; i < sizeof(gLarge); i++)
+    {
+        gLarge[i] = (uint8_t)('A' + (i % 26));
+    }
+
+    /* URI record */
+    pMessage = &gMessages[gNumberOfMessages++];
+    pMessage->name = "uri";
+    bench_record(&pMessage->records[0], 0, PH_FRINFC_NDEFRECORD_TNF_NFCWELLKNOWN,
+                 gTypeU, NULL, gUriPayload, sizeof(gUriPayload) - 1);
+    pMessage->count = 1;
+
+    /* Text record */
+    pMessage = &gMessages[gNumberOfMessages++];
+    pMessage->name = "text";
+    bench_record(&pMessage->records[0], 0, PH_FRINFC_NDEFRECORD_TNF_NFCWELLKNOWN,
+                 gTypeT, NULL, gTextPayload, sizeof(gTextPayload) - 1);
+    pMessage->count = 1;
+
+    /* Smart Poster: URI, Title and Action records in an Sp record */
+    bench_record(&nested[0], 0, PH_FRINFC_NDEFRECORD_TNF_NFCWELLKNOWN,
+                 gTypeU, NULL, gUriPayload, sizeof(gUriPayload) - 1);
+    bench_record(&nested[1], 0, PH_FRINFC_NDEFRECORD_TNF_NFCWELLKNOWN,
+                 gTypeT, NULL, gTextPayload, sizeof(gTextPayload) - 1);
+    bench_record(&nested[2], 0, PH_FRINFC_NDEFRECORD_TNF_NFCWELLKNOWN,
+                 gTypeAct, NULL, gActPayload, sizeof(gActPayload));
+    length = bench_nested(nested, 3, gSmartPoster, sizeof(gSmartPoster));
+    pMessage = &gMessages[gNumberOfMessages++];
+    pMessage->name = "smart_poster";
+    bench_record(&pMessage->records[0], 0, PH_FRINFC_NDEFRECORD_TNF_NFCWELLKNOWN,
+                 gTypeSp, NULL, gSmartPoster, length);
+    pMessage->count = 1;
+
+    /* Bluetooth static handover: Hs record with one ac, then the OOB record */
+    gHandover[0] = 0x12;
+    bench_record(&nested[0], 0, PH_FRINFC_NDEFRECORD_TNF_NFCWELLKNOWN,
+                 gTypeAc, NULL, gHandoverAc, sizeof(gHandoverAc));
+    length = bench_nested(nested, 1, &gHandover[1], sizeof(gHandover) - 1);
+    pMessage = &gMessages[gNumberOfMessages++];
+    pMessage->name = "handover";
+    bench_record(&pMessage->records[0], 0, PH_FRINFC_NDEFRECORD_TNF_NFCWELLKNOWN,
+                 gTypeHs, NULL, gHandover, length + 1);
+    bench_record(&pMessage->records[1], 0, PH_FRINFC_NDEFRECORD_TNF_MEDIATYPE,
+                 gTypeBt, gId0, gBtOob, sizeof(gBtOob));
+    pMessage->count = 2;
+
+    /* MIME record with a payload above the short record limit */
+    pMessage = &gMessages[gNumberOfMessages++];
+    pMessage->name = "mime";
+    bench_record(&pMessage->records[0], 0, PH_FRINFC_NDEFRECORD_TNF_MEDIATYPE,
+                 gTypeVcard, NULL, gLarge, 600);
+    pMessage->count = 1;
+
+    /* One MIME payload sent in four chunks */
+    pMessage = &gMessages[gNumberOfMessages++];
+    pMessage->name = "chunked";
+    bench_record(&pMessage->records[0], PH_FRINFC_NDEFRECORD_FLAGS_CF,
+                 PH_FRINFC_NDEFRECORD_TNF_MEDIATYPE, gTypeOctet, NULL,
+                 &gLarge[0], 256);
+    for(i = 1; i < 4; i++)
+    {
+        bench_record(&pMessage->records[i],
+                     (uint8_t)((i < 3)? PH_FRINFC_NDEFRECORD_FLAGS_CF : 0),
+                     PH_FRINFC_NDEFRECORD_TNF_UNCHANGED, NULL, NULL,
+                     &gLarge[i * 256], 256);
+    }
+    pMessage->count = 4;
+
+    /* Many short URI records */
+    pMessage = &gMessages[gNumberOfMessages++];
+    pMessage->name = "multi";
+    for(i = 0; i < BENCH_MULTI_RECORDS; i++)
+    {
+        bench_record(&pMessage->records[i], 0,
+                     PH_FRINFC_NDEFRECORD_TNF_NFCWELLKNOWN, gTypeU, NULL,
+                     gUriPayload, sizeof(gUriPayload) - 1);
+    }
+    pMessage->count = BENCH_MULTI_RECORDS;
+
+    /* A hundred URI records, the per record cost of long messages */
+    pMessage = &gMessages[gNumberOfMessages++];
+    pMessage->name = "multi_100";
+    for(i = 0; i < BENCH_MAX_RECORDS; i++)
+    {
+        bench_record(&pMessage->records[i], 0,
+                     PH_FRINFC_NDEFRECORD_TNF_NFCWELLKNOWN, gTypeU, NULL,
+                     gUriPayload, sizeof(gUriPayload) - 1);
+    }
+    pMessage->count = BENCH_MAX_RECORDS;
+
+    for(i = 0; i < gNumberOfMessages; i++)
+    {
+        if(0 != bench_generate(&gMessages[i]))
+        {
+            fprintf(stderr, "cannot generate the %s message\n",
+                    gMessages[i].name);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* Checks that the message decodes to the records it was generated from */
+static
+int
+bench_check(
+                bench_message_t         *pMessage
+           )
+{
+    uint8_t                         *raw[BENCH_MAX_RECORDS];
+    uint8_t                         chunked[BENCH_MAX_RECORDS];
+    uint32_t                        count = BENCH_MAX_RECORDS;
+    phFriNfc_NdefRecord_Iterator_t  iterator;
+    phFriNfc_NdefRecord_t           record;
+    uint32_t                        i = 0;
+
+    if((NFCSTATUS_SUCCESS != phFriNfc_NdefRecord_GetRecords(pMessage->buffer,
+                    pMessage->length, raw, chunked, &count))
+        || (count != pMessage->count))
+    {
+        return -1;
+    }
+    (void)phFriNfc_NdefRecord_IteratorInit(&iterator, pMessage->buffer,
+                    pMessage->length, pMessage->length);
+    for(i = 0; i < pMessage->count; i++)
+    {
+        if((NFCSTATUS_SUCCESS != phFriNfc_NdefRecord_IteratorNext(&iterator,
+                    &record))
+            || (record.Tnf != pMessage->records[i].Tnf)
+            || (record.PayloadLength != pMessage->records[i].PayloadLength)
+            || (0 != memcmp(record.PayloadData,
+                    pMessage->records[i].PayloadData, record.PayloadLength)))
+        {
+            return -1;
+        }
+    }
+    if(PHNFCSTATUS(phFriNfc_NdefRecord_IteratorNext(&iterator, &record))
+        != NFCSTATUS_EOF_NDEF_CONTAINER_REACHED)
+    {
+        return -1;
+    }
+    return 0;
+}
+
+static
+NFCSTATUS
+bench_get_records(
+                bench_message_t         *pMessage
+                 )
+{
+    uint8_t             *raw[BENCH_MAX_RECORDS];
+    uint8_t             chunked[BENCH_MAX_RECORDS];
+    uint32_t            count = BENCH_MAX_RECORDS;
+    NFCSTATUS           status = NFCSTATUS_SUCCESS;
+
+    status = phFriNfc_NdefRecord_GetRecords(pMessage->buffer, pMessage->length,
+                                            raw, chunked, &count);
+    gSink += count;
+    return status;
+}
+
+static
+NFCSTATUS
+bench_parse(
+                bench_message_t         *pMessage
+           )
+{
+    uint8_t                 *raw[BENCH_MAX_RECORDS];
+    uint8_t                 chunked[BENCH_MAX_RECORDS];
+    uint32_t                count = BENCH_MAX_RECORDS;
+    phFriNfc_NdefRecord_t   record;
+    uint32_t                i = 0;
+    NFCSTATUS               status = NFCSTATUS_SUCCESS;
+
+    status = phFriNfc_NdefRecord_GetRecords(pMessage->buffer, pMessage->length,
+                                            raw, chunked, &count);
+    for(i = 0; (NFCSTATUS_SUCCESS == status) && (i < count); i++)
+    {
+        status = phFriNfc_NdefRecord_Parse(&record, raw[i]);
+        gSink += record.PayloadLength;
+    }
+    return status;
+}
+
+static
+NFCSTATUS
+bench_iterator(
+                bench_message_t         *pMessage
+              )
+{
+    phFriNfc_NdefRecord_Iterator_t  iterator;
+    phFriNfc_NdefRecord_t           record;
+    NFCSTATUS                       status = NFCSTATUS_SUCCESS;
+
+    (void)phFriNfc_NdefRecord_IteratorInit(&iterator, pMessage->buffer,
+                    pMessage->length, pMessage->length);
+    while(NFCSTATUS_SUCCESS == status)
+    {
+        status = phFriNfc_NdefRecord_IteratorNext(&iterator, &record);
+        gSink += record.PayloadLength;
+    }
+    return (NFCSTATUS_EOF_NDEF_CONTAINER_REACHED == PHNFCSTATUS(status))?
+                NFCSTATUS_SUCCESS : status;
+}
+
+static
+NFCSTATUS
+bench_reassemble(
+                bench_message_t         *pMessage
+                )
+{
+    static uint8_t                  arena_buffer[BENCH_MAX_MESSAGE];
+    phFriNfc_NdefRecord_Iterator_t  iterator;
+    phFriNfc_NdefRecord_Arena_t     arena;
+    phFriNfc_NdefRecord_t           record;
+    NFCSTATUS                       status = NFCSTATUS_SUCCESS;
+
+    arena.Buffer = arena_buffer;
+    arena.Length = sizeof(arena_buffer);
+    arena.Used = 0;
+    (void)phFriNfc_NdefRecord_IteratorInit(&iterator, pMessage->buffer,
+                    pMessage->length, pMessage->length);
+    while(NFCSTATUS_SUCCESS == status)
+    {
+        status = phFriNfc_NdefRecord_Reassemble(&iterator, &record, &arena,
+                                                NULL, NULL);
+        gSink += record.PayloadLength;
+    }
+    return (NFCSTATUS_EOF_NDEF_CONTAINER_REACHED == PHNFCSTATUS(status))?
+                NFCSTATUS_SUCCESS : status;
+}
+
+static
+NFCSTATUS
+bench_generate_message(
+                bench_message_t         *pMessage
+                      )
+{
+    static uint8_t      out[BENCH_MAX_MESSAGE];
+    phNfc_sData_t       message;
+    NFCSTATUS           status = NFCSTATUS_SUCCESS;
+
+    message.buffer = out;
+    message.length = sizeof(out);
+    status = phFriNfc_NdefRecord_GenerateMessage(pMessage->records,
+                                        pMessage->count, &message);
+    gSink += message.length;
+    return status;
+}
+
+static
+NFCSTATUS
+bench_generate_vector(
+                bench_message_t         *pMessage
+                     )
+{
+    static uint8_t      headers[BENCH_MAX_MESSAGE];
+    phNfc_sData_t       header_data;
+    phNfc_sData_t       segments[BENCH_MAX_SEGMENTS];
+    uint32_t            count = BENCH_MAX_SEGMENTS;
+    NFCSTATUS           status = NFCSTATUS_SUCCESS;
+
+    header_data.buffer = headers;
+    header_data.length = sizeof(headers);
+    status = phFriNfc_NdefRecord_GenerateMessageVector(pMessage->records,
+                        pMessage->count, &header_data, segments, &count);
+    gSink += count;
+    return status;
+}
+
+static
+uint64_t
+bench_now_ns(void)
+{
+    struct timespec     now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+/* Runs the operation for at least TimeMs and prints its timing */
+static
+int
+bench_run(
+                const char              *pName,
+                bench_op_t              pOp,
+                bench_message_t         *pMessage,
+                uint32_t                TimeMs
+         )
+{
+    uint64_t            budget = (uint64_t)TimeMs * 1000000ULL;
+    uint64_t            start = 0;
+    uint64_t            elapsed = 0;
+    uint64_t            iterations = 0;
+    uint64_t            batch = 1;
+    uint64_t            i = 0;
+    double              ns_per_op = 0;
+
+    if(NFCSTATUS_SUCCESS != pOp(pMessage))
+    {
+        fprintf(stderr, "%s failed on the %s message\n", pName, pMessage->name);
+        return -1;
+    }
+
+    start = bench_now_ns();
+    while(elapsed < budget)
+    {
+        for(i = 0; i < batch; i++)
+        {
+            (void)pOp(pMessage);
+        }
+        iterations += batch;
+        elapsed = bench_now_ns() - start;
+        if(batch < 0x10000ULL)
+        {
+            batch *= 2;
+        }
+    }
+    ns_per_op = (double)elapsed / (double)iterations;
+
+    printf("{\"bench\":\"%s\",\"message\":\"%s\",\"bytes\":%u,\"records\":%u,"
+           "\"iterations\":%llu,\"ns_per_op\":%.1f,\"mb_per_s\":%.1f}\n",
+           pName, pMessage->name, (unsigned)pMessage->length,
+           (unsigned)pMessage->count, (unsigned long long)iterations,
+           ns_per_op, ((double)pMessage->length * 1000.0) / ns_per_op);
+    return 0;
+}
+
+static
+int
+bench_write_corpus(
+                const char              *pDirectory
+                  )
+{
+    char                path[512];
+    FILE                *file = NULL;
+    uint32_t            i = 0;
+
+    for(i = 0; i < gNumberOfMessages; i++)
+    {
+        (void)snprintf(path, sizeof(path), "%s/%s.ndef", pDirectory,
+                       gMessages[i].name);
+        file = fopen(path, "wb");
+        if((NULL == file)
+            || (1 != fwrite(gMessages[i].buffer, gMessages[i].length, 1, file)))
+        {
+            fprintf(stderr, "cannot write %s\n", path);
+            if(NULL != file)
+            {
+                (void)fclose(file);
+            }
+            return -1;
+        }
+        (void)fclose(file);
+    }
+    return 0;
+}
+
+int
+main(
+                int                     argc,
+                char                    **argv
+    )
+{
+    static const struct
+    {
+        const char      *name;
+        bench_op_t      op;
+    } benches[] = {
+        { "GetRecords",             bench_get_records },
+        { "Parse",                  bench_parse },
+        { "Iterator",               bench_iterator },
+        { "Reassemble",             bench_reassemble },
+        { "GenerateMessage",        bench_generate_message },
+        { "GenerateMessageVector",  bench_generate_vector },
+    };
+    uint32_t            time_ms = BENCH_DEFAULT_TIME_MS;
+    const char          *corpus = NULL;
+    uint32_t            i = 0;
+    uint32_t            j = 0;
+    int                 arg = 0;
+
+    for(arg = 1; arg < argc; arg++)
+    {
+        if((0 == strcmp(argv[arg], "-t")) && ((arg + 1) < argc))
+        {
+            time_ms = (uint32_t)strtoul(argv[++arg], NULL, 0);
+        }
+        else if((0 == strcmp(argv[arg], "-c")) && ((arg + 1) < argc))
+        {
+            corpus = argv[++arg];
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [-t <ms per case>] [-c <corpus dir>]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+
+    if(0 != bench_build_corpus())
+    {
+        return 1;
+    }
+    for(i = 0; i < gNumberOfMessages; i++)
+    {
+        if(0 != bench_check(&gMessages[i]))
+        {
+            fprintf(stderr, "the %s message does not decode back\n",
+                    gMessages[i].name);
+            return 1;
+        }
+    }
+    if((NULL != corpus) && (0 != bench_write_corpus(corpus)))
+    {
+        return 1;
+    }
+
+    for(j = 0; j < (sizeof(benches) / sizeof(benches[0])); j++)
+    {
+        for(i = 0; i < gNumberOfMessages; i++)
+        {
+            if(0 != bench_run(benches[j].name, benches[j].op, &gMessages[i],
+                              time_ms))
+            {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
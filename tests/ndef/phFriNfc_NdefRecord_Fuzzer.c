@@ -0,0 +1,263 @@
+/*
+ * Copyright (C) 2010 NXP Semiconductors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*!
+ * \file  phFriNfc_NdefRecord_Fuzzer.c
+ * \brief libFuzzer target of the NDEF record decoding.
+ *
+ * The input is taken as a received NDEF message and decoded with GetRecords and
+ * Parse, with the record iterator (the message being made available in two
+ * steps) and with Reassemble. The input is copied to a buffer of its exact size
+ * so that the sanitizers catch any read past the message.
+ *
+ * The decoders have to agree: GetRecords accepts the message exactly when the
+ * iterator reaches the end of the message, and then both return the same records
+ * (TNF, flags, type, ID, payload pointer and length). The fuzzer aborts on any
+ * difference.
+ *
+ * The seed corpus is tests/ndef/corpus, written by nfc_ndef_benchmark -c.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <phNfcTypes.h>
+#include <phNfcStatus.h>
+#include <phFriNfc_NdefRecord.h>
+
+#define FUZZ_MAX_RECORDS            128U
+#define FUZZ_MAX_SEGMENTS           8U
+#define FUZZ_ARENA_SIZE             256U
+
+/* Records decoded by GetRecords and Parse, then by the iterator */
+static phFriNfc_NdefRecord_t    gParsed[FUZZ_MAX_RECORDS];
+static phFriNfc_NdefRecord_t    gIterated[FUZZ_MAX_RECORDS];
+
+static
+uint32_t
+fuzz_get_records(
+                uint8_t                 *pBuffer,
+                uint32_t                Length,
+                NFCSTATUS               *pStatus
+                )
+{
+    uint8_t                 *raw[FUZZ_MAX_RECORDS];
+    uint8_t                 chunked[FUZZ_MAX_RECORDS];
+    uint32_t                count = 0;
+    uint32_t                i = 0;
+
+    /* Count only, then fill in the records */
+    *pStatus = phFriNfc_NdefRecord_GetRecords(pBuffer, Length, NULL, NULL,
+                                              &count);
+    if((NFCSTATUS_SUCCESS == *pStatus) && (count > FUZZ_MAX_RECORDS))
+    {
+        /* Too many records to be compared, the message is skipped */
+        return count;
+    }
+    if(NFCSTATUS_SUCCESS == *pStatus)
+    {
+        *pStatus = phFriNfc_NdefRecord_GetRecords(pBuffer, Length, raw,
+                                                  chunked, &count);
+    }
+    for(i = 0; (NFCSTATUS_SUCCESS == *pStatus) && (i < count); i++)
+    {
+        /* Parse leaves the ID untouched when there is none */
+        (void)memset(&gParsed[i], 0, sizeof(gParsed[i]));
+        *pStatus = phFriNfc_NdefRecord_Parse(&gParsed[i], raw[i]);
+    }
+    return count;
+}
+
+static
+uint32_t
+fuzz_iterator(
+                uint8_t                 *pBuffer,
+                uint32_t                Length,
+                NFCSTATUS               *pStatus
+             )
+{
+    phFriNfc_NdefRecord_Iterator_t  iterator;
+    phFriNfc_NdefRecord_t           record;
+    uint32_t                        count = 0;
+    uint8_t                         fed = FALSE;
+    NFCSTATUS                       status = NFCSTATUS_SUCCESS;
+
+    status = phFriNfc_NdefRecord_IteratorInit(&iterator, pBuffer, Length,
+                                              Length / 2);
+    while(NFCSTATUS_SUCCESS == status)
+    {
+        status = phFriNfc_NdefRecord_IteratorNext(&iterator, &record);
+        if(NFCSTATUS_SUCCESS == status)
+        {
+            if(count < FUZZ_MAX_RECORDS)
+            {
+                gIterated[count] = record;
+            }
+            count++;
+        }
+        else if((NFCSTATUS_MORE_INFORMATION == PHNFCSTATUS(status))
+            && (FALSE == fed))
+        {
+            /* The rest of the message arrives */
+            fed = TRUE;
+            status = phFriNfc_NdefRecord_IteratorFeed(&iterator, Length);
+        }
+        else
+        {
+            /* End of the message or error */
+        }
+    }
+    *pStatus = status;
+    return count;
+}
+
+/* Returns 0 when both decoders give the same record */
+static
+int
+fuzz_compare(
+                phFriNfc_NdefRecord_t   *pParsed,
+                phFriNfc_NdefRecord_t   *pIterated
+            )
+{
+    /* Parse points the type at the ID or payload when the type is empty,
+        the iterator gives NULL: the pointers are only compared when set */
+    if((pParsed->Tnf != pIterated->Tnf)
+        || (pParsed->Flags != pIterated->Flags)
+        || (pParsed->TypeLength != pIterated->TypeLength)
+        || ((0 != pParsed->TypeLength) && (pParsed->Type != pIterated->Type))
+        || (pParsed->IdLength != pIterated->IdLength)
+        || ((0 != pParsed->IdLength) && (pParsed->Id != pIterated->Id))
+        || (pParsed->PayloadLength != pIterated->PayloadLength)
+        || (pParsed->PayloadData != pIterated->PayloadData))
+    {
+        return -1;
+    }
+    return 0;
+}
+
+static
+void
+fuzz_reassemble(
+                uint8_t                 *pBuffer,
+                uint32_t                Length
+               )
+{
+    phFriNfc_NdefRecord_Iterator_t  iterator;
+    phFriNfc_NdefRecord_Arena_t     arena;
+    phFriNfc_NdefRecord_t           record;
+    phNfc_sData_t                   segments[FUZZ_MAX_SEGMENTS];
+    uint32_t                        number_of_segments = 0;
+    uint8_t                         *arena_buffer = NULL;
+    NFCSTATUS                       status = NFCSTATUS_SUCCESS;
+
+    arena_buffer = (uint8_t *)malloc(FUZZ_ARENA_SIZE);
+    if(NULL == arena_buffer)
+    {
+        return;
+    }
+    arena.Buffer = arena_buffer;
+    arena.Length = FUZZ_ARENA_SIZE;
+    arena.Used = 0;
+
+    /* With an arena, then zero copy with the segment list */
+    status = phFriNfc_NdefRecord_IteratorInit(&iterator, pBuffer, Length,
+                                              Length);
+    while(NFCSTATUS_SUCCESS == status)
+    {
+        number_of_segments = FUZZ_MAX_SEGMENTS;
+        status = phFriNfc_NdefRecord_Reassemble(&iterator, &record, &arena,
+                                        segments, &number_of_segments);
+        if((NFCSTATUS_SUCCESS == status) && (NULL != record.PayloadData)
+            && (0 != record.PayloadLength))
+        {
+            /* Touch the first and the last payload byte */
+            arena_buffer[0] ^= (uint8_t)(record.PayloadData[0]
+                            ^ record.PayloadData[record.PayloadLength - 1]);
+        }
+    }
+    status = phFriNfc_NdefRecord_IteratorInit(&iterator, pBuffer, Length,
+                                              Length);
+    while(NFCSTATUS_SUCCESS == status)
+    {
+        number_of_segments = FUZZ_MAX_SEGMENTS;
+        status = phFriNfc_NdefRecord_Reassemble(&iterator, &record, NULL,
+                                        segments, &number_of_segments);
+    }
+    free(arena_buffer);
+}
+
+int
+LLVMFuzzerTestOneInput(
+                const uint8_t           *pData,
+                size_t                  Size
+                      )
+{
+    uint8_t             *buffer = NULL;
+    uint32_t            length = (uint32_t)Size;
+    uint32_t            records = 0;
+    uint32_t            iterated = 0;
+    uint32_t            i = 0;
+    NFCSTATUS           records_status = NFCSTATUS_SUCCESS;
+    NFCSTATUS           iterator_status = NFCSTATUS_SUCCESS;
+
+    if((0 == Size) || (Size > 0x10000U))
+    {
+        return 0;
+    }
+    buffer = (uint8_t *)malloc(Size);
+    if(NULL == buffer)
+    {
+        return 0;
+    }
+    (void)memcpy(buffer, pData, Size);
+
+    records = fuzz_get_records(buffer, length, &records_status);
+    iterated = fuzz_iterator(buffer, length, &iterator_status);
+    fuzz_reassemble(buffer, length);
+
+    if(records > FUZZ_MAX_RECORDS)
+    {
+        /* Not compared */
+    }
+    else if((NFCSTATUS_SUCCESS == records_status) !=
+        (NFCSTATUS_EOF_NDEF_CONTAINER_REACHED == PHNFCSTATUS(iterator_status)))
+    {
+        /* One decoder accepts the message and the other rejects it */
+        abort();
+    }
+    else if(NFCSTATUS_SUCCESS == records_status)
+    {
+        if(records != iterated)
+        {
+            abort();
+        }
+        for(i = 0; i < records; i++)
+        {
+            if(0 != fuzz_compare(&gParsed[i], &gIterated[i]))
+            {
+                abort();
+            }
+        }
+    }
+    else
+    {
+        /* Rejected by both */
+    }
+
+    free(buffer);
+    return 0;
+}